@@ -0,0 +1,90 @@
+#include <cmath>
+#include <vector>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "Bench.hpp"
+#include "math/Affine.hpp"
+
+namespace bench {
+
+// Affine3 (3x4) against the same transforms held as full Mat4s: composition, inverse,
+// normal matrix and point transforms, scalar and batched.
+void RunAffineBench() {
+    constexpr std::size_t kCount = 1 << 16;
+    std::vector<math::Affine3> a(kCount), b(kCount), ab(kCount);
+    std::vector<Mat4> ma(kCount), mb(kCount), mab(kCount);
+    std::vector<Mat3> normals(kCount);
+    for (std::size_t i = 0; i < kCount; ++i) {
+        const float f = static_cast<float>(i);
+        a[i] = math::Affine3::Translation({std::sin(f), 1.f, -2.f}) *
+               math::Affine3::Rotation(f, Vec3{1.f, std::cos(f), 0.5f}) * math::Affine3::Scale({1.f, 1.5f, 2.f});
+        b[i] = math::Affine3::Rotation(0.3f * f, Vec3{0.f, 1.f, std::sin(f)}) *
+               math::Affine3::Translation({0.5f, std::cos(f), 1.f});
+        ma[i] = a[i].ToMat4();
+        mb[i] = b[i].ToMat4();
+    }
+
+    const double tComposeMat4 = TimeBest([&] {
+        for (std::size_t i = 0; i < kCount; ++i) mab[i] = ma[i] * mb[i];
+        DoNotOptimize(mab.data());
+    });
+    const double tComposeAffine = TimeBest([&] {
+        for (std::size_t i = 0; i < kCount; ++i) ab[i] = a[i] * b[i];
+        DoNotOptimize(ab.data());
+    });
+    const double tInverseMat4 = TimeBest([&] {
+        for (std::size_t i = 0; i < kCount; ++i) mab[i] = glm::inverse(ma[i]);
+        DoNotOptimize(mab.data());
+    });
+    const double tInverseAffine = TimeBest([&] {
+        for (std::size_t i = 0; i < kCount; ++i) ab[i] = a[i].Inverse();
+        DoNotOptimize(ab.data());
+    });
+    const double tNormalMat4 = TimeBest([&] {
+        for (std::size_t i = 0; i < kCount; ++i) normals[i] = glm::transpose(glm::inverse(Mat3(ma[i])));
+        DoNotOptimize(normals.data());
+    });
+    const double tNormalAffine = TimeBest([&] {
+        for (std::size_t i = 0; i < kCount; ++i) normals[i] = a[i].NormalMatrix();
+        DoNotOptimize(normals.data());
+    });
+
+    // One model transform over many points, as the raster and shadow loops use it
+    constexpr std::size_t kPoints = 1 << 20;
+    std::vector<Vec3> points(kPoints), out(kPoints);
+    math::Vec3Batch batch(kPoints), batchOut;
+    for (std::size_t i = 0; i < kPoints; ++i) {
+        const float f = static_cast<float>(i);
+        points[i] = {std::sin(f), std::cos(1.3f * f), 0.5f};
+        batch.set(i, points[i]);
+    }
+    const Mat4 model = ma[7];
+    const math::Affine3 modelAffine = a[7];
+    const double tPointsMat4 = TimeBest([&] {
+        for (std::size_t i = 0; i < kPoints; ++i) out[i] = Vec3(model * Vec4(points[i], 1.f));
+        DoNotOptimize(out.data());
+    });
+    const double tPointsAffine = TimeBest([&] {
+        for (std::size_t i = 0; i < kPoints; ++i) out[i] = modelAffine.TransformPoint(points[i]);
+        DoNotOptimize(out.data());
+    });
+    const double tPointsBatch = TimeBest([&] {
+        math::transformPoints(modelAffine, batch, batchOut);
+        DoNotOptimize(batchOut.x.data());
+    });
+
+    const double n = static_cast<double>(kCount);
+    const double np = static_cast<double>(kPoints);
+    Report("compose (Mat4)", tComposeMat4, n, "op");
+    Report("compose (Affine3)", tComposeAffine, n, "op", tComposeMat4);
+    Report("inverse (glm::inverse Mat4)", tInverseMat4, n, "op");
+    Report("inverse (Affine3)", tInverseAffine, n, "op", tInverseMat4);
+    Report("normal matrix (glm)", tNormalMat4, n, "op");
+    Report("normal matrix (Affine3 cofactors)", tNormalAffine, n, "op", tNormalMat4);
+    Report("points (Mat4 * Vec4)", tPointsMat4, np, "pt");
+    Report("points (Affine3)", tPointsAffine, np, "pt", tPointsMat4);
+    Report("points (transformPoints, SoA)", tPointsBatch, np, "pt", tPointsMat4);
+}
+
+} // namespace bench
@@ -0,0 +1,61 @@
+#include <cmath>
+#include <vector>
+
+#include "Bench.hpp"
+#include "math/Basis.hpp"
+#include "math/Orthonormalize.hpp"
+
+namespace bench {
+
+void RunBasisBench() {
+    constexpr std::size_t kCount = 1 << 16;
+    const Vec3 e1{1, 0, 0}, e2{1, 1, 0}, e3{1, 1, 1};
+
+    std::vector<Vec3> points(kCount), coords(kCount);
+    math::Vec3Batch pointsSoa(kCount), coordsSoa;
+    for (std::size_t i = 0; i < kCount; ++i) {
+        const float f = static_cast<float>(i);
+        points[i] = {std::sin(f), 0.001f * f, std::cos(f)};
+        pointsSoa.set(i, points[i]);
+    }
+
+    const double tPerCall = TimeBest([&] {
+        for (std::size_t i = 0; i < kCount; ++i) coords[i] = math::CoordsInBasis(e1, e2, e3, points[i]);
+        DoNotOptimize(coords.data());
+    });
+    const math::BasisTransform basis(e1, e2, e3);
+    const double tCached = TimeBest([&] {
+        for (std::size_t i = 0; i < kCount; ++i) coords[i] = basis.ToCoords(points[i]);
+        DoNotOptimize(coords.data());
+    });
+    const double tBatch = TimeBest([&] {
+        basis.ToCoords(pointsSoa, coordsSoa);
+        DoNotOptimize(coordsSoa.x.data());
+    });
+
+    const double n = static_cast<double>(kCount);
+    Report("CoordsInBasis (per call)", tPerCall, n, "pt");
+    Report("BasisTransform::ToCoords (scalar)", tCached, n, "pt", tPerCall);
+    Report("BasisTransform::ToCoords (batch)", tBatch, n, "pt", tPerCall);
+
+    // Re-orthonormalizing frames (columns of slightly skewed rotations)
+    std::vector<Mat3> frames(kCount), fixed(kCount);
+    math::Mat3Batch framesSoa(kCount);
+    for (std::size_t i = 0; i < kCount; ++i) {
+        const float f = static_cast<float>(i);
+        frames[i] = Mat3(Vec3{1.f, 0.01f * std::sin(f), 0.f}, Vec3{0.f, 1.f, 0.01f * std::cos(f)}, Vec3{0.001f * f, 0.f, 1.f});
+        framesSoa.set(i, frames[i]);
+    }
+    const double tFrames = TimeBest([&] {
+        for (std::size_t i = 0; i < kCount; ++i) fixed[i] = math::orthonormalizeColumns(frames[i]);
+        DoNotOptimize(fixed.data());
+    });
+    const double tFramesBatch = TimeBest([&] {
+        math::orthonormalizeColumns(framesSoa); // in place; same work once already orthonormal
+        DoNotOptimize(framesSoa.m[0].data());
+    });
+    Report("orthonormalizeColumns (scalar)", tFrames, n, "mat");
+    Report("orthonormalizeColumns (batch)", tFramesBatch, n, "mat", tFrames);
+}
+
+} // namespace bench
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+
+namespace bench {
+
+// Keeps the compiler from discarding a result that is otherwise unused.
+template <class T>
+inline void DoNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Best wall time in seconds of one call to fn, over enough repetitions to cover ~minSeconds.
+template <class Fn>
+double TimeBest(Fn&& fn, double minSeconds = 0.2) {
+    using Clock = std::chrono::steady_clock;
+    double best = 1e30;
+    double total = 0.0;
+    int reps = 0;
+    while (total < minSeconds || reps < 3) {
+        const auto start = Clock::now();
+        fn();
+        const double dt = std::chrono::duration<double>(Clock::now() - start).count();
+        best = dt < best ? dt : best;
+        total += dt;
+        ++reps;
+    }
+    return best;
+}
+
+// One result line: items/second, plus the speedup over a baseline time when given.
+inline void Report(const char* name, double seconds, double items, const char* unit, double baseline = 0.0) {
+    const double rate = items / seconds;
+    if (baseline > 0.0) {
+        std::printf("  %-36s %10.2f M%s/s  %6.2fx\n", name, rate * 1e-6, unit, baseline / seconds);
+    } else {
+        std::printf("  %-36s %10.2f M%s/s\n", name, rate * 1e-6, unit);
+    }
+}
+
+// Suites, one per translation unit
+void RunQuatBench();
+void RunSkinningBench();
+void RunBasisBench();
+void RunLightingBench();
+void RunRasterBench();
+void RunMatrixBench();
+void RunEigenBench();
+void RunSparseBench();
+void RunExprBench();
+void RunAffineBench();
+void RunPrecisionBench();
+void RunQuantizeBench();
+void RunMeshOptimizeBench();
+void RunMeshletCullBench();
+void RunSceneGraphBench();
+
+} // namespace bench
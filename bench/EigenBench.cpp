@@ -0,0 +1,54 @@
+#include <cmath>
+#include <vector>
+
+#include "Bench.hpp"
+#include "math/Eigen3x3.hpp"
+
+namespace bench {
+
+// 3x3 SVD and symmetric eigen decomposition: scalar calls over an AoS array vs the
+// SoA batch kernels.
+void RunEigenBench() {
+    constexpr std::size_t kCount = 1 << 16;
+    std::vector<Mat3> ms(kCount), syms(kCount);
+    math::Mat3Batch batch(kCount), symBatch(kCount);
+    for (std::size_t i = 0; i < kCount; ++i) {
+        const float f = static_cast<float>(i);
+        ms[i] = Mat3(Vec3{std::sin(f), std::cos(1.3f * f), 0.5f},
+                     Vec3{0.2f, std::sin(0.7f * f), std::cos(f)},
+                     Vec3{std::cos(2.1f * f), 0.1f, std::sin(1.9f * f)});
+        syms[i] = glm::transpose(ms[i]) * ms[i];
+        batch.set(i, ms[i]);
+        symBatch.set(i, syms[i]);
+    }
+
+    std::vector<math::Svd3> svds(kCount);
+    std::vector<math::SymmetricEigen3> eigens(kCount);
+    math::Mat3Batch u, v, vectors;
+    math::Vec3Batch sigma, values;
+
+    const double tEigen = TimeBest([&] {
+        for (std::size_t i = 0; i < kCount; ++i) eigens[i] = math::symmetricEigen(syms[i]);
+        DoNotOptimize(eigens.data());
+    });
+    const double tEigenBatch = TimeBest([&] {
+        math::symmetricEigen(symBatch, values, vectors);
+        DoNotOptimize(values.x.data());
+    });
+    const double tSvd = TimeBest([&] {
+        for (std::size_t i = 0; i < kCount; ++i) svds[i] = math::svd(ms[i]);
+        DoNotOptimize(svds.data());
+    });
+    const double tSvdBatch = TimeBest([&] {
+        math::svd(batch, u, sigma, v);
+        DoNotOptimize(sigma.x.data());
+    });
+
+    const double n = static_cast<double>(kCount);
+    Report("symmetricEigen (scalar)", tEigen, n, "mat");
+    Report("symmetricEigen (batch)", tEigenBatch, n, "mat", tEigen);
+    Report("svd (scalar)", tSvd, n, "mat");
+    Report("svd (batch)", tSvdBatch, n, "mat", tSvd);
+}
+
+} // namespace bench
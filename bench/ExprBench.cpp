@@ -0,0 +1,121 @@
+#include <cmath>
+#include <vector>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "Bench.hpp"
+#include "math/Expr.hpp"
+
+namespace bench {
+
+namespace {
+
+// Out of line like render::ToScreenH, so the compiler cannot hoist P * MV out of the loop
+[[gnu::noinline]] Vec4 ClipGlm(const Mat4& P, const Mat4& MV, const Vec3& p) {
+    return P * MV * Vec4(p, 1.f);
+}
+
+[[gnu::noinline]] Vec4 ClipExpr(const Mat4& P, const Mat4& MV, const Vec3& p) {
+    return math::expr::eval(math::expr::lazy(P) * MV * Vec4(p, 1.f));
+}
+
+} // namespace
+
+// Expression templates against the same arithmetic in plain glm: single-point matrix
+// chains, a bilinear patch, and whole-array expressions that otherwise need a temporary
+// array per operation.
+void RunExprBench() {
+    using math::expr::lazy;
+    constexpr std::size_t kCount = 1 << 20;
+    std::vector<Vec3> a(kCount), b(kCount), c(kCount), out(kCount);
+    std::vector<float> us(kCount), vs(kCount);
+    for (std::size_t i = 0; i < kCount; ++i) {
+        const float f = static_cast<float>(i);
+        a[i] = {std::sin(f), std::cos(1.3f * f), 0.5f};
+        b[i] = {0.2f, std::sin(0.7f * f), std::cos(f)};
+        c[i] = {std::cos(2.1f * f), 0.1f, std::sin(1.9f * f)};
+        us[i] = 0.5f + 0.5f * std::sin(0.01f * f);
+        vs[i] = 0.5f + 0.5f * std::cos(0.013f * f);
+    }
+    const Mat4 P = glm::perspective(glm::radians(60.f), 1.5f, 0.1f, 50.f);
+    const Mat4 MV = glm::rotate(glm::translate(Mat4(1.f), Vec3{0.f, 0.f, -4.f}), 0.4f, Vec3{0.f, 1.f, 0.f});
+    std::vector<Vec4> clip(kCount);
+
+    // P * MV * p per call, as ToScreenH does
+    const double tChainGlm = TimeBest([&] {
+        for (std::size_t i = 0; i < kCount; ++i) clip[i] = ClipGlm(P, MV, a[i]);
+        DoNotOptimize(clip.data());
+    });
+    const double tChainExpr = TimeBest([&] {
+        for (std::size_t i = 0; i < kCount; ++i) clip[i] = ClipExpr(P, MV, a[i]);
+        DoNotOptimize(clip.data());
+    });
+    // The whole array: the chain is multiplied out once
+    const double tChainBatch = TimeBest([&] {
+        math::expr::assign(std::span<Vec4>(clip), lazy(P) * MV * math::expr::point(lazy(a)));
+        DoNotOptimize(clip.data());
+    });
+
+    // Bilinear patch, as BuildGridDrawData evaluates it
+    const Vec3 A{-1.f, 0.f, -1.f}, B{1.f, 0.f, -1.f}, C{-1.f, 0.f, 1.f}, D{1.f, 0.2f, 1.f};
+    const double tBilinearGlm = TimeBest([&] {
+        for (std::size_t i = 0; i < kCount; ++i) {
+            const float u = us[i], v = vs[i];
+            out[i] = (1.f - u) * (1.f - v) * A + u * (1.f - v) * B + (1.f - u) * v * C + u * v * D;
+        }
+        DoNotOptimize(out.data());
+    });
+    const double tBilinearExpr = TimeBest([&] {
+        const auto u = lazy(us);
+        const auto v = lazy(vs);
+        math::expr::assign(std::span<Vec3>(out), (1.f - u) * (1.f - v) * A + u * (1.f - v) * B + (1.f - u) * v * C + u * v * D);
+        DoNotOptimize(out.data());
+    });
+
+    // out = a * s + b * t - c over whole arrays: one temporary array per operation, as
+    // array-at-a-time code computes it, against one fused pass
+    std::vector<Vec3> t0(kCount), t1(kCount);
+    const float s = 0.7f, t = 1.3f;
+    const double tArraysGlm = TimeBest([&] {
+        for (std::size_t i = 0; i < kCount; ++i) t0[i] = a[i] * s;
+        for (std::size_t i = 0; i < kCount; ++i) t1[i] = b[i] * t;
+        for (std::size_t i = 0; i < kCount; ++i) t0[i] = t0[i] + t1[i];
+        for (std::size_t i = 0; i < kCount; ++i) out[i] = t0[i] - c[i];
+        DoNotOptimize(out.data());
+    });
+    const double tArraysExpr = TimeBest([&] {
+        math::expr::assign(std::span<Vec3>(out), lazy(a) * s + lazy(b) * t - lazy(c));
+        DoNotOptimize(out.data());
+    });
+
+    math::Vec3Batch sa(kCount), sb(kCount), sc(kCount), sOut(kCount), s0(kCount), s1(kCount);
+    for (std::size_t i = 0; i < kCount; ++i) {
+        sa.set(i, a[i]);
+        sb.set(i, b[i]);
+        sc.set(i, c[i]);
+    }
+    const double tBatchGlm = TimeBest([&] {
+        for (std::size_t i = 0; i < kCount; ++i) s0.set(i, sa.get(i) * s);
+        for (std::size_t i = 0; i < kCount; ++i) s1.set(i, sb.get(i) * t);
+        for (std::size_t i = 0; i < kCount; ++i) s0.set(i, s0.get(i) + s1.get(i));
+        for (std::size_t i = 0; i < kCount; ++i) sOut.set(i, s0.get(i) - sc.get(i));
+        DoNotOptimize(sOut.x.data());
+    });
+    const double tBatchExpr = TimeBest([&] {
+        math::expr::assign(sOut, lazy(sa) * s + lazy(sb) * t - lazy(sc));
+        DoNotOptimize(sOut.x.data());
+    });
+
+    const double n = static_cast<double>(kCount);
+    Report("P*MV*p per point (glm)", tChainGlm, n, "pt");
+    Report("P*MV*p per point (expr, R-to-L)", tChainExpr, n, "pt", tChainGlm);
+    Report("P*MV*p array (expr, collapsed)", tChainBatch, n, "pt", tChainGlm);
+    Report("bilinear patch (glm)", tBilinearGlm, n, "pt");
+    Report("bilinear patch (expr)", tBilinearExpr, n, "pt", tBilinearGlm);
+    Report("a*s+b*t-c AoS, temporaries (glm)", tArraysGlm, n, "vec");
+    Report("a*s+b*t-c AoS (expr, fused)", tArraysExpr, n, "vec", tArraysGlm);
+    Report("a*s+b*t-c SoA, temporaries (glm)", tBatchGlm, n, "vec");
+    Report("a*s+b*t-c SoA (expr, fused)", tBatchExpr, n, "vec", tBatchGlm);
+}
+
+} // namespace bench
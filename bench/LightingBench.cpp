@@ -0,0 +1,135 @@
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <numeric>
+#include <vector>
+
+#include "Bench.hpp"
+#include "math/LightClusters.hpp"
+#include "math/Lighting.h"
+#include "math/LightingBatch.hpp"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace bench {
+
+namespace {
+
+// Shading cost per point as the light count grows: brute force vs clustered culling.
+// Ranges shrink with the count so roughly the same number of lights reaches each point,
+// the case clustering is meant to keep flat.
+void RunClusterScaling() {
+    constexpr std::size_t kPoints = 1 << 12;
+    const Mat4 view = glm::lookAt(Vec3{0, 2, 10}, Vec3{0, 0, 0}, Vec3{0, 1, 0});
+    const Mat4 projection = glm::perspective(glm::radians(60.f), 16.f / 9.f, 0.1f, 100.f);
+    const math::PhongMaterial material{};
+    const math::SpecularTable specular(32.f);
+
+    std::vector<Vec3> points(kPoints), viewPoints(kPoints);
+    for (std::size_t i = 0; i < kPoints; ++i) {
+        const float f = static_cast<float>(i);
+        points[i] = {6.f * std::sin(0.37f * f), 3.f * std::cos(0.11f * f), 4.f * std::sin(0.07f * f)};
+        viewPoints[i] = Vec3(view * Vec4(points[i], 1.f));
+    }
+    const Vec3 n{0, 1, 0};
+    const Vec3 eye{0, 2, 10};
+
+    for (std::size_t count : {1u, 10u, 100u, 1000u}) {
+        std::vector<math::Light> lights(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            const float f = static_cast<float>(i);
+            lights[i].position = {6.f * std::sin(2.3f * f), 3.f * std::cos(1.3f * f), 4.f * std::cos(0.7f * f)};
+            lights[i].range = 3.f / std::cbrt(static_cast<float>(count));
+        }
+        std::vector<std::uint32_t> all(count);
+        std::iota(all.begin(), all.end(), 0u);
+
+        Vec3 sink{};
+        const double tBrute = TimeBest([&] {
+            for (const Vec3& p : points) sink += math::shadeLights(p, n, eye, material, specular, lights, Vec3(1.f), all, {});
+            DoNotOptimize(sink);
+        }, 0.05);
+        math::LightClusters clusters;
+        const double tClustered = TimeBest([&] {
+            clusters.Build(lights, view, projection, 0.1f, 100.f);
+            for (std::size_t i = 0; i < kPoints; ++i) {
+                const auto local = clusters.PointLights(clusters.ClusterIndex(viewPoints[i]));
+                sink += math::shadeLights(points[i], n, eye, material, specular, lights, Vec3(1.f), local, clusters.GlobalLights());
+            }
+            DoNotOptimize(sink);
+        }, 0.05);
+
+        char name[64];
+        std::snprintf(name, sizeof(name), "%zu lights, brute force", count);
+        Report(name, tBrute, static_cast<double>(kPoints), "pt");
+        std::snprintf(name, sizeof(name), "%zu lights, clustered (+build)", count);
+        Report(name, tClustered, static_cast<double>(kPoints), "pt", tBrute);
+    }
+}
+
+} // namespace
+
+void RunLightingBench() {
+    // One 256x256 tile of per-pixel shading
+    constexpr std::size_t kCount = 1 << 16;
+
+    std::vector<Vec3> positions(kCount), normals(kCount);
+    math::Vec3Batch positionsSoa(kCount), normalsSoa(kCount);
+    for (std::size_t i = 0; i < kCount; ++i) {
+        const float f = static_cast<float>(i);
+        positions[i] = {std::sin(f), std::cos(f), 0.001f * f};
+        normals[i] = glm::normalize(Vec3{std::sin(0.3f * f), 1.f, std::cos(0.7f * f)});
+        positionsSoa.set(i, positions[i]);
+        normalsSoa.set(i, normals[i]);
+    }
+
+    math::ShadeParams params;
+    params.materialColor = {0.8f, 0.3f, 0.3f};
+    params.lightPos = {2.f, 4.f, 1.f};
+    params.eye = {0.f, 0.f, 8.f};
+    const math::SpecularTable table(32.f);
+    std::vector<std::uint8_t> rgba(kCount * math::kRgba8Stride);
+
+    const double tScalar = TimeBest([&] {
+        for (std::size_t i = 0; i < kCount; ++i) {
+            const Vec3 l = glm::normalize(params.lightPos - positions[i]);
+            const Vec3 v = glm::normalize(params.eye - positions[i]);
+            const Vec3 c = glm::clamp(math::phong(normals[i], l, v, params.materialColor, params.ka, params.kd,
+                                                  params.ks, 32.f, params.lightColor), 0.f, 1.f);
+            rgba[4 * i + 0] = static_cast<std::uint8_t>(c.r * 255.f);
+            rgba[4 * i + 1] = static_cast<std::uint8_t>(c.g * 255.f);
+            rgba[4 * i + 2] = static_cast<std::uint8_t>(c.b * 255.f);
+            rgba[4 * i + 3] = 255;
+        }
+        DoNotOptimize(rgba.data());
+    });
+    const double tPhong = TimeBest([&] {
+        math::phongBatch(positionsSoa, normalsSoa, params, table, rgba);
+        DoNotOptimize(rgba.data());
+    });
+    params.blinn = true;
+    const double tBlinn = TimeBest([&] {
+        math::phongBatch(positionsSoa, normalsSoa, params, table, rgba);
+        DoNotOptimize(rgba.data());
+    });
+    params.blinn = false;
+    math::MaterialBatch materials(kCount);
+    for (std::size_t i = 0; i < kCount; ++i) {
+        materials.set(i, params.materialColor * (0.5f + 0.5f * std::sin(0.01f * static_cast<float>(i))), params.ka,
+                      params.kd, params.ks);
+    }
+    const double tPerItem = TimeBest([&] {
+        math::phongBatch(positionsSoa, normalsSoa, materials, params, table, rgba);
+        DoNotOptimize(rgba.data());
+    });
+
+    const double n = static_cast<double>(kCount);
+    Report("phong + std::pow (scalar)", tScalar, n, "px");
+    Report("phongBatch (table)", tPhong, n, "px", tScalar);
+    Report("phongBatch blinn (table)", tBlinn, n, "px", tScalar);
+    Report("phongBatch per-item materials", tPerItem, n, "px", tScalar);
+
+    RunClusterScaling();
+}
+
+} // namespace bench
@@ -0,0 +1,117 @@
+#include <cmath>
+#include <cstdio>
+
+#include "Bench.hpp"
+#include "math/Decompose.hpp"
+#include "math/Matrix.hpp"
+#include "math/Parallel.hpp"
+
+namespace bench {
+
+namespace {
+
+math::Matrix<float> Sample(std::size_t n, float seed) {
+    math::Matrix<float> m(n, n);
+    for (std::size_t r = 0; r < n; ++r) {
+        for (std::size_t c = 0; c < n; ++c) {
+            m(r, c) = std::sin(seed + static_cast<float>(r * 31 + c * 7));
+        }
+    }
+    return m;
+}
+
+void ReportGflops(const char* name, double seconds, std::size_t n, double baseline) {
+    const double flops = 2.0 * static_cast<double>(n) * static_cast<double>(n) * static_cast<double>(n);
+    if (baseline > 0.0) {
+        std::printf("  %-36s %10.2f GFLOP/s  %6.2fx\n", name, flops / seconds * 1e-9, baseline / seconds);
+    } else {
+        std::printf("  %-36s %10.2f GFLOP/s\n", name, flops / seconds * 1e-9);
+    }
+}
+
+// Symmetric with n added on the diagonal: diagonally dominant, so positive definite and
+// safely nonsingular for LU
+math::Matrix<double> SampleSpd(std::size_t n) {
+    math::Matrix<double> m(n, n);
+    for (std::size_t r = 0; r < n; ++r) {
+        for (std::size_t c = 0; c <= r; ++c) {
+            m(r, c) = m(c, r) = std::sin(static_cast<double>(r * 31 + c * 7) * 0.37);
+        }
+        m(r, r) += static_cast<double>(n);
+    }
+    return m;
+}
+
+void ReportFactor(const char* name, double seconds, double flops) {
+    std::printf("  %-36s %10.2f ms  %8.2f GFLOP/s\n", name, seconds * 1e3, flops / seconds * 1e-9);
+}
+
+void RunDecompositionBench() {
+    for (std::size_t n : {500u, 1000u, 2000u}) {
+        const auto A = SampleSpd(n);
+        const double n3 = static_cast<double>(n) * static_cast<double>(n) * static_cast<double>(n);
+        const double minSeconds = n >= 2000 ? 0.0 : 0.3;
+
+        const double tLu = TimeBest([&] {
+            const auto f = math::luFactor(A);
+            DoNotOptimize(f.lu.Data());
+        }, minSeconds);
+        const double tChol = TimeBest([&] {
+            const auto f = math::choleskyFactor(A);
+            DoNotOptimize(f.l.Data());
+        }, minSeconds);
+        const double tQr = TimeBest([&] {
+            const auto f = math::qrFactor(A);
+            DoNotOptimize(f.qr.Data());
+        }, minSeconds);
+
+        char name[64];
+        std::snprintf(name, sizeof(name), "lu double %zu", n);
+        ReportFactor(name, tLu, 2.0 / 3.0 * n3);
+        std::snprintf(name, sizeof(name), "cholesky double %zu", n);
+        ReportFactor(name, tChol, 1.0 / 3.0 * n3);
+        std::snprintf(name, sizeof(name), "qr double %zu", n);
+        ReportFactor(name, tQr, 4.0 / 3.0 * n3);
+    }
+}
+
+} // namespace
+
+// Square float GEMM: naive triple loop vs the blocked kernel on one thread and on all of them.
+// The naive loop is skipped past 512 (seconds per call once B no longer fits in cache).
+// Then LU, Cholesky and QR in double up to 2000 x 2000 (time per factorization).
+void RunMatrixBench() {
+    std::printf("  %u hardware threads\n", math::WorkerCount());
+    for (std::size_t n : {64u, 256u, 512u, 1024u}) {
+        const auto A = Sample(n, 0.1f);
+        const auto B = Sample(n, 0.7f);
+        math::Matrix<float> C(n, n);
+
+        const double minSeconds = n >= 512 ? 0.5 : 0.2;
+        const double tNaive = n > 512 ? 0.0 : TimeBest([&] {
+            math::gemmNaive(A, B, C);
+            DoNotOptimize(C.Data());
+        }, minSeconds);
+        const double tBlocked = TimeBest([&] {
+            math::gemm(A, B, C, 1.f, 0.f, 1);
+            DoNotOptimize(C.Data());
+        }, minSeconds);
+        const double tThreaded = TimeBest([&] {
+            math::gemm(A, B, C);
+            DoNotOptimize(C.Data());
+        }, minSeconds);
+
+        char name[64];
+        if (tNaive > 0.0) {
+            std::snprintf(name, sizeof(name), "gemm naive %zu^3", n);
+            ReportGflops(name, tNaive, n, tNaive);
+        }
+        std::snprintf(name, sizeof(name), "gemm blocked %zu^3", n);
+        ReportGflops(name, tBlocked, n, tNaive);
+        std::snprintf(name, sizeof(name), "gemm blocked, threaded %zu^3", n);
+        ReportGflops(name, tThreaded, n, tNaive);
+    }
+    RunDecompositionBench();
+}
+
+} // namespace bench
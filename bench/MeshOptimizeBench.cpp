@@ -0,0 +1,61 @@
+#include <algorithm>
+#include <array>
+#include <random>
+#include <vector>
+
+#include "Bench.hpp"
+#include "render/MeshOptimize.hpp"
+
+namespace bench {
+
+namespace {
+
+// Vertex fetch as the raster setup does it: one position read per index, in index order
+float FetchAll(const render::IndexedMesh& mesh) {
+    float sum = 0.f;
+    for (const std::uint32_t v : mesh.indices) {
+        sum += mesh.positions[v].x + mesh.positions[v].y + mesh.positions[v].z;
+    }
+    return sum;
+}
+
+} // namespace
+
+// Tipsify and fetch reordering on a 512^2 welded sphere whose triangles arrive shuffled
+// (as from an exporter with no particular order): ACMR before and after, the cost of the
+// pass and of meshlet building, and index-order vertex fetch over each layout.
+void RunMeshOptimizeBench() {
+    render::IndexedMesh shuffled = render::WeldVertices(render::MakeSphere(1.f, 512, 512));
+    std::vector<std::array<std::uint32_t, 3>> triangles(shuffled.TriangleCount());
+    std::copy_n(shuffled.indices.data(), shuffled.indices.size(), triangles.front().data());
+    std::shuffle(triangles.begin(), triangles.end(), std::mt19937(7));
+    std::copy_n(triangles.front().data(), shuffled.indices.size(), shuffled.indices.data());
+
+    render::IndexedMesh optimized = shuffled;
+    const render::MeshOptimizeReport report = render::OptimizeMesh(optimized);
+    std::printf("  ACMR (FIFO %zu): %.3f shuffled -> %.3f optimized\n", render::kVertexCacheSize, report.acmrBefore,
+                report.acmrAfter);
+
+    const double tOptimize = TimeBest([&] {
+        render::IndexedMesh copy = shuffled;
+        DoNotOptimize(render::OptimizeMesh(copy).acmrAfter);
+    });
+    render::MeshletSet meshlets;
+    const double tMeshlets = TimeBest([&] {
+        meshlets = render::BuildMeshlets(optimized);
+        DoNotOptimize(meshlets.meshlets.data());
+    });
+    const double tFetchShuffled = TimeBest([&] { DoNotOptimize(FetchAll(shuffled)); });
+    const double tFetchOptimized = TimeBest([&] { DoNotOptimize(FetchAll(optimized)); });
+
+    const double tris = static_cast<double>(shuffled.TriangleCount());
+    const double indices = static_cast<double>(shuffled.indices.size());
+    Report("OptimizeMesh (Tipsify + fetch)", tOptimize, tris, "tri");
+    Report("BuildMeshlets (64 v / 124 t)", tMeshlets, tris, "tri");
+    Report("index-order fetch (shuffled)", tFetchShuffled, indices, "idx");
+    Report("index-order fetch (optimized)", tFetchOptimized, indices, "idx", tFetchShuffled);
+    std::printf("  %zu meshlets, %.1f triangles each\n", meshlets.meshlets.size(),
+                tris / static_cast<double>(meshlets.meshlets.size()));
+}
+
+} // namespace bench
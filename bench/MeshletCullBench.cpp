@@ -0,0 +1,81 @@
+#include <cstdio>
+#include <vector>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "Bench.hpp"
+#include "math/Affine.hpp"
+#include "render/MeshOptimize.hpp"
+#include "render/MeshletCull.hpp"
+
+namespace bench {
+
+namespace {
+
+struct ClipVertex {
+    Vec4 clip;
+    Vec3 world;
+};
+
+} // namespace
+
+// Per-frame vertex work on a 512^2 welded sphere, as the raster path does it (model
+// transform plus clip position per vertex): every vertex against meshlet culling, gathering
+// and transforming the survivors' vertices. Two views: the whole sphere (the far half is
+// back-facing) and a close-up where most of it is outside the frustum.
+void RunMeshletCullBench() {
+    render::IndexedMesh mesh = render::WeldVertices(render::MakeSphere(1.f, 512, 512));
+    render::OptimizeMesh(mesh);
+    const render::MeshletSet set = render::BuildMeshlets(mesh);
+    const math::Affine3 model = math::Affine3::Rotation(0.4f, Vec3(0.f, 1.f, 0.f));
+    const math::Affine3 toModel = model.Inverse();
+    const Mat4 P = glm::perspective(glm::radians(60.f), 16.f / 9.f, 0.01f, 100.f);
+
+    struct View {
+        const char* name;
+        Vec3 eye;
+        Vec3 target;
+    };
+    const View views[] = {{"whole", {0.f, 0.5f, 3.f}, {0.f, 0.f, 0.f}},
+                          {"close-up", {0.4f, 0.3f, 1.25f}, {0.9f, 0.3f, 0.f}}};
+
+    std::vector<ClipVertex> out(mesh.VertexCount());
+    std::vector<std::uint32_t> visible;
+    std::vector<std::uint32_t> vertexIds;
+    std::vector<std::uint32_t> indices;
+    for (const View& view : views) {
+        const math::Affine3 viewAffine = math::lookAtAffine(view.eye, view.target, Vec3(0.f, 1.f, 0.f));
+        const Mat4 viewProj = P * viewAffine;
+        const Mat4 mvp = P * (viewAffine * model);
+        const Vec3 eyeModel = toModel.TransformPoint(view.eye);
+
+        const double tAll = TimeBest([&] {
+            out.resize(mesh.VertexCount());
+            for (std::size_t i = 0; i < mesh.VertexCount(); ++i) {
+                const Vec3 world = model.TransformPoint(mesh.positions[i]);
+                out[i] = {viewProj * Vec4(world, 1.f), world};
+            }
+            DoNotOptimize(out.data());
+        });
+        render::MeshletCullStats stats;
+        const double tCull = TimeBest([&] {
+            stats = render::CullMeshlets(set, mvp, eyeModel, true, visible);
+            render::GatherMeshlets(set, visible, vertexIds, indices);
+            out.resize(vertexIds.size());
+            for (std::size_t k = 0; k < vertexIds.size(); ++k) {
+                const Vec3 world = model.TransformPoint(mesh.positions[vertexIds[k]]);
+                out[k] = {viewProj * Vec4(world, 1.f), world};
+            }
+            DoNotOptimize(out.data());
+        });
+
+        std::printf("  %s: %zu of %zu meshlets drawn (%zu frustum, %zu back-facing), %zu of %zu vertices\n", view.name,
+                    visible.size(), set.meshlets.size(), stats.frustumCulled, stats.backfaceCulled, vertexIds.size(),
+                    mesh.VertexCount());
+        const double vertices = static_cast<double>(mesh.VertexCount());
+        Report("transform all vertices", tAll, vertices, "vtx");
+        Report("cull + gather + transform visible", tCull, vertices, "vtx", tAll);
+    }
+}
+
+} // namespace bench
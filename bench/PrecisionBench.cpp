@@ -0,0 +1,63 @@
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "Bench.hpp"
+#include "render/Precision.hpp"
+
+namespace bench {
+
+// One projection pipeline in double, float and half-stored positions: throughput, then the
+// screen error of float and half against double as the scene moves away from the origin.
+void RunPrecisionBench() {
+    constexpr std::size_t kPoints = 1 << 20;
+    std::vector<Vec3d> pointsD(kPoints);
+    std::vector<Vec3> pointsF(kPoints);
+    std::vector<math::HalfVec3> pointsH(kPoints);
+    for (std::size_t i = 0; i < kPoints; ++i) {
+        const double f = static_cast<double>(i);
+        pointsD[i] = {std::sin(f), std::cos(1.3 * f), 0.5 * std::sin(0.7 * f)};
+        pointsF[i] = Vec3(pointsD[i]);
+    }
+    math::toHalf(pointsF, pointsH);
+    std::vector<Vec3d> outD(kPoints);
+    std::vector<Vec3> outF(kPoints);
+
+    const Mat4d PD = glm::perspective(glm::radians(60.0), 16.0 / 9.0, 0.1, 100.0);
+    const Mat4d MVD = glm::translate(Mat4d(1.0), Vec3d{0.0, 0.0, -4.0});
+    const Mat4 PF(PD);
+    const Mat4 MVF(MVD);
+
+    const double tDouble = TimeBest([&] {
+        render::ProjectPoints<double>(pointsD, PD, MVD, 1280, 720, outD);
+        DoNotOptimize(outD.data());
+    });
+    const double tFloat = TimeBest([&] {
+        render::ProjectPoints<float>(pointsF, PF, MVF, 1280, 720, outF);
+        DoNotOptimize(outF.data());
+    });
+    const double tHalf = TimeBest([&] {
+        render::ProjectPoints(pointsH, PF, MVF, 1280, 720, outF);
+        DoNotOptimize(outF.data());
+    });
+
+    const double n = static_cast<double>(kPoints);
+    Report("project (double)", tDouble, n, "pt");
+    Report("project (float)", tFloat, n, "pt", tDouble);
+    Report("project (half storage)", tHalf, n, "pt", tDouble);
+
+    std::printf("  %-12s %14s %14s %14s\n", "offset", "float max px", "half max px", "float depth");
+    for (const double offset : {1.0, 1e3, 1e5, 1e7}) {
+        render::PrecisionSetup setup;
+        setup.offset = offset;
+        const auto results = render::RunPrecisionStudy(setup);
+        const auto& single = results[static_cast<int>(render::ScalarMode::Float)];
+        const auto& half = results[static_cast<int>(render::ScalarMode::Half)];
+        std::printf("  %-12.0e %14.3e %14.3e %14.3e\n", offset, single.error.maxPixels, half.error.maxPixels,
+                    single.error.maxDepth);
+    }
+}
+
+} // namespace bench
@@ -0,0 +1,62 @@
+#include <cmath>
+
+#include "Bench.hpp"
+#include "math/Affine.hpp"
+#include "render/QuantizedMesh.hpp"
+
+namespace bench {
+
+// Object-space vertices to world space from float SoA batches against the quantized
+// storage decoded inside the kernels: positions (6 bytes against 12) and normals (4 bytes
+// against 12), on a mesh too large for the caches.
+void RunQuantizeBench() {
+    constexpr std::size_t kVertices = 1 << 22;
+    render::IndexedMesh mesh;
+    mesh.positions.resize(kVertices);
+    mesh.normals.resize(kVertices);
+    math::Vec3Batch positions(kVertices), normals(kVertices);
+    for (std::size_t i = 0; i < kVertices; ++i) {
+        const float f = static_cast<float>(i);
+        mesh.positions[i] = {std::sin(f), std::cos(1.3f * f), 0.5f * std::sin(0.7f * f)};
+        mesh.normals[i] = glm::normalize(Vec3{std::cos(f), std::sin(2.1f * f), 0.3f});
+        positions.set(i, mesh.positions[i]);
+        normals.set(i, mesh.normals[i]);
+    }
+    const render::QuantizedMesh quantized = render::Quantize(mesh);
+    const math::Affine3 model = math::Affine3::Translation({0.5f, -1.f, -4.f}) * math::Affine3::Rotation(0.8f, Vec3{1.f, 2.f, 0.5f});
+    const Mat3 normalMatrix = model.NormalMatrix();
+    math::Vec3Batch out(kVertices);
+
+    const double tPoints = TimeBest([&] {
+        math::transformPoints(model, positions, out);
+        DoNotOptimize(out.x.data());
+    });
+    const double tPointsQuantized = TimeBest([&] {
+        render::TransformQuantizedPoints(model, quantized, out);
+        DoNotOptimize(out.x.data());
+    });
+    // Float normals through the same normalize-after-transform the raster path does
+    const double tNormals = TimeBest([&] {
+        math::transformDirections(math::Affine3::FromLinear(normalMatrix), normals, out);
+        float* x = out.x.data(); float* y = out.y.data(); float* z = out.z.data();
+        math::ForEachLane(out.paddedSize(), [=](std::size_t i) {
+            const float inv = 1.f / std::sqrt(x[i] * x[i] + y[i] * y[i] + z[i] * z[i] + 1e-30f);
+            x[i] *= inv;
+            y[i] *= inv;
+            z[i] *= inv;
+        });
+        DoNotOptimize(out.x.data());
+    });
+    const double tNormalsQuantized = TimeBest([&] {
+        render::TransformQuantizedNormals(normalMatrix, quantized, out);
+        DoNotOptimize(out.x.data());
+    });
+
+    const double n = static_cast<double>(kVertices);
+    Report("points (float SoA)", tPoints, n, "vtx");
+    Report("points (16-bit, decoded in kernel)", tPointsQuantized, n, "vtx", tPoints);
+    Report("normals (float SoA)", tNormals, n, "vtx");
+    Report("normals (octahedral 32-bit)", tNormalsQuantized, n, "vtx", tNormals);
+}
+
+} // namespace bench
@@ -0,0 +1,88 @@
+#include <cmath>
+#include <vector>
+
+#include "Bench.hpp"
+#include "math/QuatBatch.hpp"
+
+namespace bench {
+
+void RunQuatBench() {
+    // Small enough to stay cache resident, so the kernels rather than memory are measured
+    constexpr std::size_t kCount = 1 << 13;
+
+    std::vector<math::Quat> aosA(kCount), aosB(kCount), aosOut(kCount);
+    std::vector<Vec3> axes(kCount);
+    std::vector<float> angles(kCount);
+    math::QuatBatch a(kCount), b(kCount), out(kCount);
+    math::Vec3Batch axesSoa(kCount);
+    for (std::size_t i = 0; i < kCount; ++i) {
+        const float f = static_cast<float>(i);
+        aosA[i] = math::normalize({std::cos(f), std::sin(f), 0.5f, -0.25f});
+        aosB[i] = math::normalize({0.3f, std::cos(2 * f), std::sin(3 * f), 1.f});
+        a.set(i, aosA[i]);
+        b.set(i, aosB[i]);
+        axes[i] = {std::sin(f), 1.f, std::cos(f)};
+        axesSoa.set(i, axes[i]);
+        angles[i] = 0.001f * f;
+    }
+
+    const double n = static_cast<double>(kCount);
+
+    const double tMulScalar = TimeBest([&] {
+        for (std::size_t i = 0; i < kCount; ++i) aosOut[i] = math::multiply(aosA[i], aosB[i]);
+        DoNotOptimize(aosOut.data());
+    });
+    const double tMulBatch = TimeBest([&] {
+        math::multiply(a, b, out);
+        DoNotOptimize(out.w.data());
+    });
+    Report("multiply (scalar)", tMulScalar, n, "quat");
+    Report("multiply (QuatBatch)", tMulBatch, n, "quat", tMulScalar);
+
+    const double tNormScalar = TimeBest([&] {
+        for (std::size_t i = 0; i < kCount; ++i) aosOut[i] = math::normalize(aosA[i]);
+        DoNotOptimize(aosOut.data());
+    });
+    const double tNormBatch = TimeBest([&] {
+        math::normalize(a, out);
+        DoNotOptimize(out.w.data());
+    });
+    Report("normalize (scalar)", tNormScalar, n, "quat");
+    Report("normalize (QuatBatch)", tNormBatch, n, "quat", tNormScalar);
+
+    const double tConjScalar = TimeBest([&] {
+        for (std::size_t i = 0; i < kCount; ++i) aosOut[i] = math::conjugate(aosA[i]);
+        DoNotOptimize(aosOut.data());
+    });
+    const double tConjBatch = TimeBest([&] {
+        math::conjugate(a, out);
+        DoNotOptimize(out.w.data());
+    });
+    Report("conjugate (scalar)", tConjScalar, n, "quat");
+    Report("conjugate (QuatBatch)", tConjBatch, n, "quat", tConjScalar);
+
+    const double tAxisScalar = TimeBest([&] {
+        for (std::size_t i = 0; i < kCount; ++i) aosOut[i] = math::fromAxisAngle(axes[i], angles[i]);
+        DoNotOptimize(aosOut.data());
+    });
+    const double tAxisBatch = TimeBest([&] {
+        math::fromAxisAngle(axesSoa, angles, out);
+        DoNotOptimize(out.w.data());
+    });
+    Report("fromAxisAngle (scalar)", tAxisScalar, n, "quat");
+    Report("fromAxisAngle (QuatBatch)", tAxisBatch, n, "quat", tAxisScalar);
+
+    std::vector<Mat4> mats(kCount);
+    const double tMatScalar = TimeBest([&] {
+        for (std::size_t i = 0; i < kCount; ++i) mats[i] = math::quatToMat4(aosA[i]);
+        DoNotOptimize(mats.data());
+    });
+    const double tMatBatch = TimeBest([&] {
+        math::quatToMat4(a, mats);
+        DoNotOptimize(mats.data());
+    });
+    Report("quatToMat4 (scalar)", tMatScalar, n, "quat");
+    Report("quatToMat4 (QuatBatch)", tMatBatch, n, "quat", tMatScalar);
+}
+
+} // namespace bench
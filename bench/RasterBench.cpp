@@ -0,0 +1,92 @@
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "Bench.hpp"
+#include "math/LightingBatch.hpp"
+#include "render/Mesh.hpp"
+#include "render/Rasterizer.hpp"
+#include "render/ShadowMap.hpp"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace bench {
+
+namespace {
+
+// Depth pass cost against map resolution, and lookup cost against PCF width
+void RunShadowMapBench(const render::IndexedMesh& sphere) {
+    const Mat4 lightViewProj = glm::perspective(glm::radians(90.f), 1.f, 0.1f, 40.f) *
+                               glm::lookAt(Vec3{2.f, 4.f, 1.f}, Vec3{0.f}, Vec3{0.f, 1.f, 0.f});
+    render::ShadowMap map;
+    for (int size : {512, 1024, 2048}) {
+        map.Resize(size);
+        const double t = TimeBest([&] { map.Render(sphere.positions, sphere.indices, lightViewProj); });
+        char name[64];
+        std::snprintf(name, sizeof(name), "shadow depth pass %d^2", size);
+        Report(name, t, static_cast<double>(size) * size, "texel");
+    }
+
+    math::Vec3Batch points(1 << 16);
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        const float f = static_cast<float>(i);
+        points.set(i, {1.5f * std::sin(0.013f * f), -1.f, 1.5f * std::cos(0.029f * f)});
+    }
+    std::vector<float> vis(points.size());
+    double single = 0.0;
+    for (int pcf : {1, 2, 4}) {
+        const double t = TimeBest([&] {
+            map.Visibility(points, pcf, vis);
+            DoNotOptimize(vis.data());
+        });
+        if (pcf == 1) single = t;
+        char name[64];
+        std::snprintf(name, sizeof(name), "shadow lookup pcf %dx%d", pcf, pcf);
+        Report(name, t, static_cast<double>(points.size()), "px", single);
+    }
+}
+
+} // namespace
+
+// Pixel throughput of the software rasterizer per shading mode: a lit sphere filling most
+// of a 512x512 target. Rates count written fragments, so overdraw is not credited.
+void RunRasterBench() {
+    constexpr int kSize = 512;
+    const render::IndexedMesh sphere = render::MakeSphere(1.f, 48, 64);
+    const Vec3 eye{0.f, 0.f, 2.6f};
+    const Mat4 PV = glm::perspective(glm::radians(60.f), 1.f, 0.1f, 100.f) *
+                    glm::lookAt(eye, Vec3{0.f}, Vec3{0.f, 1.f, 0.f});
+
+    std::vector<render::RasterVertex> vertices(sphere.VertexCount());
+    for (std::size_t i = 0; i < vertices.size(); ++i) {
+        vertices[i] = {PV * Vec4(sphere.positions[i], 1.f), sphere.positions[i], sphere.normals[i]};
+    }
+
+    math::ShadeParams shade;
+    shade.lightPos = {3.f, 4.f, 5.f};
+    shade.eye = eye;
+    const math::SpecularTable specular(32.f);
+
+    render::Framebuffer fb;
+    fb.Resize(kSize, kSize);
+    render::Rasterizer raster;
+
+    std::printf("  sphere: %zu triangles at %dx%d\n", sphere.TriangleCount(), kSize, kSize);
+    double flat = 0.0;
+    for (auto [mode, name] : {std::pair{render::ShadingMode::Flat, "raster flat"},
+                              std::pair{render::ShadingMode::Gouraud, "raster gouraud"},
+                              std::pair{render::ShadingMode::Phong, "raster phong"}}) {
+        render::RasterStats stats;
+        const double t = TimeBest([&] {
+            fb.Clear(0, 0, 0);
+            stats = raster.Draw(fb, vertices, sphere.indices, mode, shade, specular);
+            DoNotOptimize(fb.color.data());
+        });
+        if (mode == render::ShadingMode::Flat) flat = t;
+        Report(name, t, static_cast<double>(stats.fragments), "pix", flat);
+    }
+
+    RunShadowMapBench(sphere);
+}
+
+} // namespace bench
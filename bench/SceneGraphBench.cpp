@@ -0,0 +1,102 @@
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "Bench.hpp"
+#include "render/SceneGraph.hpp"
+
+namespace bench {
+
+namespace {
+
+// The baseline: heap nodes owning their children, every world transform recomputed by a
+// depth-first walk each frame
+struct TreeNode {
+    math::Affine3 local;
+    math::Affine3 world;
+    std::vector<std::unique_ptr<TreeNode>> children;
+};
+
+void UpdateRecursive(TreeNode& node, const math::Affine3& parent) {
+    node.world = parent * node.local;
+    for (auto& child : node.children) {
+        UpdateRecursive(*child, node.world);
+    }
+}
+
+} // namespace
+
+// ~112K nodes, 8 children per node down 4 levels below 24 roots. World update per frame:
+// the recursive walk, the breadth-first pass with every root moved (all recomputed), one
+// level-2 node moved (its 73-node subtree), and nothing moved.
+void RunSceneGraphBench() {
+    constexpr int kRoots = 24;
+    constexpr int kFanout = 8;
+    constexpr int kDepth = 4;
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> u(-1.f, 1.f);
+    const auto random = [&] {
+        return math::Affine3::Translation(Vec3(u(rng), u(rng), u(rng))) *
+               math::Affine3::Rotation(u(rng), Vec3(u(rng), u(rng), 1.f));
+    };
+
+    render::SceneGraph graph;
+    std::vector<std::unique_ptr<TreeNode>> tree;
+    std::vector<render::NodeId> roots;
+    render::NodeId level2 = render::kNoNode;
+    const auto grow = [&](auto&& self, render::NodeId parent, TreeNode& node, int depth) -> void {
+        if (depth == kDepth) {
+            return;
+        }
+        for (int c = 0; c < kFanout; ++c) {
+            const math::Affine3 local = random();
+            const render::NodeId id = graph.AddNode(parent, local);
+            level2 = depth == 1 && level2 == render::kNoNode ? id : level2;
+            node.children.push_back(std::make_unique<TreeNode>(TreeNode{local, {}, {}}));
+            self(self, id, *node.children.back(), depth + 1);
+        }
+    };
+    for (int r = 0; r < kRoots; ++r) {
+        const math::Affine3 local = random();
+        roots.push_back(graph.AddNode(render::kNoNode, local));
+        tree.push_back(std::make_unique<TreeNode>(TreeNode{local, {}, {}}));
+        grow(grow, roots.back(), *tree.back(), 0);
+    }
+    graph.Update();
+    const double nodes = static_cast<double>(graph.NodeCount());
+
+    const double tRecursive = TimeBest([&] {
+        for (auto& root : tree) {
+            UpdateRecursive(*root, math::Affine3{});
+        }
+        DoNotOptimize(tree.front()->children.front()->world);
+    });
+    float angle = 0.f;
+    std::size_t updated = 0;
+    const double tAll = TimeBest([&] {
+        angle += 1e-3f;
+        for (const render::NodeId root : roots) {
+            graph.SetLocal(root, math::Affine3::Rotation(angle, Vec3(0.f, 1.f, 0.f)));
+        }
+        updated = graph.Update();
+        DoNotOptimize(graph.World(roots.front()));
+    });
+    std::size_t subtree = 0;
+    const double tSubtree = TimeBest([&] {
+        angle += 1e-3f;
+        graph.SetLocal(level2, math::Affine3::Rotation(angle, Vec3(0.f, 1.f, 0.f)));
+        subtree = graph.Update();
+        DoNotOptimize(graph.World(level2));
+    });
+    const double tStatic = TimeBest([&] { DoNotOptimize(graph.Update()); });
+
+    std::printf("  %zu nodes; all roots moved: %zu updated, one level-2 node: %zu\n", graph.NodeCount(), updated,
+                subtree);
+    Report("recursive walk (all nodes)", tRecursive, nodes, "node");
+    Report("breadth-first pass (all dirty)", tAll, nodes, "node", tRecursive);
+    Report("breadth-first pass (one subtree)", tSubtree, nodes, "node", tRecursive);
+    std::printf("  nothing moved: %.1f ns per Update()\n", tStatic * 1e9);
+}
+
+} // namespace bench
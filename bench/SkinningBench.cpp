@@ -0,0 +1,44 @@
+#include <vector>
+
+#include "Bench.hpp"
+#include "render/Skinning.hpp"
+
+namespace bench {
+
+void RunSkinningBench() {
+    constexpr int kBones = 16;
+    constexpr float kLength = 2.f;
+    const render::SkinnedMesh mesh =
+        render::MakeChainSkin(render::MakeTube(0.2f, kLength, 255, 32), kBones, kLength);
+    const auto bones = render::ChainPose(kBones, kLength, 0.2f);
+    const std::size_t n = mesh.bind.VertexCount();
+
+    // Baseline: the usual 4x4 linear blend skinning over AoS vertices
+    std::vector<Mat4> matrices;
+    for (const auto& dq : bones) matrices.push_back(math::dualQuatToMat4(dq));
+    std::vector<Vec3> outPos(n), outNrm(n);
+    const double tMatrix = TimeBest([&] {
+        for (std::size_t i = 0; i < n; ++i) {
+            const render::BoneInfluence& inf = mesh.influences[i];
+            Mat4 M(0.f);
+            for (int k = 0; k < render::kMaxBoneInfluences; ++k) {
+                M += matrices[inf.bones[k]] * inf.weights[k];
+            }
+            outPos[i] = Vec3(M * Vec4(mesh.bind.positions[i], 1.f));
+            outNrm[i] = Vec3(M * Vec4(mesh.bind.normals[i], 0.f));
+        }
+        DoNotOptimize(outPos.data());
+    });
+
+    math::Vec3Batch pos, nrm;
+    const double tDualQuat = TimeBest([&] {
+        render::SkinDualQuat(mesh, bones, pos, nrm);
+        DoNotOptimize(pos.x.data());
+    });
+
+    const double v = static_cast<double>(n);
+    Report("linear blend (Mat4)", tMatrix, v, "vert");
+    Report("dual quaternion (SkinDualQuat)", tDualQuat, v, "vert", tMatrix);
+}
+
+} // namespace bench
@@ -0,0 +1,72 @@
+#include <algorithm>
+#include <cstdio>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "Bench.hpp"
+#include "math/Sparse.hpp"
+#include "render/Mesh.hpp"
+#include "render/MeshLaplacian.hpp"
+
+namespace bench {
+
+// Mesh Laplacian of a ~1M-vertex sphere: assembly, then SpMV with the vertices in
+// generator order, shuffled, and reordered by RCM, and one 3-column smoothing step.
+void RunSparseBench() {
+    const render::IndexedMesh sphere = render::WeldVertices(render::MakeSphere(1.f, 1000, 1000));
+    const double vertices = static_cast<double>(sphere.VertexCount());
+
+    const double tAssemble = TimeBest([&] { DoNotOptimize(render::GraphLaplacian(sphere).NonZeros()); });
+    const double tCotangent = TimeBest([&] { DoNotOptimize(render::CotangentLaplacian(sphere).NonZeros()); });
+    const math::SparseMatrix<float> L = render::GraphLaplacian(sphere);
+    Report("graph Laplacian assembly", tAssemble, vertices, "vtx");
+    Report("cotangent Laplacian assembly", tCotangent, vertices, "vtx");
+
+    std::vector<std::uint32_t> shuffle(L.Rows());
+    std::iota(shuffle.begin(), shuffle.end(), 0u);
+    std::shuffle(shuffle.begin(), shuffle.end(), std::mt19937(1));
+    const math::SparseMatrix<float> shuffled = L.Permuted(shuffle);
+    std::vector<std::uint32_t> order;
+    const double tRcm = TimeBest([&] { order = math::reverseCuthillMcKee(shuffled); });
+    const math::SparseMatrix<float> reordered = shuffled.Permuted(order);
+    Report("reverseCuthillMcKee", tRcm, vertices, "vtx");
+    std::printf("  bandwidth: generator %zu, shuffled %zu, RCM %zu\n", L.Bandwidth(), shuffled.Bandwidth(),
+                reordered.Bandwidth());
+
+    std::vector<float> x(L.Rows(), 1.f), y(L.Rows());
+    const double nnz = static_cast<double>(L.NonZeros());
+    const auto timeSpmv = [&](const math::SparseMatrix<float>& A, unsigned threads) {
+        return TimeBest([&] {
+            math::spmv<float>(A, x, y, 1.f, 0.f, threads);
+            DoNotOptimize(y.data());
+        });
+    };
+    const double tShuffled = timeSpmv(shuffled, 1);
+    Report("spmv shuffled (1 thread)", tShuffled, nnz, "nnz");
+    Report("spmv generator order (1 thread)", timeSpmv(L, 1), nnz, "nnz", tShuffled);
+    Report("spmv RCM (1 thread)", timeSpmv(reordered, 1), nnz, "nnz", tShuffled);
+    Report("spmv RCM (all threads)", timeSpmv(reordered, 0), nnz, "nnz", tShuffled);
+
+    // One smoothing step on xyz: a single 3-column SpMM vs three SpMVs over the same matrix
+    const math::SparseMatrix<float> S = render::SmoothingOperator(reordered, 0.5f);
+    const math::Matrix<float> X = render::PositionMatrix(sphere.positions);
+    math::Matrix<float> Y(X.Rows(), 3);
+    std::vector<float> column(X.Rows()), out(X.Rows());
+    const double tColumns = TimeBest([&] {
+        for (std::size_t c = 0; c < 3; ++c) {
+            for (std::size_t i = 0; i < X.Rows(); ++i) column[i] = X(i, c);
+            math::spmv<float>(S, column, out);
+            for (std::size_t i = 0; i < X.Rows(); ++i) Y(i, c) = out[i];
+        }
+        DoNotOptimize(Y.Data());
+    });
+    const double tSpmm = TimeBest([&] {
+        math::spmm(S, X, Y);
+        DoNotOptimize(Y.Data());
+    });
+    Report("smoothing step, 3x spmv", tColumns, vertices, "vtx");
+    Report("smoothing step, spmm (k = 3)", tSpmm, vertices, "vtx", tColumns);
+}
+
+} // namespace bench
@@ -0,0 +1,48 @@
+//
+// Micro-benchmarks for the batched math kernels.
+// Build in Release; pass a suite name (e.g. "quat") to run just that suite.
+//
+
+#include <cstring>
+#include <cstdio>
+
+#include "Bench.hpp"
+
+namespace {
+
+struct Suite {
+    const char* name;
+    void (*run)();
+};
+
+constexpr Suite kSuites[] = {
+    {"quat", bench::RunQuatBench},
+    {"skinning", bench::RunSkinningBench},
+    {"basis", bench::RunBasisBench},
+    {"lighting", bench::RunLightingBench},
+    {"raster", bench::RunRasterBench},
+    {"matrix", bench::RunMatrixBench},
+    {"eigen", bench::RunEigenBench},
+    {"sparse", bench::RunSparseBench},
+    {"expr", bench::RunExprBench},
+    {"affine", bench::RunAffineBench},
+    {"precision", bench::RunPrecisionBench},
+    {"quantize", bench::RunQuantizeBench},
+    {"meshopt", bench::RunMeshOptimizeBench},
+    {"meshcull", bench::RunMeshletCullBench},
+    {"scene", bench::RunSceneGraphBench},
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const char* filter = argc > 1 ? argv[1] : nullptr;
+    for (const auto& suite : kSuites) {
+        if (filter && std::strcmp(filter, suite.name) != 0) {
+            continue;
+        }
+        std::printf("[%s]\n", suite.name);
+        suite.run();
+    }
+    return 0;
+}
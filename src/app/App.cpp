@@ -1,10 +1,14 @@
 #include "app/App.hpp"
 
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <iostream>
 #include <map>
+#include <numeric>
+#include <optional>
 #include <ranges>
+#include <span>
 #include <tuple>
 #include <vector>
 
@@ -13,8 +17,16 @@
 #include <imgui-SFML.h>
 #include <imgui.h>
 
+#include "math/Affine.hpp"
 #include "math/Basis.hpp"
+#include "math/ConvexHull.hpp"
+#include "math/Decompose.hpp"
+#include "math/Eigen3x3.hpp"
+#include "math/Orthonormalize.hpp"
+#include "math/Sparse.hpp"
 #include "math/Lighting.h"
+#include "math/LightingBatch.hpp"
+#include "render/MeshLaplacian.hpp"
 #include "render/Projection.hpp"
 #include "ui/MatrixLabUI.hpp"
 
@@ -22,6 +34,13 @@
 #include "math/Shadow.h"
 
 namespace {
+    // Fixed geometry and light projections, built by the compiler into read-only data
+    constexpr render::CubeMesh kCube = render::MakeCube(0.5f);
+    constexpr auto kIndexedCube = render::MakeFixedIndexedCube(kCube);
+    constexpr auto kSphere = render::MakeFixedSphere<32, 48>(0.7f);
+    constexpr Mat4 kDirectionalShadowProj = math::orthographic(4.f, 1.f, 0.1f, 40.f);
+    constexpr Mat4 kSpotShadowProj = math::cx::perspective(math::cx::radians(100.f), 1.f, 0.1f, 40.f);
+
     sf::RenderWindow CreateWindow(unsigned int& outW, unsigned int& outH) {
         sf::VideoMode desktop = sf::VideoMode::getDesktopMode();
         constexpr unsigned int kMinWindowSize = 800;
@@ -112,9 +131,9 @@ namespace {
         return R;
     }
 
-    Mat4 BuildAxisRotationQuat(const Vec3& axis, const float theta) {
+    math::Affine3 BuildAxisRotationQuat(const Vec3& axis, const float theta) {
         const math::Quat q = math::fromAxisAngle(axis, theta);
-        return math::quatToMat4(q);
+        return math::quatToAffine(q);
     }
 
     sf::VertexArray BuildWireframe(const render::CubeMesh& cube_,
@@ -142,6 +161,34 @@ namespace {
         return wire;
     }
 
+    // Triangle edges of an indexed mesh whose (deformed) positions live in a SoA batch
+    sf::VertexArray BuildMeshWire(const render::IndexedMesh& mesh,
+                                  const math::Vec3Batch& positions,
+                                  const Mat4& P,
+                                  const Mat4& MV,
+                                  unsigned int windowW_,
+                                  unsigned int windowH_) {
+        std::vector<sf::Vector2f> screen(positions.size());
+        std::vector<bool> visible(positions.size());
+        for (std::size_t i = 0; i < positions.size(); ++i) {
+            visible[i] = render::ToScreenH(positions.get(i), P, MV, windowW_, windowH_, screen[i]);
+        }
+
+        sf::VertexArray wire(sf::PrimitiveType::Lines);
+        for (std::size_t t = 0; t + 2 < mesh.indices.size(); t += 3) {
+            for (int e = 0; e < 3; ++e) {
+                const std::uint32_t a = mesh.indices[t + e];
+                const std::uint32_t b = mesh.indices[t + (e + 1) % 3];
+                if (!visible[a] || !visible[b]) {
+                    continue;
+                }
+                wire.append(sf::Vertex{screen[a], sf::Color(120, 200, 255)});
+                wire.append(sf::Vertex{screen[b], sf::Color(120, 200, 255)});
+            }
+        }
+        return wire;
+    }
+
     sf::VertexArray BuildVectorLines(const std::array<Vec3, 3>& vBasis,
                                      const std::array<Vec3, 3>& uBasis,
                                      const Vec3& w_,
@@ -197,8 +244,10 @@ namespace {
                                const Mat4& MV_cube,
                                const Mat4& model,
                                const app::MaterialParams& material,
-                               const Vec3& lightColor,
-                               const Vec3& lightPos,
+                               const math::SpecularTable& specular,
+                               std::span<const math::Light> lights,
+                               const math::LightClusters* clusters,
+                               const Mat4& view,
                                const Vec3& cameraPos,
                                const unsigned int windowW_,
                                const unsigned int windowH_) {
@@ -225,28 +274,63 @@ namespace {
         std::ranges::sort(order,
                           [](const FaceDraw& a, const FaceDraw& b) { return a.avgZ < b.avgZ; });
 
-        sf::VertexArray faces(sf::PrimitiveType::Triangles);
+        // Shade all face centers in one batch, in draw order
+        math::Vec3Batch centers(order.size());
+        math::Vec3Batch normals(order.size());
+        for (std::size_t i = 0; i < order.size(); ++i) {
+            const auto& quad = cube_.faces[order[i].faceIndex];
+            Vec3 center = (cube_.vertices[quad[0]] + cube_.vertices[quad[1]] + cube_.vertices[quad[2]] + cube_.vertices[quad[3]]) * 0.25f;
+            centers.set(i, Vec3(model * Vec4(center, 1.0f)));
+            normals.set(i, math::faceNormal(cube_.vertices, quad, model));
+        }
 
-        for (const auto& item : order) {
-            const auto& quad = cube_.faces[item.faceIndex];
+        std::vector<std::uint8_t> rgba(order.size() * math::kRgba8Stride);
+        if (lights.size() == 1) {
+            const math::ShadeParams shade{
+                .materialColor = material.color,
+                .ka = material.ka,
+                .kd = material.kd,
+                .ks = material.ks,
+                .lightPos = lights[0].position,
+                .lightColor = lights[0].color * lights[0].intensity,
+                .eye = cameraPos,
+                .blinn = material.blinn
+            };
+            math::phongBatch(centers, normals, shade, specular, rgba);
+        } else {
+            // Each face evaluates only its cluster's lights (or all of them without clusters)
+            const math::PhongMaterial surface{material.color, material.ka, material.kd, material.ks, material.blinn};
+            // Ambient from the scene light, as in the single-light path above
+            const Vec3 ambient = lights[0].color * lights[0].intensity;
+            std::vector<std::uint32_t> all(lights.size());
+            std::iota(all.begin(), all.end(), 0u);
+            for (std::size_t i = 0; i < order.size(); ++i) {
+                const Vec3 p = centers.get(i);
+                std::span<const std::uint32_t> local = all;
+                std::span<const std::uint32_t> global;
+                if (clusters) {
+                    local = clusters->PointLights(clusters->ClusterIndex(Vec3(view * Vec4(p, 1.f))));
+                    global = clusters->GlobalLights();
+                }
+                const Vec3 c = glm::clamp(
+                    math::shadeLights(p, normals.get(i), cameraPos, surface, specular, lights, ambient, local, global), 0.f, 1.f);
+                rgba[i * math::kRgba8Stride + 0] = static_cast<std::uint8_t>(c.r * 255.f);
+                rgba[i * math::kRgba8Stride + 1] = static_cast<std::uint8_t>(c.g * 255.f);
+                rgba[i * math::kRgba8Stride + 2] = static_cast<std::uint8_t>(c.b * 255.f);
+                rgba[i * math::kRgba8Stride + 3] = 255;
+            }
+        }
 
-            Vec3 normal = math::faceNormal(cube_.vertices, quad, model);
-            Vec3 center = (cube_.vertices[quad[0]] + cube_.vertices[quad[1]] + cube_.vertices[quad[2]] + cube_.vertices[quad[3]]) * 0.25f;
-            Vec3 worldCenter = Vec3(model * Vec4(center, 1.0f));
-            Vec3 l = glm::normalize(lightPos - worldCenter); // from world center to light pos
-            Vec3 v = glm::normalize(cameraPos - worldCenter); // from world center to camera pos
+        sf::VertexArray faces(sf::PrimitiveType::Triangles);
 
-            Vec3 color = math::phong(normal, l, v, material.color, material.ka,
-              material.kd, material.ks, material.shininess, lightColor);
+        for (std::size_t i = 0; i < order.size(); ++i) {
+            const auto& quad = cube_.faces[order[i].faceIndex];
 
             std::size_t base = faces.getVertexCount();
             faces.resize(base + 6);
 
-            sf::Color col(
-                static_cast<uint8_t>(glm::clamp(color.r, 0.f, 1.f) * 255.f),
-                static_cast<uint8_t>(glm::clamp(color.g, 0.f, 1.f) * 255.f),
-                static_cast<uint8_t>(glm::clamp(color.b, 0.f, 1.f) * 255.f)
-                );
+            const std::uint8_t* c = &rgba[i * math::kRgba8Stride];
+            const sf::Color col(c[0], c[1], c[2], c[3]);
 
             static constexpr int triPattern[6] = {0, 1, 2, 0, 2, 3};
             for (int k = 0; k < 6; ++k) {
@@ -370,6 +454,43 @@ namespace {
         return c;
     }
 
+    // Rotation carrying arcball vector p1 onto p2. Identity when they are (nearly) parallel.
+    math::Quat ArcballRotation(const Vec3& p1, const Vec3& p2) {
+        const Vec3 axis = glm::cross(p1, p2);
+        if (glm::length(axis) <= 0.0001f) {
+            return {1, 0, 0, 0};
+        }
+        const float dotVal = glm::clamp(glm::dot(p1, p2), -1.0f, 1.0f);
+        return math::fromAxisAngle(axis, std::acos(dotVal));
+    }
+
+    void PushArcballSample(app::ArcballHistory& history, const Vec3& axis, float angle, float dt) {
+        constexpr std::size_t kCap = app::ArcballHistory::kCapacity;
+        history.samples[history.head] = {axis, angle, dt};
+        history.head = (history.head + 1) % kCap;
+        history.count = std::min(history.count + 1, kCap);
+    }
+
+    // Net rotation over the most recent `window` seconds divided by the time it took.
+    // Frames without motion are in the history too, so pausing before release gives ~0.
+    float EstimateAngularSpeed(const app::ArcballHistory& history, float window, Vec3& outAxis) {
+        constexpr std::size_t kCap = app::ArcballHistory::kCapacity;
+        math::Quat net{1, 0, 0, 0};
+        float span = 0.f;
+        for (std::size_t i = 0; i < history.count && span < window; ++i) {
+            const auto& s = history.samples[(history.head + kCap - 1 - i) % kCap];
+            // Walking back in time, so older rotations go on the right
+            net = math::multiply(net, math::fromAxisAngle(s.axis, s.angle));
+            span += s.dt;
+        }
+        if (span <= 0.f) {
+            return 0.f;
+        }
+
+        float angle = 0.f;
+        math::toAxisAngle(math::normalize(net), outAxis, angle);
+        return angle / span;
+    }
 
 } // namespace
 
@@ -389,7 +510,28 @@ App::App()
     camera_.target = {0.f, 0.f, 0.f};
     camera_.up = {0.f, 1.f, 0.f};
 
-    cube_ = render::MakeCube(0.5f);
+    cube_ = kCube;
+    rasterCube_ = render::ToIndexedMesh(kIndexedCube);
+    rasterSphere_ = render::ToIndexedMesh(kSphere);
+    // Cache-friendly triangle and vertex order first: quantization and meshlets follow it
+    cubeOptimize_ = render::OptimizeMesh(rasterCube_);
+    sphereOptimize_ = render::OptimizeMesh(rasterSphere_);
+    cubeMeshlets_ = render::BuildMeshlets(rasterCube_);
+    sphereMeshlets_ = render::BuildMeshlets(rasterSphere_);
+    quantizedCube_ = render::Quantize(rasterCube_);
+    quantizedSphere_ = render::Quantize(rasterSphere_);
+    rasterFloor_ = render::MakeFloor(3.f, -1.f);
+    // Locals are set from the UI state every frame; unchanged ones cost nothing
+    planeNode_ = sceneGraph_.AddNode(render::kNoNode);
+    objectNode_ = sceneGraph_.AddNode(planeNode_);
+    tubeNode_ = sceneGraph_.AddNode(planeNode_, math::Affine3::Translation(Vec3(1.5f, 0.f, 0.f)));
+    cubeCorners_ = math::Matrix<float>(3, cube_.vertices.size(), math::Layout::ColMajor);
+    for (std::size_t i = 0; i < cube_.vertices.size(); ++i) {
+        for (int r = 0; r < 3; ++r) {
+            cubeCorners_(static_cast<std::size_t>(r), i) = cube_.vertices[i][r];
+        }
+    }
+    generalCorners_ = math::Matrix<float>(3, cube_.vertices.size(), math::Layout::ColMajor);
 
     scene_.vBasis[0] = {1.f, 0.f, 0.f};
     scene_.vBasis[1] = {0.f, 1.f, 0.f};
@@ -402,7 +544,9 @@ App::App()
     scene_.uBasis[1] = scene_.vBasis[0] + scene_.vBasis[1];
     scene_.uBasis[2] = scene_.vBasis[0] + scene_.vBasis[1] + scene_.vBasis[2];
 
-    scene_.b = math::CoordsInBasis(scene_.uBasis[0], scene_.uBasis[1], scene_.uBasis[2], scene_.w);
+    scene_.uTransform = math::BasisTransform(scene_.uBasis[0], scene_.uBasis[1], scene_.uBasis[2]);
+    scene_.b = scene_.uTransform.ToCoords(scene_.w);
+    scene_.uOrthonormal = math::orthonormalize(scene_.uBasis);
 
     scene_.lightPos = {2.f, 4.f, 1.f};
     scene_.lightColor = {1, 1, 1};
@@ -451,39 +595,169 @@ void App::ProcessEvents(float dt) {
                 const auto pos = MapMouseToArcballVec(mouse->position.x, mouse->position.y, windowW_, windowH_);
                 scene_.p1 = pos;
                 scene_.angular_speed = 0.f;
-                scene_.last_angle = 0.f;  // ← Add this!
+                scene_.last_angle = 0.f;
+                scene_.dragSampleCount = 0;
+                scene_.dragMoved = false;
+                scene_.arcHistory = {};
                 scene_.isDragging = true;
             }
         }
-        // 0.009 = 0.3
-        // 1 = 0.3 / 0.009
-        if (const auto* mouse = ev->getIf<sf::Event::MouseButtonReleased>()) {
+        if (ev->is<sf::Event::MouseButtonReleased>() && scene_.isDragging) {
+            FlushArcballDrag(dt);
             scene_.isDragging = false;
-            scene_.angular_speed = scene_.last_angle / dt; // per frame speed
-            printf("%f, %f, %f \n",scene_.last_angle, dt, scene_.angular_speed);
+            scene_.angular_speed = EstimateAngularSpeed(scene_.arcHistory, controls_.velocityWindow, scene_.last_axis);
         }
+        // Only remember where the drag is; the rotation is applied once per frame below
         if (const auto* mouse = ev->getIf<sf::Event::MouseMoved>(); mouse && scene_.isDragging) {
-            auto p2 = MapMouseToArcballVec(mouse->position.x, mouse->position.y, windowW_, windowH_);
-            auto axis = glm::cross(scene_.p1, p2);
-
-            float axisLen = glm::length(axis);
-            if (axisLen > 0.0001f) {
-                axis = axis / axisLen;  // Normalize the axis
-
-                float dotVal = glm::clamp(glm::dot(scene_.p1, p2), -1.0f, 1.0f);
-                const float angle = acos(dotVal);
-                Mat4 arc_ball = glm::rotate(Mat4(1.f), angle, axis);
-                scene_.arcBall_t = arc_ball * scene_.arcBall_t;
-                scene_.last_axis = axis;
-                scene_.last_angle = angle;
+            const auto p2 = MapMouseToArcballVec(mouse->position.x, mouse->position.y, windowW_, windowH_);
+            scene_.dragTarget = p2;
+            scene_.dragMoved = true;
+            if (controls_.arcballSubframe) {
+                // Bounded: once full, the last slot just tracks the newest position
+                const std::size_t idx = std::min(scene_.dragSampleCount, SceneGeometry::kMaxDragSamples - 1);
+                scene_.dragSamples[idx] = p2;
+                scene_.dragSampleCount = idx + 1;
+            }
+        }
+    }
+
+    FlushArcballDrag(dt);
+}
+
+void App::FlushArcballDrag(float dt) {
+    if (!scene_.isDragging) {
+        return;
+    }
+
+    math::Quat net{1, 0, 0, 0};
+    if (scene_.dragMoved) {
+        if (controls_.arcballSubframe && scene_.dragSampleCount > 0) {
+            Vec3 from = scene_.p1;
+            for (std::size_t i = 0; i < scene_.dragSampleCount; ++i) {
+                net = math::multiply(ArcballRotation(from, scene_.dragSamples[i]), net);
+                from = scene_.dragSamples[i];
             }
-            scene_.p1 = p2;
+        } else {
+            net = ArcballRotation(scene_.p1, scene_.dragTarget);
         }
+        scene_.arcBall_t = math::quatToMat4(net) * scene_.arcBall_t;
+        scene_.p1 = scene_.dragTarget;
     }
+
+    Vec3 axis{};
+    float angle = 0.f;
+    math::toAxisAngle(math::normalize(net), axis, angle);
+    if (angle > 0.f) {
+        scene_.last_axis = axis;
+        scene_.last_angle = angle;
+    }
+    PushArcballSample(scene_.arcHistory, axis, angle, dt);
+
+    scene_.dragSampleCount = 0;
+    scene_.dragMoved = false;
 }
 
 void App::Update(float dt) {
     UpdateControls(dt);
+    animTime_ += dt;
+
+    if (skinning_.enabled && tubeBones_ != skinning_.boneCount) {
+        constexpr float kTubeLength = 2.f;
+        render::IndexedMesh tube = render::MakeTube(0.15f, kTubeLength, 24, 12);
+        render::OptimizeMesh(tube);
+        tube_ = render::MakeChainSkin(tube, skinning_.boneCount, kTubeLength);
+        tubeBones_ = skinning_.boneCount;
+        tubeSilhouette_.emplace(tube_.bind);
+    }
+
+    // Light 0 is the scene light (unbounded, as before); extras orbit the cube
+    scene_.lights.resize(1 + static_cast<std::size_t>(lighting_.extraLights));
+    scene_.lights[0] = {.position = scene_.lightPos, .color = scene_.lightColor, .range = 0.f};
+    for (int i = 0; i < lighting_.extraLights; ++i) {
+        const float f = static_cast<float>(i);
+        const float angle = 2.399963f * f + 0.3f * animTime_; // golden angle spread
+        const float radius = 1.2f + 0.8f * std::sin(1.7f * f);
+        math::Light& light = scene_.lights[1 + static_cast<std::size_t>(i)];
+        light.position = {radius * std::cos(angle), 1.5f * std::sin(0.9f * f), radius * std::sin(angle) - transform_.distance};
+        light.color = {0.5f + 0.5f * std::sin(f), 0.5f + 0.5f * std::sin(f + 2.1f), 0.5f + 0.5f * std::sin(f + 4.2f)};
+        light.intensity = 2.f;
+        light.range = lighting_.extraRange;
+    }
+
+    if (cloud_.enabled && cloudCoords_.size() != static_cast<std::size_t>(cloud_.count)) {
+        // Fixed pseudo-random coordinates in the unit cube of the u-basis
+        const auto n = static_cast<std::size_t>(cloud_.count);
+        cloudCoords_.resize(n);
+        std::uint32_t state = 0x9e3779b9u;
+        const auto next = [&state] {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            return static_cast<float>(state >> 8) * (1.f / 16777216.f);
+        };
+        for (std::size_t i = 0; i < n; ++i) {
+            const float x = next();
+            const float y = next();
+            cloudCoords_.set(i, {x, y, next()});
+        }
+    }
+
+    if (smoothing_.enabled) {
+        UpdateSmoothing();
+    }
+    if (deform_.enabled) {
+        UpdateDeformation();
+    } else if (deformer_) {
+        deformer_.reset(); // joins the worker
+        deformSize_ = 0;
+    }
+
+    if (general_.runBench && !general_.benchBusy) {
+        // Seconds of work at n = 2000: timed on a worker, collected by a later frame
+        general_.runBench = false;
+        general_.benchBusy = true;
+        factorBenchDone_.store(false, std::memory_order_relaxed);
+        factorBench_ = std::jthread([this, n = static_cast<std::size_t>(general_.benchSize)] {
+            // Diagonally dominant symmetric, so all three factorizations apply
+            math::Matrix<double> A(n, n);
+            for (std::size_t r = 0; r < n; ++r) {
+                for (std::size_t c = 0; c <= r; ++c) {
+                    A(r, c) = A(c, r) = std::sin(0.37 * static_cast<double>(r * 31 + c * 7));
+                }
+                A(r, r) += static_cast<double>(n);
+            }
+            sf::Clock benchClock;
+            math::luFactor(A);
+            factorTimings_.luMs = benchClock.restart().asSeconds() * 1000.f;
+            math::qrFactor(A);
+            factorTimings_.qrMs = benchClock.restart().asSeconds() * 1000.f;
+            math::choleskyFactor(A);
+            factorTimings_.choleskyMs = benchClock.getElapsedTime().asSeconds() * 1000.f;
+            factorBenchDone_.store(true, std::memory_order_release);
+        });
+    }
+    if (general_.benchBusy && factorBenchDone_.load(std::memory_order_acquire)) {
+        factorBench_.join();
+        general_.luMs = factorTimings_.luMs;
+        general_.qrMs = factorTimings_.qrMs;
+        general_.choleskyMs = factorTimings_.choleskyMs;
+        general_.benchBusy = false;
+    }
+
+    if (precision_.run) {
+        precision_.run = false;
+        static constexpr int kRings[] = {64, 128, 512};
+        render::PrecisionSetup setup;
+        setup.offset = precision_.offset;
+        setup.distance = precision_.distance;
+        setup.nearPlane = precision_.nearPlane;
+        setup.farPlane = precision_.farPlane;
+        setup.width = windowW_;
+        setup.height = windowH_;
+        setup.rings = kRings[std::clamp(precision_.resolution, 0, 2)];
+        precision_.results = render::RunPrecisionStudy(setup);
+        precision_.valid = true;
+    }
 
     if (printed_) {
         printed_ = true;
@@ -515,6 +789,136 @@ void App::UpdateControls(float dt) {
         scene_.arcBall_t = rot * scene_.arcBall_t;
         scene_.angular_speed *= 0.9975f;
     }
+
+    // A product of many incremental rotations drifts off orthonormal (skew and scale)
+    if (controls_.reorthonormalizeFrames > 0 && ++arcballFrames_ >= controls_.reorthonormalizeFrames) {
+        scene_.arcBall_t = math::orthonormalizeRotation(scene_.arcBall_t);
+        arcballFrames_ = 0;
+    }
+}
+
+void App::UpdateSmoothing() {
+    constexpr int kSizes[] = {256, 512, 1024};
+    const int size = kSizes[std::clamp(smoothing_.resolution, 0, 2)];
+    if (size != smoothSize_ || smoothing_.cotangent != smoothCotangent_ || smoothing_.reorder != smoothReorder_) {
+        sf::Clock buildClock;
+        smoothMesh_ = render::WeldVertices(render::MakeSphere(0.7f, size, size));
+        smoothLaplacian_ = smoothing_.cotangent ? render::CotangentLaplacian(smoothMesh_)
+                                                : render::GraphLaplacian(smoothMesh_);
+        if (smoothing_.reorder) {
+            const std::vector<std::uint32_t> order = math::reverseCuthillMcKee(smoothLaplacian_);
+            smoothMesh_ = render::ReorderVertices(smoothMesh_, order);
+            smoothLaplacian_ = smoothLaplacian_.Permuted(order);
+        }
+        // Triangle order only: the vertex order is the Laplacian's (RCM when enabled)
+        smoothOptimize_ = render::OptimizeMesh(smoothMesh_, {.reorderVertices = false});
+        smoothMeshlets_ = render::BuildMeshlets(smoothMesh_);
+        smoothRest_ = smoothMesh_.positions;
+        smoothing_.buildMs = buildClock.getElapsedTime().asSeconds() * 1000.f;
+        smoothing_.vertices = smoothMesh_.VertexCount();
+        smoothing_.nonZeros = smoothLaplacian_.NonZeros();
+        smoothing_.bandwidth = smoothLaplacian_.Bandwidth();
+        smoothSize_ = size;
+        smoothCotangent_ = smoothing_.cotangent;
+        smoothReorder_ = smoothing_.reorder;
+        smoothLambda_ = 0.f;
+        smoothing_.reset = true;
+    }
+    if (smoothing_.lambda != smoothLambda_) {
+        smoothOperator_ = render::SmoothingOperator(smoothLaplacian_, smoothing_.lambda);
+        smoothLambda_ = smoothing_.lambda;
+    }
+    if (smoothing_.reset) {
+        smoothing_.reset = false;
+        smoothing_.addNoise = true;
+        smoothPositions_ = render::PositionMatrix(smoothRest_);
+    }
+    if (smoothing_.addNoise) {
+        // Radial: the sphere stays centred on the origin while it smooths
+        smoothing_.addNoise = false;
+        std::uint32_t state = 0x2545f491u;
+        for (std::size_t i = 0; i < smoothPositions_.Rows(); ++i) {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            const float u = static_cast<float>(state >> 8) * (2.f / 16777216.f) - 1.f;
+            for (std::size_t c = 0; c < 3; ++c) {
+                smoothPositions_(i, c) *= 1.f + smoothing_.noise * u;
+            }
+        }
+    }
+
+    if (smoothing_.run) {
+        sf::Clock smoothClock;
+        render::SmoothPositions(smoothOperator_, smoothPositions_, smoothScratch_, smoothing_.stepsPerFrame);
+        smoothing_.smoothMs = smoothClock.getElapsedTime().asSeconds() * 1000.f;
+    }
+    sf::Clock normalsClock;
+    render::CopyPositions(smoothPositions_, smoothMesh_.positions);
+    render::ComputeVertexNormals(smoothMesh_);
+    render::UpdateMeshletBounds(smoothMesh_, smoothMeshlets_);
+    smoothing_.normalsMs = normalsClock.getElapsedTime().asSeconds() * 1000.f;
+}
+
+void App::UpdateDeformation() {
+    constexpr int kSizes[] = {64, 128, 256};
+    const int size = kSizes[std::clamp(deform_.resolution, 0, 2)];
+    if (size != deformSize_ || deform_.preconditioner != deformPreconditioner_ || deform_.capHeight != deformCap_) {
+        // Setup runs here, once per change; only the solves are moved off the render loop
+        sf::Clock setupClock;
+        deformer_.reset();
+        constexpr float kRadius = 0.7f;
+        deformMesh_ = render::WeldVertices(render::MakeSphere(kRadius, size, size));
+        deformMesh_ = render::ReorderVertices(deformMesh_, math::reverseCuthillMcKee(render::GraphLaplacian(deformMesh_)));
+        deformOptimize_ = render::OptimizeMesh(deformMesh_, {.reorderVertices = false});
+        deformMeshlets_ = render::BuildMeshlets(deformMesh_);
+        std::vector<render::VertexRole> roles;
+        roles.reserve(deformMesh_.VertexCount());
+        const float cap = deform_.capHeight * kRadius;
+        for (const Vec3& p : deformMesh_.positions) {
+            roles.push_back(p.y < -cap ? render::VertexRole::Anchor
+                            : p.y > cap ? render::VertexRole::Handle
+                                        : render::VertexRole::Free);
+        }
+        const auto kind = static_cast<math::PreconditionerKind>(std::clamp(deform_.preconditioner, 0, 2));
+        deformer_.emplace(render::LaplacianDeformer(deformMesh_, roles, kind));
+        deform_.setupMs = setupClock.getElapsedTime().asSeconds() * 1000.f;
+        deform_.vertices = deformer_->VertexCount();
+        deform_.freeVertices = deformer_->FreeCount();
+        deformSize_ = size;
+        deformPreconditioner_ = deform_.preconditioner;
+        deformCap_ = deform_.capHeight;
+        deformRequested_ = Mat4(0.f);
+        deform_.residualLog.fill(0.f);
+    }
+
+    const Mat4 handle = glm::rotate(glm::translate(Mat4(1.f), deform_.handleOffset), deform_.handleTwist, Vec3{0.f, 1.f, 0.f});
+    if (handle != deformRequested_ || deform_.tolerance != deformTolerance_ || deform_.budgetMs != deformBudget_) {
+        const math::CgSettings<float> settings{
+            .maxIterations = 10000,
+            .tolerance = deform_.tolerance,
+            .budgetMs = static_cast<double>(deform_.budgetMs)
+        };
+        deformer_->Request(handle, settings);
+        deformRequested_ = handle;
+        deformTolerance_ = deform_.tolerance;
+        deformBudget_ = deform_.budgetMs;
+        deform_.totalIterations = 0;
+    }
+
+    render::DeformStats stats;
+    if (deformer_->Poll(deformMesh_.positions, stats)) {
+        render::ComputeVertexNormals(deformMesh_);
+        render::UpdateMeshletBounds(deformMesh_, deformMeshlets_);
+        deform_.iterations = stats.iterations;
+        deform_.totalIterations += stats.iterations;
+        deform_.residual = stats.residual;
+        deform_.solveMs = stats.solveMs;
+        deform_.converged = stats.converged;
+        std::rotate(deform_.residualLog.begin(), deform_.residualLog.begin() + 1, deform_.residualLog.end());
+        deform_.residualLog.back() = std::log10(std::max(stats.residual, 1e-12f));
+    }
+    deform_.busy = deformer_->Busy();
 }
 
 float App::ComputeSceneScale() const {
@@ -533,26 +937,28 @@ float App::ComputeSceneScale() const {
 
 void App::Render() {
     const float sceneScale = ComputeSceneScale();
-    Mat4 view = camera_.ViewMatrix(view_.useCustomLookAt);
-
-    Mat4 MV_plane = glm::translate(Mat4(1.f), Vec3(0.f, 0.f, -transform_.distance));
-    MV_plane = view * MV_plane;
+    // Model and view are composed as 3x4 affine transforms; Mat4 copies are made for the
+    // code that takes them, and the projection joins as P * affine
+    const math::Affine3 viewAffine = camera_.View(view_.useCustomLookAt);
+    const Mat4 view = viewAffine.ToMat4();
 
     // Local rotation (pitch, yaw, arcball, axis) composed at origin
-    Mat4 rotation = Mat4(1.f);
-    rotation = glm::rotate(rotation, transform_.pitch, Vec3(1.f, 0.f, 0.f));
-    rotation = glm::rotate(rotation, transform_.yaw, Vec3(0.f, 1.f, 0.f));
-    rotation = rotation * scene_.arcBall_t;
+    math::Affine3 rotation = math::Affine3::Rotation(transform_.pitch, Vec3(1.f, 0.f, 0.f)) *
+                             math::Affine3::Rotation(transform_.yaw, Vec3(0.f, 1.f, 0.f)) *
+                             math::Affine3::FromMat4(scene_.arcBall_t);
     rotation = BuildAxisRotationQuat(scene_.w, transform_.axisAngle) * rotation;
 
-    Mat4 shadow = math::shadowFrom(scene_.lightPos);
+    // T * R: rotate at origin, then translate into position on the plane
+    sceneGraph_.SetLocal(planeNode_, math::Affine3::Translation(Vec3(0.f, 0.f, -transform_.distance)));
+    sceneGraph_.SetLocal(objectNode_, math::Affine3::Translation(Vec3(0.f, transform_.yTrans, 0.f)) * rotation);
+    transform_.nodesUpdated = sceneGraph_.Update();
+    transform_.sceneNodes = sceneGraph_.NodeCount();
 
-    // T * R: rotate at origin, then translate into position
-    Mat4 modelCube = glm::translate(Mat4(1.f), Vec3(0.f, transform_.yTrans, -transform_.distance));
-    modelCube = modelCube * rotation;
-    Mat4 MV_shadow = view * shadow * modelCube;
+    const Mat4 MV_plane = (viewAffine * sceneGraph_.World(planeNode_)).ToMat4();
+    const math::Affine3 model = sceneGraph_.World(objectNode_);
+    const Mat4 modelCube = model.ToMat4();
 
-    Mat4 MV_cube = view * modelCube;
+    const Mat4 MV_cube = (viewAffine * model).ToMat4();
 
     const float aspect = static_cast<float>(windowW_) / static_cast<float>(windowH_);
     Mat4 P = view_.useParallelProj
@@ -571,29 +977,336 @@ void App::Render() {
                                                 MV_plane,
                                                 transform_.axisAngle);
 
+    if (view_.showOrthonormalU) {
+        for (int k = 0; k < 3; ++k) {
+            AddVectorLine(vecLines, scene_.originWorld, scene_.uBasis[k], P, MV_plane, windowW_, windowH_, sf::Color::White);
+            AddVectorLine(vecLines, scene_.originWorld, scene_.uOrthonormal[k], P, MV_plane, windowW_, windowH_, sf::Color::Yellow);
+        }
+    }
+
     std::array<Vec3, 7> tipVecs = {scene_.vBasis[0], scene_.vBasis[1], scene_.vBasis[2]};
 
     sf::VertexArray tips = BuildTips(tipVecs, P, MV_plane, windowW_, windowH_);
 
     sf::Vertex origin(render::ToScreenH(scene_.originWorld, P, MV_plane, windowW_, windowH_));
 
-    sf::VertexArray faces = BuildFaces(cube_, P, MV_cube, modelCube, material_, scene_.lightColor, scene_.lightPos, camera_.Position(), windowW_, windowH_);
+    if (specular_.Exponent() != material_.shininess) {
+        specular_ = math::SpecularTable(material_.shininess);
+    }
+    const bool useClusters = lighting_.clustered && scene_.lights.size() > 1;
+    sf::Clock lightClock;
+    if (useClusters) {
+        clusters_.Build(scene_.lights, view, P, 0.01f, 100.f);
+        lighting_.maxPerCluster = clusters_.MaxLightsPerCluster();
+    }
+    lighting_.buildMs = useClusters ? lightClock.restart().asSeconds() * 1000.f : 0.f;
+    lightClock.restart();
+    sf::VertexArray faces = BuildFaces(cube_, P, MV_cube, modelCube, material_, specular_, scene_.lights,
+                                       useClusters ? &clusters_ : nullptr, view, camera_.Position(), windowW_, windowH_);
+    lighting_.shadeMs = lightClock.getElapsedTime().asSeconds() * 1000.f;
+
+    std::optional<sf::Sprite> rasterSprite;
+    if (raster_.enabled) {
+        const int scale = std::max(raster_.downscale, 1);
+        const int fbW = static_cast<int>(windowW_) / scale;
+        const int fbH = static_cast<int>(windowH_) / scale;
+        if (framebuffer_.width != fbW || framebuffer_.height != fbH) {
+            framebuffer_.Resize(fbW, fbH);
+            (void)rasterTexture_.resize({static_cast<unsigned>(fbW), static_cast<unsigned>(fbH)});
+        }
+
+        const render::IndexedMesh& mesh = smoothing_.enabled ? smoothMesh_
+                                        : deform_.enabled   ? deformMesh_
+                                        : raster_.sphere    ? rasterSphere_
+                                                            : rasterCube_;
+        const render::MeshOptimizeReport& order = &mesh == &smoothMesh_ ? smoothOptimize_
+                                                : &mesh == &deformMesh_ ? deformOptimize_
+                                                : &mesh == &rasterSphere_ ? sphereOptimize_
+                                                                          : cubeOptimize_;
+        raster_.acmrBefore = static_cast<float>(order.acmrBefore);
+        raster_.acmrAfter = static_cast<float>(order.acmrAfter);
+        const render::MeshletSet& meshlets = &mesh == &smoothMesh_ ? smoothMeshlets_
+                                           : &mesh == &deformMesh_ ? deformMeshlets_
+                                           : &mesh == &rasterSphere_ ? sphereMeshlets_
+                                                                     : cubeMeshlets_;
+        raster_.meshlets = meshlets.meshlets.size();
+        const Mat3 normalMatrix = model.NormalMatrix();
+        const Mat4 viewProj = P * viewAffine; // once, not a 4x4 product per vertex
+        // Only the static meshes have quantized copies; smoothing and deformation rewrite theirs
+        const render::QuantizedMesh* quantized =
+            !raster_.quantized || &mesh == &smoothMesh_ || &mesh == &deformMesh_
+            ? nullptr
+            : &mesh == &rasterSphere_ ? &quantizedSphere_ : &quantizedCube_;
+        sf::Clock vertexClock;
+        std::span<const std::uint32_t> drawIndices = mesh.indices;
+        if (raster_.meshletCulling) {
+            // Whole meshlets rejected in model space, then only the survivors' vertices transformed
+            const Vec3 eyeModel = model.Inverse().TransformPoint(camera_.Position());
+            const render::MeshletCullStats cull = render::CullMeshlets(meshlets, P * (viewAffine * model), eyeModel,
+                                                                       !view_.useParallelProj, visibleMeshlets_);
+            render::GatherMeshlets(meshlets, visibleMeshlets_, rasterIds_, rasterIndices_);
+            rasterVertices_.resize(rasterIds_.size());
+            if (quantized) {
+                render::TransformQuantizedPoints(model, *quantized, rasterIds_, rasterWorld_);
+                render::TransformQuantizedNormals(normalMatrix, *quantized, rasterIds_, rasterNormals_);
+                for (std::size_t k = 0; k < rasterIds_.size(); ++k) {
+                    const Vec3 world = rasterWorld_.get(k);
+                    rasterVertices_[k] = {viewProj * Vec4(world, 1.f), world, rasterNormals_.get(k)};
+                }
+                raster_.vertexBytes = quantized->BytesPerVertex();
+            } else {
+                for (std::size_t k = 0; k < rasterIds_.size(); ++k) {
+                    const std::uint32_t i = rasterIds_[k];
+                    const Vec3 world = model.TransformPoint(mesh.positions[i]);
+                    rasterVertices_[k] = {viewProj * Vec4(world, 1.f), world, glm::normalize(normalMatrix * mesh.normals[i])};
+                }
+                raster_.vertexBytes = 2 * sizeof(Vec3);
+            }
+            drawIndices = rasterIndices_;
+            raster_.meshletsDrawn = visibleMeshlets_.size();
+            raster_.frustumCulled = cull.frustumCulled;
+            raster_.backfaceCulled = cull.backfaceCulled;
+        } else if (quantized) {
+            rasterVertices_.resize(mesh.VertexCount());
+            render::TransformQuantizedPoints(model, *quantized, rasterWorld_);
+            render::TransformQuantizedNormals(normalMatrix, *quantized, rasterNormals_);
+            for (std::size_t i = 0; i < mesh.VertexCount(); ++i) {
+                const Vec3 world = rasterWorld_.get(i);
+                rasterVertices_[i] = {viewProj * Vec4(world, 1.f), world, rasterNormals_.get(i)};
+            }
+            raster_.vertexBytes = quantized->BytesPerVertex();
+        } else {
+            rasterVertices_.resize(mesh.VertexCount());
+            for (std::size_t i = 0; i < mesh.VertexCount(); ++i) {
+                const Vec3 world = model.TransformPoint(mesh.positions[i]);
+                rasterVertices_[i] = {viewProj * Vec4(world, 1.f), world, glm::normalize(normalMatrix * mesh.normals[i])};
+            }
+            raster_.vertexBytes = 2 * sizeof(Vec3);
+        }
+        raster_.vertexMs = vertexClock.getElapsedTime().asSeconds() * 1000.f;
+        raster_.verticesTransformed = rasterVertices_.size();
+        const math::ShadeParams shade{
+            .materialColor = material_.color,
+            .ka = material_.ka,
+            .kd = material_.kd,
+            .ks = material_.ks,
+            .lightPos = scene_.lightPos,
+            .lightColor = scene_.lightColor,
+            .eye = camera_.Position(),
+            .blinn = material_.blinn
+        };
+
+        // Shadow-mapped: the object and a floor below it both cast and receive
+        const render::ShadowMap* shadowMap = nullptr;
+        const int pcf = 1 << std::clamp(shadow_.pcf, 0, 2);
+        if (shadow_.shadowMap) {
+            if (shadowMap_.Size() != shadow_.mapSize) {
+                shadowMap_.Resize(shadow_.mapSize);
+            }
+            casterPositions_.clear();
+            casterIndices_.clear();
+            // Culled meshlets still cast shadows: the map takes every vertex
+            if (raster_.meshletCulling) {
+                for (const Vec3& p : mesh.positions) {
+                    casterPositions_.push_back(model.TransformPoint(p));
+                }
+            } else {
+                for (const auto& v : rasterVertices_) {
+                    casterPositions_.push_back(v.world);
+                }
+            }
+            casterIndices_.assign(mesh.indices.begin(), mesh.indices.end());
+            const auto floorBase = static_cast<std::uint32_t>(casterPositions_.size());
+            casterPositions_.insert(casterPositions_.end(), rasterFloor_.positions.begin(), rasterFloor_.positions.end());
+            for (std::uint32_t i : rasterFloor_.indices) {
+                casterIndices_.push_back(floorBase + i);
+            }
 
+            const Vec3 center = model.Offset();
+            const Vec3 toLight = glm::normalize(scene_.lightPos - center);
+            const Vec3 up = std::abs(toLight.y) > 0.99f ? Vec3{0.f, 0.f, 1.f} : Vec3{0.f, 1.f, 0.f};
+            const Mat4 lightViewProj = shadow_.directional
+                ? kDirectionalShadowProj * glm::lookAt(center + 10.f * toLight, center, up)
+                : kSpotShadowProj * glm::lookAt(scene_.lightPos, center, up);
+
+            sf::Clock mapClock;
+            shadowMap_.Render(casterPositions_, casterIndices_, lightViewProj);
+            shadow_.mapMs = mapClock.getElapsedTime().asSeconds() * 1000.f;
+            shadowMap = &shadowMap_;
+        }
+
+        sf::Clock rasterClock;
+        framebuffer_.Clear(0, 0, 0, 0);
+        const auto mode = static_cast<render::ShadingMode>(raster_.mode);
+        render::RasterStats stats = rasterizer_.Draw(framebuffer_, rasterVertices_, drawIndices, mode, shade, specular_,
+                                                     shadowMap, pcf);
+        if (shadowMap) {
+            floorVertices_.resize(rasterFloor_.VertexCount());
+            for (std::size_t i = 0; i < floorVertices_.size(); ++i) {
+                const Vec3& world = rasterFloor_.positions[i];
+                floorVertices_[i] = {viewProj * Vec4(world, 1.f), world, rasterFloor_.normals[i]};
+            }
+            math::ShadeParams floorShade = shade;
+            floorShade.materialColor = {0.55f, 0.55f, 0.6f};
+            floorShade.ks = 0.f;
+            stats.fragments += rasterizer_.Draw(framebuffer_, floorVertices_, rasterFloor_.indices, mode, floorShade,
+                                                specular_, shadowMap, pcf).fragments;
+        }
+        raster_.rasterMs = rasterClock.getElapsedTime().asSeconds() * 1000.f;
+        raster_.fragments = stats.fragments;
+
+        rasterTexture_.update(framebuffer_.color.data());
+        rasterSprite.emplace(rasterTexture_);
+        rasterSprite->setScale({static_cast<float>(scale), static_cast<float>(scale)});
+    }
+
+    sf::VertexArray lightPoints(sf::PrimitiveType::Points);
+    for (std::size_t i = 1; i < scene_.lights.size(); ++i) {
+        const math::Light& light = scene_.lights[i];
+        const sf::Color color(static_cast<std::uint8_t>(light.color.r * 255.f),
+                              static_cast<std::uint8_t>(light.color.g * 255.f),
+                              static_cast<std::uint8_t>(light.color.b * 255.f));
+        lightPoints.append(sf::Vertex{render::ToScreenH(light.position, P, view, windowW_, windowH_), color});
+    }
+
+    // Receivers and light only change on user input, so the matrices are normally cached
+    std::array<math::Plane, 2> receivers = {
+        math::Plane{{0.f, 1.f, 0.f}, 0.f},
+        math::Plane{{0.f, 0.f, 1.f}, transform_.distance + shadow_.wallDepth}
+    };
+    shadows_.SetReceivers(std::span(receivers).first(shadow_.wall ? 2 : 1));
+    shadows_.SetLight(shadow_.directional ? math::directionalShadowLight(-glm::normalize(scene_.lightPos))
+                                          : math::pointShadowLight(scene_.lightPos));
+    shadow_.rebuilds = shadows_.Rebuilds();
+
+    cubeWorld_.resize(cube_.vertices.size());
+    for (std::size_t i = 0; i < cube_.vertices.size(); ++i) {
+        cubeWorld_.set(i, model.TransformPoint(cube_.vertices[i]));
+    }
+    shadows_.Project(cubeWorld_, cubeShadows_);
+
+    // Translucent, so every shadow pixel must be covered exactly once
+    const sf::Color shadowColor(0, 0, 0, 110);
     sf::VertexArray shadow_faces(sf::PrimitiveType::Triangles);
-    {
+    for (std::size_t r = 0; r < cubeShadows_.size(); ++r) {
+        const math::Vec3Batch& flattened = cubeShadows_[r];
+        if (shadow_.hull) {
+            // The cube is convex: its shadow is the hull of the projected corners, one fan.
+            // Corners level with a point light (projector w ~ 0) or behind the camera land far
+            // off screen and would stretch the fan across it: leave them out of the hull
+            std::vector<glm::vec2> screen;
+            for (std::size_t i = 0; i < cube_.vertices.size(); ++i) {
+                const float w = (shadows_.Matrices()[r] * Vec4(cubeWorld_.get(i), 1.f)).w;
+                sf::Vector2f s;
+                if (std::abs(w) >= 1e-6f && render::ToScreenH(flattened.get(i), P, view, windowW_, windowH_, s)) {
+                    screen.push_back({s.x, s.y});
+                }
+            }
+            // Fewer than three left: no hull, the per-face quads below draw this plane instead
+            if (screen.size() >= 3) {
+                const std::vector<glm::vec2> hull = math::convexHull(screen);
+                for (std::size_t i = 1; i + 1 < hull.size(); ++i) {
+                    for (const glm::vec2& h : {hull[0], hull[i], hull[i + 1]}) {
+                        shadow_faces.append(sf::Vertex{{h.x, h.y}, shadowColor});
+                    }
+                }
+                continue;
+            }
+        }
         static constexpr int tri[6] = {0, 1, 2, 0, 2, 3};
         for (const auto& quad : cube_.faces) {
             std::size_t base = shadow_faces.getVertexCount();
             shadow_faces.resize(base + 6);
             for (int k = 0; k < 6; ++k) {
-                int vidx = quad[tri[k]];
-                sf::Vector2f p = render::ToScreenH(cube_.vertices[vidx], P, MV_shadow, windowW_, windowH_);
-                shadow_faces[base + k].position = p;
-                shadow_faces[base + k].color = sf::Color(30, 30, 30);
+                const auto vidx = static_cast<std::size_t>(quad[tri[k]]);
+                shadow_faces[base + k].position = render::ToScreenH(flattened.get(vidx), P, view, windowW_, windowH_);
+                shadow_faces[base + k].color = shadowColor;
+            }
+        }
+    }
+    shadow_.triangles = shadow_faces.getVertexCount() / 3;
+
+    sf::VertexArray tubeWire(sf::PrimitiveType::Lines);
+    sf::VertexArray tubeShadow(sf::PrimitiveType::Lines);
+    if (skinning_.enabled && tubeBones_ > 0) {
+        const float bend = skinning_.animate ? skinning_.bend * std::sin(animTime_) : skinning_.bend;
+        const auto bones = render::ChainPose(tubeBones_, 2.f, bend);
+        render::SkinDualQuat(tube_, bones, tubePositions_, tubeNormals_);
+        const math::Affine3& modelTube = sceneGraph_.World(tubeNode_);
+        const Mat4 MV_tube = (viewAffine * modelTube).ToMat4();
+        tubeWire = BuildMeshWire(tube_.bind, tubePositions_, P, MV_tube, windowW_, windowH_);
+
+        // Not convex: outline its shadow with the silhouette edges instead of a hull
+        tubeWorld_.resize(tubePositions_.size());
+        for (std::size_t i = 0; i < tubeWorld_.size(); ++i) {
+            tubeWorld_[i] = modelTube.TransformPoint(tubePositions_.get(i));
+        }
+        const Vec4 light = shadow_.directional ? math::directionalShadowLight(-glm::normalize(scene_.lightPos))
+                                               : math::pointShadowLight(scene_.lightPos);
+        for (const render::SilhouetteEdge& edge : tubeSilhouette_->Extract(tubeWorld_, light)) {
+            for (const Mat4& S : shadows_.Matrices()) {
+                const Vec4 a = S * Vec4(tubeWorld_[edge[0]], 1.f);
+                const Vec4 b = S * Vec4(tubeWorld_[edge[1]], 1.f);
+                // An end level with a point light never reaches the plane (w ~ 0): drop the edge
+                if (std::abs(a.w) < 1e-6f || std::abs(b.w) < 1e-6f) {
+                    continue;
+                }
+                for (const Vec4& flat : {a, b}) {
+                    tubeShadow.append(sf::Vertex{render::ToScreenH(Vec3(flat) / flat.w, P, view, windowW_, windowH_),
+                                                 sf::Color(20, 20, 20)});
+                }
+            }
+        }
+    }
+
+    // Singular vectors of the model matrix from the cube center: V's columns (the object
+    // axes that stay orthogonal, dim) and U's scaled by sigma (where they land, bright)
+    sf::VertexArray svdArrows(sf::PrimitiveType::Lines);
+    if (transform_.showSvd) {
+        const math::Svd3 s = math::svd(model.Linear());
+        transform_.singularValues = s.sigma;
+        const Vec3 center = model.Offset();
+        const sf::Color colors[] = {sf::Color(255, 90, 90), sf::Color(90, 255, 90), sf::Color(90, 150, 255)};
+        for (int k = 0; k < 3; ++k) {
+            const sf::Color dim(colors[k].r, colors[k].g, colors[k].b, 110);
+            const Vec3 tips[] = {center + s.v[k], center + s.u[k] * s.sigma[k]};
+            for (int arrow = 0; arrow < 2; ++arrow) {
+                const sf::Color color = arrow == 0 ? dim : colors[k];
+                svdArrows.append(sf::Vertex{render::ToScreenH(center, P, view, windowW_, windowH_), color});
+                svdArrows.append(sf::Vertex{render::ToScreenH(tips[arrow], P, view, windowW_, windowH_), color});
+            }
+        }
+    }
+
+    sf::VertexArray generalWire(sf::PrimitiveType::Lines);
+    if (general_.enabled) {
+        math::Matrix<float> M(3, 3);
+        for (std::size_t k = 0; k < 9; ++k) {
+            M(k / 3, k % 3) = general_.m[k];
+        }
+        math::gemm(M, cubeCorners_, generalCorners_);
+        for (const auto& [a, b] : cube_.edges) {
+            for (int v : {a, b}) {
+                const auto col = static_cast<std::size_t>(v);
+                const Vec3 p{generalCorners_(0, col), generalCorners_(1, col), generalCorners_(2, col)};
+                generalWire.append(sf::Vertex{render::ToScreenH(p, P, MV_plane, windowW_, windowH_), sf::Color(255, 140, 220)});
             }
         }
     }
 
+    sf::VertexArray cloudPoints(sf::PrimitiveType::Points);
+    if (cloud_.enabled) {
+        sf::Clock convertClock;
+        scene_.uTransform.FromCoords(cloudCoords_, cloudWorld_);
+        cloud_.convertMs = convertClock.getElapsedTime().asSeconds() * 1000.f;
+
+        cloudPoints.resize(cloudWorld_.size());
+        for (std::size_t i = 0; i < cloudWorld_.size(); ++i) {
+            cloudPoints[i].position = render::ToScreenH(cloudWorld_.get(i), P, MV_plane, windowW_, windowH_);
+            cloudPoints[i].color = sf::Color(255, 210, 90, 140);
+        }
+    }
+
     sf::VertexArray basis = BuildGridLines(scene_.grid, P, MV_plane, windowW_, windowH_);
 
     auto [pairs, points_grid, lines_grid] = BuildGridDrawData(scene_.grid, P, MV_plane, windowW_, windowH_);
@@ -606,7 +1319,7 @@ void App::Render() {
         .windowW = windowW_,
         .windowH = windowH_
     };
-    ui::ShowMatrixLab(transform_, view_, scene_, frame);
+    ui::ShowMatrixLab(transform_, view_, controls_, material_, lighting_, shadow_, raster_, smoothing_, deform_, precision_, general_, skinning_, cloud_, scene_, frame);
 
     window_.clear();
 
@@ -617,8 +1330,18 @@ void App::Render() {
     window_.draw(points_grid);
     window_.draw(lines_grid);
     window_.draw(shadow_faces);
+    window_.draw(tubeShadow);
+    window_.draw(cloudPoints);
 
-    window_.draw(faces);
+    if (rasterSprite) {
+        window_.draw(*rasterSprite);
+    } else {
+        window_.draw(faces);
+    }
+    window_.draw(lightPoints);
+    window_.draw(tubeWire);
+    window_.draw(generalWire);
+    window_.draw(svdArrows);
     // window_.draw(wire);
     window_.draw(vecLines);
     window_.draw(tips);
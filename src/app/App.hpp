@@ -1,10 +1,28 @@
 #pragma once
 
+#include <atomic>
+#include <optional>
+#include <thread>
+#include <vector>
+
 #include <SFML/Graphics.hpp>
 
 #include "app/SceneParams.hpp"
 #include "math/Camera.hpp"
+#include "math/LightingBatch.hpp"
+#include "math/Matrix.hpp"
+#include "math/Sparse.hpp"
+#include "math/Shadow.h"
+#include "math/Vec3Batch.hpp"
+#include "render/LaplacianDeform.hpp"
 #include "render/Mesh.hpp"
+#include "render/MeshOptimize.hpp"
+#include "render/MeshletCull.hpp"
+#include "render/QuantizedMesh.hpp"
+#include "render/Rasterizer.hpp"
+#include "render/SceneGraph.hpp"
+#include "render/Silhouette.hpp"
+#include "render/Skinning.hpp"
 
 namespace app {
 
@@ -15,9 +33,12 @@ public:
 
 private:
     void ProcessEvents(float dt);
+    void FlushArcballDrag(float dt);
     void Update(float dt);
     void Render();
     void UpdateControls(float dt);
+    void UpdateSmoothing();
+    void UpdateDeformation();
     float ComputeSceneScale() const;
 
     // Window (windowW_/windowH_ must be declared before window_ for initialization order)
@@ -32,10 +53,92 @@ private:
     ViewParams view_;
     ControlSettings controls_;
     SceneGeometry scene_;
+    SkinningParams skinning_;
+    PointCloudParams cloud_;
+    LightingParams lighting_;
+    RasterParams raster_;
+    SmoothingParams smoothing_;
+    DeformParams deform_;
+    PrecisionParams precision_;
+    ShadowParams shadow_;
+    GeneralMatrixParams general_;
 
     // Objects
     math::OrbitCamera camera_;
+    render::SceneGraph sceneGraph_;
+    render::NodeId planeNode_{};           // the grid and basis frame, `distance` ahead
+    render::NodeId objectNode_{};          // the cube / rasterized object, on the plane
+    render::NodeId tubeNode_{};            // the skinned tube, beside the object
     render::CubeMesh cube_;
+    math::SpecularTable specular_;
+    math::LightClusters clusters_;
+    math::ShadowProjector shadows_;
+    math::Vec3Batch cubeWorld_;
+    math::Matrix<float> cubeCorners_;      // 3 x 8, one corner per column
+    math::Matrix<float> generalCorners_;   // general_.m times cubeCorners_
+    std::vector<math::Vec3Batch> cubeShadows_; // per receiver
+    render::SkinnedMesh tube_;
+    int tubeBones_{};
+    math::Vec3Batch tubePositions_;
+    math::Vec3Batch tubeNormals_;
+    std::optional<render::SilhouetteExtractor> tubeSilhouette_; // rebuilt with tube_
+    std::vector<Vec3> tubeWorld_;
+    float animTime_{};
+    int arcballFrames_{}; // frames since the arcball rotation was re-orthonormalized
+    math::Vec3Batch cloudCoords_;
+    math::Vec3Batch cloudWorld_;
+    render::IndexedMesh rasterCube_;
+    render::IndexedMesh rasterSphere_;
+    render::MeshOptimizeReport cubeOptimize_;   // ACMR before and after, for the UI
+    render::MeshOptimizeReport sphereOptimize_;
+    render::MeshletSet cubeMeshlets_;
+    render::MeshletSet sphereMeshlets_;
+    std::vector<std::uint32_t> visibleMeshlets_; // this frame's survivors of meshlet culling
+    std::vector<std::uint32_t> rasterIds_;     // mesh vertex behind each rasterVertices_ entry when culling
+    std::vector<std::uint32_t> rasterIndices_; // and the visible triangles over them
+    render::QuantizedMesh quantizedCube_;
+    render::QuantizedMesh quantizedSphere_;
+    math::Vec3Batch rasterWorld_;            // object vertices, world space, from the quantized path
+    math::Vec3Batch rasterNormals_;
+    render::IndexedMesh rasterFloor_;        // shadow-map receiver
+    std::vector<render::RasterVertex> floorVertices_;
+    render::ShadowMap shadowMap_;
+    std::vector<Vec3> casterPositions_;      // object + floor, world space
+    std::vector<std::uint32_t> casterIndices_;
+    std::vector<render::RasterVertex> rasterVertices_;
+    render::IndexedMesh smoothMesh_;         // welded (and reordered) sphere being smoothed
+    std::vector<Vec3> smoothRest_;           // its positions before smoothing
+    render::MeshOptimizeReport smoothOptimize_;
+    render::MeshletSet smoothMeshlets_;      // bounds refreshed with the normals
+    math::SparseMatrix<float> smoothLaplacian_;
+    math::SparseMatrix<float> smoothOperator_; // I - lambda D^-1 L
+    math::Matrix<float> smoothPositions_;    // n x 3, the state the smoothing steps advance
+    math::Matrix<float> smoothScratch_;
+    int smoothSize_{};                       // rings of smoothMesh_, 0 before the first build
+    bool smoothCotangent_{};
+    bool smoothReorder_{};
+    float smoothLambda_{};                   // lambda smoothOperator_ was built with
+    render::IndexedMesh deformMesh_;         // positions replaced by each published solve
+    render::MeshOptimizeReport deformOptimize_;
+    render::MeshletSet deformMeshlets_;
+    std::optional<render::AsyncDeformer> deformer_; // rebuilt when the mesh or preconditioner changes
+    int deformSize_{};
+    int deformPreconditioner_{};
+    float deformCap_{};
+    Mat4 deformRequested_{0.f};              // handle transform of the last request
+    float deformTolerance_{};                // and its settings
+    float deformBudget_{};
+    struct FactorTimings {
+        float luMs{};
+        float qrMs{};
+        float choleskyMs{};
+    };
+    FactorTimings factorTimings_;            // written by factorBench_ before it sets factorBenchDone_
+    std::atomic<bool> factorBenchDone_{false};
+    std::jthread factorBench_;               // the n x n factorization timings, off the render loop
+    render::Rasterizer rasterizer_;
+    render::Framebuffer framebuffer_;
+    sf::Texture rasterTexture_;
 
     // Debug
     bool printed_ = false;
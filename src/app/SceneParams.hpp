@@ -1,8 +1,15 @@
 #pragma once
 
 #include <array>
+#include <cstddef>
+#include <string>
+#include <vector>
 
+#include "math/Basis.hpp"
+#include "math/Decompose.hpp"
+#include "math/LightClusters.hpp"
 #include "math/Types.hpp"
+#include "render/Precision.hpp"
 
 namespace app {
 
@@ -12,6 +19,7 @@ namespace app {
         float kd = 0.7f;
         float ks = 0.5f;
         float shininess = 32.f;
+        bool blinn = false; // Blinn-Phong half-vector specular
     };
 
     // Object rotation/translation parameters
@@ -22,6 +30,10 @@ namespace app {
         float axisAngle = 0.f;
         float yTrans = 0.f;
         float distance = 0.f;  // was ws_ (world-space depth)
+        bool showSvd = false;  // overlay arrows for the model matrix's singular vectors
+        Vec3 singularValues{1.f}; // of the model matrix's 3x3 part, for the UI
+        std::size_t sceneNodes = 0;   // scene graph stats for the UI
+        std::size_t nodesUpdated = 0; // world transforms recomputed this frame
     };
 
     // Camera projection parameters
@@ -31,12 +43,166 @@ namespace app {
         bool useCustomLookAt = false;
         bool useParallelProj = false;
         float orthoSize = 5.f;
+        bool showOrthonormalU = false; // draw the u-basis next to its Gram-Schmidt frame
     };
 
     // Input sensitivity (rarely changed)
     struct ControlSettings {
         float turnSpeed = 1.f;
         float focalSpeed = 30.f;
+        bool arcballSubframe = false; // follow the sampled drag path instead of one net rotation
+        float velocityWindow = 0.08f; // seconds of drag history used for the release speed
+        int reorthonormalizeFrames = 60; // arcball rotation cleanup interval; 0: never
+    };
+
+    // Articulated tube deformed with dual-quaternion skinning
+    struct SkinningParams {
+        bool enabled = false;
+        bool animate = true;
+        int boneCount = 4;
+        float bend = 0.5f; // radians per joint (amplitude when animating)
+    };
+
+    // Sampled points given as u-basis coordinates, mapped to world with a BasisTransform
+    struct PointCloudParams {
+        bool enabled = false;
+        int count = 20000;
+        float convertMs = 0.f; // last batch FromCoords time, for the UI
+    };
+
+    // Extra point lights around the cube, shaded through clustered culling
+    struct LightingParams {
+        int extraLights = 0;
+        float extraRange = 1.5f;
+        bool clustered = true;    // off: every face evaluates every light
+        float buildMs = 0.f;      // stats for the UI
+        float shadeMs = 0.f;
+        std::size_t maxPerCluster = 0;
+    };
+
+    // A general 3x3 matrix applied to the unit cube, drawn as a second wireframe
+    struct GeneralMatrixParams {
+        bool enabled = false;
+        std::array<float, 9> m{1, 0, 0, 0, 1, 0, 0, 0, 1}; // row-major
+        int method = 0;           // factorization shown: 0 LU, 1 QR, 2 Cholesky of M^T M
+        int step = 0;             // scrubbed elimination step
+        int benchSize = 1000;     // n for the timed n x n factorizations
+        bool runBench = false;    // set by the UI, cleared once App has started the timing
+        bool benchBusy = false;   // timing on App's worker thread; results not in yet
+        float luMs = 0.f;         // stats for the UI
+        float qrMs = 0.f;
+        float choleskyMs = 0.f;
+        // The stepped 3x3 factorization, refactored by the UI only when m or method changes
+        std::array<float, 9> factoredM{};
+        int factoredMethod = -1;  // -1: nothing factored yet
+        math::FactorTrace<float> trace;
+        std::string result;       // determinant or factor summary
+    };
+
+    // Planar shadows of the cube on the floor and an optional back wall
+    struct ShadowParams {
+        bool directional = false; // light along -lightPos instead of from it
+        bool wall = false;
+        float wallDepth = 3.f;    // wall sits this far behind the cube
+        bool hull = true;         // one convex-hull fan per receiver instead of every face
+        std::size_t triangles = 0;
+        bool shadowMap = false;   // software rasterizer only: depth map from the light
+        int mapSize = 1024;
+        int pcf = 1;              // filter width 1 << pcf texels: 1, 2x2, 4x4
+        float mapMs = 0.f;
+        std::size_t rebuilds = 0; // shadow matrix rebuilds so far, for the UI
+    };
+
+    // Software rasterizer drawing the cube (or a sphere) in place of the SFML faces
+    struct RasterParams {
+        bool enabled = false;
+        int mode = 2;             // render::ShadingMode: 0 flat, 1 Gouraud, 2 Phong
+        bool sphere = false;      // draw a UV sphere instead of the cube
+        int downscale = 2;        // framebuffer is the window size divided by this
+        bool quantized = false;   // cube and sphere from their 16-bit copies (render::QuantizedMesh)
+        bool meshletCulling = true; // frustum and normal-cone tests per meshlet before the vertex work
+        float rasterMs = 0.f;     // stats for the UI
+        float vertexMs = 0.f;     // object transform, decode included
+        std::size_t fragments = 0;
+        std::size_t vertexBytes = 0; // stored per vertex: positions and normals
+        float acmrBefore = 0.f;   // vertex cache misses per triangle, as built and after
+        float acmrAfter = 0.f;    // render::OptimizeMesh
+        std::size_t meshlets = 0;
+        std::size_t meshletsDrawn = 0;
+        std::size_t frustumCulled = 0;
+        std::size_t backfaceCulled = 0;
+        std::size_t verticesTransformed = 0;
+    };
+
+    // Laplacian smoothing of a dense welded sphere, drawn by the software rasterizer
+    struct SmoothingParams {
+        bool enabled = false;     // rasterize the smoothed sphere in place of the object
+        int resolution = 1;       // rings = segments = 256, 512 or 1024 (~1M vertices)
+        bool cotangent = false;   // cotangent instead of uniform (graph) weights
+        bool reorder = true;      // RCM vertex order, so SpMV reads stay close together
+        float lambda = 0.5f;      // step towards the neighbour average
+        int stepsPerFrame = 1;
+        bool run = true;          // off: hold the current shape
+        float noise = 0.02f;      // relative radius noise applied by "Add noise"
+        bool addNoise = false;    // set by the UI, cleared once App has applied it
+        bool reset = false;       // set by the UI: back to the noisy sphere
+        std::size_t vertices = 0; // stats for the UI
+        std::size_t nonZeros = 0;
+        std::size_t bandwidth = 0;
+        float buildMs = 0.f;
+        float smoothMs = 0.f;
+        float normalsMs = 0.f;
+    };
+
+    // Laplacian-editing deformation of a welded sphere: the bottom cap is pinned, the top cap
+    // is the handle, and the band between is solved by (P)CG on a worker thread
+    struct DeformParams {
+        bool enabled = false;     // rasterize the deformed sphere in place of the object
+        int resolution = 1;       // rings = segments = 64, 128 or 256
+        int preconditioner = 2;   // math::PreconditionerKind: 0 none, 1 Jacobi, 2 IC(0)
+        Vec3 handleOffset{0.f, 0.3f, 0.f};
+        float handleTwist = 0.f;  // radians about y
+        float capHeight = 0.6f;   // |y| / radius beyond which vertices are pinned or moved
+        float budgetMs = 4.f;     // per published solve slice
+        float tolerance = 1e-5f;  // relative residual
+        // Written by App
+        std::size_t vertices = 0;
+        std::size_t freeVertices = 0;
+        std::size_t iterations = 0;      // in the last slice
+        std::size_t totalIterations = 0; // since the last handle change
+        float residual = 0.f;
+        float solveMs = 0.f;
+        float setupMs = 0.f;
+        bool converged = false;
+        bool busy = false;
+        static constexpr int kHistory = 64;
+        std::array<float, kHistory> residualLog{}; // log10 residual per slice, oldest first
+    };
+
+    // Float / double / half-storage runs of one projection pipeline (render::RunPrecisionStudy)
+    struct PrecisionParams {
+        float offset = 1e4f;      // world distance of the test sphere from the origin
+        float distance = 4.f;     // camera distance from the sphere
+        float nearPlane = 0.1f;
+        float farPlane = 100.f;
+        int resolution = 1;       // rings = 64, 128 or 512
+        bool run = false;         // set by the UI, cleared once App has run the study
+        // Written by App
+        bool valid = false;
+        std::array<render::PrecisionResult, 3> results{}; // indexed by render::ScalarMode
+    };
+
+    // Per-frame arcball rotations, kept for a short window to estimate release velocity
+    struct ArcballHistory {
+        struct Sample {
+            Vec3 axis{};
+            float angle{};
+            float dt{};
+        };
+        static constexpr std::size_t kCapacity = 32;
+        std::array<Sample, kCapacity> samples{};
+        std::size_t head{};
+        std::size_t count{};
     };
 
     // 3D scene geometry
@@ -44,6 +210,8 @@ namespace app {
         std::array<Vec3, 4> grid{};
         std::array<Vec3, 3> vBasis{};
         std::array<Vec3, 3> uBasis{};
+        math::BasisTransform uTransform; // cached inverse of uBasis
+        std::array<Vec3, 3> uOrthonormal{}; // Gram-Schmidt of uBasis
         Vec3 a{}, b{}, w{};
         Vec3 originWorld{};
         Vec3 p1{};
@@ -55,8 +223,17 @@ namespace app {
         float angular_speed{};
         float end_dt{};
 
+        // Drag input gathered while polling events, applied once per frame
+        static constexpr std::size_t kMaxDragSamples = 8;
+        std::array<Vec3, kMaxDragSamples> dragSamples{};
+        std::size_t dragSampleCount{};
+        Vec3 dragTarget{};
+        bool dragMoved{false};
+        ArcballHistory arcHistory;
+
         Vec3 lightPos{};
         Vec3 lightColor{};
+        std::vector<math::Light> lights; // [0] mirrors lightPos/lightColor, unbounded
 
         bool isDragging{false};
     };
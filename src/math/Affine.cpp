@@ -0,0 +1,186 @@
+#include "math/Affine.hpp"
+
+#include <cmath>
+
+#include "math/Orthonormalize.hpp"
+
+namespace math {
+
+namespace {
+
+// Quaternion to rotation, R[c][r] as quatToMat4.
+template <class T>
+TMat3<T> RotationFromQuat(T w, T x, T y, T z) {
+    return {TVec3<T>(1 - 2*(y*y + z*z), 2*(x*y + w*z),     2*(x*z - w*y)),
+            TVec3<T>(2*(x*y - w*z),     1 - 2*(x*x + z*z), 2*(y*z + w*x)),
+            TVec3<T>(2*(x*z + w*y),     2*(y*z - w*x),     1 - 2*(x*x + y*y))};
+}
+
+void EnsureSize(Vec3Batch& out, std::size_t n) {
+    if (out.size() != n || out.paddedSize() != PadToLanes(n)) {
+        out.resize(n);
+    }
+}
+
+} // namespace
+
+template <class T>
+TAffine3<T> TAffine3<T>::FromLinear(const TMat3<T>& linear, const TVec3<T>& translation) {
+    TAffine3 a;
+    for (int r = 0; r < 3; ++r) {
+        a.rows[r] = TVec4<T>(linear[0][r], linear[1][r], linear[2][r], translation[r]);
+    }
+    return a;
+}
+
+template <class T>
+TAffine3<T> TAffine3<T>::Rotation(T angle, const TVec3<T>& axis) {
+    const TVec3<T> a = glm::normalize(axis);
+    const T s = std::sin(angle / 2);
+    return FromLinear(RotationFromQuat(std::cos(angle / 2), a.x * s, a.y * s, a.z * s));
+}
+
+template <class T>
+TAffine3<T> TAffine3<T>::Scale(const TVec3<T>& s) {
+    TAffine3 a;
+    a.rows[0].x = s.x;
+    a.rows[1].y = s.y;
+    a.rows[2].z = s.z;
+    return a;
+}
+
+template <class T>
+TAffine3<T> TAffine3<T>::FromMat4(const TMat4<T>& m) {
+    TAffine3 a;
+    for (int r = 0; r < 3; ++r) {
+        a.rows[r] = TVec4<T>(m[0][r], m[1][r], m[2][r], m[3][r]);
+    }
+    return a;
+}
+
+template <class T>
+TMat4<T> TAffine3<T>::ToMat4() const {
+    return {TVec4<T>(rows[0].x, rows[1].x, rows[2].x, 0),
+            TVec4<T>(rows[0].y, rows[1].y, rows[2].y, 0),
+            TVec4<T>(rows[0].z, rows[1].z, rows[2].z, 0),
+            TVec4<T>(rows[0].w, rows[1].w, rows[2].w, 1)};
+}
+
+template <class T>
+TMat3<T> TAffine3<T>::Linear() const {
+    return {TVec3<T>(rows[0].x, rows[1].x, rows[2].x),
+            TVec3<T>(rows[0].y, rows[1].y, rows[2].y),
+            TVec3<T>(rows[0].z, rows[1].z, rows[2].z)};
+}
+
+template <class T>
+TAffine3<T> TAffine3<T>::Inverse() const {
+    // inverse(L) = transpose(cofactors) / det, and the cofactor columns are cross products
+    // of L's columns, i.e. the rows of inverse(L) are those cross products
+    const TMat3<T> L = Linear();
+    const TVec3<T> c0 = glm::cross(L[1], L[2]);
+    const TVec3<T> c1 = glm::cross(L[2], L[0]);
+    const TVec3<T> c2 = glm::cross(L[0], L[1]);
+    const T invDet = 1 / glm::dot(L[0], c0);
+    const TVec3<T> t = Offset();
+    TAffine3 inv;
+    inv.rows[0] = TVec4<T>(c0 * invDet, -glm::dot(c0, t) * invDet);
+    inv.rows[1] = TVec4<T>(c1 * invDet, -glm::dot(c1, t) * invDet);
+    inv.rows[2] = TVec4<T>(c2 * invDet, -glm::dot(c2, t) * invDet);
+    return inv;
+}
+
+template <class T>
+TAffine3<T> TAffine3<T>::RigidInverse() const {
+    // The rows of transpose(L) are L's columns
+    const TMat3<T> L = Linear();
+    const TVec3<T> t = Offset();
+    TAffine3 inv;
+    for (int r = 0; r < 3; ++r) {
+        inv.rows[r] = TVec4<T>(L[r], -glm::dot(L[r], t));
+    }
+    return inv;
+}
+
+template <class T>
+TMat3<T> TAffine3<T>::NormalMatrix() const {
+    const TMat3<T> L = Linear();
+    const TVec3<T> c0 = glm::cross(L[1], L[2]);
+    const TVec3<T> c1 = glm::cross(L[2], L[0]);
+    const TVec3<T> c2 = glm::cross(L[0], L[1]);
+    const T invDet = 1 / glm::dot(L[0], c0);
+    return {c0 * invDet, c1 * invDet, c2 * invDet};
+}
+
+template <class T>
+TMat4<T> operator*(const TMat4<T>& m, const TAffine3<T>& a) {
+    // Column c of the result is m applied to column c of a, whose w is 0 except the last
+    const TVec4<T>& r0 = a.rows[0];
+    const TVec4<T>& r1 = a.rows[1];
+    const TVec4<T>& r2 = a.rows[2];
+    return {m[0] * r0.x + m[1] * r1.x + m[2] * r2.x,
+            m[0] * r0.y + m[1] * r1.y + m[2] * r2.y,
+            m[0] * r0.z + m[1] * r1.z + m[2] * r2.z,
+            m[0] * r0.w + m[1] * r1.w + m[2] * r2.w + m[3]};
+}
+
+template struct TAffine3<float>;
+template struct TAffine3<double>;
+template Mat4 operator*(const Mat4&, const Affine3&);
+template Mat4d operator*(const Mat4d&, const Affine3d&);
+
+Affine3 quatToAffine(const Quat& q) {
+    return Affine3::FromLinear(RotationFromQuat(q.w, q.x, q.y, q.z));
+}
+
+void quatToAffine(const QuatBatch& q, std::span<Affine3> out) {
+    const float* qw = q.w.data(); const float* qx = q.x.data(); const float* qy = q.y.data(); const float* qz = q.z.data();
+    Affine3* a = out.data();
+
+    ForEachLane(q.size(), [=](std::size_t i) {
+        a[i] = Affine3::FromLinear(RotationFromQuat(qw[i], qx[i], qy[i], qz[i]));
+    });
+}
+
+Affine3 lookAtAffine(const Vec3& pos, const Vec3& target, const Vec3& up) {
+    // Gram-Schmidt of (forward, up, forward x up): the same frame as normalizing two
+    // cross products, but still orthonormal when up is parallel to the view direction
+    const Vec3 forward = target - pos;
+    const auto [n, trueUp, right] = orthonormalize({forward, up, glm::cross(forward, up)});
+    // The rows are the camera axes
+    Affine3 view;
+    view.rows[0] = Vec4(right, -glm::dot(right, pos));
+    view.rows[1] = Vec4(trueUp, -glm::dot(trueUp, pos));
+    view.rows[2] = Vec4(-n, glm::dot(n, pos));
+    return view;
+}
+
+void transformPoints(const Affine3& a, const Vec3Batch& in, Vec3Batch& out) {
+    EnsureSize(out, in.size());
+    const float* ix = in.x.data(); const float* iy = in.y.data(); const float* iz = in.z.data();
+    float* ox = out.x.data(); float* oy = out.y.data(); float* oz = out.z.data();
+    const Vec4 r0 = a.rows[0], r1 = a.rows[1], r2 = a.rows[2];
+
+    ForEachLane(in.size(), [=](std::size_t i) {
+        const float x = ix[i], y = iy[i], z = iz[i];
+        ox[i] = r0.x * x + r0.y * y + r0.z * z + r0.w;
+        oy[i] = r1.x * x + r1.y * y + r1.z * z + r1.w;
+        oz[i] = r2.x * x + r2.y * y + r2.z * z + r2.w;
+    });
+}
+
+void transformDirections(const Affine3& a, const Vec3Batch& in, Vec3Batch& out) {
+    EnsureSize(out, in.size());
+    const float* ix = in.x.data(); const float* iy = in.y.data(); const float* iz = in.z.data();
+    float* ox = out.x.data(); float* oy = out.y.data(); float* oz = out.z.data();
+    const Vec4 r0 = a.rows[0], r1 = a.rows[1], r2 = a.rows[2];
+
+    ForEachLane(in.size(), [=](std::size_t i) {
+        const float x = ix[i], y = iy[i], z = iz[i];
+        ox[i] = r0.x * x + r0.y * y + r0.z * z;
+        oy[i] = r1.x * x + r1.y * y + r1.z * z;
+        oz[i] = r2.x * x + r2.y * y + r2.z * z;
+    });
+}
+
+} // namespace math
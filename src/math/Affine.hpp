@@ -0,0 +1,91 @@
+#pragma once
+
+#include <array>
+#include <span>
+
+#include "math/QuatBatch.hpp"
+#include "math/Quaternion.h"
+#include "math/Types.hpp"
+#include "math/Vec3Batch.hpp"
+
+namespace math {
+
+// An affine transform p -> linear * p + translation: a Mat4 whose bottom row is known to
+// be (0, 0, 0, 1), stored as the other three rows (the 3x4 layout GPUs take for instance
+// transforms). Model and view transforms never need the fourth row, so keeping them in
+// this form saves a quarter of the storage and of every composition, and each row is a
+// Vec4 so compose and transform stay four lanes wide; promote with ToMat4(), or with
+// Mat4 * Affine3, only where a projection joins the chain. Instantiated for float
+// (Affine3) and double (Affine3d).
+template <class T>
+struct TAffine3 {
+    // rows[r] = (m[0][r], m[1][r], m[2][r], m[3][r]) of the equivalent Mat4
+    std::array<TVec4<T>, 3> rows{TVec4<T>(1, 0, 0, 0), TVec4<T>(0, 1, 0, 0), TVec4<T>(0, 0, 1, 0)};
+
+    static TAffine3 FromLinear(const TMat3<T>& linear, const TVec3<T>& translation = TVec3<T>(0));
+    static TAffine3 Translation(const TVec3<T>& t) { return FromLinear(TMat3<T>(1), t); }
+    // Angle in radians about `axis` (need not be unit length), as glm::rotate.
+    static TAffine3 Rotation(T angle, const TVec3<T>& axis);
+    static TAffine3 Scale(const TVec3<T>& s);
+    // Drops the bottom row: only meaningful when it is (0, 0, 0, 1).
+    static TAffine3 FromMat4(const TMat4<T>& m);
+
+    TMat4<T> ToMat4() const;
+    TMat3<T> Linear() const;
+    TVec3<T> Offset() const { return {rows[0].w, rows[1].w, rows[2].w}; }
+
+    TVec3<T> TransformPoint(const TVec3<T>& p) const {
+        const TVec4<T> h(p, T(1));
+        return {glm::dot(rows[0], h), glm::dot(rows[1], h), glm::dot(rows[2], h)};
+    }
+    TVec3<T> TransformDirection(const TVec3<T>& d) const {
+        const TVec4<T> h(d, T(0));
+        return {glm::dot(rows[0], h), glm::dot(rows[1], h), glm::dot(rows[2], h)};
+    }
+
+    // General inverse (the linear part must be invertible).
+    TAffine3 Inverse() const;
+    // Inverse when the linear part is a rotation: a transpose, no division.
+    TAffine3 RigidInverse() const;
+    // transpose(inverse(linear)), for transforming normals; from cofactors, so it costs
+    // three cross products and a determinant instead of a general 3x3 inverse.
+    TMat3<T> NormalMatrix() const;
+};
+
+using Affine3 = TAffine3<float>;
+using Affine3d = TAffine3<double>;
+
+// a * b applies b first, then a (same order as Mat4 products): each row of the result
+// combines b's rows, 36 multiplies against a Mat4 product's 64.
+template <class T>
+TAffine3<T> operator*(const TAffine3<T>& a, const TAffine3<T>& b) {
+    const auto row = [&](const TVec4<T>& r) {
+        return b.rows[0] * r.x + b.rows[1] * r.y + b.rows[2] * r.z + TVec4<T>(0, 0, 0, r.w);
+    };
+    return {{row(a.rows[0]), row(a.rows[1]), row(a.rows[2])}};
+}
+
+// A projection (or any full 4x4) applied after an affine transform: 48 multiplies.
+template <class T>
+TMat4<T> operator*(const TMat4<T>& m, const TAffine3<T>& a);
+
+// The same transform in another scalar type, e.g. a double-precision chain rounded to float.
+template <class U, class T>
+TAffine3<U> affineCast(const TAffine3<T>& a) {
+    return {{TVec4<U>(a.rows[0]), TVec4<U>(a.rows[1]), TVec4<U>(a.rows[2])}};
+}
+
+// The rotation of a unit quaternion, as quatToMat4.
+Affine3 quatToAffine(const Quat& q);
+// out.size() must be at least q.size().
+void quatToAffine(const QuatBatch& q, std::span<Affine3> out);
+
+// View transform from the camera position, as lookAtMatrix: the Gram-Schmidt frame keeps it
+// orthonormal even when up is parallel to the view direction.
+Affine3 lookAtAffine(const Vec3& pos, const Vec3& target, const Vec3& up);
+
+// Batched transforms, lane-parallel; `out` is resized to match and may alias `in`.
+void transformPoints(const Affine3& a, const Vec3Batch& in, Vec3Batch& out);
+void transformDirections(const Affine3& a, const Vec3Batch& in, Vec3Batch& out);
+
+} // namespace math
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+namespace math {
+
+// Lanes processed per step by the batched kernels. 16 floats is one AVX-512 register
+// or two AVX2 registers; loops over a fixed lane count vectorize without intrinsics.
+constexpr std::size_t kSimdLanes = 16;
+constexpr std::size_t kSimdAlign = 64;
+
+constexpr std::size_t PadToLanes(std::size_t n) {
+    return (n + kSimdLanes - 1) / kSimdLanes * kSimdLanes;
+}
+
+template <class T, std::size_t Align = kSimdAlign>
+struct AlignedAllocator {
+    using value_type = T;
+
+    template <class U>
+    struct rebind {
+        using other = AlignedAllocator<U, Align>;
+    };
+
+    AlignedAllocator() = default;
+    template <class U>
+    constexpr AlignedAllocator(const AlignedAllocator<U, Align>&) noexcept {}
+
+    T* allocate(std::size_t n) {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{Align}));
+    }
+
+    void deallocate(T* p, std::size_t) noexcept {
+        ::operator delete(p, std::align_val_t{Align});
+    }
+
+    template <class U>
+    bool operator==(const AlignedAllocator<U, Align>&) const noexcept { return true; }
+};
+
+template <class T>
+using AlignedVector = std::vector<T, AlignedAllocator<T>>;
+
+// Calls body(i) for i in [0, n) as one SIMD loop. Kernels read and write lane i only,
+// so lanes are independent even when an output aliases an input (in-place updates);
+// `omp simd` states that, which the compiler can't prove across separate arrays.
+// Bodies should capture raw pointers by value and stay branch-free (selects, no libm
+// calls without a vector form such as std::floor/std::fmax) or the loop stays scalar.
+template <class Body>
+inline void ForEachLane(std::size_t n, Body&& body) {
+#pragma omp simd
+    for (std::size_t i = 0; i < n; ++i) {
+        body(i);
+    }
+}
+
+} // namespace math
@@ -7,6 +7,37 @@
 
 namespace math {
 
+namespace {
+
+// Row-major 3x3 times a vector, as used by both directions of BasisTransform.
+Vec3 Apply(const std::array<float, 9>& m, const Vec3& v) {
+    return {
+        m[0] * v.x + m[1] * v.y + m[2] * v.z,
+        m[3] * v.x + m[4] * v.y + m[5] * v.z,
+        m[6] * v.x + m[7] * v.y + m[8] * v.z
+    };
+}
+
+void ApplyBatch(const std::array<float, 9>& m, const Vec3Batch& in, Vec3Batch& out) {
+    if (out.size() != in.size() || out.paddedSize() != in.paddedSize()) {
+        out.resize(in.size());
+    }
+    const float* ix = in.x.data(); const float* iy = in.y.data(); const float* iz = in.z.data();
+    float* ox = out.x.data(); float* oy = out.y.data(); float* oz = out.z.data();
+    const float m0 = m[0], m1 = m[1], m2 = m[2];
+    const float m3 = m[3], m4 = m[4], m5 = m[5];
+    const float m6 = m[6], m7 = m[7], m8 = m[8];
+
+    ForEachLane(in.paddedSize(), [=](std::size_t i) {
+        const float x = ix[i], y = iy[i], z = iz[i];
+        ox[i] = m0 * x + m1 * y + m2 * z;
+        oy[i] = m3 * x + m4 * y + m5 * z;
+        oz[i] = m6 * x + m7 * y + m8 * z;
+    });
+}
+
+} // namespace
+
 float MaxAbsComponent(const Vec3& v) {
     return std::max({std::abs(v.x), std::abs(v.y), std::abs(v.z)});
 }
@@ -38,4 +69,41 @@ Vec3 FromCoords(const Vec3& e1,
     return e1 * c.x + e2 * c.y + e3 * c.z;
 }
 
+BasisTransform::BasisTransform(const Vec3& e1, const Vec3& e2, const Vec3& e3)
+    : forward_{e1.x, e2.x, e3.x,
+               e1.y, e2.y, e3.y,
+               e1.z, e2.z, e3.z} {
+    const Vec3 e2xe3 = glm::cross(e2, e3);
+    const Vec3 e3xe1 = glm::cross(e3, e1);
+    const Vec3 e1xe2 = glm::cross(e1, e2);
+
+    det_ = glm::dot(e1, e2xe3);
+    degenerate_ = std::abs(det_) < 1e-6f;
+    if (degenerate_) {
+        inverse_.fill(0.f);
+        return;
+    }
+
+    const float invDet = 1.f / det_;
+    inverse_ = {e2xe3.x * invDet, e2xe3.y * invDet, e2xe3.z * invDet,
+                e3xe1.x * invDet, e3xe1.y * invDet, e3xe1.z * invDet,
+                e1xe2.x * invDet, e1xe2.y * invDet, e1xe2.z * invDet};
+}
+
+Vec3 BasisTransform::ToCoords(const Vec3& w) const {
+    return Apply(inverse_, w);
+}
+
+Vec3 BasisTransform::FromCoords(const Vec3& c) const {
+    return Apply(forward_, c);
+}
+
+void BasisTransform::ToCoords(const Vec3Batch& w, Vec3Batch& out) const {
+    ApplyBatch(inverse_, w, out);
+}
+
+void BasisTransform::FromCoords(const Vec3Batch& c, Vec3Batch& out) const {
+    ApplyBatch(forward_, c, out);
+}
+
 } // namespace math
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <array>
+
 #include "math/Types.hpp"
+#include "math/Vec3Batch.hpp"
 
 namespace math {
 
@@ -18,4 +21,30 @@ Vec3 FromCoords(const Vec3& e1,
                 const Vec3& e3,
                 const Vec3& c);
 
+// Change of basis with the inverse computed once per basis, for converting many points.
+// A degenerate basis (|det| < 1e-6) is flagged; ToCoords then returns zero, like CoordsInBasis.
+class BasisTransform {
+public:
+    BasisTransform() = default; // standard basis
+    BasisTransform(const Vec3& e1, const Vec3& e2, const Vec3& e3);
+
+    bool IsDegenerate() const { return degenerate_; }
+    float Determinant() const { return det_; }
+
+    Vec3 ToCoords(const Vec3& w) const;
+    Vec3 FromCoords(const Vec3& c) const;
+
+    // Batched conversions; out is resized to match (and may not alias the input).
+    void ToCoords(const Vec3Batch& w, Vec3Batch& out) const;
+    void FromCoords(const Vec3Batch& c, Vec3Batch& out) const;
+
+private:
+    // Row-major 3x3: forward_ has the basis vectors as columns, inverse_ rows are
+    // (e2 x e3, e3 x e1, e1 x e2) / det, zero when degenerate.
+    std::array<float, 9> forward_{1, 0, 0, 0, 1, 0, 0, 0, 1};
+    std::array<float, 9> inverse_{1, 0, 0, 0, 1, 0, 0, 0, 1};
+    float det_{1.f};
+    bool degenerate_{false};
+};
+
 } // namespace math
@@ -1,5 +1,9 @@
 #pragma once
 
+#include <type_traits>
+
+#include "math/Affine.hpp"
+#include "math/Constexpr.hpp"
 #include "math/Types.hpp"
 
 namespace math {
@@ -11,11 +15,22 @@ namespace math {
         float radius{8.f};
 
         Vec3 Position() const;
+        // The view transform is affine; ViewMatrix() is the same promoted to a Mat4.
+        Affine3 View(bool useCustom = false) const;
         Mat4 ViewMatrix(bool useCustom = false) const;
     };
 
-    Mat4 lookAtMatrix(Vec3 pos, Vec3 target, Vec3 up);
+    // Constant-evaluated by cross products (cx::lookAt); at run time by the Gram-Schmidt
+    // frame, which also copes with up parallel to the view direction.
+    constexpr Mat4 lookAtMatrix(Vec3 pos, Vec3 target, Vec3 up) {
+        if (std::is_constant_evaluated()) {
+            return cx::lookAt(pos, target, up);
+        }
+        return lookAtAffine(pos, target, up).ToMat4();
+    }
 
-    Mat4 orthographic(const float& orthoSize, const float& aspect, const float& near, const float& far);
+    constexpr Mat4 orthographic(const float& orthoSize, const float& aspect, const float& near, const float& far) {
+        return cx::orthographic(orthoSize, aspect, near, far);
+    }
 
 } // namespace math
@@ -0,0 +1,212 @@
+#include "math/ConjugateGradient.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace math {
+
+namespace {
+
+// Dot products accumulate in double: float CG on a million unknowns otherwise loses the
+// last digits of the residual it is trying to drive down.
+template <class T>
+double Dot(std::span<const T> a, std::span<const T> b) {
+    double sum = 0.0;
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        sum += static_cast<double>(a[i]) * static_cast<double>(b[i]);
+    }
+    return sum;
+}
+
+// IC(0) of A + shift * diag(A) into `values`, on the pattern of `lower` (A's lower
+// triangle as CSR, so the diagonal is last in each row). False on a non-positive pivot.
+template <class T>
+bool FactorIC0(const SparseMatrix<T>& lower, std::vector<T>& values, T shift) {
+    const std::span<const std::uint32_t> offsets = lower.Offsets();
+    const std::span<const std::uint32_t> indices = lower.Indices();
+    const std::span<const T> a = lower.Values();
+    for (std::size_t i = 0; i < lower.Rows(); ++i) {
+        const std::uint32_t rowBegin = offsets[i];
+        const std::uint32_t diag = offsets[i + 1] - 1;
+        if (rowBegin > diag || indices[diag] != i) {
+            return false; // no diagonal entry
+        }
+        for (std::uint32_t p = rowBegin; p <= diag; ++p) {
+            const std::uint32_t k = indices[p];
+            // sum over j < k of L(i, j) L(k, j): merge the two sorted rows
+            double sum = 0.0;
+            std::uint32_t q = offsets[k];
+            const std::uint32_t kDiag = offsets[k + 1] - 1;
+            for (std::uint32_t s = rowBegin; s < p; ++s) {
+                while (q < kDiag && indices[q] < indices[s]) {
+                    ++q;
+                }
+                if (q < kDiag && indices[q] == indices[s]) {
+                    sum += static_cast<double>(values[s]) * static_cast<double>(values[q]);
+                }
+            }
+            if (p < diag) {
+                values[p] = static_cast<T>((static_cast<double>(a[p]) - sum) / static_cast<double>(values[kDiag]));
+            } else {
+                const double pivot = static_cast<double>(a[p]) * (1.0 + static_cast<double>(shift)) - sum;
+                if (!(pivot > 0.0)) {
+                    return false;
+                }
+                values[p] = static_cast<T>(std::sqrt(pivot));
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+template <class T>
+Preconditioner<T>::Preconditioner(const SparseMatrix<T>& A, PreconditionerKind kind) : kind_(kind) {
+    if (kind == PreconditionerKind::Jacobi) {
+        inverseDiagonal_ = A.Diagonal();
+        for (T& d : inverseDiagonal_) {
+            d = d != T{} ? T{1} / d : T{1};
+        }
+    } else if (kind == PreconditionerKind::IncompleteCholesky) {
+        std::vector<Triplet<T>> triplets;
+        triplets.reserve(A.NonZeros() / 2 + A.Rows());
+        const SparseMatrix<T> csr = A.WithLayout(Layout::RowMajor);
+        for (std::size_t r = 0; r < csr.Rows(); ++r) {
+            for (std::uint32_t p = csr.Offsets()[r]; p < csr.Offsets()[r + 1]; ++p) {
+                if (csr.Indices()[p] <= r) {
+                    triplets.push_back({static_cast<std::uint32_t>(r), csr.Indices()[p], csr.Values()[p]});
+                }
+            }
+        }
+        lower_ = SparseMatrix<T>::FromTriplets(A.Rows(), A.Cols(), triplets);
+        std::vector<T> values(lower_.NonZeros());
+        for (T shift : {T(0), T(1e-3), T(1e-2), T(1e-1), T(1)}) {
+            if (FactorIC0(lower_, values, shift)) {
+                shift_ = shift;
+                std::copy(values.begin(), values.end(), lower_.Values().begin());
+                return;
+            }
+        }
+        *this = Preconditioner(A, PreconditionerKind::Jacobi); // hopeless for IC(0): fall back
+    }
+}
+
+template <class T>
+void Preconditioner<T>::Apply(std::span<const T> r, std::span<T> z) const {
+    const std::size_t n = r.size();
+    switch (kind_) {
+        case PreconditionerKind::None:
+            std::copy(r.begin(), r.end(), z.begin());
+            return;
+        case PreconditionerKind::Jacobi:
+            for (std::size_t i = 0; i < n; ++i) {
+                z[i] = r[i] * inverseDiagonal_[i];
+            }
+            return;
+        case PreconditionerKind::IncompleteCholesky:
+            break;
+    }
+
+    // L y = r forward by rows, then L^T z = y backward as column updates on the same rows
+    const std::span<const std::uint32_t> offsets = lower_.Offsets();
+    const std::span<const std::uint32_t> indices = lower_.Indices();
+    const std::span<const T> values = lower_.Values();
+    for (std::size_t i = 0; i < n; ++i) {
+        const std::uint32_t diag = offsets[i + 1] - 1;
+        T sum = r[i];
+        for (std::uint32_t p = offsets[i]; p < diag; ++p) {
+            sum -= values[p] * z[indices[p]];
+        }
+        z[i] = sum / values[diag];
+    }
+    for (std::size_t i = n; i-- > 0;) {
+        const std::uint32_t diag = offsets[i + 1] - 1;
+        const T zi = z[i] / values[diag];
+        z[i] = zi;
+        for (std::uint32_t p = offsets[i]; p < diag; ++p) {
+            z[indices[p]] -= values[p] * zi;
+        }
+    }
+}
+
+template <class T>
+CgResult<T> conjugateGradient(const SparseMatrix<T>& A, std::span<const T> b, std::span<T> x,
+                              const CgSettings<T>& settings, const Preconditioner<T>& preconditioner) {
+    using Clock = std::chrono::steady_clock;
+    const auto start = Clock::now();
+    CgResult<T> result;
+    const std::size_t n = b.size();
+    if (A.Rows() != n || A.Cols() != n || x.size() != n) {
+        return result;
+    }
+
+    const double bNorm = std::sqrt(Dot<T>(b, b));
+    if (bNorm == 0.0) {
+        std::fill(x.begin(), x.end(), T{});
+        result.converged = true;
+        result.history.push_back(T{});
+        return result;
+    }
+
+    // r = b - A x
+    std::vector<T> r(n), z(n), p(n), Ap(n);
+    std::copy(b.begin(), b.end(), r.begin());
+    spmv<T>(A, x, r, T{-1}, T{1}, settings.threads);
+    double rNorm = std::sqrt(Dot<T>(r, r));
+    result.residual = static_cast<T>(rNorm / bNorm);
+    result.history.push_back(result.residual);
+    if (result.residual <= settings.tolerance) {
+        result.converged = true;
+        return result;
+    }
+
+    preconditioner.Apply(r, z);
+    std::copy(z.begin(), z.end(), p.begin());
+    double rz = Dot<T>(r, z);
+    while (result.iterations < settings.maxIterations) {
+        spmv<T>(A, p, Ap, T{1}, T{0}, settings.threads);
+        const double pAp = Dot<T>(p, Ap);
+        if (!(pAp > 0.0)) {
+            break; // A is not positive definite along p
+        }
+        const auto alpha = static_cast<T>(rz / pAp);
+        for (std::size_t i = 0; i < n; ++i) {
+            x[i] += alpha * p[i];
+            r[i] -= alpha * Ap[i];
+        }
+        ++result.iterations;
+        rNorm = std::sqrt(Dot<T>(r, r));
+        result.residual = static_cast<T>(rNorm / bNorm);
+        result.history.push_back(result.residual);
+        if (result.residual <= settings.tolerance) {
+            result.converged = true;
+            break;
+        }
+        if (settings.budgetMs > 0.0 &&
+            std::chrono::duration<double, std::milli>(Clock::now() - start).count() >= settings.budgetMs) {
+            result.outOfTime = true;
+            break;
+        }
+
+        preconditioner.Apply(r, z);
+        const double rzNext = Dot<T>(r, z);
+        const auto beta = static_cast<T>(rzNext / rz);
+        rz = rzNext;
+        for (std::size_t i = 0; i < n; ++i) {
+            p[i] = z[i] + beta * p[i];
+        }
+    }
+    return result;
+}
+
+template class Preconditioner<float>;
+template class Preconditioner<double>;
+template CgResult<float> conjugateGradient<float>(const SparseMatrix<float>&, std::span<const float>, std::span<float>,
+                                                  const CgSettings<float>&, const Preconditioner<float>&);
+template CgResult<double> conjugateGradient<double>(const SparseMatrix<double>&, std::span<const double>,
+                                                    std::span<double>, const CgSettings<double>&,
+                                                    const Preconditioner<double>&);
+
+} // namespace math
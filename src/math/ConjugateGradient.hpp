@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "math/Sparse.hpp"
+
+namespace math {
+
+enum class PreconditionerKind {
+    None,
+    Jacobi,            // z = r / diag(A): free to build, helps when the diagonal varies
+    IncompleteCholesky // IC(0): A ~ L L^T on A's own lower pattern, two triangular solves per apply
+};
+
+// M^-1 for preconditioned CG, built once per matrix. IC(0) breaks down on matrices that are
+// positive definite but not diagonally dominant enough; it is then retried on A + shift *
+// diag(A) with a growing shift, which keeps it usable as a preconditioner (Shift() reports it).
+template <class T>
+class Preconditioner {
+public:
+    Preconditioner() = default;
+    Preconditioner(const SparseMatrix<T>& A, PreconditionerKind kind);
+
+    PreconditionerKind Kind() const { return kind_; }
+    T Shift() const { return shift_; }
+    // z = M^-1 r; z may not alias r.
+    void Apply(std::span<const T> r, std::span<T> z) const;
+
+private:
+    PreconditionerKind kind_{PreconditionerKind::None};
+    std::vector<T> inverseDiagonal_; // Jacobi
+    SparseMatrix<T> lower_;          // IC(0): CSR, diagonal last in every row
+    T shift_{};
+};
+
+template <class T>
+struct CgSettings {
+    std::size_t maxIterations{1000};
+    T tolerance{T(1e-6)}; // on the relative residual |b - A x| / |b|
+    double budgetMs{0.0}; // wall-time limit; 0 for none. The iteration in flight finishes.
+    unsigned threads{0};  // for the SpMVs, as in spmv
+};
+
+template <class T>
+struct CgResult {
+    std::size_t iterations{};
+    T residual{};              // relative residual at exit
+    bool converged{false};
+    bool outOfTime{false};     // stopped by budgetMs
+    std::vector<T> history;    // relative residual before the first and after every iteration
+};
+
+// Preconditioned conjugate gradients for symmetric positive definite A (CSR). x holds the
+// starting guess on entry, so a solve can warm-start from the previous frame's solution or
+// continue one that ran out of time; it holds the latest iterate on exit.
+template <class T>
+CgResult<T> conjugateGradient(const SparseMatrix<T>& A, std::span<const T> b, std::span<T> x,
+                              const CgSettings<T>& settings, const Preconditioner<T>& preconditioner = {});
+
+} // namespace math
@@ -0,0 +1,302 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <type_traits>
+
+#include "math/Quaternion.h"
+#include "math/Types.hpp"
+
+// constexpr vector, matrix and quaternion math, for transforms, bases and meshes that are
+// fixed at compile time: `constexpr Mat4 P = cx::perspective(...)` is computed by the
+// compiler and lands in read-only data, and geometric identities can be checked with
+// static_assert.
+//
+// Only glm's constructors and const component access are used, which glm declares
+// constexpr; its operators and functions (glm::dot, Mat4 * Mat4, ...) are not guaranteed
+// to be, so everything here is written out on components. sqrt, sin and cos are series /
+// Newton iterations in double when constant-evaluated and the <cmath> functions at run
+// time, so the same call gives the same results either way to within a float ulp.
+// Calls are qualified (cx::dot) so that argument-dependent lookup cannot pick glm's or
+// Quaternion.h's overloads of the same names.
+
+namespace math::cx {
+
+inline constexpr float kPi = std::numbers::pi_v<float>;
+
+namespace detail {
+
+constexpr double sqrt(double x) {
+    if (x != x || x < 0.0) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    if (x == 0.0 || x == std::numeric_limits<double>::infinity()) {
+        return x;
+    }
+    // Newton from above decreases monotonically until it stalls at the root
+    double r = x > 1.0 ? x : 1.0;
+    for (;;) {
+        const double next = 0.5 * (r + x / r);
+        if (next >= r) {
+            return r;
+        }
+        r = next;
+    }
+}
+
+// Taylor series, accurate to double precision on [-pi/2, pi/2]
+constexpr double sinSeries(double x) {
+    const double x2 = x * x;
+    double term = x;
+    double sum = x;
+    for (int k = 1; k <= 12; ++k) {
+        term *= -x2 / static_cast<double>((2 * k) * (2 * k + 1));
+        sum += term;
+    }
+    return sum;
+}
+
+constexpr double sin(double x) {
+    // Into [-pi, pi], then by symmetry into [-pi/2, pi/2]
+    constexpr double pi = std::numbers::pi;
+    const double turns = x / (2.0 * pi);
+    const auto n = static_cast<long long>(turns < 0.0 ? turns - 0.5 : turns + 0.5);
+    double r = x - static_cast<double>(n) * 2.0 * pi;
+    if (r > pi / 2) {
+        r = pi - r;
+    } else if (r < -pi / 2) {
+        r = -pi - r;
+    }
+    return sinSeries(r);
+}
+
+constexpr float abs(float x) { return x < 0.f ? -x : x; }
+
+} // namespace detail
+
+// ---- Scalars ----
+
+constexpr float sqrt(float x) {
+    if (!std::is_constant_evaluated()) {
+        return std::sqrt(x);
+    }
+    return static_cast<float>(detail::sqrt(x));
+}
+
+constexpr float sin(float x) {
+    if (!std::is_constant_evaluated()) {
+        return std::sin(x);
+    }
+    return static_cast<float>(detail::sin(x));
+}
+
+constexpr float cos(float x) {
+    if (!std::is_constant_evaluated()) {
+        return std::cos(x);
+    }
+    return static_cast<float>(detail::sin(static_cast<double>(x) + std::numbers::pi / 2));
+}
+
+constexpr float tan(float x) {
+    if (!std::is_constant_evaluated()) {
+        return std::tan(x);
+    }
+    return static_cast<float>(detail::sin(x) / detail::sin(static_cast<double>(x) + std::numbers::pi / 2));
+}
+
+constexpr float radians(float degrees) { return degrees * (kPi / 180.f); }
+
+// ---- Vectors ----
+
+constexpr float dot(const Vec3& a, const Vec3& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+constexpr float dot(const Vec4& a, const Vec4& b) { return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w; }
+
+constexpr Vec3 cross(const Vec3& a, const Vec3& b) {
+    return {a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x};
+}
+
+constexpr Vec3 add(const Vec3& a, const Vec3& b) { return {a.x + b.x, a.y + b.y, a.z + b.z}; }
+constexpr Vec3 sub(const Vec3& a, const Vec3& b) { return {a.x - b.x, a.y - b.y, a.z - b.z}; }
+constexpr Vec3 scale(const Vec3& v, float s) { return {v.x * s, v.y * s, v.z * s}; }
+
+constexpr float length(const Vec3& v) { return sqrt(cx::dot(v, v)); }
+
+constexpr Vec3 normalize(const Vec3& v) {
+    const float len = cx::length(v);
+    return {v.x / len, v.y / len, v.z / len};
+}
+
+// Right-handed orthonormal frame {t, b, n} around unit n with no branch on n's direction
+// other than its sign (Duff et al. 2017), e.g. a tangent frame for a fixed surface normal.
+constexpr std::array<Vec3, 3> orthonormalBasis(const Vec3& n) {
+    const float sign = n.z < 0.f ? -1.f : 1.f;
+    const float a = -1.f / (sign + n.z);
+    const float b = n.x * n.y * a;
+    return {Vec3{1.f + sign * n.x * n.x * a, sign * b, -sign * n.x},
+            Vec3{b, sign + n.y * n.y * a, -n.y},
+            n};
+}
+
+// ---- Matrices (column-major, m[c][r] as glm) ----
+
+constexpr Vec3 mul(const Mat3& m, const Vec3& v) {
+    return {m[0][0] * v.x + m[1][0] * v.y + m[2][0] * v.z,
+            m[0][1] * v.x + m[1][1] * v.y + m[2][1] * v.z,
+            m[0][2] * v.x + m[1][2] * v.y + m[2][2] * v.z};
+}
+
+constexpr Vec4 mul(const Mat4& m, const Vec4& v) {
+    return {m[0][0] * v.x + m[1][0] * v.y + m[2][0] * v.z + m[3][0] * v.w,
+            m[0][1] * v.x + m[1][1] * v.y + m[2][1] * v.z + m[3][1] * v.w,
+            m[0][2] * v.x + m[1][2] * v.y + m[2][2] * v.z + m[3][2] * v.w,
+            m[0][3] * v.x + m[1][3] * v.y + m[2][3] * v.z + m[3][3] * v.w};
+}
+
+constexpr Mat3 mul(const Mat3& a, const Mat3& b) { return {mul(a, b[0]), mul(a, b[1]), mul(a, b[2])}; }
+constexpr Mat4 mul(const Mat4& a, const Mat4& b) { return {mul(a, b[0]), mul(a, b[1]), mul(a, b[2]), mul(a, b[3])}; }
+
+constexpr Vec3 transformPoint(const Mat4& m, const Vec3& p) {
+    const Vec4 h = mul(m, Vec4(p.x, p.y, p.z, 1.f));
+    return {h.x, h.y, h.z};
+}
+
+constexpr Mat3 transpose(const Mat3& m) {
+    return {Vec3(m[0][0], m[1][0], m[2][0]), Vec3(m[0][1], m[1][1], m[2][1]), Vec3(m[0][2], m[1][2], m[2][2])};
+}
+
+constexpr Mat4 transpose(const Mat4& m) {
+    return {Vec4(m[0][0], m[1][0], m[2][0], m[3][0]), Vec4(m[0][1], m[1][1], m[2][1], m[3][1]),
+            Vec4(m[0][2], m[1][2], m[2][2], m[3][2]), Vec4(m[0][3], m[1][3], m[2][3], m[3][3])};
+}
+
+constexpr float determinant(const Mat3& m) { return cx::dot(m[0], cx::cross(m[1], m[2])); }
+
+constexpr Mat4 translation(const Vec3& t) {
+    return {Vec4(1.f, 0.f, 0.f, 0.f), Vec4(0.f, 1.f, 0.f, 0.f), Vec4(0.f, 0.f, 1.f, 0.f), Vec4(t.x, t.y, t.z, 1.f)};
+}
+
+constexpr Mat4 scaling(const Vec3& s) {
+    return {Vec4(s.x, 0.f, 0.f, 0.f), Vec4(0.f, s.y, 0.f, 0.f), Vec4(0.f, 0.f, s.z, 0.f), Vec4(0.f, 0.f, 0.f, 1.f)};
+}
+
+// Angle in radians about `axis` (need not be unit length), as glm::rotate(Mat4(1), ...).
+constexpr Mat4 rotation(float angle, const Vec3& axis) {
+    const Vec3 a = cx::normalize(axis);
+    const float c = cos(angle);
+    const float s = sin(angle);
+    const Vec3 t = scale(a, 1.f - c);
+    return {Vec4(c + t.x * a.x, t.x * a.y + s * a.z, t.x * a.z - s * a.y, 0.f),
+            Vec4(t.y * a.x - s * a.z, c + t.y * a.y, t.y * a.z + s * a.x, 0.f),
+            Vec4(t.z * a.x + s * a.y, t.z * a.y - s * a.x, c + t.z * a.z, 0.f),
+            Vec4(0.f, 0.f, 0.f, 1.f)};
+}
+
+// As glm::perspective (right-handed, clip z in [-w, w]).
+constexpr Mat4 perspective(float fovy, float aspect, float near, float far) {
+    const float t = tan(fovy * 0.5f);
+    return {Vec4(1.f / (aspect * t), 0.f, 0.f, 0.f),
+            Vec4(0.f, 1.f / t, 0.f, 0.f),
+            Vec4(0.f, 0.f, -(far + near) / (far - near), -1.f),
+            Vec4(0.f, 0.f, -(2.f * far * near) / (far - near), 0.f)};
+}
+
+// As math::orthographic: a box of half-height orthoSize centred on the view axis.
+constexpr Mat4 orthographic(float orthoSize, float aspect, float near, float far) {
+    return {Vec4(1.f / (orthoSize * aspect), 0.f, 0.f, 0.f),
+            Vec4(0.f, 1.f / orthoSize, 0.f, 0.f),
+            Vec4(0.f, 0.f, -2.f / (far - near), 0.f),
+            Vec4(0.f, 0.f, -(far + near) / (far - near), 1.f)};
+}
+
+// As glm::lookAt; up must not be parallel to the view direction.
+constexpr Mat4 lookAt(const Vec3& eye, const Vec3& target, const Vec3& up) {
+    const Vec3 f = cx::normalize(sub(target, eye));
+    const Vec3 s = cx::normalize(cx::cross(f, up));
+    const Vec3 u = cx::cross(s, f);
+    return {Vec4(s.x, u.x, -f.x, 0.f),
+            Vec4(s.y, u.y, -f.y, 0.f),
+            Vec4(s.z, u.z, -f.z, 0.f),
+            Vec4(-cx::dot(s, eye), -cx::dot(u, eye), cx::dot(f, eye), 1.f)};
+}
+
+// ---- Quaternions (Quat is w, x, y, z as in Quaternion.h) ----
+
+constexpr Quat multiply(const Quat& a, const Quat& b) {
+    return {a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z,
+            a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+            a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+            a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w};
+}
+
+constexpr Quat conjugate(const Quat& q) { return {q.w, -q.x, -q.y, -q.z}; }
+
+constexpr float norm(const Quat& q) { return sqrt(q.w * q.w + q.x * q.x + q.y * q.y + q.z * q.z); }
+
+// Identity for a (near) zero quaternion, as math::normalize.
+constexpr Quat normalize(const Quat& q) {
+    const float n = cx::norm(q);
+    if (n < 1e-8f) {
+        return {1.f, 0.f, 0.f, 0.f};
+    }
+    return {q.w / n, q.x / n, q.y / n, q.z / n};
+}
+
+constexpr Quat fromAxisAngle(const Vec3& axis, float theta) {
+    const float len = cx::length(axis);
+    if (len < 1e-8f) {
+        return {1.f, 0.f, 0.f, 0.f};
+    }
+    const float s = sin(theta * 0.5f) / len;
+    return {cos(theta * 0.5f), axis.x * s, axis.y * s, axis.z * s};
+}
+
+// q v q* for unit q.
+constexpr Vec3 rotate(const Quat& q, const Vec3& v) {
+    const Quat r = cx::multiply(cx::multiply(q, Quat{0.f, v.x, v.y, v.z}), cx::conjugate(q));
+    return {r.x, r.y, r.z};
+}
+
+constexpr Mat3 quatToMat3(const Quat& q) {
+    return {Vec3(1 - 2 * (q.y * q.y + q.z * q.z), 2 * (q.x * q.y + q.w * q.z), 2 * (q.x * q.z - q.w * q.y)),
+            Vec3(2 * (q.x * q.y - q.w * q.z), 1 - 2 * (q.x * q.x + q.z * q.z), 2 * (q.y * q.z + q.w * q.x)),
+            Vec3(2 * (q.x * q.z + q.w * q.y), 2 * (q.y * q.z - q.w * q.x), 1 - 2 * (q.x * q.x + q.y * q.y))};
+}
+
+constexpr Mat4 quatToMat4(const Quat& q) {
+    const Mat3 r = quatToMat3(q);
+    return {Vec4(r[0][0], r[0][1], r[0][2], 0.f), Vec4(r[1][0], r[1][1], r[1][2], 0.f),
+            Vec4(r[2][0], r[2][1], r[2][2], 0.f), Vec4(0.f, 0.f, 0.f, 1.f)};
+}
+
+// ---- Comparisons, for static_assert ----
+
+constexpr bool approxEqual(float a, float b, float eps = 1e-5f) { return detail::abs(a - b) <= eps; }
+
+constexpr bool approxEqual(const Vec3& a, const Vec3& b, float eps = 1e-5f) {
+    return approxEqual(a.x, b.x, eps) && approxEqual(a.y, b.y, eps) && approxEqual(a.z, b.z, eps);
+}
+
+constexpr bool approxEqual(const Vec4& a, const Vec4& b, float eps = 1e-5f) {
+    return approxEqual(a.x, b.x, eps) && approxEqual(a.y, b.y, eps) && approxEqual(a.z, b.z, eps) &&
+           approxEqual(a.w, b.w, eps);
+}
+
+constexpr bool approxEqual(const Mat3& a, const Mat3& b, float eps = 1e-5f) {
+    return approxEqual(a[0], b[0], eps) && approxEqual(a[1], b[1], eps) && approxEqual(a[2], b[2], eps);
+}
+
+constexpr bool approxEqual(const Mat4& a, const Mat4& b, float eps = 1e-5f) {
+    return approxEqual(a[0], b[0], eps) && approxEqual(a[1], b[1], eps) && approxEqual(a[2], b[2], eps) &&
+           approxEqual(a[3], b[3], eps);
+}
+
+// Columns orthonormal to within eps.
+constexpr bool isOrthonormal(const Mat3& m, float eps = 1e-5f) {
+    return approxEqual(cx::dot(m[0], m[0]), 1.f, eps) && approxEqual(cx::dot(m[1], m[1]), 1.f, eps) &&
+           approxEqual(cx::dot(m[2], m[2]), 1.f, eps) && approxEqual(cx::dot(m[0], m[1]), 0.f, eps) &&
+           approxEqual(cx::dot(m[0], m[2]), 0.f, eps) && approxEqual(cx::dot(m[1], m[2]), 0.f, eps);
+}
+
+} // namespace math::cx
@@ -0,0 +1,49 @@
+#include "math/ConvexHull.hpp"
+
+#include <algorithm>
+
+namespace math {
+
+namespace {
+
+// > 0 when o -> a -> b turns counter-clockwise
+float cross(const glm::vec2& o, const glm::vec2& a, const glm::vec2& b) {
+    return (a.x - o.x) * (b.y - o.y) - (a.y - o.y) * (b.x - o.x);
+}
+
+} // namespace
+
+std::vector<glm::vec2> convexHull(std::span<const glm::vec2> points) {
+    std::vector<glm::vec2> sorted(points.begin(), points.end());
+    std::ranges::sort(sorted, [](const glm::vec2& a, const glm::vec2& b) {
+        return a.x < b.x || (a.x == b.x && a.y < b.y);
+    });
+    const auto dup = std::ranges::unique(sorted, [](const glm::vec2& a, const glm::vec2& b) {
+        return a.x == b.x && a.y == b.y;
+    });
+    sorted.erase(dup.begin(), dup.end());
+    if (sorted.size() < 3) {
+        return sorted;
+    }
+
+    // Lower chain left to right, then upper chain right to left, popping non-left turns
+    std::vector<glm::vec2> hull(2 * sorted.size());
+    std::size_t k = 0;
+    for (const glm::vec2& p : sorted) {
+        while (k >= 2 && cross(hull[k - 2], hull[k - 1], p) <= 0.f) {
+            --k;
+        }
+        hull[k++] = p;
+    }
+    const std::size_t lower = k + 1;
+    for (std::size_t i = sorted.size() - 1; i-- > 0;) {
+        while (k >= lower && cross(hull[k - 2], hull[k - 1], sorted[i]) <= 0.f) {
+            --k;
+        }
+        hull[k++] = sorted[i];
+    }
+    hull.resize(k - 1); // the last point repeats the first
+    return hull;
+}
+
+} // namespace math
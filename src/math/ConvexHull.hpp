@@ -0,0 +1,16 @@
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+namespace math {
+
+// Convex hull of 2D points by Andrew's monotone chain, O(n log n). Returns the hull
+// vertices counter-clockwise (for y up; clockwise on screen where y points down),
+// without repeating the first point and without collinear points. Fewer than three
+// distinct input points come back as they are, deduplicated.
+std::vector<glm::vec2> convexHull(std::span<const glm::vec2> points);
+
+} // namespace math
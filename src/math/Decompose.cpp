@@ -0,0 +1,438 @@
+#include "math/Decompose.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace math {
+
+namespace {
+
+// Columns per panel: the panel is factored with scalar loops, the rest of the work
+// (the trailing update) goes through gemm
+constexpr std::size_t kPanel = 64;
+// Width of the gemm calls splitting Cholesky's symmetric trailing update
+constexpr std::size_t kTrailingColumns = 256;
+
+template <class T>
+Matrix<T> InLayout(Matrix<T>&& A, Layout layout) {
+    return A.GetLayout() == layout ? std::move(A) : A.WithLayout(layout);
+}
+
+template <class T>
+void BeginTrace(FactorTrace<T>* trace, const Matrix<T>& A) {
+    if (!trace) {
+        return;
+    }
+    *trace = {};
+    trace->rows = A.Rows();
+    trace->cols = A.Cols();
+}
+
+template <class T>
+void Record(FactorTrace<T>* trace, const Matrix<T>& work, std::size_t column, std::size_t pivotRow, T pivot) {
+    if (!trace) {
+        return;
+    }
+    trace->steps.push_back({column, pivotRow, pivot});
+    if (work.Size() <= FactorTrace<T>::kMaxSnapshotElements) {
+        for (std::size_t r = 0; r < work.Rows(); ++r) {
+            for (std::size_t c = 0; c < work.Cols(); ++c) {
+                trace->snapshots.push_back(work(r, c));
+            }
+        }
+    }
+}
+
+// Reflector j of a QR factorization applied to the columns of B (rows j.. only).
+template <class T>
+void ApplyReflector(const QRFactors<T>& f, std::size_t j, MatrixRef<T> B) {
+    const T tau = f.tau[j];
+    if (tau == T{}) {
+        return;
+    }
+    const Matrix<T>& a = f.qr;
+    for (std::size_t c = 0; c < B.cols; ++c) {
+        T w = B(j, c);
+        for (std::size_t i = j + 1; i < a.Rows(); ++i) {
+            w += a(i, j) * B(i, c);
+        }
+        w *= tau;
+        B(j, c) -= w;
+        for (std::size_t i = j + 1; i < a.Rows(); ++i) {
+            B(i, c) -= w * a(i, j);
+        }
+    }
+}
+
+} // namespace
+
+template <class T>
+Matrix<T> FactorTrace<T>::Snapshot(std::size_t step) const {
+    if (!HasSnapshots() || step >= steps.size()) {
+        return {};
+    }
+    Matrix<T> m(rows, cols);
+    std::copy_n(&snapshots[step * rows * cols], rows * cols, m.Data());
+    return m;
+}
+
+template <class T>
+LUFactors<T> luFactor(Matrix<T> A, FactorTrace<T>* trace) {
+    LUFactors<T> f;
+    f.lu = InLayout(std::move(A), Layout::RowMajor);
+    Matrix<T>& a = f.lu;
+    const std::size_t m = a.Rows(), n = a.Cols(), steps = std::min(m, n);
+    f.pivots.resize(steps);
+    BeginTrace(trace, a);
+
+    for (std::size_t j0 = 0; j0 < steps; j0 += kPanel) {
+        const std::size_t j1 = std::min(steps, j0 + kPanel);
+
+        // Panel: unblocked elimination of columns j0..j1 over all rows below
+        for (std::size_t j = j0; j < j1; ++j) {
+            std::size_t p = j;
+            T best = std::abs(a(j, j));
+            for (std::size_t i = j + 1; i < m; ++i) {
+                if (std::abs(a(i, j)) > best) {
+                    best = std::abs(a(i, j));
+                    p = i;
+                }
+            }
+            f.pivots[j] = p;
+            if (p != j) {
+                // Whole rows: columns right of the panel have no pending updates from it yet
+                std::swap_ranges(&a(j, 0), &a(j, 0) + n, &a(p, 0));
+                ++f.swaps;
+            }
+
+            const T pivot = a(j, j);
+            if (pivot == T{}) {
+                f.singular = true; // the column is already zero below the diagonal
+            } else {
+                const T inv = T{1} / pivot;
+                for (std::size_t i = j + 1; i < m; ++i) {
+                    const T l = a(i, j) * inv;
+                    a(i, j) = l;
+                    T* row = &a(i, 0);
+                    const T* pivotRow = &a(j, 0);
+                    for (std::size_t c = j + 1; c < j1; ++c) {
+                        row[c] -= l * pivotRow[c];
+                    }
+                }
+            }
+            Record(trace, a, j, p, pivot);
+        }
+
+        if (j1 < n) {
+            // U12 = L11^-1 A12, then A22 -= L21 U12
+            for (std::size_t r = j0 + 1; r < j1; ++r) {
+                T* dst = &a(r, 0);
+                for (std::size_t i = j0; i < r; ++i) {
+                    const T l = a(r, i);
+                    const T* src = &a(i, 0);
+                    for (std::size_t c = j1; c < n; ++c) {
+                        dst[c] -= l * src[c];
+                    }
+                }
+            }
+            if (j1 < m) {
+                gemm<T>(a.Block(j1, j0, m - j1, j1 - j0), a.Block(j0, j1, j1 - j0, n - j1),
+                        a.Block(j1, j1, m - j1, n - j1), T{-1}, T{1});
+            }
+        }
+    }
+    return f;
+}
+
+template <class T>
+bool luSolve(const LUFactors<T>& f, Matrix<T>& B) {
+    const Matrix<T>& a = f.lu;
+    const std::size_t n = a.Rows();
+    if (f.singular || a.Cols() != n || B.Rows() != n) {
+        return false;
+    }
+    const std::size_t k = B.Cols();
+    for (std::size_t j = 0; j < n; ++j) {
+        if (f.pivots[j] != j) {
+            for (std::size_t c = 0; c < k; ++c) {
+                std::swap(B(j, c), B(f.pivots[j], c));
+            }
+        }
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t p = 0; p < i; ++p) {
+            const T l = a(i, p);
+            for (std::size_t c = 0; c < k; ++c) {
+                B(i, c) -= l * B(p, c);
+            }
+        }
+    }
+    for (std::size_t i = n; i-- > 0;) {
+        for (std::size_t p = i + 1; p < n; ++p) {
+            const T u = a(i, p);
+            for (std::size_t c = 0; c < k; ++c) {
+                B(i, c) -= u * B(p, c);
+            }
+        }
+        const T inv = T{1} / a(i, i);
+        for (std::size_t c = 0; c < k; ++c) {
+            B(i, c) *= inv;
+        }
+    }
+    return true;
+}
+
+template <class T>
+T luDeterminant(const LUFactors<T>& f) {
+    if (f.lu.Rows() != f.lu.Cols()) {
+        return T{};
+    }
+    T det = f.swaps % 2 ? T{-1} : T{1};
+    for (std::size_t i = 0; i < f.lu.Rows(); ++i) {
+        det *= f.lu(i, i);
+    }
+    return det;
+}
+
+template <class T>
+QRFactors<T> qrFactor(Matrix<T> A, FactorTrace<T>* trace) {
+    QRFactors<T> f;
+    f.qr = InLayout(std::move(A), Layout::ColMajor);
+    Matrix<T>& a = f.qr;
+    const std::size_t m = a.Rows(), n = a.Cols(), steps = std::min(m, n);
+    f.tau.assign(steps, T{});
+    BeginTrace(trace, a);
+
+    for (std::size_t j0 = 0; j0 < steps; j0 += kPanel) {
+        const std::size_t j1 = std::min(steps, j0 + kPanel);
+
+        for (std::size_t j = j0; j < j1; ++j) {
+            // Reflector zeroing column j below the diagonal (columns are contiguous)
+            T* col = &a(0, j);
+            T sigma{};
+            for (std::size_t i = j + 1; i < m; ++i) {
+                sigma += col[i] * col[i];
+            }
+            const T x0 = col[j];
+            T beta = x0;
+            T tau{};
+            if (sigma > T{}) {
+                const T norm = std::sqrt(x0 * x0 + sigma);
+                beta = x0 <= T{} ? norm : -norm; // opposite sign to x0: no cancellation
+                tau = (beta - x0) / beta;
+                const T scale = T{1} / (x0 - beta);
+                for (std::size_t i = j + 1; i < m; ++i) {
+                    col[i] *= scale;
+                }
+                col[j] = beta;
+            }
+            f.tau[j] = tau;
+
+            if (tau != T{}) {
+                for (std::size_t c = j + 1; c < j1; ++c) {
+                    T* cc = &a(0, c);
+                    T w = cc[j];
+                    for (std::size_t i = j + 1; i < m; ++i) {
+                        w += col[i] * cc[i];
+                    }
+                    w *= tau;
+                    cc[j] -= w;
+                    for (std::size_t i = j + 1; i < m; ++i) {
+                        cc[i] -= w * col[i];
+                    }
+                }
+            }
+            Record(trace, a, j, j, beta);
+        }
+
+        if (j1 < n) {
+            // H_j0 ... H_j1-1 = I - V T V^T; trailing A2 -= V (T^T (V^T A2))
+            const std::size_t nb = j1 - j0, rows = m - j0, rest = n - j1;
+            Matrix<T> V(rows, nb, Layout::ColMajor);
+            for (std::size_t c = 0; c < nb; ++c) {
+                V(c, c) = T{1};
+                for (std::size_t i = c + 1; i < rows; ++i) {
+                    V(i, c) = a(j0 + i, j0 + c);
+                }
+            }
+            Matrix<T> Tf(nb, nb, Layout::ColMajor);
+            std::vector<T> y(nb);
+            for (std::size_t i = 0; i < nb; ++i) {
+                const T tau = f.tau[j0 + i];
+                Tf(i, i) = tau;
+                for (std::size_t k = 0; k < i; ++k) {
+                    T dot{};
+                    for (std::size_t r = i; r < rows; ++r) {
+                        dot += V(r, k) * V(r, i);
+                    }
+                    y[k] = dot;
+                }
+                for (std::size_t k = 0; k < i; ++k) {
+                    T sum{};
+                    for (std::size_t l = k; l < i; ++l) {
+                        sum += Tf(k, l) * y[l];
+                    }
+                    Tf(k, i) = -tau * sum;
+                }
+            }
+
+            const MatrixRef<T> A2 = a.Block(j0, j1, rows, rest);
+            Matrix<T> W(nb, rest, Layout::ColMajor);
+            gemm<T>(V.Ref().Transposed(), A2, W.Ref());
+            for (std::size_t c = 0; c < rest; ++c) {
+                // W = T^T W, bottom row first so the rows it reads are still unmodified
+                for (std::size_t i = nb; i-- > 0;) {
+                    T sum{};
+                    for (std::size_t k = 0; k <= i; ++k) {
+                        sum += Tf(k, i) * W(k, c);
+                    }
+                    W(i, c) = sum;
+                }
+            }
+            gemm<T>(V.Ref(), W.Ref(), A2, T{-1}, T{1});
+        }
+    }
+    return f;
+}
+
+template <class T>
+bool qrSolve(const QRFactors<T>& f, Matrix<T>& B) {
+    const Matrix<T>& a = f.qr;
+    const std::size_t m = a.Rows(), n = a.Cols();
+    if (m < n || B.Rows() != m) {
+        return false;
+    }
+    for (std::size_t j = 0; j < n; ++j) {
+        if (a(j, j) == T{}) {
+            return false;
+        }
+    }
+    for (std::size_t j = 0; j < n; ++j) {
+        ApplyReflector(f, j, B.Ref());
+    }
+    for (std::size_t i = n; i-- > 0;) {
+        for (std::size_t c = 0; c < B.Cols(); ++c) {
+            T sum = B(i, c);
+            for (std::size_t p = i + 1; p < n; ++p) {
+                sum -= a(i, p) * B(p, c);
+            }
+            B(i, c) = sum / a(i, i);
+        }
+    }
+    return true;
+}
+
+template <class T>
+Matrix<T> qrQ(const QRFactors<T>& f) {
+    const std::size_t m = f.qr.Rows(), k = f.tau.size();
+    Matrix<T> Q(m, k, Layout::ColMajor);
+    for (std::size_t i = 0; i < k; ++i) {
+        Q(i, i) = T{1};
+    }
+    for (std::size_t j = k; j-- > 0;) {
+        ApplyReflector(f, j, Q.Ref());
+    }
+    return Q;
+}
+
+template <class T>
+CholeskyFactors<T> choleskyFactor(Matrix<T> A, FactorTrace<T>* trace) {
+    CholeskyFactors<T> f;
+    f.l = InLayout(std::move(A), Layout::RowMajor);
+    Matrix<T>& a = f.l;
+    const std::size_t n = a.Rows();
+    if (a.Cols() != n) {
+        return f;
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        std::fill(&a(i, 0) + i + 1, &a(i, 0) + n, T{});
+    }
+    BeginTrace(trace, a);
+
+    for (std::size_t j0 = 0; j0 < n; j0 += kPanel) {
+        const std::size_t j1 = std::min(n, j0 + kPanel);
+
+        // Panel: the diagonal block and everything below it, column by column
+        for (std::size_t j = j0; j < j1; ++j) {
+            const T d = a(j, j);
+            if (!(d > T{})) {
+                Record(trace, a, j, j, d);
+                return f;
+            }
+            const T l = std::sqrt(d);
+            a(j, j) = l;
+            const T inv = T{1} / l;
+            for (std::size_t i = j + 1; i < n; ++i) {
+                a(i, j) *= inv;
+            }
+            for (std::size_t i = j + 1; i < n; ++i) {
+                const T lij = a(i, j);
+                T* row = &a(i, 0);
+                const std::size_t end = std::min(j1, i + 1);
+                for (std::size_t c = j + 1; c < end; ++c) {
+                    row[c] -= lij * a(c, j);
+                }
+            }
+            Record(trace, a, j, j, l);
+        }
+
+        // A22 -= L21 L21^T, lower half only: one gemm per block column of A22, from its
+        // diagonal block down (the few upper elements this touches are cleared at the end)
+        const MatrixRef<T> L21 = a.Block(0, j0, n, j1 - j0);
+        for (std::size_t c0 = j1; c0 < n; c0 += kTrailingColumns) {
+            const std::size_t c1 = std::min(n, c0 + kTrailingColumns);
+            gemm<T>(L21.Block(c0, 0, n - c0, j1 - j0), L21.Block(c0, 0, c1 - c0, j1 - j0).Transposed(),
+                    a.Block(c0, c0, n - c0, c1 - c0), T{-1}, T{1});
+        }
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        std::fill(&a(i, 0) + i + 1, &a(i, 0) + n, T{});
+    }
+    f.ok = true;
+    return f;
+}
+
+template <class T>
+bool choleskySolve(const CholeskyFactors<T>& f, Matrix<T>& B) {
+    const Matrix<T>& l = f.l;
+    const std::size_t n = l.Rows();
+    if (!f.ok || B.Rows() != n) {
+        return false;
+    }
+    for (std::size_t c = 0; c < B.Cols(); ++c) {
+        for (std::size_t i = 0; i < n; ++i) {
+            T sum = B(i, c);
+            for (std::size_t p = 0; p < i; ++p) {
+                sum -= l(i, p) * B(p, c);
+            }
+            B(i, c) = sum / l(i, i);
+        }
+        for (std::size_t i = n; i-- > 0;) {
+            T sum = B(i, c);
+            for (std::size_t p = i + 1; p < n; ++p) {
+                sum -= l(p, i) * B(p, c);
+            }
+            B(i, c) = sum / l(i, i);
+        }
+    }
+    return true;
+}
+
+#define LINALG_INSTANTIATE_DECOMPOSE(T)                                              \
+    template struct FactorTrace<T>;                                                  \
+    template LUFactors<T> luFactor<T>(Matrix<T>, FactorTrace<T>*);                   \
+    template bool luSolve<T>(const LUFactors<T>&, Matrix<T>&);                       \
+    template T luDeterminant<T>(const LUFactors<T>&);                                \
+    template QRFactors<T> qrFactor<T>(Matrix<T>, FactorTrace<T>*);                   \
+    template bool qrSolve<T>(const QRFactors<T>&, Matrix<T>&);                       \
+    template Matrix<T> qrQ<T>(const QRFactors<T>&);                                  \
+    template CholeskyFactors<T> choleskyFactor<T>(Matrix<T>, FactorTrace<T>*);       \
+    template bool choleskySolve<T>(const CholeskyFactors<T>&, Matrix<T>&);
+
+LINALG_INSTANTIATE_DECOMPOSE(float)
+LINALG_INSTANTIATE_DECOMPOSE(double)
+
+#undef LINALG_INSTANTIATE_DECOMPOSE
+
+} // namespace math
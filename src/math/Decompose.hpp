@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "math/Matrix.hpp"
+
+namespace math {
+
+// One step of a factorization as recorded for the UI: the column it finished and its pivot.
+template <class T>
+struct FactorStep {
+    std::size_t column{};
+    std::size_t pivotRow{}; // LU: the row swapped into place (== column when none); otherwise column
+    T pivot{};              // LU: U(k,k); Cholesky: L(k,k); QR: R(k,k)
+};
+
+// Steps of a factorization, one per column. Small matrices (up to kMaxSnapshotElements)
+// also keep the working matrix after every step, so the UI can scrub through the
+// elimination; larger ones record the pivots only.
+template <class T>
+struct FactorTrace {
+    static constexpr std::size_t kMaxSnapshotElements = 256;
+
+    std::size_t rows{}, cols{};
+    std::vector<FactorStep<T>> steps;
+    std::vector<T> snapshots; // rows * cols per step, row-major; empty when too large
+
+    bool HasSnapshots() const { return !snapshots.empty(); }
+    // Working matrix after `step` (row-major); empty without snapshots.
+    Matrix<T> Snapshot(std::size_t step) const;
+};
+
+// PA = LU with partial pivoting, stored packed: U on and above the diagonal, L (unit
+// diagonal implied) below. pivots[k] is the row swapped with row k at step k.
+template <class T>
+struct LUFactors {
+    Matrix<T> lu;
+    std::vector<std::size_t> pivots;
+    int swaps{};
+    bool singular{false}; // an exactly zero pivot; solves fail, the determinant is 0
+};
+
+// A = QR by Householder reflections H_k = I - tau_k v_k v_k^T. qr holds R on and above the
+// diagonal and v_k below it (v_k(k) = 1 implied). Column-major.
+template <class T>
+struct QRFactors {
+    Matrix<T> qr;
+    std::vector<T> tau;
+};
+
+// A = L L^T for symmetric positive definite A; only A's lower triangle is read.
+template <class T>
+struct CholeskyFactors {
+    Matrix<T> l;     // lower triangular, zeros above
+    bool ok{false};  // false when A is not positive definite (l is then partial)
+};
+
+// Square or rectangular A, any layout. Blocked right-looking elimination: panels of 64
+// columns are factored in place, then the trailing matrix is updated with gemm (threaded
+// for large sizes). Pass a trace to record the steps.
+template <class T>
+LUFactors<T> luFactor(Matrix<T> A, FactorTrace<T>* trace = nullptr);
+// Solves A X = B in place (B is n x k). False when A is singular or the sizes don't match.
+template <class T>
+bool luSolve(const LUFactors<T>& f, Matrix<T>& B);
+template <class T>
+T luDeterminant(const LUFactors<T>& f);
+
+// Blocked Householder QR: each panel's reflectors are combined into I - V T V^T (compact WY)
+// and applied to the trailing columns with two gemm calls.
+template <class T>
+QRFactors<T> qrFactor(Matrix<T> A, FactorTrace<T>* trace = nullptr);
+// Least-squares solution of A x = B (A is m x n, m >= n) in the first n rows of B, which
+// is overwritten with Q^T B. False when R has a zero on its diagonal.
+template <class T>
+bool qrSolve(const QRFactors<T>& f, Matrix<T>& B);
+// The m x min(m, n) Q with orthonormal columns.
+template <class T>
+Matrix<T> qrQ(const QRFactors<T>& f);
+
+// Blocked right-looking Cholesky with gemm trailing updates.
+template <class T>
+CholeskyFactors<T> choleskyFactor(Matrix<T> A, FactorTrace<T>* trace = nullptr);
+// Solves A X = B in place. False when the factorization failed or the sizes don't match.
+template <class T>
+bool choleskySolve(const CholeskyFactors<T>& f, Matrix<T>& B);
+
+} // namespace math
@@ -0,0 +1,80 @@
+#include "math/DualQuat.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace math {
+
+namespace {
+
+Vec3 vecPart(const Quat& q) {
+    return {q.x, q.y, q.z};
+}
+
+} // namespace
+
+DualQuat fromRotationTranslation(const Quat& r, const Vec3& t) {
+    const Quat tq{0, t.x, t.y, t.z};
+    return {r, multiply(tq, r) * 0.5f};
+}
+
+DualQuat multiply(const DualQuat& a, const DualQuat& b) {
+    return {
+        multiply(a.real, b.real),
+        multiply(a.real, b.dual) + multiply(a.dual, b.real)
+    };
+}
+
+DualQuat normalize(const DualQuat& dq) {
+    const float n = norm(dq.real);
+    if (n < 1e-8f) return {};
+    const float inv = 1.f / n;
+    return {dq.real * inv, dq.dual * inv};
+}
+
+DualQuat inverse(const DualQuat& dq) {
+    return {conjugate(dq.real), conjugate(dq.dual)};
+}
+
+Vec3 translation(const DualQuat& dq) {
+    // t = 2 * dual * conj(real)
+    const Quat t = multiply(dq.dual, conjugate(dq.real)) * 2.f;
+    return {t.x, t.y, t.z};
+}
+
+Vec3 transformVector(const DualQuat& dq, const Vec3& v) {
+    // v + 2 r x (r x v + w v), i.e. the quaternion sandwich without building a matrix
+    const Vec3 r = vecPart(dq.real);
+    return v + 2.f * glm::cross(r, glm::cross(r, v) + dq.real.w * v);
+}
+
+Vec3 transformPoint(const DualQuat& dq, const Vec3& p) {
+    const Vec3 r = vecPart(dq.real);
+    const Vec3 d = vecPart(dq.dual);
+    const Vec3 t = 2.f * (dq.real.w * d - dq.dual.w * r + glm::cross(r, d));
+    return transformVector(dq, p) + t;
+}
+
+Mat4 dualQuatToMat4(const DualQuat& dq) {
+    Mat4 M = quatToMat4(dq.real);
+    const Vec3 t = translation(dq);
+    M[3] = Vec4(t, 1.f);
+    return M;
+}
+
+DualQuat blend(std::span<const DualQuat> transforms, std::span<const float> weights) {
+    const std::size_t n = std::min(transforms.size(), weights.size());
+    if (n == 0) return {};
+
+    const Quat& pivot = transforms[0].real;
+    DualQuat sum{{0, 0, 0, 0}, {0, 0, 0, 0}};
+    for (std::size_t i = 0; i < n; ++i) {
+        // q and -q are the same transform; blend them on the same side
+        const float w = dot(pivot, transforms[i].real) < 0.f ? -weights[i] : weights[i];
+        sum.real = sum.real + transforms[i].real * w;
+        sum.dual = sum.dual + transforms[i].dual * w;
+    }
+    return normalize(sum);
+}
+
+} // namespace math
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <span>
+
+#include "math/Quaternion.h"
+#include "math/Types.hpp"
+
+namespace math {
+
+// Rigid transform as a unit dual quaternion: real = rotation r, dual = 0.5 * t * r.
+// 8 floats per transform instead of 16, and blends without the shear/volume loss of
+// linearly blended matrices.
+struct DualQuat {
+    Quat real{1, 0, 0, 0};
+    Quat dual{0, 0, 0, 0};
+};
+
+// Rotate by r (unit), then translate by t.
+DualQuat fromRotationTranslation(const Quat& r, const Vec3& t);
+// Composition: multiply(a, b) applies b first, then a (same order as Mat4 products).
+DualQuat multiply(const DualQuat& a, const DualQuat& b);
+// Scales both parts so the real part is unit. The dual part is not re-orthogonalized.
+DualQuat normalize(const DualQuat& dq);
+// Inverse of a unit dual quaternion.
+DualQuat inverse(const DualQuat& dq);
+
+Vec3 translation(const DualQuat& dq);
+Vec3 transformPoint(const DualQuat& dq, const Vec3& p);
+Vec3 transformVector(const DualQuat& dq, const Vec3& v);
+Mat4 dualQuatToMat4(const DualQuat& dq);
+
+// Dual quaternion linear blending (DLB): weighted sum with every term flipped into the
+// hemisphere of the first, then normalized. Weights need not sum to 1.
+DualQuat blend(std::span<const DualQuat> transforms, std::span<const float> weights);
+
+} // namespace math
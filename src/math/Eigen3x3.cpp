@@ -0,0 +1,289 @@
+#include "math/Eigen3x3.hpp"
+
+#include <cmath>
+
+namespace math {
+
+namespace {
+
+// Row-major scratch matrices; every index below is a compile-time constant, so the lane
+// kernels keep all of it in registers. The helpers are forced inline and the sweeps are
+// written out: the lane loops only vectorize as one straight-line body.
+using Mat3x3 = float[3][3];
+
+// Jacobi rotation in the (p, q) plane zeroing a[p][q] (r is the remaining index),
+// accumulated into v's columns. tau / apq is written without dividing by apq:
+// t = sign(tau) 2 apq / (|tau| + sqrt(tau^2 + 4 apq^2)), the smaller root, which is 0
+// when apq is.
+template <int p, int q, int r>
+[[gnu::always_inline]] inline void JacobiRotate(Mat3x3& a, Mat3x3& v) {
+    // Converged entries are snapped to zero: squaring them would otherwise produce
+    // denormals, which cost more than the whole decomposition
+    const float tau = a[q][q] - a[p][p];
+    const float apq = std::fabs(a[p][q]) > 1e-10f * (std::fabs(a[p][p]) + std::fabs(a[q][q])) ? a[p][q] : 0.f;
+    const float sign = tau >= 0.f ? 1.f : -1.f;
+    const float den = std::fabs(tau) + std::sqrt(tau * tau + 4.f * apq * apq);
+    const float t = 2.f * sign * apq / (den > 1e-30f ? den : 1e-30f);
+    const float c = 1.f / std::sqrt(t * t + 1.f);
+    const float s = t * c;
+
+    a[p][p] -= t * apq;
+    a[q][q] += t * apq;
+    a[p][q] = a[q][p] = 0.f;
+    const float arp = a[r][p];
+    const float arq = a[r][q];
+    a[r][p] = a[p][r] = c * arp - s * arq;
+    a[r][q] = a[q][r] = s * arp + c * arq;
+    for (int k = 0; k < 3; ++k) {
+        const float vp = v[k][p];
+        const float vq = v[k][q];
+        v[k][p] = c * vp - s * vq;
+        v[k][q] = s * vp + c * vq;
+    }
+}
+
+// Orders d[i] >= d[j], swapping v's columns with selects. One of them is negated on a
+// swap so v stays a rotation.
+template <int i, int j>
+[[gnu::always_inline]] inline void SortPair(float (&d)[3], Mat3x3& v) {
+    const bool swap = d[j] > d[i];
+    const float di = d[i];
+    const float dj = d[j];
+    d[i] = swap ? dj : di;
+    d[j] = swap ? di : dj;
+    for (int k = 0; k < 3; ++k) {
+        const float vi = v[k][i];
+        const float vj = v[k][j];
+        v[k][i] = swap ? vj : vi;
+        v[k][j] = swap ? -vi : vj;
+    }
+}
+
+[[gnu::always_inline]] inline void Sweep(Mat3x3& a, Mat3x3& v) {
+    JacobiRotate<0, 1, 2>(a, v);
+    JacobiRotate<0, 2, 1>(a, v);
+    JacobiRotate<1, 2, 0>(a, v);
+}
+
+// Symmetric a (both triangles filled) -> descending values d, rotation v.
+[[gnu::always_inline]] inline void EigenLane(Mat3x3& a, float (&d)[3], Mat3x3& v) {
+    for (int r = 0; r < 3; ++r) {
+        for (int c = 0; c < 3; ++c) {
+            v[r][c] = r == c ? 1.f : 0.f;
+        }
+    }
+    Sweep(a, v);
+    Sweep(a, v);
+    Sweep(a, v);
+    Sweep(a, v);
+    Sweep(a, v);
+    d[0] = a[0][0];
+    d[1] = a[1][1];
+    d[2] = a[2][2];
+    SortPair<0, 1>(d, v);
+    SortPair<0, 2>(d, v);
+    SortPair<1, 2>(d, v);
+}
+
+// Givens rotation of rows p, q of b zeroing b[q][p]; u accumulates the transpose so
+// u * b is unchanged. Leaves b[p][p] >= 0.
+template <int p, int q>
+[[gnu::always_inline]] inline void GivensQR(Mat3x3& b, Mat3x3& u) {
+    const float x = b[p][p];
+    const float y = b[q][p];
+    const float r2 = x * x + y * y;
+    const bool ok = r2 > 1e-30f;
+    const float inv = 1.f / std::sqrt(ok ? r2 : 1.f);
+    const float c = ok ? x * inv : 1.f;
+    const float s = ok ? y * inv : 0.f;
+    for (int k = 0; k < 3; ++k) {
+        const float bp = b[p][k];
+        const float bq = b[q][k];
+        b[p][k] = c * bp + s * bq;
+        b[q][k] = c * bq - s * bp;
+        const float up = u[k][p];
+        const float uq = u[k][q];
+        u[k][p] = c * up + s * uq;
+        u[k][q] = c * uq - s * up;
+    }
+}
+
+[[gnu::always_inline]] inline void SvdLane(const Mat3x3& a, Mat3x3& u, float (&sigma)[3], Mat3x3& v) {
+    Mat3x3 ata;
+    for (int r = 0; r < 3; ++r) {
+        for (int c = 0; c < 3; ++c) {
+            ata[r][c] = a[0][r] * a[0][c] + a[1][r] * a[1][c] + a[2][r] * a[2][c];
+        }
+    }
+    float d[3];
+    EigenLane(ata, d, v);
+
+    Mat3x3 b; // A V: columns orthogonal, in descending length
+    for (int r = 0; r < 3; ++r) {
+        for (int c = 0; c < 3; ++c) {
+            b[r][c] = a[r][0] * v[0][c] + a[r][1] * v[1][c] + a[r][2] * v[2][c];
+            u[r][c] = r == c ? 1.f : 0.f;
+        }
+    }
+    GivensQR<0, 1>(b, u);
+    GivensQR<0, 2>(b, u);
+    GivensQR<1, 2>(b, u);
+    sigma[0] = b[0][0];
+    sigma[1] = b[1][1];
+    sigma[2] = b[2][2];
+}
+
+void ToScratch(const Mat3& m, Mat3x3& out) {
+    for (int r = 0; r < 3; ++r) {
+        for (int c = 0; c < 3; ++c) {
+            out[r][c] = m[c][r];
+        }
+    }
+}
+
+Mat3 FromScratch(const Mat3x3& m) {
+    Mat3 out;
+    for (int r = 0; r < 3; ++r) {
+        for (int c = 0; c < 3; ++c) {
+            out[c][r] = m[r][c];
+        }
+    }
+    return out;
+}
+
+// Raw column-major element pointers of a batch, captured by value in the lane loops.
+template <class F>
+struct Mat3Ptrs {
+    F* m[9];
+};
+
+Mat3Ptrs<const float> Pointers(const Mat3Batch& b) {
+    Mat3Ptrs<const float> p;
+    for (std::size_t k = 0; k < 9; ++k) {
+        p.m[k] = b.m[k].data();
+    }
+    return p;
+}
+
+Mat3Ptrs<float> Pointers(Mat3Batch& b) {
+    Mat3Ptrs<float> p;
+    for (std::size_t k = 0; k < 9; ++k) {
+        p.m[k] = b.m[k].data();
+    }
+    return p;
+}
+
+void EnsureSize(Mat3Batch& out, std::size_t n) {
+    if (out.size() != n || out.paddedSize() != PadToLanes(n)) {
+        out.resize(n);
+    }
+}
+
+void EnsureSize(Vec3Batch& out, std::size_t n) {
+    if (out.size() != n || out.paddedSize() != PadToLanes(n)) {
+        out.resize(n);
+    }
+}
+
+} // namespace
+
+SymmetricEigen3 symmetricEigen(const Mat3& A) {
+    Mat3x3 a;
+    ToScratch(A, a);
+    a[0][1] = a[1][0];
+    a[0][2] = a[2][0];
+    a[1][2] = a[2][1];
+    float d[3];
+    Mat3x3 v;
+    EigenLane(a, d, v);
+    return {{d[0], d[1], d[2]}, FromScratch(v)};
+}
+
+Svd3 svd(const Mat3& A) {
+    Mat3x3 a, u, v;
+    ToScratch(A, a);
+    float sigma[3];
+    SvdLane(a, u, sigma, v);
+    return {FromScratch(u), {sigma[0], sigma[1], sigma[2]}, FromScratch(v)};
+}
+
+Mat3 covariance(std::span<const Vec3> points) {
+    if (points.size() < 2) {
+        return Mat3(0.f);
+    }
+    Vec3 mean{0.f};
+    for (const Vec3& p : points) {
+        mean += p;
+    }
+    mean /= static_cast<float>(points.size());
+    Mat3 cov(0.f);
+    for (const Vec3& p : points) {
+        const Vec3 d = p - mean;
+        cov[0] += d * d.x;
+        cov[1] += d * d.y;
+        cov[2] += d * d.z;
+    }
+    const float inv = 1.f / static_cast<float>(points.size());
+    return Mat3(cov[0] * inv, cov[1] * inv, cov[2] * inv);
+}
+
+void symmetricEigen(const Mat3Batch& a, Vec3Batch& values, Mat3Batch& vectors) {
+    EnsureSize(values, a.size());
+    EnsureSize(vectors, a.size());
+    const auto in = Pointers(a);
+    const auto out = Pointers(vectors);
+    float* vx = values.x.data(); float* vy = values.y.data(); float* vz = values.z.data();
+
+    ForEachLane(a.paddedSize(), [=](std::size_t i) {
+        // Lower triangle, mirrored
+        Mat3x3 s;
+        for (int r = 0; r < 3; ++r) {
+            for (int c = 0; c < 3; ++c) {
+                s[r][c] = c <= r ? in.m[c * 3 + r][i] : in.m[r * 3 + c][i];
+            }
+        }
+        float d[3];
+        Mat3x3 v;
+        EigenLane(s, d, v);
+        vx[i] = d[0];
+        vy[i] = d[1];
+        vz[i] = d[2];
+        for (int r = 0; r < 3; ++r) {
+            for (int c = 0; c < 3; ++c) {
+                out.m[c * 3 + r][i] = v[r][c];
+            }
+        }
+    });
+}
+
+void svd(const Mat3Batch& a, Mat3Batch& u, Vec3Batch& sigma, Mat3Batch& v) {
+    EnsureSize(u, a.size());
+    EnsureSize(sigma, a.size());
+    EnsureSize(v, a.size());
+    const auto in = Pointers(a);
+    const auto uOut = Pointers(u);
+    const auto vOut = Pointers(v);
+    float* sx = sigma.x.data(); float* sy = sigma.y.data(); float* sz = sigma.z.data();
+
+    ForEachLane(a.paddedSize(), [=](std::size_t i) {
+        Mat3x3 m, um, vm;
+        for (int r = 0; r < 3; ++r) {
+            for (int c = 0; c < 3; ++c) {
+                m[r][c] = in.m[c * 3 + r][i];
+            }
+        }
+        float s[3];
+        SvdLane(m, um, s, vm);
+        sx[i] = s[0];
+        sy[i] = s[1];
+        sz[i] = s[2];
+        for (int r = 0; r < 3; ++r) {
+            for (int c = 0; c < 3; ++c) {
+                uOut.m[c * 3 + r][i] = um[r][c];
+                vOut.m[c * 3 + r][i] = vm[r][c];
+            }
+        }
+    });
+}
+
+} // namespace math
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <span>
+
+#include "math/Mat3Batch.hpp"
+#include "math/Types.hpp"
+#include "math/Vec3Batch.hpp"
+
+namespace math {
+
+// Eigen decomposition of a symmetric 3x3: A = V diag(values) V^T. Values are in
+// descending order; V's columns are the unit eigenvectors and V is a rotation (det +1).
+struct SymmetricEigen3 {
+    Vec3 values{};
+    Mat3 vectors{1.f};
+};
+
+// Singular value decomposition A = U diag(sigma) V^T with U and V rotations. |sigma| is
+// in descending order; sigma.x and sigma.y are >= 0 and sigma.z carries the sign of
+// det A, so a reflection shows up as a negative smallest value instead of in U or V.
+struct Svd3 {
+    Mat3 u{1.f};
+    Vec3 sigma{};
+    Mat3 v{1.f};
+};
+
+// Cyclic Jacobi with a fixed number of sweeps (5, enough for float precision on any
+// input) and branch-free rotations and sorting, so the batched versions below are the
+// same arithmetic run lane-parallel. Only A's lower triangle is read.
+SymmetricEigen3 symmetricEigen(const Mat3& A);
+
+// Jacobi on A^T A for V, then Givens QR of A V for U and sigma (McAdams et al. 2011),
+// which stays well-defined for rank-deficient A where normalizing A V's columns fails.
+Svd3 svd(const Mat3& A);
+
+// Covariance of a point set about its mean (divided by the count), e.g. for the normal
+// and principal directions of a vertex neighborhood. Zero for fewer than two points.
+Mat3 covariance(std::span<const Vec3> points);
+
+// Lane-parallel counterparts; outputs are resized to match the input.
+void symmetricEigen(const Mat3Batch& a, Vec3Batch& values, Mat3Batch& vectors);
+void svd(const Mat3Batch& a, Mat3Batch& u, Vec3Batch& sigma, Mat3Batch& v);
+
+} // namespace math
@@ -0,0 +1,370 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "math/Types.hpp"
+#include "math/Vec3Batch.hpp"
+
+// Expression templates over float / Vec3 / Vec4 / Mat4.
+//
+// Operators on expressions build a tree instead of computing, and the tree is evaluated
+// element by element in one loop by eval() (a single value) or assign() (a span or a
+// Vec3Batch): `assign(out, lazy(a) * s + lazy(b) * t - c)` reads a, b and c once and
+// writes out once, with no whole-array temporaries in between. Each element is computed
+// with glm's own operators, and map() applies any other function (glm::normalize,
+// glm::cross, ...) per element, so everything glm can do stays available in a fused loop.
+//
+// Matrix chains are evaluated in the cheaper order for their use: applied to a single
+// vector, `lazy(P) * V * M * p` runs right to left as three matrix-vector products instead
+// of two 4x4 products and one matrix-vector product; applied to a sequence, the chain is
+// multiplied out once and each element costs a single matrix-vector product.
+//
+// Expressions copy scalar and vector constants but refer to arrays (by span) and matrices
+// (by pointer), so an expression kept past its statement needs those to outlive it; a
+// chain over a temporary matrix, `lazy(P * V)`, must be evaluated in the same statement.
+// Evaluation only reads element i to write element i, so `assign(x, lazy(x) * 2.f)` is safe.
+
+namespace math::expr {
+
+// Per-element value types of the leaves
+template <class T>
+concept Element = std::is_same_v<T, float> || std::is_same_v<T, Vec3> || std::is_same_v<T, Vec4>;
+
+template <class E>
+concept Expression = requires { typename std::remove_cvref_t<E>::IsExpression; };
+
+template <class E>
+concept MatrixExpression = requires { typename std::remove_cvref_t<E>::IsMatrixExpression; };
+
+// ---- Leaves ----
+
+// One value for every element, whatever the length.
+template <Element V>
+struct Constant {
+    using IsExpression = void;
+    using Value = V;
+    static constexpr bool kUniform = true;
+
+    V value;
+
+    bool Covers(std::size_t) const { return true; }
+    V operator[](std::size_t) const { return value; }
+};
+
+// One value per element, read from contiguous storage.
+template <Element V>
+struct Sequence {
+    using IsExpression = void;
+    using Value = V;
+    static constexpr bool kUniform = false;
+
+    std::span<const V> values;
+
+    bool Covers(std::size_t n) const { return values.size() >= n; }
+    V operator[](std::size_t i) const { return values[i]; }
+};
+
+// One Vec3 per element, gathered from a structure-of-arrays batch.
+struct Lanes {
+    using IsExpression = void;
+    using Value = Vec3;
+    static constexpr bool kUniform = false;
+
+    const Vec3Batch* batch;
+
+    bool Covers(std::size_t n) const { return batch->size() >= n; }
+    Vec3 operator[](std::size_t i) const { return {batch->x[i], batch->y[i], batch->z[i]}; }
+};
+
+// ---- Nodes ----
+
+struct Add {
+    template <class A, class B>
+    static auto Apply(const A& a, const B& b) { return a + b; }
+};
+struct Subtract {
+    template <class A, class B>
+    static auto Apply(const A& a, const B& b) { return a - b; }
+};
+struct Multiply {
+    template <class A, class B>
+    static auto Apply(const A& a, const B& b) { return a * b; }
+};
+struct Divide {
+    template <class A, class B>
+    static auto Apply(const A& a, const B& b) { return a / b; }
+};
+
+template <class Op, Expression L, Expression R>
+struct Binary {
+    using IsExpression = void;
+    using Value = decltype(Op::Apply(std::declval<typename L::Value>(), std::declval<typename R::Value>()));
+    static constexpr bool kUniform = L::kUniform && R::kUniform;
+
+    L left;
+    R right;
+
+    // True when every array in the tree holds at least n elements; constants fit any length
+    bool Covers(std::size_t n) const { return left.Covers(n) && right.Covers(n); }
+    Value operator[](std::size_t i) const { return Op::Apply(left[i], right[i]); }
+};
+
+template <Expression E>
+struct Negate {
+    using IsExpression = void;
+    using Value = typename E::Value;
+    static constexpr bool kUniform = E::kUniform;
+
+    E operand;
+
+    bool Covers(std::size_t n) const { return operand.Covers(n); }
+    Value operator[](std::size_t i) const { return -operand[i]; }
+};
+
+// f applied to the elements of each argument: the fallback to glm for everything else.
+template <class F, Expression... Es>
+struct Map {
+    using IsExpression = void;
+    using Value = std::invoke_result_t<const F&, typename Es::Value...>;
+    static constexpr bool kUniform = (Es::kUniform && ...);
+
+    F f;
+    std::tuple<Es...> args;
+
+    bool Covers(std::size_t n) const {
+        return std::apply([n](const auto&... e) { return (e.Covers(n) && ...); }, args);
+    }
+    Value operator[](std::size_t i) const {
+        return std::apply([&](const auto&... e) { return std::invoke(f, e[i]...); }, args);
+    }
+};
+
+// ---- Matrix chains ----
+
+struct MatrixConstant {
+    using IsMatrixExpression = void;
+
+    const Mat4* value;
+
+    Mat4 Evaluate() const { return *value; }
+    Vec4 Apply(const Vec4& v) const { return *value * v; }
+};
+
+template <MatrixExpression L, MatrixExpression R>
+struct MatrixProduct {
+    using IsMatrixExpression = void;
+
+    L left;
+    R right;
+
+    Mat4 Evaluate() const { return left.Evaluate() * right.Evaluate(); }
+    Vec4 Apply(const Vec4& v) const { return left.Apply(right.Apply(v)); }
+};
+
+// A matrix chain applied to Vec4 elements; see the file comment for the evaluation order.
+template <MatrixExpression M, Expression E>
+struct Transformed {
+    using IsExpression = void;
+    using Value = Vec4;
+    static constexpr bool kUniform = E::kUniform;
+
+    M chain;
+    E vector;
+    std::conditional_t<kUniform, M, Mat4> collapsed; // the chain multiplied out for sequences
+
+    Transformed(const M& m, const E& e) : chain(m), vector(e), collapsed(Collapse(m)) {}
+
+    bool Covers(std::size_t n) const { return vector.Covers(n); }
+    Vec4 operator[](std::size_t i) const {
+        if constexpr (kUniform) {
+            return chain.Apply(vector[i]);
+        } else {
+            return collapsed * vector[i];
+        }
+    }
+
+private:
+    static auto Collapse(const M& m) {
+        if constexpr (kUniform) {
+            return m;
+        } else {
+            return m.Evaluate();
+        }
+    }
+};
+
+// ---- Building expressions ----
+
+template <Element V>
+Constant<V> lazy(const V& value) {
+    return {value};
+}
+
+template <Element V>
+Sequence<V> lazy(std::span<const V> values) {
+    return {values};
+}
+
+template <Element V>
+Sequence<V> lazy(const std::vector<V>& values) {
+    return {std::span<const V>(values)};
+}
+
+inline Lanes lazy(const Vec3Batch& batch) {
+    return {&batch};
+}
+
+inline MatrixConstant lazy(const Mat4& m) {
+    return {&m};
+}
+
+namespace detail {
+
+template <class T>
+decltype(auto) AsExpression(const T& x) {
+    if constexpr (Expression<T>) {
+        return (x);
+    } else {
+        return Constant<T>{x};
+    }
+}
+
+template <class T>
+decltype(auto) AsMatrix(const T& x) {
+    if constexpr (MatrixExpression<T>) {
+        return (x);
+    } else {
+        return MatrixConstant{&x};
+    }
+}
+
+template <class T>
+using ExpressionOf = std::remove_cvref_t<decltype(AsExpression(std::declval<const T&>()))>;
+
+template <class T>
+using MatrixOf = std::remove_cvref_t<decltype(AsMatrix(std::declval<const T&>()))>;
+
+template <class T>
+concept Operand = Expression<T> || Element<T>;
+
+// At least one side must already be an expression, so plain glm arithmetic is untouched
+template <class A, class B>
+concept Operands = Operand<A> && Operand<B> && (Expression<A> || Expression<B>);
+
+template <class A, class B>
+concept MatrixOperands =
+    (MatrixExpression<A> || std::is_same_v<A, Mat4>) && (MatrixExpression<B> || std::is_same_v<B, Mat4>) &&
+    (MatrixExpression<A> || MatrixExpression<B>);
+
+template <class Op, class A, class B>
+auto MakeBinary(const A& a, const B& b) {
+    return Binary<Op, ExpressionOf<A>, ExpressionOf<B>>{AsExpression(a), AsExpression(b)};
+}
+
+} // namespace detail
+
+template <class A, class B>
+    requires detail::Operands<A, B>
+auto operator+(const A& a, const B& b) {
+    return detail::MakeBinary<Add>(a, b);
+}
+
+template <class A, class B>
+    requires detail::Operands<A, B>
+auto operator-(const A& a, const B& b) {
+    return detail::MakeBinary<Subtract>(a, b);
+}
+
+template <class A, class B>
+    requires detail::Operands<A, B>
+auto operator*(const A& a, const B& b) {
+    return detail::MakeBinary<Multiply>(a, b);
+}
+
+template <class A, class B>
+    requires detail::Operands<A, B>
+auto operator/(const A& a, const B& b) {
+    return detail::MakeBinary<Divide>(a, b);
+}
+
+template <Expression E>
+Negate<E> operator-(const E& e) {
+    return {e};
+}
+
+template <class A, class B>
+    requires detail::MatrixOperands<A, B>
+auto operator*(const A& a, const B& b) {
+    return MatrixProduct<detail::MatrixOf<A>, detail::MatrixOf<B>>{detail::AsMatrix(a), detail::AsMatrix(b)};
+}
+
+template <MatrixExpression M, class V>
+    requires(Expression<V> || std::is_same_v<V, Vec4>)
+auto operator*(const M& m, const V& v) {
+    return Transformed<M, detail::ExpressionOf<V>>(m, detail::AsExpression(v));
+}
+
+// f(elements...) per element; arguments may be expressions or plain values.
+template <class F, class... Args>
+auto map(F f, const Args&... args) {
+    return Map<F, detail::ExpressionOf<Args>...>{std::move(f), {detail::AsExpression(args)...}};
+}
+
+// Vec3 elements as homogeneous points (w = 1) or directions (w = 0).
+template <class E>
+auto point(const E& e) {
+    return map([](const Vec3& p) { return Vec4(p, 1.f); }, e);
+}
+
+template <class E>
+auto direction(const E& e) {
+    return map([](const Vec3& d) { return Vec4(d, 0.f); }, e);
+}
+
+// ---- Evaluation ----
+
+// The value of an expression made of constants only.
+template <Expression E>
+    requires E::kUniform
+typename E::Value eval(const E& e) {
+    return e[0];
+}
+
+template <MatrixExpression M>
+Mat4 eval(const M& m) {
+    return m.Evaluate();
+}
+
+// out[i] = e[i] for every element of out, in one pass. Every array in e must hold at least
+// out.size() elements (checked by assert in debug builds); longer arrays are read as prefixes.
+template <Expression E>
+void assign(std::span<typename E::Value> out, const E& e) {
+    assert(e.Covers(out.size()));
+    for (std::size_t i = 0; i < out.size(); ++i) {
+        out[i] = e[i];
+    }
+}
+
+template <Expression E>
+    requires std::is_same_v<typename E::Value, Vec3>
+void assign(Vec3Batch& out, const E& e) {
+    assert(e.Covers(out.size()));
+    float* x = out.x.data();
+    float* y = out.y.data();
+    float* z = out.z.data();
+    for (std::size_t i = 0; i < out.size(); ++i) {
+        const Vec3 v = e[i];
+        x[i] = v.x;
+        y[i] = v.y;
+        z[i] = v.z;
+    }
+}
+
+} // namespace math::expr
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <span>
+
+#include "math/Types.hpp"
+
+namespace math {
+
+// IEEE 754 binary16, for storage only: 11 significant bits and a range of +-65504, so
+// model-space positions and normals of a large vertex buffer fit in half the bytes and are
+// widened to float before any arithmetic. Conversion rounds to nearest even; values past
+// the range become infinity and tiny ones flush through the subnormals to zero.
+struct Half {
+    std::uint16_t bits{};
+};
+
+struct HalfVec3 {
+    Half x, y, z;
+};
+
+constexpr Half toHalf(float f) {
+    const auto x = std::bit_cast<std::uint32_t>(f);
+    const auto sign = static_cast<std::uint16_t>((x >> 16) & 0x8000u);
+    const std::uint32_t magnitude = x & 0x7fffffffu;
+    if (magnitude >= 0x7f800000u) { // infinity, or NaN (kept quiet)
+        return {static_cast<std::uint16_t>(sign | 0x7c00u | (magnitude > 0x7f800000u ? 0x200u : 0u))};
+    }
+    if (magnitude >= 0x477ff000u) { // rounds past 65504
+        return {static_cast<std::uint16_t>(sign | 0x7c00u)};
+    }
+    std::uint32_t h = 0;
+    std::uint32_t rest = 0;
+    std::uint32_t halfway = 0;
+    if (magnitude >= 0x38800000u) {
+        // Normal: rebias the exponent from 127 to 15 and drop 13 mantissa bits
+        h = (magnitude - 0x38000000u) >> 13;
+        rest = magnitude & 0x1fffu;
+        halfway = 0x1000u;
+    } else if (magnitude >= 0x33000000u) {
+        // Subnormal half, in units of 2^-24: the full significand shifted down
+        const std::uint32_t shift = 126u - (magnitude >> 23);
+        const std::uint32_t significand = (magnitude & 0x7fffffu) | 0x800000u;
+        h = significand >> shift;
+        rest = significand & ((1u << shift) - 1u);
+        halfway = 1u << (shift - 1u);
+    } else {
+        return {sign};
+    }
+    h += rest > halfway || (rest == halfway && (h & 1u)) ? 1u : 0u;
+    return {static_cast<std::uint16_t>(sign | h)};
+}
+
+// Branch-free so that batch loops vectorize: the exponent and mantissa bits move into
+// float position as they are, and a multiply by 2^112 rebiases the exponent from 15 to 127,
+// which also normalizes the subnormals. Infinity and NaN get the float exponent directly.
+constexpr float toFloat(Half h) {
+    const std::uint32_t sign = static_cast<std::uint32_t>(h.bits & 0x8000u) << 16;
+    const std::uint32_t magnitude = static_cast<std::uint32_t>(h.bits & 0x7fffu) << 13;
+    const float scaled = std::bit_cast<float>(magnitude) * 0x1p112f;
+    const std::uint32_t bits = magnitude >= (0x7c00u << 13) ? magnitude | 0x7f800000u : std::bit_cast<std::uint32_t>(scaled);
+    return std::bit_cast<float>(sign | bits);
+}
+
+constexpr HalfVec3 toHalf(const Vec3& v) { return {toHalf(v.x), toHalf(v.y), toHalf(v.z)}; }
+constexpr Vec3 toFloat(const HalfVec3& v) { return {toFloat(v.x), toFloat(v.y), toFloat(v.z)}; }
+
+// out.size() must be at least in.size().
+inline void toHalf(std::span<const Vec3> in, std::span<HalfVec3> out) {
+    for (std::size_t i = 0; i < in.size(); ++i) {
+        out[i] = toHalf(in[i]);
+    }
+}
+
+} // namespace math
@@ -0,0 +1,226 @@
+#include "math/LightClusters.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace math {
+
+float attenuation(const Light& light, float distance) {
+    if (light.type == LightType::Directional || light.range <= 0.f) {
+        return light.intensity;
+    }
+    const float ratio = distance / light.range;
+    const float window = std::clamp(1.f - ratio * ratio * ratio * ratio, 0.f, 1.f);
+    return light.intensity * window * window / (distance * distance + 1.f);
+}
+
+LightClusters::LightClusters(int tilesX, int tilesY, int slices)
+    : tilesX_(std::max(tilesX, 1)),
+      tilesY_(std::max(tilesY, 1)),
+      slices_(std::max(slices, 1)) {
+    offsets_.assign(static_cast<std::size_t>(ClusterCount()) + 1, 0);
+}
+
+int LightClusters::SliceOf(float depth) const {
+    const int s = static_cast<int>(std::log(depth / near_) * logScale_);
+    return std::clamp(s, 0, slices_ - 1);
+}
+
+float LightClusters::SliceDepth(int slice) const {
+    return near_ * std::exp(static_cast<float>(slice) / logScale_);
+}
+
+void LightClusters::BuildBounds() {
+    const Mat4& P = projection_;
+    // View-space x (or y) that projects to ndc at view depth d; P is a standard projection
+    // (no x/y cross terms), perspective or orthographic
+    const auto unproject = [&P](float ndc, float d, int axis) {
+        const float z = -d;
+        const float w = P[2][3] * z + P[3][3];
+        return (ndc * w - P[2][axis] * z - P[3][axis]) / P[axis][axis];
+    };
+
+    bounds_.resize(static_cast<std::size_t>(ClusterCount()));
+    for (int s = 0; s < slices_; ++s) {
+        const float d0 = SliceDepth(s);
+        const float d1 = SliceDepth(s + 1);
+        for (int ty = 0; ty < tilesY_; ++ty) {
+            for (int tx = 0; tx < tilesX_; ++tx) {
+                Bounds b{Vec3(1e30f), Vec3(-1e30f)};
+                for (int corner = 0; corner < 8; ++corner) {
+                    const float nx = 2.f * static_cast<float>(tx + (corner & 1)) / static_cast<float>(tilesX_) - 1.f;
+                    const float ny = 2.f * static_cast<float>(ty + ((corner >> 1) & 1)) / static_cast<float>(tilesY_) - 1.f;
+                    const float d = (corner & 4) ? d1 : d0;
+                    const Vec3 p{unproject(nx, d, 0), unproject(ny, d, 1), -d};
+                    b.min = glm::min(b.min, p);
+                    b.max = glm::max(b.max, p);
+                }
+                bounds_[static_cast<std::size_t>((s * tilesY_ + ty) * tilesX_ + tx)] = b;
+            }
+        }
+    }
+}
+
+void LightClusters::Build(std::span<const Light> lights, const Mat4& view, const Mat4& projection, float near, float far) {
+    if (bounds_.empty() || projection != projection_ || near != near_ || far != far_) {
+        projection_ = projection;
+        near_ = near;
+        far_ = far;
+        logScale_ = static_cast<float>(slices_) / std::log(far / near);
+        BuildBounds();
+    }
+
+    global_.clear();
+    indices_.clear();
+    maxPerCluster_ = 0;
+
+    // (cluster, light) pairs first, then a counting sort into CSR order
+    struct Pair {
+        std::uint32_t cluster;
+        std::uint32_t light;
+    };
+    std::vector<Pair> pairs;
+    std::vector<std::uint32_t> counts(static_cast<std::size_t>(ClusterCount()), 0);
+
+    for (std::size_t li = 0; li < lights.size(); ++li) {
+        const Light& light = lights[li];
+        const auto id = static_cast<std::uint32_t>(li);
+        if (light.type == LightType::Directional || light.range <= 0.f) {
+            global_.push_back(id);
+            continue;
+        }
+
+        const Vec3 c = Vec3(view * Vec4(light.position, 1.f));
+        const float r = light.range;
+        const float r2 = r * r;
+        const float depth = -c.z;
+        const float dMin = std::max(depth - r, near);
+        const float dMax = std::min(depth + r, far);
+        if (dMin > dMax) {
+            continue;
+        }
+
+        for (int s = SliceOf(dMin); s <= SliceOf(dMax); ++s) {
+            // Part of the sphere's bounding box inside this slice. Projected x/w and y/w are
+            // linear-fractional, so their extremes over the box are at its corners.
+            const float s0 = std::max(dMin, SliceDepth(s));
+            const float s1 = std::min(dMax, SliceDepth(s + 1));
+            float xMin = 1e30f, xMax = -1e30f, yMin = 1e30f, yMax = -1e30f;
+            for (int corner = 0; corner < 8; ++corner) {
+                const Vec4 p{
+                    (corner & 1) ? c.x + r : c.x - r,
+                    (corner & 2) ? c.y + r : c.y - r,
+                    (corner & 4) ? -s1 : -s0,
+                    1.f
+                };
+                const Vec4 clip = projection * p;
+                const float x = clip.x / clip.w;
+                const float y = clip.y / clip.w;
+                xMin = std::min(xMin, x);
+                xMax = std::max(xMax, x);
+                yMin = std::min(yMin, y);
+                yMax = std::max(yMax, y);
+            }
+            if (xMax < -1.f || xMin > 1.f || yMax < -1.f || yMin > 1.f) {
+                continue;
+            }
+
+            const auto tile = [](float ndc, int tiles) {
+                return std::clamp(static_cast<int>((ndc + 1.f) * 0.5f * static_cast<float>(tiles)), 0, tiles - 1);
+            };
+            for (int ty = tile(yMin, tilesY_); ty <= tile(yMax, tilesY_); ++ty) {
+                for (int tx = tile(xMin, tilesX_); tx <= tile(xMax, tilesX_); ++tx) {
+                    const auto cluster = static_cast<std::uint32_t>((s * tilesY_ + ty) * tilesX_ + tx);
+                    const Bounds& b = bounds_[cluster];
+                    const Vec3 closest = glm::clamp(c, b.min, b.max);
+                    const Vec3 delta = closest - c;
+                    if (glm::dot(delta, delta) > r2) {
+                        continue;
+                    }
+                    pairs.push_back({cluster, id});
+                    ++counts[cluster];
+                }
+            }
+        }
+    }
+
+    offsets_[0] = 0;
+    for (std::size_t k = 0; k < counts.size(); ++k) {
+        offsets_[k + 1] = offsets_[k] + counts[k];
+        maxPerCluster_ = std::max<std::size_t>(maxPerCluster_, counts[k]);
+    }
+    indices_.resize(pairs.size());
+    std::vector<std::uint32_t> cursor(offsets_.begin(), offsets_.end() - 1);
+    for (const Pair& pair : pairs) {
+        indices_[cursor[pair.cluster]++] = pair.light;
+    }
+}
+
+int LightClusters::ClusterIndex(const Vec3& viewPos) const {
+    const float depth = -viewPos.z;
+    if (!(depth >= near_ && depth <= far_)) {
+        return -1;
+    }
+    const Vec4 clip = projection_ * Vec4(viewPos, 1.f);
+    const float x = clip.x / clip.w;
+    const float y = clip.y / clip.w;
+    if (x < -1.f || x > 1.f || y < -1.f || y > 1.f) {
+        return -1;
+    }
+    const int tx = std::min(static_cast<int>((x + 1.f) * 0.5f * static_cast<float>(tilesX_)), tilesX_ - 1);
+    const int ty = std::min(static_cast<int>((y + 1.f) * 0.5f * static_cast<float>(tilesY_)), tilesY_ - 1);
+    return (SliceOf(depth) * tilesY_ + ty) * tilesX_ + tx;
+}
+
+std::span<const std::uint32_t> LightClusters::PointLights(int cluster) const {
+    if (cluster < 0 || cluster >= ClusterCount()) {
+        return {};
+    }
+    const auto k = static_cast<std::size_t>(cluster);
+    return std::span<const std::uint32_t>(indices_).subspan(offsets_[k], offsets_[k + 1] - offsets_[k]);
+}
+
+Vec3 shadeLights(const Vec3& p,
+                 const Vec3& n,
+                 const Vec3& eye,
+                 const PhongMaterial& material,
+                 const SpecularTable& specular,
+                 std::span<const Light> lights,
+                 const Vec3& ambient,
+                 std::span<const std::uint32_t> clusterIndices,
+                 std::span<const std::uint32_t> globalIndices) {
+    const Vec3 v = glm::normalize(eye - p);
+    Vec3 color = material.ka * material.color * ambient;
+
+    const auto addLight = [&](const Light& light, const Vec3& l, float att) {
+        const float ndl = glm::dot(n, l);
+        const float cosSpec = material.blinn ? glm::dot(n, glm::normalize(l + v))
+                                             : glm::dot(glm::reflect(-l, n), v);
+        const Vec3 radiance = light.color * att;
+        color += radiance * (material.kd * std::max(ndl, 0.f) * material.color +
+                             Vec3(material.ks * specular(cosSpec)));
+    };
+
+    const auto shade = [&](std::uint32_t i) {
+        const Light& light = lights[i];
+        if (light.type == LightType::Directional) {
+            addLight(light, -glm::normalize(light.direction), light.intensity);
+            return;
+        }
+        const Vec3 toLight = light.position - p;
+        const float d = glm::length(toLight);
+        const float att = attenuation(light, d);
+        if (att > 0.f && d > 0.f) {
+            addLight(light, toLight / d, att);
+        }
+    };
+    for (std::uint32_t i : clusterIndices) {
+        shade(i);
+    }
+    for (std::uint32_t i : globalIndices) {
+        shade(i);
+    }
+    return color;
+}
+
+} // namespace math
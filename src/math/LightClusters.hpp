@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "math/LightingBatch.hpp"
+#include "math/Types.hpp"
+
+namespace math {
+
+enum class LightType : std::uint8_t { Point, Directional };
+
+struct Light {
+    LightType type{LightType::Point};
+    Vec3 position{};            // point lights
+    Vec3 direction{0, -1, 0};   // directional lights: the direction the light travels
+    Vec3 color{1.f};
+    float intensity{1.f};
+    float range{10.f};          // point lights contribute nothing beyond this; <= 0: unbounded, no falloff
+};
+
+// Point-light falloff: inverse square, windowed to reach exactly zero at `range` so that
+// culling by range is exact rather than an approximation. Directional and unbounded point
+// lights return their intensity unchanged.
+float attenuation(const Light& light, float distance);
+
+// Surface response shared by every light (ambient is applied once, not per light).
+struct PhongMaterial {
+    Vec3 color{1.f};
+    float ka{0.1f};
+    float kd{0.7f};
+    float ks{0.5f};
+    bool blinn{false};
+};
+
+// View-frustum clusters ("froxels"): a tilesX x tilesY screen grid split into `slices`
+// depth ranges with exponential spacing. Build() assigns every point light to the clusters
+// its range sphere overlaps (screen-rect bound, then sphere vs cluster AABB in view space);
+// directional and unbounded lights go in one global list.
+class LightClusters {
+public:
+    explicit LightClusters(int tilesX = 16, int tilesY = 9, int slices = 24);
+
+    // view/projection as used for rendering; near/far bound the clustered depth range.
+    // Works for perspective and orthographic projections.
+    void Build(std::span<const Light> lights, const Mat4& view, const Mat4& projection, float near, float far);
+
+    // Cluster containing a view-space point, or -1 outside the clustered volume.
+    int ClusterIndex(const Vec3& viewPos) const;
+    // Indices into the lights passed to Build(). Empty for index -1.
+    std::span<const std::uint32_t> PointLights(int cluster) const;
+    std::span<const std::uint32_t> GlobalLights() const { return global_; }
+
+    int ClusterCount() const { return tilesX_ * tilesY_ * slices_; }
+    std::size_t Assignments() const { return indices_.size(); }
+    std::size_t MaxLightsPerCluster() const { return maxPerCluster_; }
+
+private:
+    struct Bounds {
+        Vec3 min;
+        Vec3 max;
+    };
+
+    int SliceOf(float depth) const;
+    float SliceDepth(int slice) const;
+    void BuildBounds();
+
+    int tilesX_, tilesY_, slices_;
+    Mat4 projection_{1.f};
+    float near_{0.1f};
+    float far_{100.f};
+    float logScale_{};                   // slices / log(far / near)
+    std::vector<Bounds> bounds_;         // view-space AABB per cluster, rebuilt when the projection changes
+    std::vector<std::uint32_t> offsets_; // ClusterCount() + 1, CSR-style into indices_
+    std::vector<std::uint32_t> indices_;
+    std::vector<std::uint32_t> global_;
+    std::size_t maxPerCluster_{};
+};
+
+// Phong/Blinn-Phong at world position p with unit normal n, summed over the given lights.
+// Pass a cluster's index lists for culled shading, or every index for brute force. The
+// ambient term, ka * color * ambient, is added once; pass the scene light's color as
+// `ambient` to match phongBatch, which scales ambient by its single light.
+Vec3 shadeLights(const Vec3& p,
+                 const Vec3& n,
+                 const Vec3& eye,
+                 const PhongMaterial& material,
+                 const SpecularTable& specular,
+                 std::span<const Light> lights,
+                 const Vec3& ambient,
+                 std::span<const std::uint32_t> clusterIndices,
+                 std::span<const std::uint32_t> globalIndices);
+
+} // namespace math
@@ -1,5 +1,7 @@
 #ifndef PROJECTION_3D_2D_LIGHTING_H
 #define PROJECTION_3D_2D_LIGHTING_H
+#include <array>
+
 #include "Types.hpp"
 
 namespace math {
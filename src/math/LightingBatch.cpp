@@ -0,0 +1,163 @@
+#include "math/LightingBatch.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace math {
+
+namespace {
+
+// PerItem reads color, ka, kd and ks from `materials` (one lane each) instead of params
+template <bool Blinn, bool PerItem>
+void ShadeLanes(const Vec3Batch& positions,
+                const Vec3Batch& normals,
+                const MaterialBatch* materials,
+                const ShadeParams& params,
+                const SpecularTable& specular,
+                std::uint8_t* rgba) {
+    const float* px = positions.x.data(); const float* py = positions.y.data(); const float* pz = positions.z.data();
+    const float* nx = normals.x.data(); const float* ny = normals.y.data(); const float* nz = normals.z.data();
+    const float* table = specular.Data();
+    const int last = specular.Size() - 1;
+    const float scale = static_cast<float>(last);
+
+    const float lx = params.lightPos.x, ly = params.lightPos.y, lz = params.lightPos.z;
+    const float ex = params.eye.x, ey = params.eye.y, ez = params.eye.z;
+    // Ambient and diffuse share materialColor * lightColor; specular is white times lightColor
+    const Vec3 base = params.materialColor * params.lightColor;
+    const float ar = params.ka * base.r, ag = params.ka * base.g, ab = params.ka * base.b;
+    const float dr = params.kd * base.r, dg = params.kd * base.g, db = params.kd * base.b;
+    const float sr = params.ks * params.lightColor.r;
+    const float sg = params.ks * params.lightColor.g;
+    const float sb = params.ks * params.lightColor.b;
+    const float lr = params.lightColor.r, lg = params.lightColor.g, lb = params.lightColor.b;
+    const float* mr = PerItem ? materials->color.x.data() : nullptr;
+    const float* mg = PerItem ? materials->color.y.data() : nullptr;
+    const float* mb = PerItem ? materials->color.z.data() : nullptr;
+    const float* mka = PerItem ? materials->ka.data() : nullptr;
+    const float* mkd = PerItem ? materials->kd.data() : nullptr;
+    const float* mks = PerItem ? materials->ks.data() : nullptr;
+
+    ForEachLane(positions.size(), [=](std::size_t i) {
+        // Light and view directions, normalized with a clamped reciprocal so no lane divides by 0
+        float Lx = lx - px[i], Ly = ly - py[i], Lz = lz - pz[i];
+        float Vx = ex - px[i], Vy = ey - py[i], Vz = ez - pz[i];
+        const float l2 = Lx * Lx + Ly * Ly + Lz * Lz;
+        const float v2 = Vx * Vx + Vy * Vy + Vz * Vz;
+        const float il = 1.f / std::sqrt(l2 > 1e-20f ? l2 : 1e-20f);
+        const float iv = 1.f / std::sqrt(v2 > 1e-20f ? v2 : 1e-20f);
+        Lx *= il; Ly *= il; Lz *= il;
+        Vx *= iv; Vy *= iv; Vz *= iv;
+
+        const float ndl = nx[i] * Lx + ny[i] * Ly + nz[i] * Lz;
+        const float diffuse = ndl > 0.f ? ndl : 0.f;
+
+        float cosSpec;
+        if constexpr (Blinn) {
+            const float Hx = Lx + Vx, Hy = Ly + Vy, Hz = Lz + Vz;
+            const float h2 = Hx * Hx + Hy * Hy + Hz * Hz;
+            const float ih = 1.f / std::sqrt(h2 > 1e-20f ? h2 : 1e-20f);
+            cosSpec = (nx[i] * Hx + ny[i] * Hy + nz[i] * Hz) * ih;
+        } else {
+            // r = reflect(-l, n) = 2 (n.l) n - l
+            const float Rx = 2.f * ndl * nx[i] - Lx;
+            const float Ry = 2.f * ndl * ny[i] - Ly;
+            const float Rz = 2.f * ndl * nz[i] - Lz;
+            cosSpec = Rx * Vx + Ry * Vy + Rz * Vz;
+        }
+        cosSpec = cosSpec > 0.f ? (cosSpec < 1.f ? cosSpec : 1.f) : 0.f;
+
+        // Table lookup with linear interpolation; the index is clamped so the +1 stays in range
+        const float t = cosSpec * scale;
+        const int k0 = static_cast<int>(t);
+        const int k = k0 < last ? k0 : last - 1;
+        const float f = t - static_cast<float>(k);
+        const float spec = table[k] + f * (table[k + 1] - table[k]);
+
+        float r, g, b;
+        if constexpr (PerItem) {
+            const float br = mr[i] * lr, bg = mg[i] * lg, bb = mb[i] * lb;
+            const float ambientDiffuse = mka[i] + mkd[i] * diffuse;
+            const float highlight = mks[i] * spec;
+            r = br * ambientDiffuse + lr * highlight;
+            g = bg * ambientDiffuse + lg * highlight;
+            b = bb * ambientDiffuse + lb * highlight;
+        } else {
+            r = ar + dr * diffuse + sr * spec;
+            g = ag + dg * diffuse + sg * spec;
+            b = ab + db * diffuse + sb * spec;
+        }
+
+        const float rc = r > 0.f ? (r < 1.f ? r : 1.f) : 0.f;
+        const float gc = g > 0.f ? (g < 1.f ? g : 1.f) : 0.f;
+        const float bc = b > 0.f ? (b < 1.f ? b : 1.f) : 0.f;
+        rgba[kRgba8Stride * i + 0] = static_cast<std::uint8_t>(rc * 255.f);
+        rgba[kRgba8Stride * i + 1] = static_cast<std::uint8_t>(gc * 255.f);
+        rgba[kRgba8Stride * i + 2] = static_cast<std::uint8_t>(bc * 255.f);
+        rgba[kRgba8Stride * i + 3] = 255;
+    });
+}
+
+} // namespace
+
+SpecularTable::SpecularTable(float exponent, int size)
+    : exponent_(exponent) {
+    size = std::max(size, 2);
+    values_.resize(static_cast<std::size_t>(size));
+    const float h = 1.f / static_cast<float>(size - 1);
+    for (int i = 0; i < size; ++i) {
+        values_[static_cast<std::size_t>(i)] = std::pow(static_cast<float>(i) * h, exponent);
+    }
+    // Linear interpolation errs by at most max|f''| h^2 / 8 on an interval. For exponent >= 2,
+    // |f''| = a (a - 1) x^(a - 2) peaks at x = 1. Below 2 it is unbounded near 0, so the first
+    // interval is bounded exactly instead: the chord t h^a against (t h)^a is off by
+    // h^a |t - t^a|, largest at t = a^(-1 / (a - 1)). The other intervals keep the h^2 / 8
+    // bound with |f''| taken at x = h, which gives a |a - 1| h^a / 8.
+    const float a = exponent;
+    if (a >= 2.f) {
+        maxError_ = a * (a - 1.f) * h * h / 8.f;
+    } else if (a == 1.f || a == 0.f) {
+        maxError_ = 0.f; // linear or constant: interpolation is exact
+    } else {
+        const float t = std::pow(a, -1.f / (a - 1.f));
+        const float first = std::pow(h, a) * std::fabs(t - std::pow(t, a));
+        const float rest = a * std::fabs(a - 1.f) * std::pow(h, a) / 8.f;
+        maxError_ = std::max(first, rest);
+    }
+}
+
+float SpecularTable::operator()(float x) const {
+    const int last = Size() - 1;
+    const float t = std::clamp(x, 0.f, 1.f) * static_cast<float>(last);
+    const int k = std::min(static_cast<int>(t), last - 1);
+    const float f = t - static_cast<float>(k);
+    const auto idx = static_cast<std::size_t>(k);
+    return values_[idx] + f * (values_[idx + 1] - values_[idx]);
+}
+
+void phongBatch(const Vec3Batch& positions,
+                const Vec3Batch& normals,
+                const ShadeParams& params,
+                const SpecularTable& specular,
+                std::span<std::uint8_t> rgba) {
+    if (params.blinn) {
+        ShadeLanes<true, false>(positions, normals, nullptr, params, specular, rgba.data());
+    } else {
+        ShadeLanes<false, false>(positions, normals, nullptr, params, specular, rgba.data());
+    }
+}
+
+void phongBatch(const Vec3Batch& positions,
+                const Vec3Batch& normals,
+                const MaterialBatch& materials,
+                const ShadeParams& params,
+                const SpecularTable& specular,
+                std::span<std::uint8_t> rgba) {
+    if (params.blinn) {
+        ShadeLanes<true, true>(positions, normals, &materials, params, specular, rgba.data());
+    } else {
+        ShadeLanes<false, true>(positions, normals, &materials, params, specular, rgba.data());
+    }
+}
+
+} // namespace math
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "math/Aligned.hpp"
+#include "math/Types.hpp"
+#include "math/Vec3Batch.hpp"
+
+namespace math {
+
+// x^exponent on [0, 1] sampled at `size` points and linearly interpolated, replacing
+// std::pow in the specular term. exponent must be >= 0. With h = 1/(size-1), the
+// interpolation error for exponents >= 2 is at most h^2/8 * max|f''|, i.e.
+// exponent*(exponent-1) / (8*(size-1)^2): below half an 8-bit step (1/510) for exponents
+// up to ~128 at the default size. Between 0 and 2, f'' is unbounded at 0 and the error
+// shrinks only like h^exponent, worst on the first interval; MaxError() reports it.
+class SpecularTable {
+public:
+    static constexpr int kDefaultSize = 1024;
+
+    explicit SpecularTable(float exponent = 32.f, int size = kDefaultSize);
+
+    float Exponent() const { return exponent_; }
+    float MaxError() const { return maxError_; }
+    int Size() const { return static_cast<int>(values_.size()); }
+    const float* Data() const { return values_.data(); }
+
+    // x is clamped to [0, 1].
+    float operator()(float x) const;
+
+private:
+    AlignedVector<float> values_;
+    float exponent_{};
+    float maxError_{};
+};
+
+// Per-item materials, structure-of-arrays like Vec3Batch: every array is padded to
+// kSimdLanes (padding zero), so the shading kernel loads them a lane block at a time.
+struct MaterialBatch {
+    Vec3Batch color;
+    AlignedVector<float> ka, kd, ks;
+
+    MaterialBatch() = default;
+    explicit MaterialBatch(std::size_t n) { resize(n); }
+
+    std::size_t size() const { return color.size(); }
+
+    // Resizes and zero-fills.
+    void resize(std::size_t n) {
+        color.resize(n);
+        ka.assign(color.paddedSize(), 0.f);
+        kd.assign(color.paddedSize(), 0.f);
+        ks.assign(color.paddedSize(), 0.f);
+    }
+
+    void set(std::size_t i, const Vec3& c, float ambient, float diffuse, float specular) {
+        color.set(i, c);
+        ka[i] = ambient;
+        kd[i] = diffuse;
+        ks[i] = specular;
+    }
+};
+
+// The light, the eye and the specular model; materialColor, ka, kd and ks are the material
+// of every item unless a MaterialBatch is given.
+struct ShadeParams {
+    Vec3 materialColor{1.f};
+    float ka{0.1f};
+    float kd{0.7f};
+    float ks{0.5f};
+    Vec3 lightPos{};
+    Vec3 lightColor{1.f};
+    Vec3 eye{};
+    bool blinn{false}; // half-vector specular (n.h) instead of reflection (r.v)
+};
+
+// Bytes per shaded item in the packed output: r, g, b, a, the layout of sf::Color and of
+// SFML's RGBA8 pixel buffers.
+constexpr std::size_t kRgba8Stride = 4;
+
+// Shades positions.size() surface points (unit normals) with one point light, the same
+// model as math::phong, and writes clamped, truncated RGBA8 (alpha 255) to rgba, which
+// must hold at least kRgba8Stride * positions.size() bytes.
+void phongBatch(const Vec3Batch& positions,
+                const Vec3Batch& normals,
+                const ShadeParams& params,
+                const SpecularTable& specular,
+                std::span<std::uint8_t> rgba);
+
+// The same with a material per item: materials.size() must be at least positions.size(),
+// and params' material fields are ignored. The specular exponent stays uniform, since it
+// selects the SpecularTable.
+void phongBatch(const Vec3Batch& positions,
+                const Vec3Batch& normals,
+                const MaterialBatch& materials,
+                const ShadeParams& params,
+                const SpecularTable& specular,
+                std::span<std::uint8_t> rgba);
+
+} // namespace math
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include "math/Aligned.hpp"
+#include "math/Types.hpp"
+
+namespace math {
+
+// Structure-of-arrays 3x3 matrices, one array per element, column-major like glm:
+// m[c * 3 + r] holds element (r, c). Padding lanes hold the identity so the kernels can
+// run whole lane blocks without producing NaNs.
+struct Mat3Batch {
+    std::array<AlignedVector<float>, 9> m;
+    std::size_t count{};
+
+    Mat3Batch() = default;
+    explicit Mat3Batch(std::size_t n) { resize(n); }
+
+    std::size_t size() const { return count; }
+    std::size_t paddedSize() const { return m[0].size(); }
+
+    // Resizes and fills with the identity.
+    void resize(std::size_t n) {
+        count = n;
+        const std::size_t padded = PadToLanes(n);
+        for (std::size_t k = 0; k < 9; ++k) {
+            m[k].assign(padded, k % 4 == 0 ? 1.f : 0.f);
+        }
+    }
+
+    void set(std::size_t i, const Mat3& a) {
+        for (int c = 0; c < 3; ++c) {
+            for (int r = 0; r < 3; ++r) {
+                m[static_cast<std::size_t>(c * 3 + r)][i] = a[c][r];
+            }
+        }
+    }
+
+    Mat3 get(std::size_t i) const {
+        Mat3 a;
+        for (int c = 0; c < 3; ++c) {
+            for (int r = 0; r < 3; ++r) {
+                a[c][r] = m[static_cast<std::size_t>(c * 3 + r)][i];
+            }
+        }
+        return a;
+    }
+};
+
+} // namespace math
@@ -0,0 +1,181 @@
+#include "math/Matrix.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include "math/Parallel.hpp"
+
+namespace math {
+
+namespace {
+
+// Register tile MR x NR: NR is one 64-byte vector row (16 floats / 8 doubles) so each
+// accumulator row is a whole number of SIMD registers, MR rows of those stay in registers.
+// KC x NR of packed B and MR x KC of packed A fit in L1; MC x KC of A in L2.
+template <class T>
+struct Blocking {
+    static constexpr std::size_t MR = 6;
+    static constexpr std::size_t NR = kSimdAlign / sizeof(T);
+    static constexpr std::size_t KC = 256;
+    static constexpr std::size_t MC = 96;
+    static constexpr std::size_t NC = 4096;
+};
+
+// Below this many multiply-adds the thread start-up costs more than it saves
+constexpr std::size_t kParallelWork = std::size_t{128} * 128 * 128;
+
+// A[i0 .. i0+mc, p0 .. p0+kc] as MR-row slivers: for each sliver, kc columns of MR values.
+// Rows past the edge are zero so the micro-kernel never needs a remainder path.
+template <class T>
+void PackA(MatrixRef<const T> A, std::size_t i0, std::size_t mc, std::size_t p0, std::size_t kc, T* out) {
+    constexpr std::size_t MR = Blocking<T>::MR;
+    for (std::size_t ir = 0; ir < mc; ir += MR) {
+        const std::size_t rows = std::min(MR, mc - ir);
+        for (std::size_t p = 0; p < kc; ++p) {
+            for (std::size_t r = 0; r < MR; ++r) {
+                *out++ = r < rows ? A(i0 + ir + r, p0 + p) : T{};
+            }
+        }
+    }
+}
+
+// B[p0 .. p0+kc, j0 .. j0+nc] as NR-column slivers: for each sliver, kc rows of NR values.
+template <class T>
+void PackB(MatrixRef<const T> B, std::size_t p0, std::size_t kc, std::size_t j0, std::size_t nc, T* out) {
+    constexpr std::size_t NR = Blocking<T>::NR;
+    for (std::size_t jr = 0; jr < nc; jr += NR) {
+        const std::size_t cols = std::min(NR, nc - jr);
+        for (std::size_t p = 0; p < kc; ++p) {
+            if (B.cs == 1 && cols == NR) {
+                std::copy_n(&B(p0 + p, j0 + jr), NR, out);
+                out += NR;
+                continue;
+            }
+            for (std::size_t c = 0; c < NR; ++c) {
+                *out++ = c < cols ? B(p0 + p, j0 + jr + c) : T{};
+            }
+        }
+    }
+}
+
+// acc[MR][NR] = sum over p of a[p][:] outer b[p][:]; fixed trip counts so the j loop is one
+// SIMD row and the accumulators are registers.
+template <class T>
+void MicroKernel(std::size_t kc, const T* __restrict a, const T* __restrict b, T* __restrict acc) {
+    constexpr std::size_t MR = Blocking<T>::MR;
+    constexpr std::size_t NR = Blocking<T>::NR;
+    T c[MR][NR] = {};
+    for (std::size_t p = 0; p < kc; ++p) {
+        for (std::size_t i = 0; i < MR; ++i) {
+            const T ai = a[p * MR + i];
+#pragma omp simd
+            for (std::size_t j = 0; j < NR; ++j) {
+                c[i][j] += ai * b[p * NR + j];
+            }
+        }
+    }
+    for (std::size_t i = 0; i < MR; ++i) {
+        for (std::size_t j = 0; j < NR; ++j) {
+            acc[i * NR + j] = c[i][j];
+        }
+    }
+}
+
+template <class T>
+bool ShapesAgree(MatrixRef<const T> A, MatrixRef<const T> B, MatrixRef<const T> C) {
+    return A.cols == B.rows && C.rows == A.rows && C.cols == B.cols;
+}
+
+template <class T>
+void ScaleC(MatrixRef<T> C, T beta) {
+    if (beta == T{1}) {
+        return;
+    }
+    for (std::size_t r = 0; r < C.rows; ++r) {
+        for (std::size_t c = 0; c < C.cols; ++c) {
+            C(r, c) = beta == T{} ? T{} : beta * C(r, c);
+        }
+    }
+}
+
+} // namespace
+
+template <class T>
+bool gemm(MatrixRef<const T> A, MatrixRef<const T> B, MatrixRef<T> C, T alpha, T beta, unsigned threads) {
+    using Blk = Blocking<T>;
+    if (!ShapesAgree<T>(A, B, C)) {
+        return false;
+    }
+    ScaleC(C, beta);
+    const std::size_t m = A.rows, n = B.cols, k = A.cols;
+    if (m == 0 || n == 0 || k == 0 || alpha == T{}) {
+        return true;
+    }
+
+    T* c = C.data;
+    const std::size_t crs = C.rs, ccs = C.cs;
+
+    const unsigned workers = m * n * k >= kParallelWork ? (threads == 0 ? WorkerCount() : threads) : 1;
+    AlignedVector<T> packedB(Blk::KC * ((std::min(Blk::NC, n) + Blk::NR - 1) / Blk::NR * Blk::NR));
+
+    for (std::size_t jc = 0; jc < n; jc += Blk::NC) {
+        const std::size_t nc = std::min(Blk::NC, n - jc);
+        for (std::size_t pc = 0; pc < k; pc += Blk::KC) {
+            const std::size_t kc = std::min(Blk::KC, k - pc);
+            PackB(B, pc, kc, jc, nc, packedB.data());
+
+            // Row blocks write disjoint rows of C, so they run concurrently; each packs its own A
+            const std::size_t rowBlocks = (m + Blk::MC - 1) / Blk::MC;
+            const auto rowBlock = [&](std::size_t block) {
+                thread_local AlignedVector<T> packedA;
+                packedA.resize(Blk::MC * Blk::KC);
+                alignas(kSimdAlign) T acc[Blk::MR * Blk::NR];
+
+                const std::size_t ic = block * Blk::MC;
+                const std::size_t mc = std::min(Blk::MC, m - ic);
+                PackA(A, ic, mc, pc, kc, packedA.data());
+
+                for (std::size_t jr = 0; jr < nc; jr += Blk::NR) {
+                    const std::size_t cols = std::min(Blk::NR, nc - jr);
+                    const T* bp = &packedB[jr * kc];
+                    for (std::size_t ir = 0; ir < mc; ir += Blk::MR) {
+                        const std::size_t rows = std::min(Blk::MR, mc - ir);
+                        MicroKernel(kc, &packedA[ir * kc], bp, acc);
+                        for (std::size_t i = 0; i < rows; ++i) {
+                            T* crow = c + (ic + ir + i) * crs + (jc + jr) * ccs;
+                            for (std::size_t j = 0; j < cols; ++j) {
+                                crow[j * ccs] += alpha * acc[i * Blk::NR + j];
+                            }
+                        }
+                    }
+                }
+            };
+            ParallelFor(rowBlocks, rowBlock, workers);
+        }
+    }
+    return true;
+}
+
+template <class T>
+bool gemmNaive(const Matrix<T>& A, const Matrix<T>& B, Matrix<T>& C, T alpha, T beta) {
+    if (!ShapesAgree<T>(A.Ref(), B.Ref(), C.Ref())) {
+        return false;
+    }
+    for (std::size_t i = 0; i < A.Rows(); ++i) {
+        for (std::size_t j = 0; j < B.Cols(); ++j) {
+            T sum{};
+            for (std::size_t p = 0; p < A.Cols(); ++p) {
+                sum += A(i, p) * B(p, j);
+            }
+            C(i, j) = alpha * sum + (beta == T{} ? T{} : beta * C(i, j));
+        }
+    }
+    return true;
+}
+
+template bool gemm<float>(MatrixRef<const float>, MatrixRef<const float>, MatrixRef<float>, float, float, unsigned);
+template bool gemm<double>(MatrixRef<const double>, MatrixRef<const double>, MatrixRef<double>, double, double, unsigned);
+template bool gemmNaive<float>(const Matrix<float>&, const Matrix<float>&, Matrix<float>&, float, float);
+template bool gemmNaive<double>(const Matrix<double>&, const Matrix<double>&, Matrix<double>&, double, double);
+
+} // namespace math
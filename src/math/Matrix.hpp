@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+
+#include "math/Aligned.hpp"
+
+namespace math {
+
+enum class Layout { RowMajor, ColMajor };
+
+// Non-owning strided view of a dense block: element (r, c) at data[r * rs + c * cs].
+// Blocks of a Matrix (Matrix::Block) are views, so factorizations can hand sub-matrices
+// to gemm without copying. MatrixRef<const T> is the read-only form.
+template <class T>
+struct MatrixRef {
+    T* data{};
+    std::size_t rows{}, cols{};
+    std::size_t rs{}, cs{};
+
+    T& operator()(std::size_t r, std::size_t c) const { return data[r * rs + c * cs]; }
+    MatrixRef Block(std::size_t r0, std::size_t c0, std::size_t nr, std::size_t nc) const {
+        return {data + r0 * rs + c0 * cs, nr, nc, rs, cs};
+    }
+    MatrixRef Transposed() const { return {data, cols, rows, cs, rs}; }
+    operator MatrixRef<const T>() const { return {data, rows, cols, rs, cs}; }
+};
+
+// Dense rows x cols matrix in one aligned allocation, row- or column-major. Element (r, c)
+// lives at Data()[r * RowStride() + c * ColStride()], which is how the kernels below
+// address either layout without copying.
+template <class T>
+class Matrix {
+public:
+    Matrix() = default;
+    // Zero-filled
+    Matrix(std::size_t rows, std::size_t cols, Layout layout = Layout::RowMajor)
+        : rows_(rows), cols_(cols), layout_(layout), data_(rows * cols, T{}) {}
+
+    static Matrix Identity(std::size_t n, Layout layout = Layout::RowMajor) {
+        Matrix m(n, n, layout);
+        for (std::size_t i = 0; i < n; ++i) {
+            m(i, i) = T{1};
+        }
+        return m;
+    }
+
+    std::size_t Rows() const { return rows_; }
+    std::size_t Cols() const { return cols_; }
+    std::size_t Size() const { return data_.size(); }
+    Layout GetLayout() const { return layout_; }
+    bool Empty() const { return data_.empty(); }
+
+    std::size_t RowStride() const { return layout_ == Layout::RowMajor ? cols_ : 1; }
+    std::size_t ColStride() const { return layout_ == Layout::RowMajor ? 1 : rows_; }
+
+    T& operator()(std::size_t r, std::size_t c) { return data_[r * RowStride() + c * ColStride()]; }
+    const T& operator()(std::size_t r, std::size_t c) const { return data_[r * RowStride() + c * ColStride()]; }
+
+    T* Data() { return data_.data(); }
+    const T* Data() const { return data_.data(); }
+
+    MatrixRef<T> Ref() { return {data_.data(), rows_, cols_, RowStride(), ColStride()}; }
+    MatrixRef<const T> Ref() const { return {data_.data(), rows_, cols_, RowStride(), ColStride()}; }
+    MatrixRef<T> Block(std::size_t r0, std::size_t c0, std::size_t nr, std::size_t nc) {
+        return Ref().Block(r0, c0, nr, nc);
+    }
+    MatrixRef<const T> Block(std::size_t r0, std::size_t c0, std::size_t nr, std::size_t nc) const {
+        return Ref().Block(r0, c0, nr, nc);
+    }
+
+    // Same values in the other storage order (a copy even when the layout already matches).
+    Matrix WithLayout(Layout layout) const {
+        Matrix out(rows_, cols_, layout);
+        for (std::size_t r = 0; r < rows_; ++r) {
+            for (std::size_t c = 0; c < cols_; ++c) {
+                out(r, c) = (*this)(r, c);
+            }
+        }
+        return out;
+    }
+
+    // Transpose as a view change: swaps the dimensions and the layout, no data movement.
+    Matrix Transposed() && {
+        std::swap(rows_, cols_);
+        layout_ = layout_ == Layout::RowMajor ? Layout::ColMajor : Layout::RowMajor;
+        return std::move(*this);
+    }
+    Matrix Transposed() const& { return Matrix(*this).Transposed(); }
+
+private:
+    std::size_t rows_{};
+    std::size_t cols_{};
+    Layout layout_{Layout::RowMajor};
+    AlignedVector<T> data_;
+};
+
+// C = alpha * A * B + beta * C for any mix of layouts (beta = 0 overwrites C, even NaNs).
+// A and B are packed into cache-sized panels and multiplied by a register-tiled micro-kernel;
+// products above ~128^3 multiply-adds are split over `threads` threads by row blocks
+// (0: every hardware thread). Returns false (and leaves C alone) when the shapes don't
+// agree; C must already be A.Rows() x B.Cols(). Instantiated for float and double.
+template <class T>
+bool gemm(MatrixRef<const T> A, MatrixRef<const T> B, MatrixRef<T> C, T alpha = T{1}, T beta = T{0}, unsigned threads = 0);
+
+template <class T>
+bool gemm(const Matrix<T>& A, const Matrix<T>& B, Matrix<T>& C, T alpha = T{1}, T beta = T{0}, unsigned threads = 0) {
+    return gemm<T>(A.Ref(), B.Ref(), C.Ref(), alpha, beta, threads);
+}
+
+// Reference triple loop (i, j, k order, no blocking) with the same contract, for tests and
+// as the benchmark baseline.
+template <class T>
+bool gemmNaive(const Matrix<T>& A, const Matrix<T>& B, Matrix<T>& C, T alpha = T{1}, T beta = T{0});
+
+// A * B in A's layout; an empty matrix when the shapes don't agree.
+template <class T>
+Matrix<T> operator*(const Matrix<T>& A, const Matrix<T>& B) {
+    Matrix<T> C(A.Rows(), B.Cols(), A.GetLayout());
+    return gemm(A, B, C) ? C : Matrix<T>{};
+}
+
+} // namespace math
@@ -0,0 +1,149 @@
+#include "math/Orthonormalize.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+#include "math/Decompose.hpp"
+
+namespace math {
+
+namespace {
+
+// A vector keeping less than this fraction of its length after projection counts as
+// dependent: well above float round-off in the projection, well below real data.
+constexpr float kDependent = 1e-5f;
+
+[[gnu::always_inline]] inline Vec3 Select(bool c, const Vec3& a, const Vec3& b) {
+    return {c ? a.x : b.x, c ? a.y : b.y, c ? a.z : b.z};
+}
+
+// Unit vector perpendicular to unit q, from the world axis least aligned with it.
+[[gnu::always_inline]] inline Vec3 Perpendicular(const Vec3& q) {
+    const Vec3 axis = Select(std::fabs(q.x) < 0.577f, Vec3{1.f, 0.f, 0.f}, Vec3{0.f, 1.f, 0.f});
+    const Vec3 p = glm::cross(q, axis);
+    return p * (1.f / std::sqrt(glm::dot(p, p)));
+}
+
+// One frame, shared by the scalar and batched entry points. Branch-free: every fallback
+// is computed and selected, divisions use clamped denominators, and conditions combine
+// with & rather than && (short-circuiting is control flow, which stops vectorization).
+[[gnu::always_inline]] inline void OrthonormalizeLane(Vec3& e1, Vec3& e2, Vec3& e3) {
+    const float l1 = glm::dot(e1, e1);
+    const bool ok1 = l1 > 1e-30f;
+    const Vec3 q1 = Select(ok1, e1 * (1.f / std::sqrt(ok1 ? l1 : 1.f)), Vec3{1.f, 0.f, 0.f});
+
+    const Vec3 v2 = e2 - glm::dot(e2, q1) * q1;
+    const float l2 = glm::dot(v2, v2);
+    const bool ok2 = (l2 > kDependent * kDependent * glm::dot(e2, e2)) & (l2 > 1e-30f);
+    const Vec3 q2 = Select(ok2, v2 * (1.f / std::sqrt(ok2 ? l2 : 1.f)), Perpendicular(q1));
+
+    Vec3 v3 = e3 - glm::dot(e3, q1) * q1;
+    v3 -= glm::dot(v3, q2) * q2;
+    const float l3 = glm::dot(v3, v3);
+    const bool ok3 = (l3 > kDependent * kDependent * glm::dot(e3, e3)) & (l3 > 1e-30f);
+    const Vec3 q3 = Select(ok3, v3 * (1.f / std::sqrt(ok3 ? l3 : 1.f)), glm::cross(q1, q2));
+
+    e1 = q1;
+    e2 = q2;
+    e3 = q3;
+}
+
+} // namespace
+
+std::array<Vec3, 3> orthonormalize(const std::array<Vec3, 3>& basis) {
+    std::array<Vec3, 3> q = basis;
+    OrthonormalizeLane(q[0], q[1], q[2]);
+    return q;
+}
+
+Mat3 orthonormalizeColumns(const Mat3& m) {
+    Vec3 c0 = m[0], c1 = m[1], c2 = m[2];
+    OrthonormalizeLane(c0, c1, c2);
+    return Mat3(c0, c1, c2);
+}
+
+Mat4 orthonormalizeRotation(const Mat4& m) {
+    const Mat3 r = orthonormalizeColumns(Mat3(m));
+    Mat4 out = m;
+    for (int c = 0; c < 3; ++c) {
+        out[c] = Vec4(r[c], m[c][3]);
+    }
+    return out;
+}
+
+void orthonormalizeColumns(Mat3Batch& m) {
+    float* p[9];
+    for (std::size_t k = 0; k < 9; ++k) {
+        p[k] = m.m[k].data();
+    }
+    float* m0 = p[0]; float* m1 = p[1]; float* m2 = p[2];
+    float* m3 = p[3]; float* m4 = p[4]; float* m5 = p[5];
+    float* m6 = p[6]; float* m7 = p[7]; float* m8 = p[8];
+
+    ForEachLane(m.paddedSize(), [=](std::size_t i) {
+        Vec3 c0{m0[i], m1[i], m2[i]};
+        Vec3 c1{m3[i], m4[i], m5[i]};
+        Vec3 c2{m6[i], m7[i], m8[i]};
+        OrthonormalizeLane(c0, c1, c2);
+        m0[i] = c0.x; m1[i] = c0.y; m2[i] = c0.z;
+        m3[i] = c1.x; m4[i] = c1.y; m5[i] = c1.z;
+        m6[i] = c2.x; m7[i] = c2.y; m8[i] = c2.z;
+    });
+}
+
+template <class T>
+bool gramSchmidt(Matrix<T>& A) {
+    const std::size_t m = A.Rows(), n = A.Cols();
+    const Layout layout = A.GetLayout();
+    // Contiguous columns for the dot products and updates
+    Matrix<T> q = layout == Layout::ColMajor ? std::move(A) : A.WithLayout(Layout::ColMajor);
+    const T tolerance = std::numeric_limits<T>::epsilon() * T{64};
+    bool independent = n <= m;
+
+    for (std::size_t j = 0; j < n; ++j) {
+        T* a = &q(0, j);
+        T before{};
+        for (std::size_t r = 0; r < m; ++r) {
+            before += a[r] * a[r];
+        }
+        for (std::size_t k = 0; k < j; ++k) {
+            const T* qk = &q(0, k);
+            T dot{};
+            for (std::size_t r = 0; r < m; ++r) {
+                dot += qk[r] * a[r];
+            }
+            for (std::size_t r = 0; r < m; ++r) {
+                a[r] -= dot * qk[r];
+            }
+        }
+        T after{};
+        for (std::size_t r = 0; r < m; ++r) {
+            after += a[r] * a[r];
+        }
+        if (!(after > tolerance * tolerance * before) || after == T{}) {
+            independent = false;
+            std::fill(a, a + m, T{});
+            continue;
+        }
+        const T inv = T{1} / std::sqrt(after);
+        for (std::size_t r = 0; r < m; ++r) {
+            a[r] *= inv;
+        }
+    }
+    A = layout == Layout::ColMajor ? std::move(q) : q.WithLayout(layout);
+    return independent;
+}
+
+template <class T>
+Matrix<T> householderBasis(const Matrix<T>& A) {
+    return qrQ(qrFactor(A));
+}
+
+template bool gramSchmidt<float>(Matrix<float>&);
+template bool gramSchmidt<double>(Matrix<double>&);
+template Matrix<float> householderBasis<float>(const Matrix<float>&);
+template Matrix<double> householderBasis<double>(const Matrix<double>&);
+
+} // namespace math
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <array>
+
+#include "math/Mat3Batch.hpp"
+#include "math/Matrix.hpp"
+#include "math/Types.hpp"
+
+namespace math {
+
+// Modified Gram-Schmidt on (e1, e2, e3) in that order: q1 has e1's direction, q2 is the
+// part of e2 orthogonal to q1, q3 the part of e3 orthogonal to both. A zero vector, or
+// one (nearly) dependent on those before it, is replaced by a perpendicular completion
+// (q3 by q1 x q2), so the result is always orthonormal and keeps the input's handedness
+// whenever the input is a basis.
+std::array<Vec3, 3> orthonormalize(const std::array<Vec3, 3>& basis);
+
+// The same on a matrix's columns, e.g. to remove the drift from a rotation accumulated
+// over many frames (the first column keeps its direction).
+Mat3 orthonormalizeColumns(const Mat3& m);
+// The upper 3x3 of an affine transform; the translation row and column are kept.
+Mat4 orthonormalizeRotation(const Mat4& m);
+
+// In place, lane-parallel.
+void orthonormalizeColumns(Mat3Batch& m);
+
+// N-D modified Gram-Schmidt on A's columns in place (A is m x n). Orthogonality degrades
+// with A's condition number; false when a column is dependent on the ones before it
+// (or n > m), in which case that column is left zero.
+template <class T>
+bool gramSchmidt(Matrix<T>& A);
+
+// Orthonormal m x min(m, n) basis from A's Householder QR: orthonormal to working
+// precision whatever A's conditioning, and its first k columns span A's first k.
+template <class T>
+Matrix<T> householderBasis(const Matrix<T>& A);
+
+} // namespace math
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace math {
+
+// Worker count for ParallelFor: the hardware thread count, at least 1.
+inline unsigned WorkerCount() {
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+// Calls fn(i) for every i in [0, count) across up to `workers` threads (the caller is one of
+// them). Items are handed out one at a time from a shared counter, so uneven items (tiles
+// with more triangles) balance themselves. Threads are started per call: meant for coarse
+// items such as tiles or row blocks, not single elements. fn must be safe to run
+// concurrently for different i.
+template <class Fn>
+void ParallelFor(std::size_t count, Fn&& fn, unsigned workers = WorkerCount()) {
+    const auto threads = static_cast<std::size_t>(std::min<std::size_t>(workers, count));
+    if (threads <= 1) {
+        for (std::size_t i = 0; i < count; ++i) {
+            fn(i);
+        }
+        return;
+    }
+
+    std::atomic<std::size_t> next{0};
+    const auto work = [&] {
+        for (std::size_t i = next.fetch_add(1, std::memory_order_relaxed); i < count;
+             i = next.fetch_add(1, std::memory_order_relaxed)) {
+            fn(i);
+        }
+    };
+    std::vector<std::jthread> pool;
+    pool.reserve(threads - 1);
+    for (std::size_t t = 1; t < threads; ++t) {
+        pool.emplace_back(work);
+    }
+    work();
+}
+
+} // namespace math
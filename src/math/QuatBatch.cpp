@@ -0,0 +1,149 @@
+#include "math/QuatBatch.hpp"
+
+#include <cassert>
+#include <cmath>
+
+namespace math {
+
+namespace {
+
+// One lane of sincosBatch. Reduces x to r in [-pi/4, pi/4] with quadrant q, evaluates
+// both polynomials and picks/negates with selects, so there is nothing to branch on.
+inline void SinCosLane(const float x, float& s, float& c) {
+    constexpr float kTwoOverPi = 0.636619772367581343f;
+    // pi/2 split into three parts whose products with small integers are exact
+    constexpr float kPio2Hi = 1.5703125f;
+    constexpr float kPio2Mid = 4.837512969970703125e-4f;
+    constexpr float kPio2Lo = 7.54978995489188216e-8f;
+
+    // Round to nearest via truncation; std::floor would block vectorization on GCC
+    const float t = x * kTwoOverPi;
+    const int q = static_cast<int>(t + (t >= 0.f ? 0.5f : -0.5f));
+    const float j = static_cast<float>(q);
+    const float r = ((x - j * kPio2Hi) - j * kPio2Mid) - j * kPio2Lo;
+    const float r2 = r * r;
+
+    const float sp = r + r * r2 * (-1.6666654611e-1f + r2 * (8.3321608736e-3f + r2 * -1.9515295891e-4f));
+    const float cp = 1.f - 0.5f * r2 +
+                     r2 * r2 * (4.166664568298827e-2f + r2 * (-1.388731625493765e-3f + r2 * 2.443315711809948e-5f));
+
+    // Quadrants 0..3: (sin, cos) = (sp, cp), (cp, -sp), (-sp, -cp), (-cp, sp)
+    const bool swap = (q & 1) != 0;
+    const float sv = swap ? cp : sp;
+    const float cv = swap ? sp : cp;
+    s = (q & 2) != 0 ? -sv : sv;
+    c = ((q + 1) & 2) != 0 ? -cv : cv;
+}
+
+inline void Store(float* w, float* x, float* y, float* z, std::size_t i, const Quat& q) {
+    w[i] = q.w;
+    x[i] = q.x;
+    y[i] = q.y;
+    z[i] = q.z;
+}
+
+// Reallocates only on a size change; every lane gets overwritten by the caller anyway.
+void EnsureSize(QuatBatch& out, std::size_t n) {
+    if (out.size() != n || out.paddedSize() != PadToLanes(n)) {
+        out.resize(n);
+    }
+}
+
+} // namespace
+
+void multiply(const QuatBatch& a, const QuatBatch& b, QuatBatch& out) {
+    assert(b.size() == a.size());
+    EnsureSize(out, a.size());
+    const float* aw = a.w.data(); const float* ax = a.x.data(); const float* ay = a.y.data(); const float* az = a.z.data();
+    const float* bw = b.w.data(); const float* bx = b.x.data(); const float* by = b.y.data(); const float* bz = b.z.data();
+    float* ow = out.w.data(); float* ox = out.x.data(); float* oy = out.y.data(); float* oz = out.z.data();
+
+    ForEachLane(a.paddedSize(), [=](std::size_t i) {
+        const Quat r{
+            aw[i] * bw[i] - ax[i] * bx[i] - ay[i] * by[i] - az[i] * bz[i],
+            aw[i] * bx[i] + ax[i] * bw[i] + ay[i] * bz[i] - az[i] * by[i],
+            aw[i] * by[i] - ax[i] * bz[i] + ay[i] * bw[i] + az[i] * bx[i],
+            aw[i] * bz[i] + ax[i] * by[i] - ay[i] * bx[i] + az[i] * bw[i]
+        };
+        Store(ow, ox, oy, oz, i, r);
+    });
+}
+
+void normalize(const QuatBatch& q, QuatBatch& out) {
+    EnsureSize(out, q.size());
+    const float* qw = q.w.data(); const float* qx = q.x.data(); const float* qy = q.y.data(); const float* qz = q.z.data();
+    float* ow = out.w.data(); float* ox = out.x.data(); float* oy = out.y.data(); float* oz = out.z.data();
+
+    ForEachLane(q.paddedSize(), [=](std::size_t i) {
+        const float n2 = qw[i] * qw[i] + qx[i] * qx[i] + qy[i] * qy[i] + qz[i] * qz[i];
+        // Divide unconditionally (clamped) and select after, so the lane stays branch-free
+        const float inv = 1.f / std::sqrt(n2 > 1e-16f ? n2 : 1e-16f);
+        const float k = n2 >= 1e-16f ? inv : 0.f;
+        // Degenerate lanes become the identity, matching the scalar normalize()
+        const Quat r{k > 0.f ? qw[i] * k : 1.f, qx[i] * k, qy[i] * k, qz[i] * k};
+        Store(ow, ox, oy, oz, i, r);
+    });
+}
+
+void conjugate(const QuatBatch& q, QuatBatch& out) {
+    EnsureSize(out, q.size());
+    const float* qw = q.w.data(); const float* qx = q.x.data(); const float* qy = q.y.data(); const float* qz = q.z.data();
+    float* ow = out.w.data(); float* ox = out.x.data(); float* oy = out.y.data(); float* oz = out.z.data();
+
+    ForEachLane(q.paddedSize(), [=](std::size_t i) {
+        const Quat r{qw[i], -qx[i], -qy[i], -qz[i]};
+        Store(ow, ox, oy, oz, i, r);
+    });
+}
+
+void fromAxisAngle(const Vec3Batch& axes, std::span<const float> angles, QuatBatch& out) {
+    EnsureSize(out, axes.size());
+    const float* vx = axes.x.data(); const float* vy = axes.y.data(); const float* vz = axes.z.data();
+    const float* theta = angles.data();
+    float* ow = out.w.data(); float* ox = out.x.data(); float* oy = out.y.data(); float* oz = out.z.data();
+
+    // Only the first size() lanes have angles; padding stays the identity from resize()
+    ForEachLane(axes.size(), [=](std::size_t i) {
+        const float len2 = vx[i] * vx[i] + vy[i] * vy[i] + vz[i] * vz[i];
+        const bool valid = len2 >= 1e-16f;
+        const float inv = 1.f / std::sqrt(len2 > 1e-16f ? len2 : 1e-16f);
+        float s;
+        float c;
+        SinCosLane(theta[i] * 0.5f, s, c);
+        const float k = valid ? s * inv : 0.f;
+        const Quat r{valid ? c : 1.f, k * vx[i], k * vy[i], k * vz[i]};
+        Store(ow, ox, oy, oz, i, r);
+    });
+}
+
+void quatToMat4(const QuatBatch& q, std::span<Mat4> out) {
+    const float* qw = q.w.data(); const float* qx = q.x.data(); const float* qy = q.y.data(); const float* qz = q.z.data();
+    Mat4* m = out.data();
+
+    ForEachLane(q.size(), [=](std::size_t i) { // R[c][r], same layout as the scalar quatToMat4
+        const float w = qw[i];
+        const float x = qx[i];
+        const float y = qy[i];
+        const float z = qz[i];
+        Mat4& R = m[i];
+        R[0] = Vec4(1 - 2*(y*y + z*z), 2*(x*y + w*z),     2*(x*z - w*y),     0);
+        R[1] = Vec4(2*(x*y - w*z),     1 - 2*(x*x + z*z), 2*(y*z + w*x),     0);
+        R[2] = Vec4(2*(x*z + w*y),     2*(y*z - w*x),     1 - 2*(x*x + y*y), 0);
+        R[3] = Vec4(0, 0, 0, 1);
+    });
+}
+
+void sincosBatch(std::span<const float> x, std::span<float> s, std::span<float> c) {
+    const float* in = x.data();
+    float* so = s.data();
+    float* co = c.data();
+    ForEachLane(x.size(), [=](std::size_t i) {
+        float sv;
+        float cv;
+        SinCosLane(in[i], sv, cv);
+        so[i] = sv;
+        co[i] = cv;
+    });
+}
+
+} // namespace math
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+
+#include "math/Aligned.hpp"
+#include "math/Quaternion.h"
+#include "math/Vec3Batch.hpp"
+
+namespace math {
+
+// Structure-of-arrays quaternions for animating many objects at once. Padding lanes
+// hold the identity so the kernels can run whole lane blocks without producing NaNs.
+struct QuatBatch {
+    AlignedVector<float> w, x, y, z;
+    std::size_t count{};
+
+    QuatBatch() = default;
+    explicit QuatBatch(std::size_t n) { resize(n); }
+
+    std::size_t size() const { return count; }
+    std::size_t paddedSize() const { return w.size(); }
+
+    // Resizes and fills with the identity.
+    void resize(std::size_t n) {
+        count = n;
+        const std::size_t padded = PadToLanes(n);
+        w.assign(padded, 1.f);
+        x.assign(padded, 0.f);
+        y.assign(padded, 0.f);
+        z.assign(padded, 0.f);
+    }
+
+    void set(std::size_t i, const Quat& q) {
+        w[i] = q.w;
+        x[i] = q.x;
+        y[i] = q.y;
+        z[i] = q.z;
+    }
+
+    Quat get(std::size_t i) const { return {w[i], x[i], y[i], z[i]}; }
+};
+
+// Lane-parallel counterparts of the scalar functions in Quaternion.h.
+// `out` is resized to match and may alias an input.
+// b.size() must equal a.size().
+void multiply(const QuatBatch& a, const QuatBatch& b, QuatBatch& out);
+void normalize(const QuatBatch& q, QuatBatch& out);
+void conjugate(const QuatBatch& q, QuatBatch& out);
+// angles.size() must be at least axes.size().
+void fromAxisAngle(const Vec3Batch& axes, std::span<const float> angles, QuatBatch& out);
+// out.size() must be at least q.size().
+void quatToMat4(const QuatBatch& q, std::span<Mat4> out);
+
+// Branch-free sin/cos (Cody-Waite reduction + minimax polynomials, ~2 ulp for |x| < 1e4).
+void sincosBatch(std::span<const float> x, std::span<float> s, std::span<float> c);
+
+} // namespace math
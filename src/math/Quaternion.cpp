@@ -2,9 +2,28 @@
 // Created by Santiago Fuentes on 1/26/26.
 //
 #include "Quaternion.h"
+#include <algorithm>
 #include <cmath>
+#include <vector>
 
 namespace math {
+    namespace {
+        // Standard slerp formula, no hemisphere check. Callers handle the flip.
+        Quat slerpUnflipped(const Quat& a, const Quat& b, const float t) {
+            const float d = std::clamp(dot(a, b), -1.f, 1.f);
+            if (std::fabs(d) > kSlerpNlerpThreshold) {
+                return normalize(a * (1.f - t) + b * t);
+            }
+            const float theta = std::acos(d);
+            const float invSin = 1.f / std::sin(theta);
+            return a * (std::sin((1.f - t) * theta) * invSin) + b * (std::sin(t * theta) * invSin);
+        }
+
+        // b, negated if needed so that a -> b is the short way round.
+        Quat sameHemisphere(const Quat& a, const Quat& b) {
+            return dot(a, b) < 0.f ? -b : b;
+        }
+    } // namespace
 
     Quat fromAxisAngle(const Vec3& axis, const float theta) {
         const float len = norm({0, axis.x, axis.y, axis.z});
@@ -17,6 +36,19 @@ namespace math {
         return { cos(half), s * n.x, s * n.y, s * n.z };
     }
 
+    void toAxisAngle(const Quat& q, Vec3& axis, float& theta) {
+        const float sign = q.w < 0.f ? -1.f : 1.f;
+        const float w = std::fmin(sign * q.w, 1.f);
+        const float s = std::sqrt(std::fmax(1.f - w * w, 0.f));
+        if (s < 1e-6f) {
+            axis = {1, 0, 0};
+            theta = 0.f;
+            return;
+        }
+        axis = {sign * q.x / s, sign * q.y / s, sign * q.z / s};
+        theta = 2.f * std::acos(w);
+    }
+
     Mat4 quatToMat4(const Quat& q) { // R[c][r]
         Mat4 R(1.0f);
         R[0][0] = 1 - 2*(q.y*q.y + q.z*q.z);
@@ -54,4 +86,146 @@ namespace math {
     float norm(const Quat& q) {
         return sqrt(q.w*q.w + q.x*q.x + q.y*q.y + q.z*q.z);
     }
+
+    float dot(const Quat& a, const Quat& b) {
+        return a.w * b.w + a.x * b.x + a.y * b.y + a.z * b.z;
+    }
+
+    Quat nlerp(const Quat& a, const Quat& b, const float t) {
+        const Quat bb = sameHemisphere(a, b);
+        return normalize(a * (1.f - t) + bb * t);
+    }
+
+    Quat slerp(const Quat& a, const Quat& b, const float t) {
+        return slerpUnflipped(a, sameHemisphere(a, b), t);
+    }
+
+    Quat quatLog(const Quat& q) {
+        const float n = norm(q);
+        const float vlen = std::sqrt(q.x * q.x + q.y * q.y + q.z * q.z);
+        if (n < 1e-8f) return {0, 0, 0, 0};
+        // atan2 keeps full precision near the identity, where acos(w) does not
+        const float k = vlen > 1e-8f ? std::atan2(vlen, q.w) / vlen : 1.f / n;
+        return { std::log(n), q.x * k, q.y * k, q.z * k };
+    }
+
+    Quat quatExp(const Quat& q) {
+        const float vlen = std::sqrt(q.x * q.x + q.y * q.y + q.z * q.z);
+        const float ew = std::exp(q.w);
+        // sin(x)/x -> 1 as x -> 0
+        const float k = vlen > 1e-8f ? ew * std::sin(vlen) / vlen : ew;
+        return { ew * std::cos(vlen), q.x * k, q.y * k, q.z * k };
+    }
+
+    Quat squadControl(const Quat& prev, const Quat& q, const Quat& next) {
+        const Quat qInv = conjugate(q);
+        const Quat lNext = quatLog(multiply(qInv, next));
+        const Quat lPrev = quatLog(multiply(qInv, prev));
+        return normalize(multiply(q, quatExp((lNext + lPrev) * -0.25f)));
+    }
+
+    Quat squad(const Quat& q1, const Quat& q2, const Quat& s1, const Quat& s2, const float t) {
+        const Quat outer = slerpUnflipped(q1, q2, t);
+        const Quat inner = slerpUnflipped(s1, s2, t);
+        return slerpUnflipped(outer, inner, 2.f * t * (1.f - t));
+    }
+
+    void slerpBatch(const Quat& a, const Quat& b, std::span<const float> ts, std::span<Quat> out) {
+        const std::size_t n = std::min(ts.size(), out.size());
+        const Quat bb = sameHemisphere(a, b);
+        const float d = std::clamp(dot(a, bb), -1.f, 1.f);
+
+        if (d > kSlerpNlerpThreshold) {
+            for (std::size_t i = 0; i < n; ++i) {
+                out[i] = normalize(a * (1.f - ts[i]) + bb * ts[i]);
+            }
+            return;
+        }
+
+        const float theta = std::acos(d);
+        const float invSin = 1.f / std::sin(theta);
+        for (std::size_t i = 0; i < n; ++i) {
+            const float wa = std::sin((1.f - ts[i]) * theta) * invSin;
+            const float wb = std::sin(ts[i] * theta) * invSin;
+            out[i] = a * wa + bb * wb;
+        }
+    }
+
+    void slerpSamples(const Quat& a, const Quat& b, std::span<Quat> out) {
+        const std::size_t n = out.size();
+        if (n == 0) return;
+        if (n == 1) {
+            out[0] = a;
+            return;
+        }
+
+        const Quat bb = sameHemisphere(a, b);
+        const float d = std::clamp(dot(a, bb), -1.f, 1.f);
+        const float step = 1.f / static_cast<float>(n - 1);
+
+        if (d > kSlerpNlerpThreshold) {
+            for (std::size_t i = 0; i < n; ++i) {
+                const float t = static_cast<float>(i) * step;
+                out[i] = normalize(a * (1.f - t) + bb * t);
+            }
+            return;
+        }
+
+        // Evenly spaced points on a great circle satisfy q[k+1] - q[k] = (q[k] - q[k-1]) - 4sin^2(phi/2) q[k],
+        // so each sample costs a few adds instead of two sines. The difference form stays accurate for
+        // tiny steps where 2cos(phi) would round to 2. Reseed exactly every kBlock samples to bound drift.
+        constexpr std::size_t kBlock = 64;
+        const float theta = std::acos(d);
+        const float invSin = 1.f / std::sin(theta);
+        const float halfStep = std::sin(0.5f * theta * step);
+        const float e = -4.f * halfStep * halfStep;
+        const auto exact = [&](std::size_t k) {
+            const float t = static_cast<float>(k) * step;
+            return a * (std::sin((1.f - t) * theta) * invSin) + bb * (std::sin(t * theta) * invSin);
+        };
+
+        Quat delta{};
+        for (std::size_t k = 0; k < n; ++k) {
+            if (k % kBlock == 0) {
+                out[k] = exact(k);
+                delta = exact(k + 1) + -out[k];
+            } else {
+                out[k] = out[k - 1] + delta;
+                delta = delta + out[k] * e;
+            }
+        }
+        out[n - 1] = bb;
+    }
+
+    void squadSamples(std::span<const Quat> keys, std::span<Quat> out) {
+        if (out.empty() || keys.empty()) return;
+        if (keys.size() == 1) {
+            std::fill(out.begin(), out.end(), keys[0]);
+            return;
+        }
+
+        // Align neighbours into one hemisphere so every segment is the short arc
+        std::vector<Quat> q(keys.begin(), keys.end());
+        for (std::size_t i = 1; i < q.size(); ++i) {
+            q[i] = sameHemisphere(q[i - 1], q[i]);
+        }
+
+        std::vector<Quat> s(q.size());
+        s.front() = q.front();
+        s.back() = q.back();
+        for (std::size_t i = 1; i + 1 < q.size(); ++i) {
+            s[i] = squadControl(q[i - 1], q[i], q[i + 1]);
+        }
+
+        const std::size_t segments = q.size() - 1;
+        const float scale = out.size() > 1
+            ? static_cast<float>(segments) / static_cast<float>(out.size() - 1)
+            : 0.f;
+        for (std::size_t i = 0; i < out.size(); ++i) {
+            const float u = static_cast<float>(i) * scale;
+            const std::size_t seg = std::min(static_cast<std::size_t>(u), segments - 1);
+            const float t = u - static_cast<float>(seg);
+            out[i] = squad(q[seg], q[seg + 1], s[seg], s[seg + 1], t);
+        }
+    }
 } // namespace math
@@ -4,6 +4,8 @@
 
 #ifndef PROJECTION_3D_2D_QUATERNION_H
 #define PROJECTION_3D_2D_QUATERNION_H
+#include <span>
+
 #include "Types.hpp"
 
 namespace math {
@@ -12,16 +14,57 @@ namespace math {
     };
 
     Quat fromAxisAngle(const Vec3& axis, float theta);
+    // Inverse of fromAxisAngle for unit q; picks the short way round (angle in [0, pi]).
+    void toAxisAngle(const Quat& q, Vec3& axis, float& theta);
 
     inline Quat operator/(const Quat& q, float s) {
         return {q.w / s, q.x / s, q.y / s, q.z / s};
     }
 
+    inline Quat operator*(const Quat& q, float s) {
+        return {q.w * s, q.x * s, q.y * s, q.z * s};
+    }
+
+    inline Quat operator+(const Quat& a, const Quat& b) {
+        return {a.w + b.w, a.x + b.x, a.y + b.y, a.z + b.z};
+    }
+
+    inline Quat operator-(const Quat& q) {
+        return {-q.w, -q.x, -q.y, -q.z};
+    }
+
     Mat4 quatToMat4(const Quat& q);
     Quat multiply(const Quat& q1, const Quat& q2);
     Quat normalize(const Quat& q);
     Quat conjugate(const Quat& q);
     float norm(const Quat& q);
+    float dot(const Quat& a, const Quat& b);
+
+    // Above this |dot| the arc is so short that slerp's sin(theta) loses precision,
+    // and nlerp is indistinguishable from it.
+    constexpr float kSlerpNlerpThreshold = 0.9995f;
+
+    // Interpolation between unit quaternions. All take the shortest arc (b is negated
+    // when dot(a, b) < 0) and return unit quaternions.
+    Quat nlerp(const Quat& a, const Quat& b, float t);
+    Quat slerp(const Quat& a, const Quat& b, float t);
+
+    // Quaternion log/exp: log of a unit quaternion is pure, (0, theta/2 * axis).
+    Quat quatLog(const Quat& q);
+    Quat quatExp(const Quat& q);
+
+    // Inner control point for squad at key q with neighbours prev and next.
+    Quat squadControl(const Quat& prev, const Quat& q, const Quat& next);
+    // Spherical cubic between keys q1, q2 with control points s1, s2.
+    Quat squad(const Quat& q1, const Quat& q2, const Quat& s1, const Quat& s2, float t);
+
+    // Batched sampling into a contiguous buffer.
+    // slerpBatch: out[i] = slerp(a, b, ts[i]); the arc angle is computed once.
+    void slerpBatch(const Quat& a, const Quat& b, std::span<const float> ts, std::span<Quat> out);
+    // out.size() evenly spaced samples from a to b inclusive, by angle-step recurrence.
+    void slerpSamples(const Quat& a, const Quat& b, std::span<Quat> out);
+    // out.size() evenly spaced samples along a squad spline through all keys.
+    void squadSamples(std::span<const Quat> keys, std::span<Quat> out);
 }
 
-#endif //PROJECTION_3D_2D_QUATERNION_H
\ No newline at end of file
+#endif //PROJECTION_3D_2D_QUATERNION_H
@@ -1,14 +1,80 @@
 #include "Types.hpp"
 #include "Shadow.h"
-#include <glm/ext/matrix_transform.hpp>
+
+#include <algorithm>
+#include <cmath>
+
 namespace math {
+    Mat4 planarShadow(const Plane& plane, const Vec4& light) {
+        // M = dot(P, L) I - L P^T projects x onto P along the line through L. Dividing by
+        // dot(P, L) leaves points on the plane fixed with w = 1.
+        const Vec4 p{plane.normal, plane.offset};
+        const float d = glm::dot(p, light);
+        const float s = std::abs(d) > 1e-12f ? 1.f / d : 1.f;
+
+        Mat4 M{0.f};
+        for (int col = 0; col < 4; ++col) {
+            for (int row = 0; row < 4; ++row) {
+                M[col][row] = ((row == col ? d : 0.f) - light[row] * p[col]) * s;
+            }
+        }
+        return M;
+    }
+
     Mat4 shadowFrom(const Vec3 lightPos) {
-        const Mat4 T = glm::translate(Mat4(1.f), -lightPos);
-        Mat4 M = {1.f};
-        M[3][3] = 0.f;
-        M[1][3] = 1.0f / -lightPos.y;
-        const Mat4 T_back = glm::translate(Mat4(1.f), lightPos);
+        return planarShadow(Plane{}, pointShadowLight(lightPos));
+    }
+
+    void ShadowProjector::SetLight(const Vec4& light) {
+        if (light == light_ && matrices_.size() == planes_.size()) {
+            return;
+        }
+        light_ = light;
+        Rebuild();
+    }
+
+    void ShadowProjector::SetReceivers(std::span<const Plane> planes) {
+        if (std::ranges::equal(planes, planes_) && matrices_.size() == planes_.size()) {
+            return;
+        }
+        planes_.assign(planes.begin(), planes.end());
+        Rebuild();
+    }
+
+    void ShadowProjector::Rebuild() {
+        matrices_.resize(planes_.size());
+        for (std::size_t r = 0; r < planes_.size(); ++r) {
+            matrices_[r] = planarShadow(planes_[r], light_);
+        }
+        ++rebuilds_;
+    }
+
+    void ShadowProjector::Project(const Vec3Batch& points, std::vector<Vec3Batch>& out) const {
+        out.resize(matrices_.size());
+        const float* ix = points.x.data(); const float* iy = points.y.data(); const float* iz = points.z.data();
+
+        for (std::size_t r = 0; r < matrices_.size(); ++r) {
+            Vec3Batch& dst = out[r];
+            if (dst.size() != points.size() || dst.paddedSize() != points.paddedSize()) {
+                dst.resize(points.size());
+            }
+            float* ox = dst.x.data(); float* oy = dst.y.data(); float* oz = dst.z.data();
+            const Mat4& M = matrices_[r];
+            const float m00 = M[0][0], m01 = M[0][1], m02 = M[0][2], m03 = M[0][3];
+            const float m10 = M[1][0], m11 = M[1][1], m12 = M[1][2], m13 = M[1][3];
+            const float m20 = M[2][0], m21 = M[2][1], m22 = M[2][2], m23 = M[2][3];
+            const float m30 = M[3][0], m31 = M[3][1], m32 = M[3][2], m33 = M[3][3];
 
-        return T_back * M * T;
+            ForEachLane(points.paddedSize(), [=](std::size_t i) {
+                const float x = ix[i], y = iy[i], z = iz[i];
+                const float w = m03 * x + m13 * y + m23 * z + m33;
+                // Points level with a point light never reach the plane; keep them finite
+                const float safeW = std::abs(w) > 1e-8f ? w : 1e-8f;
+                const float rcp = 1.f / safeW;
+                ox[i] = (m00 * x + m10 * y + m20 * z + m30) * rcp;
+                oy[i] = (m01 * x + m11 * y + m21 * z + m31) * rcp;
+                oz[i] = (m02 * x + m12 * y + m22 * z + m32) * rcp;
+            });
+        }
     }
-}
\ No newline at end of file
+}
@@ -1,8 +1,56 @@
 #ifndef PROJECTION_3D_2D_SHADOW_H
 #define PROJECTION_3D_2D_SHADOW_H
+#include <cstddef>
+#include <span>
+#include <vector>
+
 #include "Types.hpp"
+#include "Vec3Batch.hpp"
+
 namespace math {
+    // Receiver plane: dot(normal, x) + offset = 0
+    struct Plane {
+        Vec3 normal{0.f, 1.f, 0.f};
+        float offset{};
+
+        friend bool operator==(const Plane&, const Plane&) = default;
+    };
+
+    // Homogeneous light for planarShadow: a point light is (position, 1), a directional
+    // light (-direction, 0) with direction the way the light travels.
+    inline Vec4 pointShadowLight(const Vec3& position) { return {position, 1.f}; }
+    inline Vec4 directionalShadowLight(const Vec3& direction) { return {-direction, 0.f}; }
+
+    // Projects points along rays from the light onto the plane, scaled so points already on
+    // the plane map to themselves with w = 1. Points on the far side of a point light get
+    // w < 0 and land on the plane behind it; callers decide whether to draw those.
+    Mat4 planarShadow(const Plane& plane, const Vec4& light);
+
+    // Onto y = 0 from a point light
     Mat4 shadowFrom(Vec3 lightPos);
+
+    // Shadow matrices for a set of receiver planes under one light. The matrices are rebuilt
+    // only when the light or a receiver changes, so setting the same values every frame is
+    // cheap; Project() then flattens a whole point batch onto every receiver.
+    class ShadowProjector {
+    public:
+        void SetLight(const Vec4& light);
+        void SetReceivers(std::span<const Plane> planes);
+
+        std::span<const Mat4> Matrices() const { return matrices_; }
+        std::size_t Rebuilds() const { return rebuilds_; }
+
+        // out[r] receives the points projected onto receiver r (resized as needed).
+        void Project(const Vec3Batch& points, std::vector<Vec3Batch>& out) const;
+
+    private:
+        void Rebuild();
+
+        Vec4 light_{0.f, 1.f, 0.f, 0.f};
+        std::vector<Plane> planes_;
+        std::vector<Mat4> matrices_;
+        std::size_t rebuilds_{};
+    };
 }
 
 #endif //PROJECTION_3D_2D_SHADOW_H
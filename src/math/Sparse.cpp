@@ -0,0 +1,457 @@
+#include "math/Sparse.hpp"
+
+#include <algorithm>
+#include <array>
+#include <utility>
+
+#include "math/Parallel.hpp"
+
+namespace math {
+
+namespace {
+
+// Below this many stored entries a product is faster on one thread than the cost of
+// starting the others.
+constexpr std::size_t kParallelNonZeros = std::size_t{1} << 16;
+// Chunks per worker, so rows with uneven lengths still balance.
+constexpr std::size_t kChunksPerThread = 4;
+// Columns of X accumulated together in spmm (held in registers for k <= this).
+constexpr std::size_t kSpmmColumns = 8;
+
+// Row boundaries splitting a CSR matrix into `chunks` pieces of about equal non-zeros:
+// chunk c covers rows [bounds[c], bounds[c + 1]).
+std::vector<std::size_t> RowChunks(std::span<const std::uint32_t> offsets, std::size_t chunks) {
+    const std::size_t rows = offsets.size() - 1;
+    const std::size_t nnz = offsets.back();
+    std::vector<std::size_t> bounds(chunks + 1, rows);
+    bounds[0] = 0;
+    for (std::size_t c = 1; c < chunks; ++c) {
+        const auto target = static_cast<std::uint32_t>(nnz * c / chunks);
+        const auto it = std::lower_bound(offsets.begin(), offsets.end() - 1, target);
+        bounds[c] = std::max(bounds[c - 1], static_cast<std::size_t>(it - offsets.begin()));
+    }
+    return bounds;
+}
+
+// Calls rowsFn(begin, end) over all rows of a CSR matrix, split across threads when it is
+// large enough to benefit.
+template <class T, class Fn>
+void ForRowChunks(const SparseMatrix<T>& A, unsigned threads, Fn&& rowsFn) {
+    const unsigned workers = threads == 0 ? WorkerCount() : threads;
+    if (workers <= 1 || A.NonZeros() < kParallelNonZeros) {
+        rowsFn(std::size_t{0}, A.Rows());
+        return;
+    }
+    const std::vector<std::size_t> bounds = RowChunks(A.Offsets(), workers * kChunksPerThread);
+    ParallelFor(bounds.size() - 1, [&](std::size_t c) { rowsFn(bounds[c], bounds[c + 1]); }, workers);
+}
+
+} // namespace
+
+template <class T>
+SparseMatrix<T>::SparseMatrix(std::size_t rows, std::size_t cols, Layout layout)
+    : rows_(rows),
+      cols_(cols),
+      layout_(layout),
+      offsets_((layout == Layout::RowMajor ? rows : cols) + 1, 0) {}
+
+template <class T>
+SparseMatrix<T> SparseMatrix<T>::FromTriplets(std::size_t rows, std::size_t cols,
+                                              std::span<const Triplet<T>> triplets, Layout layout) {
+    SparseMatrix m(rows, cols, layout);
+    const bool csr = layout == Layout::RowMajor;
+    const std::size_t outerSize = m.OuterSize();
+    const std::size_t innerSize = csr ? cols : rows;
+    const auto outerOf = [csr](const Triplet<T>& t) { return csr ? t.row : t.col; };
+    const auto innerOf = [csr](const Triplet<T>& t) { return csr ? t.col : t.row; };
+
+    // Pass 1: counting sort of the in-range triplets by inner index
+    std::vector<std::uint32_t> cursor(innerSize + 1, 0);
+    std::size_t valid = 0;
+    for (const Triplet<T>& t : triplets) {
+        if (t.row < rows && t.col < cols) {
+            ++cursor[innerOf(t) + 1];
+            ++valid;
+        }
+    }
+    for (std::size_t k = 0; k < innerSize; ++k) {
+        cursor[k + 1] += cursor[k];
+    }
+    std::vector<std::uint32_t> byInner(valid);
+    for (std::size_t i = 0; i < triplets.size(); ++i) {
+        const Triplet<T>& t = triplets[i];
+        if (t.row < rows && t.col < cols) {
+            byInner[cursor[innerOf(t)]++] = static_cast<std::uint32_t>(i);
+        }
+    }
+
+    // Pass 2: stable counting sort by outer index, so each slice comes out sorted by inner
+    std::vector<std::uint32_t>& offsets = m.offsets_;
+    for (std::uint32_t i : byInner) {
+        ++offsets[outerOf(triplets[i]) + 1];
+    }
+    for (std::size_t k = 0; k < outerSize; ++k) {
+        offsets[k + 1] += offsets[k];
+    }
+    cursor.assign(offsets.begin(), offsets.end() - 1);
+    m.indices_.resize(valid);
+    m.values_.resize(valid);
+    for (std::uint32_t i : byInner) {
+        const Triplet<T>& t = triplets[i];
+        const std::uint32_t slot = cursor[outerOf(t)]++;
+        m.indices_[slot] = innerOf(t);
+        m.values_[slot] = t.value;
+    }
+
+    // Merge runs of equal inner index, compacting in place
+    std::uint32_t write = 0;
+    std::uint32_t begin = 0;
+    for (std::size_t k = 0; k < outerSize; ++k) {
+        const std::uint32_t end = offsets[k + 1];
+        for (std::uint32_t p = begin; p < end; ++p) {
+            if (write > offsets[k] && m.indices_[write - 1] == m.indices_[p]) {
+                m.values_[write - 1] += m.values_[p];
+            } else {
+                m.indices_[write] = m.indices_[p];
+                m.values_[write] = m.values_[p];
+                ++write;
+            }
+        }
+        begin = end;
+        offsets[k + 1] = write;
+    }
+    m.indices_.resize(write);
+    m.values_.resize(write);
+    return m;
+}
+
+template <class T>
+SparseMatrix<T> SparseMatrix<T>::Identity(std::size_t n, Layout layout) {
+    SparseMatrix m(n, n, layout);
+    m.indices_.resize(n);
+    m.values_.assign(n, T{1});
+    for (std::size_t i = 0; i < n; ++i) {
+        m.offsets_[i + 1] = static_cast<std::uint32_t>(i + 1);
+        m.indices_[i] = static_cast<std::uint32_t>(i);
+    }
+    return m;
+}
+
+template <class T>
+T SparseMatrix<T>::operator()(std::size_t r, std::size_t c) const {
+    if (r >= rows_ || c >= cols_) {
+        return T{};
+    }
+    const std::size_t outer = layout_ == Layout::RowMajor ? r : c;
+    const auto inner = static_cast<std::uint32_t>(layout_ == Layout::RowMajor ? c : r);
+    const auto first = indices_.begin() + offsets_[outer];
+    const auto last = indices_.begin() + offsets_[outer + 1];
+    const auto it = std::lower_bound(first, last, inner);
+    return it != last && *it == inner ? values_[static_cast<std::size_t>(it - indices_.begin())] : T{};
+}
+
+template <class T>
+SparseMatrix<T> SparseMatrix<T>::WithLayout(Layout layout) const {
+    if (layout == layout_) {
+        return *this;
+    }
+    // Scatter every slice into the other dimension; walking the old outer index in order
+    // leaves the new slices sorted.
+    SparseMatrix out(rows_, cols_, layout);
+    const std::size_t outerSize = out.OuterSize();
+    for (std::uint32_t inner : indices_) {
+        ++out.offsets_[inner + 1];
+    }
+    for (std::size_t k = 0; k < outerSize; ++k) {
+        out.offsets_[k + 1] += out.offsets_[k];
+    }
+    std::vector<std::uint32_t> cursor(out.offsets_.begin(), out.offsets_.end() - 1);
+    out.indices_.resize(indices_.size());
+    out.values_.resize(values_.size());
+    for (std::size_t k = 0; k < OuterSize(); ++k) {
+        for (std::uint32_t p = offsets_[k]; p < offsets_[k + 1]; ++p) {
+            const std::uint32_t slot = cursor[indices_[p]]++;
+            out.indices_[slot] = static_cast<std::uint32_t>(k);
+            out.values_[slot] = values_[p];
+        }
+    }
+    return out;
+}
+
+template <class T>
+SparseMatrix<T> SparseMatrix<T>::Transposed() && {
+    std::swap(rows_, cols_);
+    layout_ = layout_ == Layout::RowMajor ? Layout::ColMajor : Layout::RowMajor;
+    return std::move(*this);
+}
+
+template <class T>
+std::vector<T> SparseMatrix<T>::Diagonal() const {
+    std::vector<T> diagonal(std::min(rows_, cols_), T{});
+    for (std::size_t k = 0; k < diagonal.size(); ++k) {
+        const auto first = indices_.begin() + offsets_[k];
+        const auto last = indices_.begin() + offsets_[k + 1];
+        const auto it = std::lower_bound(first, last, static_cast<std::uint32_t>(k));
+        if (it != last && *it == k) {
+            diagonal[k] = values_[static_cast<std::size_t>(it - indices_.begin())];
+        }
+    }
+    return diagonal;
+}
+
+template <class T>
+std::size_t SparseMatrix<T>::Bandwidth() const {
+    std::size_t band = 0;
+    for (std::size_t k = 0; k < OuterSize(); ++k) {
+        for (std::uint32_t p = offsets_[k]; p < offsets_[k + 1]; ++p) {
+            const std::size_t inner = indices_[p];
+            band = std::max(band, inner > k ? inner - k : k - inner);
+        }
+    }
+    return band;
+}
+
+template <class T>
+SparseMatrix<T> SparseMatrix<T>::Permuted(std::span<const std::uint32_t> order) const {
+    if (rows_ != cols_ || order.size() != rows_) {
+        return {};
+    }
+    const std::vector<std::uint32_t> inverse = invertPermutation(order);
+    SparseMatrix out(rows_, cols_, layout_);
+    out.indices_.resize(indices_.size());
+    out.values_.resize(values_.size());
+    std::vector<std::pair<std::uint32_t, T>> slice;
+    for (std::size_t k = 0; k < rows_; ++k) {
+        const std::uint32_t old = order[k];
+        slice.clear();
+        for (std::uint32_t p = offsets_[old]; p < offsets_[old + 1]; ++p) {
+            slice.emplace_back(inverse[indices_[p]], values_[p]);
+        }
+        std::sort(slice.begin(), slice.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+        const std::uint32_t base = out.offsets_[k];
+        for (std::size_t s = 0; s < slice.size(); ++s) {
+            out.indices_[base + s] = slice[s].first;
+            out.values_[base + s] = slice[s].second;
+        }
+        out.offsets_[k + 1] = base + static_cast<std::uint32_t>(slice.size());
+    }
+    return out;
+}
+
+template <class T>
+Matrix<T> SparseMatrix<T>::ToDense(Layout layout) const {
+    Matrix<T> dense(rows_, cols_, layout);
+    const bool csr = layout_ == Layout::RowMajor;
+    for (std::size_t k = 0; k < OuterSize(); ++k) {
+        for (std::uint32_t p = offsets_[k]; p < offsets_[k + 1]; ++p) {
+            if (csr) {
+                dense(k, indices_[p]) = values_[p];
+            } else {
+                dense(indices_[p], k) = values_[p];
+            }
+        }
+    }
+    return dense;
+}
+
+template <class T>
+bool spmv(const SparseMatrix<T>& A, std::span<const T> x, std::span<T> y, T alpha, T beta, unsigned threads) {
+    if (x.size() != A.Cols() || y.size() != A.Rows()) {
+        return false;
+    }
+    const std::span<const std::uint32_t> offsets = A.Offsets();
+    const std::span<const std::uint32_t> indices = A.Indices();
+    const std::span<const T> values = A.Values();
+
+    if (A.GetLayout() == Layout::ColMajor) {
+        for (T& v : y) {
+            v = beta == T{} ? T{} : beta * v;
+        }
+        for (std::size_t c = 0; c < A.Cols(); ++c) {
+            const T xc = alpha * x[c];
+            for (std::uint32_t p = offsets[c]; p < offsets[c + 1]; ++p) {
+                y[indices[p]] += values[p] * xc;
+            }
+        }
+        return true;
+    }
+
+    ForRowChunks(A, threads, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t r = begin; r < end; ++r) {
+            T sum{};
+            for (std::uint32_t p = offsets[r]; p < offsets[r + 1]; ++p) {
+                sum += values[p] * x[indices[p]];
+            }
+            y[r] = beta == T{} ? alpha * sum : alpha * sum + beta * y[r];
+        }
+    });
+    return true;
+}
+
+template <class T>
+bool spmm(const SparseMatrix<T>& A, MatrixRef<const T> X, MatrixRef<T> Y, T alpha, T beta, unsigned threads) {
+    if (X.rows != A.Cols() || Y.rows != A.Rows() || X.cols != Y.cols) {
+        return false;
+    }
+    const std::span<const std::uint32_t> offsets = A.Offsets();
+    const std::span<const std::uint32_t> indices = A.Indices();
+    const std::span<const T> values = A.Values();
+    const std::size_t k = X.cols;
+
+    if (A.GetLayout() == Layout::ColMajor) {
+        for (std::size_t r = 0; r < Y.rows; ++r) {
+            for (std::size_t j = 0; j < k; ++j) {
+                Y(r, j) = beta == T{} ? T{} : beta * Y(r, j);
+            }
+        }
+        for (std::size_t c = 0; c < A.Cols(); ++c) {
+            for (std::uint32_t p = offsets[c]; p < offsets[c + 1]; ++p) {
+                const T a = alpha * values[p];
+                for (std::size_t j = 0; j < k; ++j) {
+                    Y(indices[p], j) += a * X(c, j);
+                }
+            }
+        }
+        return true;
+    }
+
+    ForRowChunks(A, threads, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t j0 = 0; j0 < k; j0 += kSpmmColumns) {
+            const std::size_t width = std::min(kSpmmColumns, k - j0);
+            for (std::size_t r = begin; r < end; ++r) {
+                std::array<T, kSpmmColumns> sum{};
+                for (std::uint32_t p = offsets[r]; p < offsets[r + 1]; ++p) {
+                    const T a = values[p];
+                    const T* xRow = X.data + indices[p] * X.rs + j0 * X.cs;
+                    for (std::size_t j = 0; j < width; ++j) {
+                        sum[j] += a * xRow[j * X.cs];
+                    }
+                }
+                for (std::size_t j = 0; j < width; ++j) {
+                    T& out = Y(r, j0 + j);
+                    out = beta == T{} ? alpha * sum[j] : alpha * sum[j] + beta * out;
+                }
+            }
+        }
+    });
+    return true;
+}
+
+template <class T>
+std::vector<std::uint32_t> reverseCuthillMcKee(const SparseMatrix<T>& A) {
+    if (A.Rows() != A.Cols()) {
+        return {};
+    }
+    const std::size_t n = A.Rows();
+    const std::span<const std::uint32_t> offsets = A.Offsets();
+    const std::span<const std::uint32_t> indices = A.Indices();
+
+    // Degree without the diagonal
+    std::vector<std::uint32_t> degree(n);
+    for (std::size_t v = 0; v < n; ++v) {
+        std::uint32_t d = 0;
+        for (std::uint32_t p = offsets[v]; p < offsets[v + 1]; ++p) {
+            d += indices[p] != v ? 1u : 0u;
+        }
+        degree[v] = d;
+    }
+
+    // Breadth-first level structure from root within one component; `stamp` marks vertices
+    // reached in the current search so nothing needs clearing between searches. Returns
+    // the eccentricity of root and leaves the last level in `lastLevel`.
+    std::vector<std::uint32_t> stamp(n, 0);
+    std::uint32_t search = 0;
+    std::vector<std::uint32_t> frontier, next, lastLevel;
+    const auto levels = [&](std::uint32_t root) {
+        ++search;
+        frontier.assign(1, root);
+        stamp[root] = search;
+        std::size_t depth = 0;
+        while (true) {
+            next.clear();
+            for (std::uint32_t v : frontier) {
+                for (std::uint32_t p = offsets[v]; p < offsets[v + 1]; ++p) {
+                    const std::uint32_t u = indices[p];
+                    if (stamp[u] != search) {
+                        stamp[u] = search;
+                        next.push_back(u);
+                    }
+                }
+            }
+            if (next.empty()) {
+                lastLevel = frontier;
+                return depth;
+            }
+            frontier.swap(next);
+            ++depth;
+        }
+    };
+
+    std::vector<std::uint32_t> order;
+    order.reserve(n);
+    std::vector<bool> placed(n, false);
+    std::vector<std::uint32_t> neighbours;
+    for (std::size_t seed = 0; seed < n; ++seed) {
+        if (placed[seed]) {
+            continue;
+        }
+        // George-Liu: hop to a minimum-degree vertex of the last level while that deepens
+        // the level structure
+        auto root = static_cast<std::uint32_t>(seed);
+        std::size_t eccentricity = levels(root);
+        for (int hop = 0; hop < 8; ++hop) {
+            const std::uint32_t candidate = *std::min_element(
+                lastLevel.begin(), lastLevel.end(),
+                [&degree](std::uint32_t a, std::uint32_t b) { return degree[a] < degree[b]; });
+            const std::size_t e = levels(candidate);
+            if (e <= eccentricity) {
+                break;
+            }
+            root = candidate;
+            eccentricity = e;
+        }
+
+        // Cuthill-McKee: breadth-first, each vertex's unplaced neighbours by increasing degree
+        std::size_t head = order.size();
+        order.push_back(root);
+        placed[root] = true;
+        while (head < order.size()) {
+            const std::uint32_t v = order[head++];
+            neighbours.clear();
+            for (std::uint32_t p = offsets[v]; p < offsets[v + 1]; ++p) {
+                const std::uint32_t u = indices[p];
+                if (!placed[u]) {
+                    placed[u] = true;
+                    neighbours.push_back(u);
+                }
+            }
+            std::sort(neighbours.begin(), neighbours.end(), [&degree](std::uint32_t a, std::uint32_t b) {
+                return degree[a] != degree[b] ? degree[a] < degree[b] : a < b;
+            });
+            order.insert(order.end(), neighbours.begin(), neighbours.end());
+        }
+    }
+    std::reverse(order.begin(), order.end());
+    return order;
+}
+
+std::vector<std::uint32_t> invertPermutation(std::span<const std::uint32_t> order) {
+    std::vector<std::uint32_t> inverse(order.size());
+    for (std::size_t i = 0; i < order.size(); ++i) {
+        inverse[order[i]] = static_cast<std::uint32_t>(i);
+    }
+    return inverse;
+}
+
+#define LINALG_INSTANTIATE_SPARSE(T)                                                                        \
+    template class SparseMatrix<T>;                                                                         \
+    template bool spmv<T>(const SparseMatrix<T>&, std::span<const T>, std::span<T>, T, T, unsigned);        \
+    template bool spmm<T>(const SparseMatrix<T>&, MatrixRef<const T>, MatrixRef<T>, T, T, unsigned);        \
+    template std::vector<std::uint32_t> reverseCuthillMcKee<T>(const SparseMatrix<T>&);
+
+LINALG_INSTANTIATE_SPARSE(float)
+LINALG_INSTANTIATE_SPARSE(double)
+
+#undef LINALG_INSTANTIATE_SPARSE
+
+} // namespace math
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "math/Matrix.hpp"
+
+namespace math {
+
+// One (row, col, value) entry for assembling a SparseMatrix. Duplicates are allowed and
+// summed, which is how per-triangle contributions to a mesh operator accumulate.
+template <class T>
+struct Triplet {
+    std::uint32_t row{};
+    std::uint32_t col{};
+    T value{};
+};
+
+// Compressed sparse matrix: CSR for Layout::RowMajor, CSC for Layout::ColMajor. The
+// "outer" dimension (rows for CSR, columns for CSC) indexes Offsets(); entries of outer
+// slice k are Indices()/Values()[Offsets()[k], Offsets()[k + 1]), sorted by inner index
+// with no duplicates. 32-bit indices: up to 2^32 - 1 rows, columns and non-zeros.
+template <class T>
+class SparseMatrix {
+public:
+    SparseMatrix() = default;
+    // Empty (all zero) rows x cols
+    SparseMatrix(std::size_t rows, std::size_t cols, Layout layout = Layout::RowMajor);
+
+    // Sums duplicate (row, col) entries; entries outside rows x cols are dropped. Two
+    // counting-sort passes, so assembly is linear in the number of triplets. Explicit zeros
+    // (including sums that cancel) are kept as stored entries.
+    static SparseMatrix FromTriplets(std::size_t rows, std::size_t cols, std::span<const Triplet<T>> triplets,
+                                     Layout layout = Layout::RowMajor);
+    static SparseMatrix Identity(std::size_t n, Layout layout = Layout::RowMajor);
+
+    std::size_t Rows() const { return rows_; }
+    std::size_t Cols() const { return cols_; }
+    std::size_t NonZeros() const { return values_.size(); }
+    Layout GetLayout() const { return layout_; }
+    std::size_t OuterSize() const { return layout_ == Layout::RowMajor ? rows_ : cols_; }
+
+    std::span<const std::uint32_t> Offsets() const { return offsets_; }
+    std::span<const std::uint32_t> Indices() const { return indices_; }
+    std::span<const T> Values() const { return values_; }
+    // Values can be rescaled in place; the pattern is fixed
+    std::span<T> Values() { return values_; }
+
+    // Stored value at (r, c), 0 when absent. Binary search within the outer slice.
+    T operator()(std::size_t r, std::size_t c) const;
+
+    // Same matrix in the other compressed form (a copy even when the layout already matches).
+    SparseMatrix WithLayout(Layout layout) const;
+    // Transpose as a view change, like Matrix::Transposed: CSR of A is CSC of A^T.
+    SparseMatrix Transposed() &&;
+    SparseMatrix Transposed() const& { return SparseMatrix(*this).Transposed(); }
+
+    // min(rows, cols) diagonal entries, 0 where not stored.
+    std::vector<T> Diagonal() const;
+    // Largest |r - c| over stored entries: how far a row's reads stray from its own index.
+    std::size_t Bandwidth() const;
+    // P A P^T for square A: entry (i, j) of the result is A(order[i], order[j]), i.e. order[new] = old.
+    SparseMatrix Permuted(std::span<const std::uint32_t> order) const;
+    Matrix<T> ToDense(Layout layout = Layout::RowMajor) const;
+
+private:
+    std::size_t rows_{};
+    std::size_t cols_{};
+    Layout layout_{Layout::RowMajor};
+    std::vector<std::uint32_t> offsets_{0}; // OuterSize() + 1
+    std::vector<std::uint32_t> indices_;
+    std::vector<T> values_;
+};
+
+// y = alpha * A x + beta * y (beta = 0 overwrites y, even NaNs). CSR rows are split into
+// chunks of roughly equal non-zeros across `threads` threads (0: every hardware thread)
+// once A has enough entries to pay for starting them; CSC scatters into y and runs on the
+// calling thread. False (y untouched) when the sizes don't agree.
+template <class T>
+bool spmv(const SparseMatrix<T>& A, std::span<const T> x, std::span<T> y, T alpha = T{1}, T beta = T{0},
+          unsigned threads = 0);
+
+// Y = alpha * A X + beta * Y with dense X (A.Cols() x k) and Y (A.Rows() x k), any layout.
+// Each stored entry of A is loaded once for all k columns, so smoothing xyz positions is
+// one pass over the matrix rather than three. Same threading and contract as spmv.
+template <class T>
+bool spmm(const SparseMatrix<T>& A, MatrixRef<const T> X, MatrixRef<T> Y, T alpha = T{1}, T beta = T{0},
+          unsigned threads = 0);
+
+template <class T>
+bool spmm(const SparseMatrix<T>& A, const Matrix<T>& X, Matrix<T>& Y, T alpha = T{1}, T beta = T{0},
+          unsigned threads = 0) {
+    return spmm<T>(A, X.Ref(), Y.Ref(), alpha, beta, threads);
+}
+
+// Reverse Cuthill-McKee ordering of a square matrix with a symmetric pattern (mesh
+// operators are): breadth-first from a pseudo-peripheral vertex of each connected
+// component, neighbours visited by increasing degree, the whole order reversed. Feed the
+// result to Permuted() to get a small bandwidth, so SpMV reads of x stay near the row
+// being computed. Returns order[new] = old.
+template <class T>
+std::vector<std::uint32_t> reverseCuthillMcKee(const SparseMatrix<T>& A);
+
+// Inverse of a permutation: inverse[order[i]] = i.
+std::vector<std::uint32_t> invertPermutation(std::span<const std::uint32_t> order);
+
+} // namespace math
@@ -2,6 +2,28 @@
 
 #include <glm/glm.hpp>
 
-using Vec3 = glm::vec3;
-using Vec4 = glm::vec4;
-using Mat4 = glm::mat4;
+// Scalar-templated forms (glm's own templates), for code written once for float and
+// double: float where throughput matters, double where float runs out of precision
+// (large distances, far planes). Vec3, Vec4, Mat3 and Mat4 are the float instances the
+// rest of the code uses.
+template <class T>
+using TVec2 = glm::vec<2, T, glm::defaultp>;
+template <class T>
+using TVec3 = glm::vec<3, T, glm::defaultp>;
+template <class T>
+using TVec4 = glm::vec<4, T, glm::defaultp>;
+template <class T>
+using TMat3 = glm::mat<3, 3, T, glm::defaultp>;
+template <class T>
+using TMat4 = glm::mat<4, 4, T, glm::defaultp>;
+
+using Vec2 = TVec2<float>;
+using Vec3 = TVec3<float>;
+using Vec4 = TVec4<float>;
+using Mat3 = TMat3<float>;
+using Mat4 = TMat4<float>;
+
+using Vec3d = TVec3<double>;
+using Vec4d = TVec4<double>;
+using Mat3d = TMat3<double>;
+using Mat4d = TMat4<double>;
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+
+#include "math/Aligned.hpp"
+#include "math/Types.hpp"
+
+namespace math {
+
+// Structure-of-arrays Vec3 storage. Arrays are padded to a multiple of kSimdLanes
+// (padding is zero) so batched kernels can run whole lane blocks without a tail loop.
+struct Vec3Batch {
+    AlignedVector<float> x, y, z;
+    std::size_t count{};
+
+    Vec3Batch() = default;
+    explicit Vec3Batch(std::size_t n) { resize(n); }
+
+    std::size_t size() const { return count; }
+    std::size_t paddedSize() const { return x.size(); }
+
+    // Resizes and zero-fills.
+    void resize(std::size_t n) {
+        count = n;
+        const std::size_t padded = PadToLanes(n);
+        x.assign(padded, 0.f);
+        y.assign(padded, 0.f);
+        z.assign(padded, 0.f);
+    }
+
+    void set(std::size_t i, const Vec3& v) {
+        x[i] = v.x;
+        y[i] = v.y;
+        z[i] = v.z;
+    }
+
+    Vec3 get(std::size_t i) const { return {x[i], y[i], z[i]}; }
+};
+
+} // namespace math
@@ -0,0 +1,192 @@
+#include "render/LaplacianDeform.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <utility>
+
+#include "render/MeshLaplacian.hpp"
+
+namespace render {
+
+LaplacianDeformer::LaplacianDeformer(const IndexedMesh& mesh, std::span<const VertexRole> roles,
+                                     math::PreconditionerKind preconditioner)
+    : rest_(mesh.positions),
+      roles_(roles.begin(), roles.end()) {
+    const std::size_t n = mesh.VertexCount();
+    roles_.resize(n, VertexRole::Free);
+    slot_.resize(n);
+    std::uint32_t freeCount = 0;
+    for (std::size_t v = 0; v < n; ++v) {
+        if (roles_[v] == VertexRole::Free) {
+            slot_[v] = freeCount++;
+        } else {
+            slot_[v] = static_cast<std::uint32_t>(constrained_.size());
+            constrained_.push_back(static_cast<std::uint32_t>(v));
+        }
+    }
+
+    // Split the free rows of L into the free block and the coupling to the constraints
+    const math::SparseMatrix<float> L = GraphLaplacian(mesh);
+    std::vector<math::Triplet<float>> free, coupling;
+    free.reserve(L.NonZeros());
+    for (std::size_t v = 0; v < n; ++v) {
+        if (roles_[v] != VertexRole::Free) {
+            continue;
+        }
+        for (std::uint32_t p = L.Offsets()[v]; p < L.Offsets()[v + 1]; ++p) {
+            const std::uint32_t u = L.Indices()[p];
+            auto& list = roles_[u] == VertexRole::Free ? free : coupling;
+            list.push_back({slot_[v], slot_[u], L.Values()[p]});
+        }
+    }
+    A_ = math::SparseMatrix<float>::FromTriplets(freeCount, freeCount, free);
+    B_ = math::SparseMatrix<float>::FromTriplets(freeCount, constrained_.size(), coupling);
+    preconditioner_ = math::Preconditioner<float>(A_, preconditioner);
+
+    // delta = L x_rest, kept for the free rows; the rest pose is the first warm start
+    const math::Matrix<float> rest = PositionMatrix(rest_);
+    math::Matrix<float> delta(n, 3);
+    math::spmm(L, rest, delta);
+    for (int c = 0; c < 3; ++c) {
+        delta_[c].resize(freeCount);
+        solution_[c].resize(freeCount);
+        targets_[c].resize(constrained_.size());
+    }
+    for (std::size_t v = 0; v < n; ++v) {
+        for (int c = 0; c < 3; ++c) {
+            if (roles_[v] == VertexRole::Free) {
+                delta_[c][slot_[v]] = delta(v, static_cast<std::size_t>(c));
+                solution_[c][slot_[v]] = rest_[v][c];
+            }
+        }
+    }
+    SetHandleTransform(Mat4(1.f));
+}
+
+void LaplacianDeformer::SetHandleTransform(const Mat4& transform) {
+    for (std::size_t k = 0; k < constrained_.size(); ++k) {
+        const std::uint32_t v = constrained_[k];
+        const Vec3 target = roles_[v] == VertexRole::Handle ? Vec3(transform * Vec4(rest_[v], 1.f)) : rest_[v];
+        for (int c = 0; c < 3; ++c) {
+            targets_[c][k] = target[c];
+        }
+    }
+    for (int c = 0; c < 3; ++c) {
+        rhs_[c] = delta_[c];
+        math::spmv<float>(B_, targets_[c], rhs_[c], -1.f, 1.f);
+    }
+}
+
+DeformStats LaplacianDeformer::Solve(const math::CgSettings<float>& settings) {
+    using Clock = std::chrono::steady_clock;
+    const auto start = Clock::now();
+    DeformStats stats;
+    stats.converged = true;
+    math::CgSettings<float> perCoordinate = settings;
+    perCoordinate.budgetMs = settings.budgetMs / 3.0;
+    for (int c = 0; c < 3; ++c) {
+        const math::CgResult<float> result =
+            math::conjugateGradient<float>(A_, rhs_[c], solution_[c], perCoordinate, preconditioner_);
+        stats.iterations += result.iterations;
+        stats.residual = std::max(stats.residual, result.residual);
+        stats.converged = stats.converged && result.converged;
+    }
+    stats.solveMs = static_cast<float>(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+    return stats;
+}
+
+void LaplacianDeformer::Positions(std::vector<Vec3>& out) const {
+    out.resize(rest_.size());
+    for (std::size_t v = 0; v < rest_.size(); ++v) {
+        const auto& source = roles_[v] == VertexRole::Free ? solution_ : targets_;
+        const std::uint32_t k = slot_[v];
+        out[v] = {source[0][k], source[1][k], source[2][k]};
+    }
+}
+
+AsyncDeformer::AsyncDeformer(LaplacianDeformer deformer)
+    : deformer_(std::move(deformer)),
+      vertexCount_(deformer_.VertexCount()),
+      freeCount_(deformer_.FreeCount()),
+      worker_([this](std::stop_token stop) { Run(std::move(stop)); }) {}
+
+void AsyncDeformer::Request(const Mat4& handleTransform, const math::CgSettings<float>& settings) {
+    {
+        std::lock_guard lock(mutex_);
+        pending_ = true;
+        transform_ = handleTransform;
+        settings_ = settings;
+        busy_.store(true, std::memory_order_relaxed);
+    }
+    wake_.notify_one();
+}
+
+bool AsyncDeformer::Poll(std::vector<Vec3>& positions, DeformStats& stats) {
+    std::lock_guard lock(mutex_);
+    if (!fresh_) {
+        return false;
+    }
+    positions.swap(published_);
+    stats = publishedStats_;
+    fresh_ = false;
+    return true;
+}
+
+void SliceProgress::Reset() {
+    best_ = std::numeric_limits<float>::infinity();
+    stalled_ = 0;
+}
+
+bool SliceProgress::Continue(const DeformStats& stats) {
+    if (stats.converged || stats.iterations == 0) {
+        return false;
+    }
+    if (stats.residual < best_ * (1.f - kMinImprovement)) {
+        best_ = stats.residual;
+        stalled_ = 0;
+        return true;
+    }
+    return ++stalled_ < kPatience;
+}
+
+void AsyncDeformer::Run(std::stop_token stop) {
+    std::vector<Vec3> positions;
+    math::CgSettings<float> settings;
+    bool converging = false;
+    SliceProgress progress;
+    while (true) {
+        bool request = false;
+        Mat4 transform{1.f};
+        {
+            std::unique_lock lock(mutex_);
+            if (!wake_.wait(lock, stop, [&] { return pending_ || converging; })) {
+                return; // stop requested
+            }
+            if (pending_) {
+                request = true;
+                transform = transform_;
+                settings = settings_;
+                pending_ = false;
+            }
+        }
+        if (request) {
+            deformer_.SetHandleTransform(transform);
+            progress.Reset();
+        }
+        const DeformStats stats = deformer_.Solve(settings);
+        deformer_.Positions(positions);
+        // Slices that keep failing to lower the residual mean CG broke down or stalled at the
+        // precision floor (e.g. an indefinite IC(0) even after the shift retry, or an
+        // unreachable tolerance): wait for the next request instead
+        converging = progress.Continue(stats);
+
+        std::lock_guard lock(mutex_);
+        published_.swap(positions);
+        publishedStats_ = stats;
+        fresh_ = true;
+        busy_.store(pending_ || converging, std::memory_order_relaxed);
+    }
+}
+
+} // namespace render
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include "math/ConjugateGradient.hpp"
+#include "math/Sparse.hpp"
+#include "math/Types.hpp"
+#include "render/Mesh.hpp"
+
+namespace render {
+
+enum class VertexRole : std::uint8_t {
+    Free,   // solved for
+    Anchor, // pinned at its rest position
+    Handle  // follows the handle transform
+};
+
+struct DeformStats {
+    std::size_t iterations{}; // CG iterations over the three coordinates
+    float residual{};         // largest relative residual of the three
+    bool converged{false};
+    float solveMs{};
+};
+
+// Laplacian editing with hard constraints: anchors stay put, handles follow a rigid
+// transform, and the free vertices solve L_ff x_f = delta_f - L_fc x_c for each coordinate,
+// where delta = L x_rest are the rest pose's differential coordinates. The surface detail
+// (delta) is kept while the constraints move. Uniform weights keep L_ff symmetric positive
+// definite as long as every connected part has a constraint; mesh vertices must be shared.
+class LaplacianDeformer {
+public:
+    LaplacianDeformer() = default;
+    LaplacianDeformer(const IndexedMesh& mesh, std::span<const VertexRole> roles,
+                      math::PreconditionerKind preconditioner);
+
+    std::size_t VertexCount() const { return rest_.size(); }
+    std::size_t FreeCount() const { return A_.Rows(); }
+    math::PreconditionerKind Preconditioner() const { return preconditioner_.Kind(); }
+
+    // Moves the handles to transform * rest. The current solution stays as the warm start.
+    void SetHandleTransform(const Mat4& transform);
+    // CG on x, y and z, each continuing from the current solution; budgetMs (if set) is
+    // split evenly between the three.
+    DeformStats Solve(const math::CgSettings<float>& settings);
+    // Constrained vertices at their targets, free ones at the current solution.
+    void Positions(std::vector<Vec3>& out) const;
+
+private:
+    std::vector<Vec3> rest_;
+    std::vector<VertexRole> roles_;
+    std::vector<std::uint32_t> slot_;        // vertex -> row of A_ (free) or column of B_ (constrained)
+    std::vector<std::uint32_t> constrained_; // constrained vertices in column order
+    math::SparseMatrix<float> A_;            // L_ff
+    math::SparseMatrix<float> B_;            // L_fc
+    math::Preconditioner<float> preconditioner_;
+    std::array<std::vector<float>, 3> delta_;    // delta_f per coordinate
+    std::array<std::vector<float>, 3> rhs_;      // delta_f - L_fc x_c
+    std::array<std::vector<float>, 3> solution_; // x_f
+    std::array<std::vector<float>, 3> targets_;  // x_c
+};
+
+// When AsyncDeformer keeps slicing. Every slice restarts CG and the CG residual norm is not
+// monotone, so one slice may end a little higher while the solve still converges: the
+// decision tracks the best residual of the current request and gives up only after
+// kPatience slices in a row that fail to improve on it by kMinImprovement (relative).
+class SliceProgress {
+public:
+    static constexpr int kPatience = 3;
+    static constexpr float kMinImprovement = 1e-3f;
+
+    // A new request: nothing seen yet.
+    void Reset();
+    // Whether to slice again after `stats`; false once converged, on a slice that made no
+    // iteration (CG broke down), or after kPatience slices without progress.
+    bool Continue(const DeformStats& stats);
+
+private:
+    float best_{std::numeric_limits<float>::infinity()};
+    int stalled_{};
+};
+
+// Runs a LaplacianDeformer on a worker thread so the render loop never waits for a solve.
+// Each request warm-starts from the last solution; the worker solves in slices of
+// settings.budgetMs and publishes the positions after every slice until converged (or until
+// slices stop lowering the residual, see SliceProgress), then sleeps until the next request. Requests
+// arriving mid-slice replace any older pending one.
+class AsyncDeformer {
+public:
+    explicit AsyncDeformer(LaplacianDeformer deformer);
+    AsyncDeformer(const AsyncDeformer&) = delete;
+    AsyncDeformer& operator=(const AsyncDeformer&) = delete;
+
+    void Request(const Mat4& handleTransform, const math::CgSettings<float>& settings);
+    // The latest result published since the previous Poll, swapped into `positions`; false
+    // (outputs untouched) when there is none. Never blocks on the solver.
+    bool Poll(std::vector<Vec3>& positions, DeformStats& stats);
+    // A request is pending or still converging.
+    bool Busy() const { return busy_.load(std::memory_order_relaxed); }
+    std::size_t VertexCount() const { return vertexCount_; }
+    std::size_t FreeCount() const { return freeCount_; }
+
+private:
+    void Run(std::stop_token stop);
+
+    LaplacianDeformer deformer_; // owned by the worker once started
+    std::size_t vertexCount_{};
+    std::size_t freeCount_{};
+
+    std::mutex mutex_;           // guards everything below except busy_
+    std::condition_variable_any wake_;
+    bool pending_{false};
+    Mat4 transform_{1.f};
+    math::CgSettings<float> settings_;
+    bool fresh_{false};
+    std::vector<Vec3> published_;
+    DeformStats publishedStats_;
+    std::atomic<bool> busy_{false};
+
+    std::jthread worker_; // last: started once the state above exists; stopped and joined first
+};
+
+} // namespace render
@@ -1,35 +1,163 @@
 #include "render/Mesh.hpp"
 
+#include <cmath>
+#include <unordered_map>
+
 namespace render {
 
-CubeMesh MakeCube(float halfSize) {
-    const float zNear = -halfSize;
-    const float zFar = halfSize;
-
-    CubeMesh mesh;
-    mesh.vertices = {{
-        {-halfSize,  halfSize,  zNear}, { halfSize,  halfSize,  zNear},
-        { halfSize, -halfSize,  zNear}, {-halfSize, -halfSize,  zNear},
-        {-halfSize,  halfSize,  zFar }, { halfSize,  halfSize,  zFar },
-        { halfSize, -halfSize,  zFar }, {-halfSize, -halfSize,  zFar }
-    }};
-
-    mesh.faces = {{
-        {{0, 1, 2, 3}}, // near
-        {{4, 5, 6, 7}}, // far
-        {{0, 1, 5, 4}}, // top
-        {{3, 2, 6, 7}}, // bottom
-        {{1, 2, 6, 5}}, // right
-        {{0, 3, 7, 4}}  // left
-    }};
-
-    mesh.edges = {{
-        {0, 1}, {1, 2}, {2, 3}, {3, 0},
-        {4, 5}, {5, 6}, {6, 7}, {7, 4},
-        {0, 4}, {1, 5}, {2, 6}, {3, 7}
-    }};
+IndexedMesh MakeIndexedCube(const CubeMesh& cube) {
+    return ToIndexedMesh(MakeFixedIndexedCube(cube));
+}
+
+IndexedMesh MakeSphere(float radius, int rings, int segments) {
+    IndexedMesh mesh;
+    const auto segCount = static_cast<std::uint32_t>(segments + 1); // seam vertices duplicated
+    for (int r = 0; r <= rings; ++r) {
+        for (int s = 0; s <= segments; ++s) {
+            const Vec3 n = SphereNormal(r, s, rings, segments);
+            mesh.positions.push_back(radius * n);
+            mesh.normals.push_back(n);
+        }
+    }
+
+    for (std::uint32_t r = 0; r < static_cast<std::uint32_t>(rings); ++r) {
+        for (std::uint32_t s = 0; s < static_cast<std::uint32_t>(segments); ++s) {
+            const std::uint32_t a = r * segCount + s;
+            const std::uint32_t b = a + 1;
+            const std::uint32_t c = a + segCount;
+            const std::uint32_t d = c + 1;
+            mesh.indices.insert(mesh.indices.end(), {a, b, c, b, d, c});
+        }
+    }
+    return mesh;
+}
+
+IndexedMesh MakeFloor(float halfSize, float y) {
+    IndexedMesh mesh;
+    mesh.positions = {{-halfSize, y, -halfSize}, {-halfSize, y, halfSize}, {halfSize, y, halfSize}, {halfSize, y, -halfSize}};
+    mesh.normals.assign(4, Vec3{0.f, 1.f, 0.f});
+    mesh.indices = {0, 1, 2, 0, 2, 3};
+    return mesh;
+}
+
+IndexedMesh MakeTube(float radius, float length, int rings, int segments) {
+    IndexedMesh mesh;
+    const auto ringCount = static_cast<std::uint32_t>(rings + 1);
+    const auto segCount = static_cast<std::uint32_t>(segments);
+    mesh.positions.reserve(ringCount * segCount);
+    mesh.normals.reserve(ringCount * segCount);
+
+    constexpr float kTwoPi = 6.28318530718f;
+    for (std::uint32_t r = 0; r < ringCount; ++r) {
+        const float y = length * static_cast<float>(r) / static_cast<float>(rings);
+        for (std::uint32_t s = 0; s < segCount; ++s) {
+            const float a = kTwoPi * static_cast<float>(s) / static_cast<float>(segments);
+            const Vec3 n{std::cos(a), 0.f, std::sin(a)};
+            mesh.positions.push_back({radius * n.x, y, radius * n.z});
+            mesh.normals.push_back(n);
+        }
+    }
+
+    mesh.indices.reserve(static_cast<std::size_t>(rings) * segCount * 6);
+    for (std::uint32_t r = 0; r + 1 < ringCount; ++r) {
+        for (std::uint32_t s = 0; s < segCount; ++s) {
+            const std::uint32_t a = r * segCount + s;
+            const std::uint32_t b = r * segCount + (s + 1) % segCount;
+            const std::uint32_t c = a + segCount;
+            const std::uint32_t d = b + segCount;
+            mesh.indices.insert(mesh.indices.end(), {a, c, b, b, c, d});
+        }
+    }
 
     return mesh;
 }
 
+IndexedMesh WeldVertices(const IndexedMesh& mesh, float tolerance) {
+    // Grid cell -> welded id
+    struct Cell {
+        std::int64_t x, y, z;
+        bool operator==(const Cell&) const = default;
+    };
+    struct CellHash {
+        std::size_t operator()(const Cell& c) const {
+            const auto h = static_cast<std::uint64_t>(c.x) * 0x9e3779b97f4a7c15ull ^
+                           static_cast<std::uint64_t>(c.y) * 0xc2b2ae3d27d4eb4full ^
+                           static_cast<std::uint64_t>(c.z) * 0x165667b19e3779f9ull;
+            return static_cast<std::size_t>(h ^ (h >> 29));
+        }
+    };
+    const float scale = 1.f / tolerance;
+    const auto cellOf = [scale](const Vec3& p) {
+        return Cell{std::llround(p.x * scale), std::llround(p.y * scale), std::llround(p.z * scale)};
+    };
+
+    IndexedMesh out;
+    std::unordered_map<Cell, std::uint32_t, CellHash> ids;
+    ids.reserve(mesh.VertexCount());
+    std::vector<std::uint32_t> remap(mesh.VertexCount());
+    const bool hasNormals = mesh.normals.size() == mesh.VertexCount();
+    for (std::size_t i = 0; i < mesh.VertexCount(); ++i) {
+        const auto [it, inserted] = ids.try_emplace(cellOf(mesh.positions[i]), static_cast<std::uint32_t>(out.positions.size()));
+        if (inserted) {
+            out.positions.push_back(mesh.positions[i]);
+            out.normals.push_back(hasNormals ? mesh.normals[i] : Vec3{});
+        } else if (hasNormals) {
+            out.normals[it->second] += mesh.normals[i];
+        }
+        remap[i] = it->second;
+    }
+    for (Vec3& n : out.normals) {
+        const float len = glm::length(n);
+        n = len > 0.f ? n / len : Vec3{0.f, 1.f, 0.f};
+    }
+
+    out.indices.reserve(mesh.indices.size());
+    for (std::size_t t = 0; t < mesh.TriangleCount(); ++t) {
+        const std::uint32_t a = remap[mesh.indices[3 * t]];
+        const std::uint32_t b = remap[mesh.indices[3 * t + 1]];
+        const std::uint32_t c = remap[mesh.indices[3 * t + 2]];
+        if (a != b && b != c && c != a) {
+            out.indices.insert(out.indices.end(), {a, b, c});
+        }
+    }
+    return out;
+}
+
+IndexedMesh ReorderVertices(const IndexedMesh& mesh, std::span<const std::uint32_t> order) {
+    IndexedMesh out;
+    out.positions.resize(order.size());
+    out.normals.resize(mesh.normals.size() == mesh.VertexCount() ? order.size() : 0);
+    std::vector<std::uint32_t> inverse(mesh.VertexCount());
+    for (std::size_t i = 0; i < order.size(); ++i) {
+        out.positions[i] = mesh.positions[order[i]];
+        if (!out.normals.empty()) {
+            out.normals[i] = mesh.normals[order[i]];
+        }
+        inverse[order[i]] = static_cast<std::uint32_t>(i);
+    }
+    out.indices.resize(mesh.indices.size());
+    for (std::size_t k = 0; k < mesh.indices.size(); ++k) {
+        out.indices[k] = inverse[mesh.indices[k]];
+    }
+    return out;
+}
+
+void ComputeVertexNormals(IndexedMesh& mesh) {
+    mesh.normals.assign(mesh.VertexCount(), Vec3{});
+    for (std::size_t t = 0; t < mesh.TriangleCount(); ++t) {
+        const std::uint32_t a = mesh.indices[3 * t];
+        const std::uint32_t b = mesh.indices[3 * t + 1];
+        const std::uint32_t c = mesh.indices[3 * t + 2];
+        // The unnormalized cross product is twice the area: larger faces weigh more
+        const Vec3 n = glm::cross(mesh.positions[b] - mesh.positions[a], mesh.positions[c] - mesh.positions[a]);
+        mesh.normals[a] += n;
+        mesh.normals[b] += n;
+        mesh.normals[c] += n;
+    }
+    for (Vec3& n : mesh.normals) {
+        const float len = glm::length(n);
+        n = len > 0.f ? n / len : Vec3{0.f, 1.f, 0.f};
+    }
+}
+
 } // namespace render
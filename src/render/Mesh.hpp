@@ -1,8 +1,12 @@
 #pragma once
 
 #include <array>
+#include <cstdint>
+#include <span>
 #include <utility>
+#include <vector>
 
+#include "math/Constexpr.hpp"
 #include "math/Types.hpp"
 
 namespace render {
@@ -13,6 +17,148 @@ struct CubeMesh {
     std::array<std::pair<int, int>, 12> edges{};
 };
 
-CubeMesh MakeCube(float halfSize);
+constexpr CubeMesh MakeCube(float halfSize) {
+    const float zNear = -halfSize;
+    const float zFar = halfSize;
+    return {
+        {{
+            {-halfSize,  halfSize,  zNear}, { halfSize,  halfSize,  zNear},
+            { halfSize, -halfSize,  zNear}, {-halfSize, -halfSize,  zNear},
+            {-halfSize,  halfSize,  zFar }, { halfSize,  halfSize,  zFar },
+            { halfSize, -halfSize,  zFar }, {-halfSize, -halfSize,  zFar }
+        }},
+        {{
+            {{0, 1, 2, 3}}, // near
+            {{4, 5, 6, 7}}, // far
+            {{0, 1, 5, 4}}, // top
+            {{3, 2, 6, 7}}, // bottom
+            {{1, 2, 6, 5}}, // right
+            {{0, 3, 7, 4}}  // left
+        }},
+        {{
+            {0, 1}, {1, 2}, {2, 3}, {3, 0},
+            {4, 5}, {5, 6}, {6, 7}, {7, 4},
+            {0, 4}, {1, 5}, {2, 6}, {3, 7}
+        }}
+    };
+}
+
+// General triangle mesh: shared vertices referenced by a triangle-list index buffer.
+struct IndexedMesh {
+    std::vector<Vec3> positions;
+    std::vector<Vec3> normals;
+    std::vector<std::uint32_t> indices;
+
+    std::size_t VertexCount() const { return positions.size(); }
+    std::size_t TriangleCount() const { return indices.size() / 3; }
+};
+
+// An IndexedMesh with its sizes fixed at compile time, so that constexpr generators can
+// build it: `constexpr auto mesh = MakeFixedSphere<16, 24>(1.f)` is computed by the
+// compiler and kept in read-only data; ToIndexedMesh copies it out for the renderers.
+template <std::size_t Vertices, std::size_t Indices>
+struct FixedMesh {
+    std::array<Vec3, Vertices> positions{};
+    std::array<Vec3, Vertices> normals{};
+    std::array<std::uint32_t, Indices> indices{};
+};
+
+template <std::size_t Vertices, std::size_t Indices>
+IndexedMesh ToIndexedMesh(const FixedMesh<Vertices, Indices>& mesh) {
+    return {{mesh.positions.begin(), mesh.positions.end()},
+            {mesh.normals.begin(), mesh.normals.end()},
+            {mesh.indices.begin(), mesh.indices.end()}};
+}
+
+// Indexed version of a CubeMesh: 4 vertices per face with the outward face normal,
+// triangles wound counter-clockwise seen from outside.
+constexpr FixedMesh<24, 36> MakeFixedIndexedCube(const CubeMesh& cube) {
+    namespace cx = math::cx;
+    FixedMesh<24, 36> mesh;
+    std::uint32_t base = 0;
+    std::size_t index = 0;
+    for (const auto& face : cube.faces) {
+        const Vec3 a = cube.vertices[face[0]];
+        const Vec3 b = cube.vertices[face[1]];
+        const Vec3 d = cube.vertices[face[3]];
+        const Vec3 center = cx::scale(cx::add(cx::add(a, b), cx::add(cube.vertices[face[2]], d)), 0.25f);
+        Vec3 n = cx::normalize(cx::cross(cx::sub(b, a), cx::sub(d, a)));
+        const bool flip = cx::dot(n, center) < 0.f; // the face lists are not consistently wound
+        if (flip) {
+            n = cx::scale(n, -1.f);
+        }
+
+        for (std::uint32_t k = 0; k < 4; ++k) {
+            mesh.positions[base + k] = cube.vertices[face[k]];
+            mesh.normals[base + k] = n;
+        }
+        const std::array<std::uint32_t, 6> quad = flip
+            ? std::array<std::uint32_t, 6>{base, base + 2, base + 1, base, base + 3, base + 2}
+            : std::array<std::uint32_t, 6>{base, base + 1, base + 2, base, base + 2, base + 3};
+        for (const std::uint32_t i : quad) {
+            mesh.indices[index++] = i;
+        }
+        base += 4;
+    }
+    return mesh;
+}
+
+IndexedMesh MakeIndexedCube(const CubeMesh& cube);
+
+// Unit normal (= position on the unit sphere) of UV-sphere vertex s of ring r.
+constexpr Vec3 SphereNormal(int r, int s, int rings, int segments) {
+    namespace cx = math::cx;
+    const float theta = cx::kPi * static_cast<float>(r) / static_cast<float>(rings);
+    const float phi = 2.f * cx::kPi * static_cast<float>(s) / static_cast<float>(segments);
+    return {cx::sin(theta) * cx::cos(phi), cx::cos(theta), cx::sin(theta) * cx::sin(phi)};
+}
+
+// UV sphere centred at the origin: `rings` latitude bands of `segments` quads each, wound
+// counter-clockwise seen from outside. Seam and pole vertices are duplicated (WeldVertices).
+IndexedMesh MakeSphere(float radius, int rings, int segments);
+
+// The same with the resolution fixed at compile time, for spheres built by the compiler.
+template <int Rings, int Segments>
+constexpr auto MakeFixedSphere(float radius) {
+    static_assert(Rings > 0 && Segments > 2);
+    constexpr std::uint32_t segCount = Segments + 1;
+    FixedMesh<(Rings + 1) * (Segments + 1), Rings * Segments * 6> mesh;
+    std::size_t v = 0;
+    for (int r = 0; r <= Rings; ++r) {
+        for (int s = 0; s <= Segments; ++s, ++v) {
+            mesh.normals[v] = SphereNormal(r, s, Rings, Segments);
+            mesh.positions[v] = math::cx::scale(mesh.normals[v], radius);
+        }
+    }
+    std::size_t k = 0;
+    for (std::uint32_t r = 0; r < Rings; ++r) {
+        for (std::uint32_t s = 0; s < Segments; ++s) {
+            const std::uint32_t a = r * segCount + s;
+            const std::uint32_t c = a + segCount;
+            for (const std::uint32_t i : {a, a + 1, c, a + 1, c + 1, c}) {
+                mesh.indices[k++] = i;
+            }
+        }
+    }
+    return mesh;
+}
+
+// Horizontal square at height y facing up (+y), as two triangles.
+IndexedMesh MakeFloor(float halfSize, float y);
+
+// Open cylinder along +y from y = 0 to y = length, `rings` + 1 vertex rings of `segments` each.
+IndexedMesh MakeTube(float radius, float length, int rings, int segments);
+
+// Merges vertices whose positions agree to within `tolerance` (snapped to a grid of that
+// spacing, so near-equal points on opposite sides of a cell boundary stay apart) and drops
+// triangles that collapse. Generators duplicate seam and pole vertices for their normals;
+// operators built from adjacency need them shared. Merged normals are averaged.
+IndexedMesh WeldVertices(const IndexedMesh& mesh, float tolerance = 1e-5f);
+
+// Vertices renumbered so that new vertex i is old vertex order[i]; indices follow.
+IndexedMesh ReorderVertices(const IndexedMesh& mesh, std::span<const std::uint32_t> order);
+
+// Area-weighted vertex normals from the triangles (positions are left alone).
+void ComputeVertexNormals(IndexedMesh& mesh);
 
 } // namespace render
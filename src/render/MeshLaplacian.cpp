@@ -0,0 +1,112 @@
+#include "render/MeshLaplacian.hpp"
+
+#include <utility>
+
+namespace render {
+
+namespace {
+
+using Triplets = std::vector<math::Triplet<float>>;
+
+// Adds w to edge (i, j) of L = D - W: -w off the diagonal, +w on both diagonal entries.
+void AddEdge(Triplets& triplets, std::uint32_t i, std::uint32_t j, float w) {
+    triplets.push_back({i, j, -w});
+    triplets.push_back({j, i, -w});
+    triplets.push_back({i, i, w});
+    triplets.push_back({j, j, w});
+}
+
+} // namespace
+
+math::SparseMatrix<float> GraphLaplacian(const IndexedMesh& mesh) {
+    // Interior edges come from two triangles and sum to -2; the pattern is what matters,
+    // so the values are rewritten once duplicates are merged
+    Triplets triplets;
+    triplets.reserve(mesh.TriangleCount() * 12);
+    for (std::size_t t = 0; t < mesh.TriangleCount(); ++t) {
+        for (int k = 0; k < 3; ++k) {
+            AddEdge(triplets, mesh.indices[3 * t + k], mesh.indices[3 * t + (k + 1) % 3], 1.f);
+        }
+    }
+    auto L = math::SparseMatrix<float>::FromTriplets(mesh.VertexCount(), mesh.VertexCount(), triplets);
+
+    const std::span<const std::uint32_t> offsets = L.Offsets();
+    const std::span<const std::uint32_t> indices = L.Indices();
+    const std::span<float> values = L.Values();
+    for (std::size_t r = 0; r < L.Rows(); ++r) {
+        const float valence = static_cast<float>(offsets[r + 1] - offsets[r] - 1);
+        for (std::uint32_t p = offsets[r]; p < offsets[r + 1]; ++p) {
+            values[p] = indices[p] == r ? valence : -1.f;
+        }
+    }
+    return L;
+}
+
+math::SparseMatrix<float> CotangentLaplacian(const IndexedMesh& mesh) {
+    Triplets triplets;
+    triplets.reserve(mesh.TriangleCount() * 12);
+    for (std::size_t t = 0; t < mesh.TriangleCount(); ++t) {
+        const std::uint32_t* tri = &mesh.indices[3 * t];
+        const Vec3 p[3] = {mesh.positions[tri[0]], mesh.positions[tri[1]], mesh.positions[tri[2]]};
+        const float doubleArea = glm::length(glm::cross(p[1] - p[0], p[2] - p[0]));
+        if (!(doubleArea > 0.f)) {
+            continue; // degenerate: its angles are undefined
+        }
+        // Corner k is opposite edge (k + 1, k + 2); cot = (a . b) / |a x b|
+        for (int k = 0; k < 3; ++k) {
+            const int i = (k + 1) % 3;
+            const int j = (k + 2) % 3;
+            const float cot = glm::dot(p[i] - p[k], p[j] - p[k]) / doubleArea;
+            AddEdge(triplets, tri[i], tri[j], 0.5f * cot);
+        }
+    }
+    return math::SparseMatrix<float>::FromTriplets(mesh.VertexCount(), mesh.VertexCount(), triplets);
+}
+
+math::SparseMatrix<float> SmoothingOperator(const math::SparseMatrix<float>& laplacian, float lambda) {
+    math::SparseMatrix<float> S = laplacian.WithLayout(math::Layout::RowMajor);
+    const std::vector<float> diagonal = S.Diagonal();
+    const std::span<const std::uint32_t> offsets = S.Offsets();
+    const std::span<const std::uint32_t> indices = S.Indices();
+    const std::span<float> values = S.Values();
+    for (std::size_t r = 0; r < S.Rows(); ++r) {
+        const float d = diagonal[r];
+        const float scale = d > 0.f ? lambda / d : 0.f;
+        for (std::uint32_t p = offsets[r]; p < offsets[r + 1]; ++p) {
+            values[p] = (indices[p] == r ? 1.f : 0.f) - scale * values[p];
+        }
+    }
+    return S;
+}
+
+math::Matrix<float> PositionMatrix(std::span<const Vec3> positions) {
+    math::Matrix<float> m(positions.size(), 3);
+    for (std::size_t i = 0; i < positions.size(); ++i) {
+        m(i, 0) = positions[i].x;
+        m(i, 1) = positions[i].y;
+        m(i, 2) = positions[i].z;
+    }
+    return m;
+}
+
+void CopyPositions(const math::Matrix<float>& matrix, std::vector<Vec3>& positions) {
+    positions.resize(matrix.Rows());
+    for (std::size_t i = 0; i < positions.size(); ++i) {
+        positions[i] = {matrix(i, 0), matrix(i, 1), matrix(i, 2)};
+    }
+}
+
+void SmoothPositions(const math::SparseMatrix<float>& op, math::Matrix<float>& positions,
+                     math::Matrix<float>& scratch, int iterations, unsigned threads) {
+    if (scratch.Rows() != positions.Rows() || scratch.Cols() != positions.Cols()) {
+        scratch = math::Matrix<float>(positions.Rows(), positions.Cols(), positions.GetLayout());
+    }
+    for (int it = 0; it < iterations; ++it) {
+        if (!math::spmm(op, positions, scratch, 1.f, 0.f, threads)) {
+            return;
+        }
+        std::swap(positions, scratch);
+    }
+}
+
+} // namespace render
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include "math/Matrix.hpp"
+#include "math/Sparse.hpp"
+#include "math/Types.hpp"
+#include "render/Mesh.hpp"
+
+namespace render {
+
+// Mesh Laplacians L = D - W as symmetric CSR matrices: W holds one weight per edge, D the
+// row sums, so every row sums to zero and constants are in the null space. Triangles must
+// share vertices (WeldVertices first), otherwise seams fall apart under smoothing.
+
+// Uniform ("umbrella") weights: w_ij = 1 per edge, so D is the vertex valence.
+math::SparseMatrix<float> GraphLaplacian(const IndexedMesh& mesh);
+
+// Cotangent weights w_ij = (cot a_ij + cot b_ij) / 2 over the angles opposite edge ij.
+// Unlike uniform weights it depends on the geometry, not the triangulation: on a flat patch
+// L x = 0 at interior vertices, so smoothing doesn't drift vertices tangentially.
+math::SparseMatrix<float> CotangentLaplacian(const IndexedMesh& mesh);
+
+// One explicit smoothing step x <- x - lambda D^-1 L x, assembled once as S = I - lambda D^-1 L
+// (same pattern as L). lambda in (0, 1] moves each vertex that far towards the weighted
+// average of its neighbours; rows without positive weight (isolated vertices) stay put.
+math::SparseMatrix<float> SmoothingOperator(const math::SparseMatrix<float>& laplacian, float lambda);
+
+// Positions as an n x 3 row-major matrix, one vertex per row, as spmm takes them; and back.
+math::Matrix<float> PositionMatrix(std::span<const Vec3> positions);
+void CopyPositions(const math::Matrix<float>& matrix, std::vector<Vec3>& positions);
+
+// `iterations` applications of a smoothing operator to positions (n x 3), each one spmm
+// into scratch and a swap. threads as for spmm.
+void SmoothPositions(const math::SparseMatrix<float>& op, math::Matrix<float>& positions,
+                     math::Matrix<float>& scratch, int iterations, unsigned threads = 0);
+
+} // namespace render
@@ -0,0 +1,279 @@
+#include "render/MeshOptimize.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace render {
+
+namespace {
+
+// Vertex -> triangle adjacency in CSR form: the triangles using vertex v are
+// triangles[offsets[v] .. offsets[v + 1]).
+struct VertexTriangles {
+    std::vector<std::uint32_t> offsets;
+    std::vector<std::uint32_t> triangles;
+};
+
+VertexTriangles BuildVertexTriangles(std::span<const std::uint32_t> indices, std::size_t vertexCount) {
+    VertexTriangles adjacency;
+    adjacency.offsets.assign(vertexCount + 1, 0);
+    for (const std::uint32_t v : indices) {
+        ++adjacency.offsets[v + 1];
+    }
+    for (std::size_t v = 0; v < vertexCount; ++v) {
+        adjacency.offsets[v + 1] += adjacency.offsets[v];
+    }
+    adjacency.triangles.resize(indices.size());
+    std::vector<std::uint32_t> fill(adjacency.offsets.begin(), adjacency.offsets.end() - 1);
+    for (std::size_t k = 0; k < indices.size(); ++k) {
+        adjacency.triangles[fill[indices[k]]++] = static_cast<std::uint32_t>(k / 3);
+    }
+    return adjacency;
+}
+
+// Bounds and normal cone of one meshlet's triangles (meshoptimizer's construction).
+// normals and corners are scratch, reused across meshlets.
+void ComputeMeshletBounds(const IndexedMesh& mesh, const MeshletSet& set, Meshlet& m,
+                          std::vector<Vec3>& normals, std::vector<Vec3>& corners) {
+    const std::uint32_t* ids = set.vertices.data() + m.vertexOffset;
+    const std::uint8_t* tris = set.triangles.data() + m.triangleOffset;
+
+    Vec3 lo = mesh.positions[ids[0]];
+    Vec3 hi = lo;
+    for (std::uint32_t i = 1; i < m.vertexCount; ++i) {
+        lo = glm::min(lo, mesh.positions[ids[i]]);
+        hi = glm::max(hi, mesh.positions[ids[i]]);
+    }
+    m.center = 0.5f * (lo + hi);
+    m.radius = 0.f;
+    for (std::uint32_t i = 0; i < m.vertexCount; ++i) {
+        m.radius = std::max(m.radius, glm::distance(m.center, mesh.positions[ids[i]]));
+    }
+
+    normals.clear();
+    corners.clear();
+    Vec3 axis{0.f};
+    for (std::uint32_t t = 0; t < m.triangleCount; ++t) {
+        const Vec3& a = mesh.positions[ids[tris[3 * t]]];
+        const Vec3& b = mesh.positions[ids[tris[3 * t + 1]]];
+        const Vec3& c = mesh.positions[ids[tris[3 * t + 2]]];
+        const Vec3 n = glm::cross(b - a, c - a);
+        const float area = glm::length(n);
+        if (area <= 0.f) {
+            continue; // degenerate: faces nowhere
+        }
+        normals.push_back(n / area);
+        corners.push_back(a);
+        axis += normals.back();
+    }
+
+    const float axisLength = glm::length(axis);
+    float minDot = 1.f;
+    if (axisLength > 0.f) {
+        axis /= axisLength;
+        for (const Vec3& n : normals) {
+            minDot = std::min(minDot, glm::dot(n, axis));
+        }
+    }
+    // Spread past ~84 degrees: almost any view sees some triangle front-on
+    if (normals.empty() || axisLength <= 0.f || minDot <= 0.1f) {
+        m.coneApex = m.center;
+        m.coneAxis = Vec3(0.f);
+        m.coneCutoff = 1.f;
+        return;
+    }
+    // Apex on the ray center - t * axis behind every triangle's plane
+    float maxT = 0.f;
+    for (std::size_t t = 0; t < normals.size(); ++t) {
+        const float along = glm::dot(axis, normals[t]);
+        maxT = std::max(maxT, glm::dot(m.center - corners[t], normals[t]) / along);
+    }
+    m.coneApex = m.center - axis * maxT;
+    m.coneAxis = axis;
+    // The back-facing region is the normal cone widened by 90 degrees on each side and
+    // inverted: cos(spread + 90) negated, i.e. sin(spread)
+    m.coneCutoff = std::sqrt(1.f - minDot * minDot);
+}
+
+} // namespace
+
+double ComputeACMR(std::span<const std::uint32_t> indices, std::size_t vertexCount, std::size_t cacheSize) {
+    if (indices.size() < 3) {
+        return 0.0;
+    }
+    // FIFO: a vertex is resident while fewer than cacheSize misses happened since its own
+    std::vector<std::size_t> insertedAt(vertexCount, std::numeric_limits<std::size_t>::max());
+    std::size_t misses = 0;
+    for (const std::uint32_t v : indices) {
+        if (insertedAt[v] == std::numeric_limits<std::size_t>::max() || misses - insertedAt[v] >= cacheSize) {
+            insertedAt[v] = misses++;
+        }
+    }
+    return static_cast<double>(misses) / static_cast<double>(indices.size() / 3);
+}
+
+std::vector<std::uint32_t> OptimizeTriangleOrder(std::span<const std::uint32_t> indices,
+                                                 std::size_t vertexCount,
+                                                 std::size_t cacheSize) {
+    const std::size_t triangleCount = indices.size() / 3;
+    std::vector<std::uint32_t> out;
+    out.reserve(triangleCount * 3);
+    if (triangleCount == 0) {
+        return out;
+    }
+
+    const VertexTriangles adjacency = BuildVertexTriangles(indices, vertexCount);
+    std::vector<std::uint32_t> live(vertexCount); // triangles not yet emitted, per vertex
+    for (std::size_t v = 0; v < vertexCount; ++v) {
+        live[v] = adjacency.offsets[v + 1] - adjacency.offsets[v];
+    }
+    std::vector<std::size_t> cachedAt(vertexCount, 0); // time stamp of each vertex's last cache entry
+    std::vector<std::uint8_t> emitted(triangleCount, 0);
+    std::vector<std::uint32_t> deadEnds;   // recently used vertices, to resume from when a fan runs out
+    std::vector<std::uint32_t> candidates; // vertices of the fan just emitted
+    const auto k = static_cast<std::ptrdiff_t>(cacheSize);
+    std::ptrdiff_t time = k + 1;
+    std::size_t cursor = 1;
+
+    const auto skipDeadEnd = [&]() -> std::ptrdiff_t {
+        while (!deadEnds.empty()) {
+            const std::uint32_t d = deadEnds.back();
+            deadEnds.pop_back();
+            if (live[d] > 0) {
+                return d;
+            }
+        }
+        for (; cursor < vertexCount; ++cursor) {
+            if (live[cursor] > 0) {
+                return static_cast<std::ptrdiff_t>(cursor);
+            }
+        }
+        return -1;
+    };
+
+    std::ptrdiff_t fan = 0;
+    while (fan >= 0) {
+        candidates.clear();
+        for (std::uint32_t a = adjacency.offsets[fan]; a < adjacency.offsets[fan + 1]; ++a) {
+            const std::uint32_t t = adjacency.triangles[a];
+            if (emitted[t]) {
+                continue;
+            }
+            emitted[t] = 1;
+            for (int c = 0; c < 3; ++c) {
+                const std::uint32_t v = indices[3 * t + c];
+                out.push_back(v);
+                deadEnds.push_back(v);
+                candidates.push_back(v);
+                --live[v];
+                if (time - static_cast<std::ptrdiff_t>(cachedAt[v]) > k) {
+                    cachedAt[v] = static_cast<std::size_t>(time++);
+                }
+            }
+        }
+
+        // Next fan: the candidate that entered the cache earliest and will still be in it
+        // after its remaining triangles are emitted (each adds at most 2 new vertices)
+        std::ptrdiff_t next = -1;
+        std::ptrdiff_t best = -1;
+        for (const std::uint32_t v : candidates) {
+            if (live[v] == 0) {
+                continue;
+            }
+            const std::ptrdiff_t age = time - static_cast<std::ptrdiff_t>(cachedAt[v]);
+            const std::ptrdiff_t priority = age + 2 * static_cast<std::ptrdiff_t>(live[v]) <= k ? age : 0;
+            if (priority > best) {
+                best = priority;
+                next = v;
+            }
+        }
+        fan = next >= 0 ? next : skipDeadEnd();
+    }
+    return out;
+}
+
+std::vector<std::uint32_t> VertexFetchOrder(std::span<const std::uint32_t> indices, std::size_t vertexCount) {
+    std::vector<std::uint32_t> order;
+    order.reserve(vertexCount);
+    std::vector<std::uint8_t> seen(vertexCount, 0);
+    for (const std::uint32_t v : indices) {
+        if (!seen[v]) {
+            seen[v] = 1;
+            order.push_back(v);
+        }
+    }
+    for (std::uint32_t v = 0; v < vertexCount; ++v) {
+        if (!seen[v]) {
+            order.push_back(v);
+        }
+    }
+    return order;
+}
+
+MeshOptimizeReport OptimizeMesh(IndexedMesh& mesh, const MeshOptimizeOptions& options) {
+    MeshOptimizeReport report;
+    const std::size_t n = mesh.VertexCount();
+    report.acmrBefore = ComputeACMR(mesh.indices, n, options.cacheSize);
+    mesh.indices = OptimizeTriangleOrder(mesh.indices, n, options.cacheSize);
+    if (options.reorderVertices) {
+        mesh = ReorderVertices(mesh, VertexFetchOrder(mesh.indices, n));
+    }
+    report.acmrAfter = ComputeACMR(mesh.indices, n, options.cacheSize);
+    return report;
+}
+
+MeshletSet BuildMeshlets(const IndexedMesh& mesh, std::size_t maxVertices, std::size_t maxTriangles) {
+    MeshletSet set;
+    // Local index of each mesh vertex in the open meshlet, valid while stamp[v] == meshlet number
+    std::vector<std::uint8_t> local(mesh.VertexCount(), 0);
+    std::vector<std::uint32_t> stamp(mesh.VertexCount(), std::numeric_limits<std::uint32_t>::max());
+    Meshlet open;
+    std::vector<Vec3> normals;
+    std::vector<Vec3> corners;
+
+    const auto close = [&] {
+        if (open.triangleCount > 0) {
+            ComputeMeshletBounds(mesh, set, open, normals, corners);
+            set.meshlets.push_back(open);
+        }
+        open = Meshlet{};
+        open.vertexOffset = static_cast<std::uint32_t>(set.vertices.size());
+        open.triangleOffset = static_cast<std::uint32_t>(set.triangles.size());
+    };
+
+    for (std::size_t t = 0; t < mesh.TriangleCount(); ++t) {
+        const std::uint32_t* tri = mesh.indices.data() + 3 * t;
+        auto id = static_cast<std::uint32_t>(set.meshlets.size());
+        std::size_t added = 0;
+        for (int c = 0; c < 3; ++c) {
+            added += stamp[tri[c]] != id && (c == 0 || tri[c] != tri[0]) && (c < 2 || tri[c] != tri[1]) ? 1 : 0;
+        }
+        if (open.vertexCount + added > maxVertices || open.triangleCount + 1 > maxTriangles) {
+            close();
+            id = static_cast<std::uint32_t>(set.meshlets.size());
+        }
+        for (int c = 0; c < 3; ++c) {
+            const std::uint32_t v = tri[c];
+            if (stamp[v] != id) {
+                stamp[v] = id;
+                local[v] = static_cast<std::uint8_t>(open.vertexCount++);
+                set.vertices.push_back(v);
+            }
+            set.triangles.push_back(local[v]);
+        }
+        ++open.triangleCount;
+    }
+    close();
+    return set;
+}
+
+void UpdateMeshletBounds(const IndexedMesh& mesh, MeshletSet& set) {
+    std::vector<Vec3> normals;
+    std::vector<Vec3> corners;
+    for (Meshlet& m : set.meshlets) {
+        ComputeMeshletBounds(mesh, set, m, normals, corners);
+    }
+}
+
+} // namespace render
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "math/Types.hpp"
+#include "render/Mesh.hpp"
+
+namespace render {
+
+// FIFO post-transform cache size assumed by the ordering and the ACMR figures; 16 to 32
+// entries is typical of GPUs, and orders tuned for 16 hold up on larger caches.
+constexpr std::size_t kVertexCacheSize = 16;
+
+// Average cache miss ratio: vertices transformed per triangle through a FIFO cache of
+// `cacheSize` entries. 3 is the worst case, ~0.5 the limit for large regular meshes.
+double ComputeACMR(std::span<const std::uint32_t> indices, std::size_t vertexCount,
+                   std::size_t cacheSize = kVertexCacheSize);
+
+// Tipsify (Sander, Nehab and Barczak 2007): triangles re-emitted as fans around a vertex,
+// moving to the next fanning vertex still in the cache, so neighbouring triangles reuse
+// transformed vertices. Linear time; returns the new index buffer (same triangles, each
+// keeping its winding).
+std::vector<std::uint32_t> OptimizeTriangleOrder(std::span<const std::uint32_t> indices,
+                                                 std::size_t vertexCount,
+                                                 std::size_t cacheSize = kVertexCacheSize);
+
+// Vertices in order of first use by `indices`, unreferenced ones last: the order for
+// ReorderVertices that makes vertex reads walk memory forwards.
+std::vector<std::uint32_t> VertexFetchOrder(std::span<const std::uint32_t> indices, std::size_t vertexCount);
+
+struct MeshOptimizeOptions {
+    bool reorderVertices = true; // off: keep the vertex numbering (e.g. an RCM order other data shares)
+    std::size_t cacheSize = kVertexCacheSize;
+};
+
+struct MeshOptimizeReport {
+    double acmrBefore = 0.0;
+    double acmrAfter = 0.0;
+};
+
+// Triangle reordering, then vertex-fetch reordering unless disabled; the mesh is rewritten
+// in place. Run on every mesh as it is built or loaded.
+MeshOptimizeReport OptimizeMesh(IndexedMesh& mesh, const MeshOptimizeOptions& options = {});
+
+// A small cluster of triangles with its own vertex list, for culling whole groups at once.
+// The normal cone bounds the triangle normals: every triangle faces away from a viewer at
+// `eye` when dot(normalize(coneApex - eye), coneAxis) >= coneCutoff. Clusters too curved
+// to have a useful cone get coneCutoff = 1 and are never rejected by it.
+struct Meshlet {
+    std::uint32_t vertexOffset{};   // into MeshletSet::vertices
+    std::uint32_t vertexCount{};
+    std::uint32_t triangleOffset{}; // into MeshletSet::triangles, 3 entries per triangle
+    std::uint32_t triangleCount{};
+    Vec3 center{0.f};               // bounding sphere
+    float radius{};
+    Vec3 coneApex{0.f};
+    Vec3 coneAxis{0.f};
+    float coneCutoff = 1.f;         // sine of the cone's half-angle spread
+};
+
+struct MeshletSet {
+    std::vector<Meshlet> meshlets;
+    std::vector<std::uint32_t> vertices; // mesh vertex ids, per meshlet
+    std::vector<std::uint8_t> triangles; // indices into the meshlet's vertices
+};
+
+constexpr std::size_t kMeshletMaxVertices = 64;
+constexpr std::size_t kMeshletMaxTriangles = 124;
+
+// Greedy clustering in index-buffer order (so run OptimizeMesh first: a cache-friendly
+// order is also a compact one), closing a meshlet when the next triangle would overflow
+// either limit. maxVertices must be at most 256.
+MeshletSet BuildMeshlets(const IndexedMesh& mesh,
+                         std::size_t maxVertices = kMeshletMaxVertices,
+                         std::size_t maxTriangles = kMeshletMaxTriangles);
+
+// Bounds and cones recomputed from the mesh's current positions, clusters kept: for meshes
+// whose vertices move but whose triangles do not.
+void UpdateMeshletBounds(const IndexedMesh& mesh, MeshletSet& set);
+
+} // namespace render
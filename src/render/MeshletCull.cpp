@@ -0,0 +1,66 @@
+#include "render/MeshletCull.hpp"
+
+namespace render {
+
+std::array<Vec4, 6> FrustumPlanes(const Mat4& clip) {
+    // Row r of the matrix; glm stores columns
+    const auto row = [&](int r) { return Vec4(clip[0][r], clip[1][r], clip[2][r], clip[3][r]); };
+    const Vec4 x = row(0), y = row(1), z = row(2), w = row(3);
+    std::array<Vec4, 6> planes = {w + x, w - x, w + y, w - y, w + z, w - z};
+    for (Vec4& p : planes) {
+        p = p / glm::length(Vec3(p));
+    }
+    return planes;
+}
+
+MeshletCullStats CullMeshlets(const MeshletSet& set,
+                              const Mat4& modelViewProj,
+                              const Vec3& eye,
+                              bool backface,
+                              std::vector<std::uint32_t>& visible) {
+    const std::array<Vec4, 6> planes = FrustumPlanes(modelViewProj);
+    MeshletCullStats stats;
+    visible.clear();
+    for (std::size_t i = 0; i < set.meshlets.size(); ++i) {
+        const Meshlet& m = set.meshlets[i];
+        bool outside = false;
+        for (const Vec4& p : planes) {
+            outside |= glm::dot(Vec3(p), m.center) + p.w < -m.radius;
+        }
+        if (outside) {
+            ++stats.frustumCulled;
+            continue;
+        }
+        // coneCutoff = 1 marks a cluster with no useful cone; the test can never pass for it
+        const Vec3 toApex = m.coneApex - eye;
+        const float distance = glm::length(toApex);
+        if (backface && m.coneCutoff < 1.f && glm::dot(toApex, m.coneAxis) >= m.coneCutoff * distance) {
+            ++stats.backfaceCulled;
+            continue;
+        }
+        visible.push_back(static_cast<std::uint32_t>(i));
+        stats.vertices += m.vertexCount;
+        stats.triangles += m.triangleCount;
+    }
+    return stats;
+}
+
+void GatherMeshlets(const MeshletSet& set,
+                    std::span<const std::uint32_t> visible,
+                    std::vector<std::uint32_t>& vertexIds,
+                    std::vector<std::uint32_t>& indices) {
+    vertexIds.clear();
+    indices.clear();
+    for (const std::uint32_t i : visible) {
+        const Meshlet& m = set.meshlets[i];
+        const auto base = static_cast<std::uint32_t>(vertexIds.size());
+        vertexIds.insert(vertexIds.end(), set.vertices.begin() + m.vertexOffset,
+                         set.vertices.begin() + m.vertexOffset + m.vertexCount);
+        const std::uint8_t* local = set.triangles.data() + m.triangleOffset;
+        for (std::uint32_t k = 0; k < 3 * m.triangleCount; ++k) {
+            indices.push_back(base + local[k]);
+        }
+    }
+}
+
+} // namespace render
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "math/Types.hpp"
+#include "render/MeshOptimize.hpp"
+
+namespace render {
+
+// The six clip planes (n, d) of a clip matrix, unit normals pointing inwards: p is inside
+// when dot(n, p) + d >= 0 for all of them. Read off the matrix rows (Gribb and Hartmann)
+// for the -w <= z <= w depth range; from P * V * M the planes come out in M's model space.
+std::array<Vec4, 6> FrustumPlanes(const Mat4& clip);
+
+struct MeshletCullStats {
+    std::size_t frustumCulled{};    // bounding sphere wholly outside a plane
+    std::size_t backfaceCulled{};   // inside, but every triangle faces away (normal cone)
+    std::size_t vertices{};         // meshlet vertices of the survivors
+    std::size_t triangles{};
+};
+
+// Whole-meshlet rejection before any vertex is touched. Both tests run in the mesh's model
+// space, so the bounds are never transformed: the frustum comes from modelViewProj, and
+// `eye` is the camera position taken into model space (the cone test assumes a perspective
+// view; pass backface = false for parallel projections). `visible` is cleared and filled
+// with the indices of the meshlets that may contribute pixels.
+MeshletCullStats CullMeshlets(const MeshletSet& set,
+                              const Mat4& modelViewProj,
+                              const Vec3& eye,
+                              bool backface,
+                              std::vector<std::uint32_t>& visible);
+
+// Draw lists for the visible meshlets: vertexIds names the mesh vertex behind each output
+// vertex (the meshlets' own vertex lists concatenated, so vertices on a meshlet border
+// repeat, as in mesh shaders) and indices address vertexIds. Transforming vertexIds alone
+// is the whole per-frame vertex work. Both vectors are cleared first.
+void GatherMeshlets(const MeshletSet& set,
+                    std::span<const std::uint32_t> visible,
+                    std::vector<std::uint32_t>& vertexIds,
+                    std::vector<std::uint32_t>& indices);
+
+} // namespace render
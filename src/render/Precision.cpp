@@ -0,0 +1,159 @@
+#include "render/Precision.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "math/Affine.hpp"
+#include "render/Mesh.hpp"
+
+namespace render {
+
+namespace {
+
+template <class T>
+TVec3<T> ClipToScreen(const TVec4<T>& clip, T width, T height) {
+    if (std::abs(clip.w) < T(1e-6)) {
+        return {-99999, -99999, 0};
+    }
+    const T invW = 1 / clip.w;
+    return {(clip.x * invW + 1) * T(0.5) * width,
+            (1 - (clip.y * invW + 1) * T(0.5)) * height,
+            clip.z * invW};
+}
+
+// Model (translation to the sphere centre) then view, composed in T from inputs rounded to T
+template <class T>
+TMat4<T> StudyModelView(const PrecisionSetup& setup) {
+    const Vec3d center = setup.offset * glm::normalize(Vec3d{0.6, 0.48, 0.64});
+    const Vec3d eye = center + setup.distance * glm::normalize(Vec3d{0.2, 0.3, 1.0});
+    const auto model = math::TAffine3<T>::Translation(TVec3<T>(center));
+    const auto view = math::TAffine3<T>::FromMat4(glm::lookAt(TVec3<T>(eye), TVec3<T>(center), TVec3<T>(0, 1, 0)));
+    return (view * model).ToMat4();
+}
+
+template <class T>
+TMat4<T> StudyProjection(const PrecisionSetup& setup) {
+    return glm::perspective(static_cast<T>(glm::radians(setup.fovyDegrees)),
+                            static_cast<T>(setup.width) / static_cast<T>(setup.height),
+                            static_cast<T>(setup.nearPlane), static_cast<T>(setup.farPlane));
+}
+
+template <class F>
+double BestSeconds(int repeats, F&& pass) {
+    using Clock = std::chrono::steady_clock;
+    double best = 1e30;
+    for (int r = 0; r < std::max(repeats, 1); ++r) {
+        const auto start = Clock::now();
+        pass();
+        best = std::min(best, std::chrono::duration<double>(Clock::now() - start).count());
+    }
+    return best;
+}
+
+} // namespace
+
+template <class T>
+void ProjectPoints(std::span<const TVec3<T>> points,
+                   const TMat4<T>& P,
+                   const TMat4<T>& MV,
+                   unsigned int width,
+                   unsigned int height,
+                   std::span<TVec3<T>> out) {
+    const auto w = static_cast<T>(width);
+    const auto h = static_cast<T>(height);
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        out[i] = ClipToScreen(P * (MV * TVec4<T>(points[i], 1)), w, h);
+    }
+}
+
+void ProjectPoints(std::span<const math::HalfVec3> points,
+                   const Mat4& P,
+                   const Mat4& MV,
+                   unsigned int width,
+                   unsigned int height,
+                   std::span<Vec3> out) {
+    const auto w = static_cast<float>(width);
+    const auto h = static_cast<float>(height);
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        out[i] = ClipToScreen(P * (MV * Vec4(math::toFloat(points[i]), 1.f)), w, h);
+    }
+}
+
+template <class T>
+ProjectionError MeasureProjectionError(std::span<const TVec3<T>> screen, std::span<const Vec3d> reference) {
+    ProjectionError error;
+    double sumSquares = 0.0;
+    for (std::size_t i = 0; i < screen.size(); ++i) {
+        const Vec3d p(screen[i]);
+        const double dx = p.x - reference[i].x;
+        const double dy = p.y - reference[i].y;
+        const double squared = dx * dx + dy * dy;
+        sumSquares += squared;
+        error.maxPixels = std::max(error.maxPixels, std::sqrt(squared));
+        error.maxDepth = std::max(error.maxDepth, std::abs(p.z - reference[i].z));
+    }
+    if (!screen.empty()) {
+        error.rmsPixels = std::sqrt(sumSquares / static_cast<double>(screen.size()));
+    }
+    return error;
+}
+
+std::array<PrecisionResult, 3> RunPrecisionStudy(const PrecisionSetup& setup) {
+    // Unit sphere points in model space
+    std::vector<Vec3d> pointsD;
+    const int segments = 2 * setup.rings;
+    for (int r = 0; r <= setup.rings; ++r) {
+        for (int s = 0; s <= segments; ++s) {
+            pointsD.push_back(Vec3d(SphereNormal(r, s, setup.rings, segments)));
+        }
+    }
+    const std::size_t n = pointsD.size();
+    std::vector<Vec3> pointsF(n);
+    std::vector<math::HalfVec3> pointsH(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        pointsF[i] = Vec3(pointsD[i]);
+    }
+    math::toHalf(pointsF, pointsH);
+
+    const Mat4d PD = StudyProjection<double>(setup);
+    const Mat4d MVD = StudyModelView<double>(setup);
+    const Mat4 PF = StudyProjection<float>(setup);
+    const Mat4 MVF = StudyModelView<float>(setup);
+
+    std::vector<Vec3d> screenD(n);
+    std::vector<Vec3> screenF(n);
+    std::array<PrecisionResult, 3> results{};
+    const auto rate = [n](double seconds) { return seconds > 0.0 ? static_cast<double>(n) / seconds : 0.0; };
+
+    auto& exact = results[static_cast<int>(ScalarMode::Double)];
+    exact.pointsPerSecond = rate(BestSeconds(setup.repeats, [&] {
+        ProjectPoints<double>(pointsD, PD, MVD, setup.width, setup.height, screenD);
+    }));
+    exact.bytesPerPoint = sizeof(Vec3d);
+
+    auto& single = results[static_cast<int>(ScalarMode::Float)];
+    single.pointsPerSecond = rate(BestSeconds(setup.repeats, [&] {
+        ProjectPoints<float>(pointsF, PF, MVF, setup.width, setup.height, screenF);
+    }));
+    single.error = MeasureProjectionError<float>(screenF, screenD);
+    single.bytesPerPoint = sizeof(Vec3);
+
+    auto& half = results[static_cast<int>(ScalarMode::Half)];
+    half.pointsPerSecond = rate(BestSeconds(setup.repeats, [&] {
+        ProjectPoints(pointsH, PF, MVF, setup.width, setup.height, screenF);
+    }));
+    half.error = MeasureProjectionError<float>(screenF, screenD);
+    half.bytesPerPoint = sizeof(math::HalfVec3);
+    return results;
+}
+
+template void ProjectPoints<float>(std::span<const Vec3>, const Mat4&, const Mat4&, unsigned int, unsigned int, std::span<Vec3>);
+template void ProjectPoints<double>(std::span<const Vec3d>, const Mat4d&, const Mat4d&, unsigned int, unsigned int, std::span<Vec3d>);
+template ProjectionError MeasureProjectionError<float>(std::span<const Vec3>, std::span<const Vec3d>);
+template ProjectionError MeasureProjectionError<double>(std::span<const Vec3d>, std::span<const Vec3d>);
+
+} // namespace render
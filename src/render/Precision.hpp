@@ -0,0 +1,71 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <span>
+
+#include "math/Half.hpp"
+#include "math/Types.hpp"
+
+namespace render {
+
+// P * MV * p -> (screen x, screen y, NDC z) per point, in scalar type T: pixels with row 0
+// at the top as NdcToScreen, and ToScreenH's offscreen value where w is ~0. MV is applied
+// first, as ToScreenH does. Instantiated for float and double; out.size() must be at least
+// points.size().
+template <class T>
+void ProjectPoints(std::span<const TVec3<T>> points,
+                   const TMat4<T>& P,
+                   const TMat4<T>& MV,
+                   unsigned int width,
+                   unsigned int height,
+                   std::span<TVec3<T>> out);
+
+// Half-precision storage: each point is widened to float and projected in float.
+void ProjectPoints(std::span<const math::HalfVec3> points,
+                   const Mat4& P,
+                   const Mat4& MV,
+                   unsigned int width,
+                   unsigned int height,
+                   std::span<Vec3> out);
+
+// Distance from a reference projection: screen position in pixels, depth in NDC units.
+struct ProjectionError {
+    double maxPixels = 0.0;
+    double rmsPixels = 0.0;
+    double maxDepth = 0.0;
+};
+
+template <class T>
+ProjectionError MeasureProjectionError(std::span<const TVec3<T>> screen, std::span<const Vec3d> reference);
+
+enum class ScalarMode { Double, Float, Half }; // Half: storage only, float arithmetic
+
+// A unit sphere of points `offset` world units from the origin, seen from `distance` away.
+// At large offsets the model and view translations nearly cancel in MV, and float keeps
+// only ~7 significant digits of each; a far plane far beyond the sphere spends the depth
+// range where nothing is.
+struct PrecisionSetup {
+    double offset = 1e4;
+    double distance = 4.0;
+    double nearPlane = 0.1;
+    double farPlane = 100.0;
+    double fovyDegrees = 60.0;
+    unsigned int width = 1280;
+    unsigned int height = 720;
+    int rings = 128; // (rings + 1) * (2 rings + 1) points
+    int repeats = 3; // timed passes per mode, best kept
+};
+
+struct PrecisionResult {
+    ProjectionError error;          // against the double-precision pipeline
+    double pointsPerSecond = 0.0;
+    std::size_t bytesPerPoint = 0;  // position storage
+};
+
+// Builds the scene once per mode from the same double-precision inputs, rounded as each
+// pipeline would store them (matrices and positions in float; positions in half for Half),
+// then projects and times it. Indexed by ScalarMode.
+std::array<PrecisionResult, 3> RunPrecisionStudy(const PrecisionSetup& setup);
+
+} // namespace render
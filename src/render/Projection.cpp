@@ -16,7 +16,8 @@ sf::Vector2f ToScreenH(const Vec3& world,
                        const Mat4& MV,
                        unsigned int width,
                        unsigned int height) {
-    Vec4 clip = P * MV * Vec4(world, 1.f);
+    // Right to left: two matrix-vector products instead of a 4x4 product per point
+    Vec4 clip = P * (MV * Vec4(world, 1.f));
 
     // Behind camera or invalid.
     if (std::abs(clip.w) < 1e-6f) {
@@ -33,7 +34,7 @@ bool ToScreenH(const Vec3& world,
                unsigned int width,
                unsigned int height,
                sf::Vector2f& outScreen) {
-    Vec4 clip = P * MV * Vec4(world, 1.f);
+    Vec4 clip = P * (MV * Vec4(world, 1.f));
 
     // If w <= 0, point is on/behind the camera plane in the usual convention.
     if (clip.w <= 1e-6f) {
@@ -0,0 +1,238 @@
+#include "render/QuantizedMesh.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace render {
+
+namespace {
+
+constexpr float kUnorm16 = 65535.f;
+constexpr float kSnorm16 = 32767.f;
+
+std::uint16_t ToUnorm16(float value, float origin, float extent) {
+    if (extent <= 0.f) {
+        return 0;
+    }
+    return static_cast<std::uint16_t>(std::clamp(std::round((value - origin) / extent * kUnorm16), 0.f, kUnorm16));
+}
+
+std::uint32_t PackSnorm16(float u, float v) {
+    const auto su = static_cast<std::int16_t>(std::clamp(u, -kSnorm16, kSnorm16));
+    const auto sv = static_cast<std::int16_t>(std::clamp(v, -kSnorm16, kSnorm16));
+    return static_cast<std::uint16_t>(su) | static_cast<std::uint32_t>(static_cast<std::uint16_t>(sv)) << 16;
+}
+
+// Shared by DecodeOctahedral and the lane kernel; branch-free (selects only), unnormalized.
+inline Vec3 UnfoldOctahedral(std::uint32_t packed) {
+    // Sign-extended with 32-bit shifts, clamped with selects: 16-bit lane types and fmaxf
+    // (NaN rules) both keep the kernel loop scalar
+    float x = static_cast<float>(static_cast<std::int32_t>(packed << 16) >> 16) / kSnorm16;
+    float y = static_cast<float>(static_cast<std::int32_t>(packed) >> 16) / kSnorm16;
+    x = x < -1.f ? -1.f : x;
+    y = y < -1.f ? -1.f : y;
+    const float z = 1.f - std::fabs(x) - std::fabs(y);
+    const float t = z < 0.f ? -z : 0.f;
+    x += x >= 0.f ? -t : t;
+    y += y >= 0.f ? -t : t;
+    return {x, y, z};
+}
+
+// Dequantization folded into the model transform: q -> model * (min + q / 65535 * extent)
+math::Affine3 DecodeAffine(const math::Affine3& model, const QuantizedMesh& mesh) {
+    return model * math::Affine3::Translation(mesh.boundsMin) * math::Affine3::Scale(mesh.boundsExtent / kUnorm16);
+}
+
+// normalize(normalMatrix * n), written out so both normal kernels stay branch-free
+inline Vec3 TransformNormal(const Mat3& normalMatrix, const Vec3& n) {
+    const Vec3 c0 = normalMatrix[0], c1 = normalMatrix[1], c2 = normalMatrix[2];
+    const float tx = c0.x * n.x + c1.x * n.y + c2.x * n.z;
+    const float ty = c0.y * n.x + c1.y * n.y + c2.y * n.z;
+    const float tz = c0.z * n.x + c1.z * n.y + c2.z * n.z;
+    const float inv = 1.f / std::sqrt(tx * tx + ty * ty + tz * tz);
+    return {tx * inv, ty * inv, tz * inv};
+}
+
+} // namespace
+
+std::uint32_t EncodeOctahedral(const Vec3& n) {
+    const float l1 = std::fabs(n.x) + std::fabs(n.y) + std::fabs(n.z);
+    if (l1 <= 0.f) {
+        return 0; // decodes to +z
+    }
+    float u = n.x / l1;
+    float v = n.y / l1;
+    if (n.z < 0.f) {
+        const float fu = (1.f - std::fabs(v)) * (u >= 0.f ? 1.f : -1.f);
+        const float fv = (1.f - std::fabs(u)) * (v >= 0.f ? 1.f : -1.f);
+        u = fu;
+        v = fv;
+    }
+
+    // Plain rounding can miss the nearest code on the fold; compare the four around it
+    const Vec3 unit = n / glm::length(n);
+    const float su = u * kSnorm16;
+    const float sv = v * kSnorm16;
+    std::uint32_t best = 0;
+    float bestDot = -2.f;
+    for (const float cu : {std::floor(su), std::ceil(su)}) {
+        for (const float cv : {std::floor(sv), std::ceil(sv)}) {
+            const std::uint32_t packed = PackSnorm16(cu, cv);
+            const float d = glm::dot(DecodeOctahedral(packed), unit);
+            if (d > bestDot) {
+                bestDot = d;
+                best = packed;
+            }
+        }
+    }
+    return best;
+}
+
+Vec3 DecodeOctahedral(std::uint32_t packed) {
+    return glm::normalize(UnfoldOctahedral(packed));
+}
+
+QuantizedMesh Quantize(const IndexedMesh& mesh, std::span<const Vec2> uvs) {
+    QuantizedMesh q;
+    q.count = mesh.VertexCount();
+    q.indices = mesh.indices;
+    const std::size_t padded = math::PadToLanes(q.count);
+    q.x.assign(padded, 0);
+    q.y.assign(padded, 0);
+    q.z.assign(padded, 0);
+    q.normals.assign(padded, 0);
+    if (q.count == 0) {
+        return q;
+    }
+
+    Vec3 lo = mesh.positions[0];
+    Vec3 hi = lo;
+    for (const Vec3& p : mesh.positions) {
+        lo = glm::min(lo, p);
+        hi = glm::max(hi, p);
+    }
+    q.boundsMin = lo;
+    q.boundsExtent = hi - lo;
+    for (std::size_t i = 0; i < q.count; ++i) {
+        const Vec3& p = mesh.positions[i];
+        q.x[i] = ToUnorm16(p.x, lo.x, q.boundsExtent.x);
+        q.y[i] = ToUnorm16(p.y, lo.y, q.boundsExtent.y);
+        q.z[i] = ToUnorm16(p.z, lo.z, q.boundsExtent.z);
+        q.normals[i] = EncodeOctahedral(mesh.normals[i]);
+    }
+
+    if (!uvs.empty()) {
+        Vec2 uvLo = uvs[0];
+        Vec2 uvHi = uvLo;
+        for (const Vec2& uv : uvs) {
+            uvLo = glm::min(uvLo, uv);
+            uvHi = glm::max(uvHi, uv);
+        }
+        q.uvMin = uvLo;
+        q.uvExtent = uvHi - uvLo;
+        q.uvs.assign(padded, 0);
+        for (std::size_t i = 0; i < q.count; ++i) {
+            q.uvs[i] = ToUnorm16(uvs[i].x, uvLo.x, q.uvExtent.x) |
+                       static_cast<std::uint32_t>(ToUnorm16(uvs[i].y, uvLo.y, q.uvExtent.y)) << 16;
+        }
+    }
+    return q;
+}
+
+IndexedMesh Dequantize(const QuantizedMesh& mesh) {
+    math::Vec3Batch positions, normals;
+    TransformQuantizedPoints(math::Affine3{}, mesh, positions);
+    TransformQuantizedNormals(Mat3(1.f), mesh, normals);
+    IndexedMesh out;
+    out.positions.resize(mesh.count);
+    out.normals.resize(mesh.count);
+    for (std::size_t i = 0; i < mesh.count; ++i) {
+        out.positions[i] = positions.get(i);
+        out.normals[i] = normals.get(i);
+    }
+    out.indices = mesh.indices;
+    return out;
+}
+
+void TransformQuantizedPoints(const math::Affine3& model, const QuantizedMesh& mesh, math::Vec3Batch& out) {
+    if (out.size() != mesh.count || out.paddedSize() != mesh.x.size()) {
+        out.resize(mesh.count);
+    }
+    const math::Affine3 decode = DecodeAffine(model, mesh);
+    const std::uint16_t* qx = mesh.x.data(); const std::uint16_t* qy = mesh.y.data(); const std::uint16_t* qz = mesh.z.data();
+    float* ox = out.x.data(); float* oy = out.y.data(); float* oz = out.z.data();
+    const Vec4 r0 = decode.rows[0], r1 = decode.rows[1], r2 = decode.rows[2];
+
+    math::ForEachLane(mesh.x.size(), [=](std::size_t i) {
+        const float x = qx[i], y = qy[i], z = qz[i];
+        ox[i] = r0.x * x + r0.y * y + r0.z * z + r0.w;
+        oy[i] = r1.x * x + r1.y * y + r1.z * z + r1.w;
+        oz[i] = r2.x * x + r2.y * y + r2.z * z + r2.w;
+    });
+}
+
+void TransformQuantizedPoints(const math::Affine3& model,
+                              const QuantizedMesh& mesh,
+                              std::span<const std::uint32_t> ids,
+                              math::Vec3Batch& out) {
+    if (out.size() != ids.size()) {
+        out.resize(ids.size());
+    }
+    const math::Affine3 decode = DecodeAffine(model, mesh);
+    const std::uint16_t* qx = mesh.x.data(); const std::uint16_t* qy = mesh.y.data(); const std::uint16_t* qz = mesh.z.data();
+    const std::uint32_t* id = ids.data();
+    float* ox = out.x.data(); float* oy = out.y.data(); float* oz = out.z.data();
+    const Vec4 r0 = decode.rows[0], r1 = decode.rows[1], r2 = decode.rows[2];
+
+    math::ForEachLane(ids.size(), [=](std::size_t k) {
+        const std::uint32_t i = id[k];
+        const float x = qx[i], y = qy[i], z = qz[i];
+        ox[k] = r0.x * x + r0.y * y + r0.z * z + r0.w;
+        oy[k] = r1.x * x + r1.y * y + r1.z * z + r1.w;
+        oz[k] = r2.x * x + r2.y * y + r2.z * z + r2.w;
+    });
+}
+
+void TransformQuantizedNormals(const Mat3& normalMatrix, const QuantizedMesh& mesh, math::Vec3Batch& out) {
+    if (out.size() != mesh.count || out.paddedSize() != mesh.normals.size()) {
+        out.resize(mesh.count);
+    }
+    const std::uint32_t* packed = mesh.normals.data();
+    float* ox = out.x.data(); float* oy = out.y.data(); float* oz = out.z.data();
+
+    math::ForEachLane(mesh.normals.size(), [=](std::size_t i) {
+        const Vec3 n = TransformNormal(normalMatrix, UnfoldOctahedral(packed[i]));
+        ox[i] = n.x;
+        oy[i] = n.y;
+        oz[i] = n.z;
+    });
+}
+
+void TransformQuantizedNormals(const Mat3& normalMatrix,
+                               const QuantizedMesh& mesh,
+                               std::span<const std::uint32_t> ids,
+                               math::Vec3Batch& out) {
+    if (out.size() != ids.size()) {
+        out.resize(ids.size());
+    }
+    const std::uint32_t* packed = mesh.normals.data();
+    const std::uint32_t* id = ids.data();
+    float* ox = out.x.data(); float* oy = out.y.data(); float* oz = out.z.data();
+
+    math::ForEachLane(ids.size(), [=](std::size_t k) {
+        const Vec3 n = TransformNormal(normalMatrix, UnfoldOctahedral(packed[id[k]]));
+        ox[k] = n.x;
+        oy[k] = n.y;
+        oz[k] = n.z;
+    });
+}
+
+void DecodeUVs(const QuantizedMesh& mesh, std::span<Vec2> out) {
+    const Vec2 scale = mesh.uvExtent / kUnorm16;
+    for (std::size_t i = 0; i < mesh.count; ++i) {
+        const std::uint32_t uv = mesh.uvs[i];
+        out[i] = mesh.uvMin + scale * Vec2(static_cast<float>(uv & 0xffffu), static_cast<float>(uv >> 16));
+    }
+}
+
+} // namespace render
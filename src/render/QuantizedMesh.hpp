@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "math/Affine.hpp"
+#include "math/Aligned.hpp"
+#include "math/Types.hpp"
+#include "math/Vec3Batch.hpp"
+#include "render/Mesh.hpp"
+
+namespace render {
+
+// Compact vertex storage for large meshes, 10 bytes per vertex (14 with UVs) against 24 for
+// float positions and normals:
+// - positions as 16-bit unsigned fractions of the mesh bounds, one SoA array per axis;
+// - normals octahedral-encoded, two 16-bit snorm coordinates packed in 32 bits;
+// - UVs (optional) as two 16-bit fractions of their own bounds, packed in 32 bits.
+// Arrays are padded to kSimdLanes like Vec3Batch, so the decoding kernels below run whole
+// lane blocks; they widen and transform in one pass, never materializing float vertices.
+struct QuantizedMesh {
+    Vec3 boundsMin{0.f};
+    Vec3 boundsExtent{0.f};  // max - min; position = min + q / 65535 * extent
+    Vec2 uvMin{0.f};
+    Vec2 uvExtent{0.f};
+    math::AlignedVector<std::uint16_t> x, y, z;
+    math::AlignedVector<std::uint32_t> normals;
+    math::AlignedVector<std::uint32_t> uvs;  // empty when the source had none
+    std::vector<std::uint32_t> indices;
+    std::size_t count{};
+
+    std::size_t VertexCount() const { return count; }
+    std::size_t TriangleCount() const { return indices.size() / 3; }
+    std::size_t BytesPerVertex() const { return 3 * sizeof(std::uint16_t) + sizeof(std::uint32_t) + (uvs.empty() ? 0 : sizeof(std::uint32_t)); }
+    // Largest position rounding error along each axis: half a quantization step.
+    Vec3 PositionTolerance() const { return boundsExtent * (0.5f / 65535.f); }
+};
+
+// Octahedral normal encoding: the unit sphere folded onto the |x| + |y| <= 1 square, the
+// lower hemisphere into the corners. Encoding tries the four neighbouring codes and keeps
+// the one that decodes closest, which bounds the error at under 0.01 degrees.
+std::uint32_t EncodeOctahedral(const Vec3& n);
+Vec3 DecodeOctahedral(std::uint32_t packed);
+
+// uvs, when given, must have one entry per vertex.
+QuantizedMesh Quantize(const IndexedMesh& mesh, std::span<const Vec2> uvs = {});
+// Back to float positions and normals (UVs are dropped; see DecodeUVs).
+IndexedMesh Dequantize(const QuantizedMesh& mesh);
+
+// model * position for every vertex, lane-parallel. The dequantization is an affine map
+// itself, so it is folded into `model` up front and decoding costs only the int-to-float
+// conversions. `out` is resized to the vertex count.
+void TransformQuantizedPoints(const math::Affine3& model, const QuantizedMesh& mesh, math::Vec3Batch& out);
+
+// normalize(normalMatrix * normal) for every vertex, lane-parallel, decoding the
+// octahedral normals inline. `out` is resized to the vertex count.
+void TransformQuantizedNormals(const Mat3& normalMatrix, const QuantizedMesh& mesh, math::Vec3Batch& out);
+
+// The same for the listed vertices only, out[k] from vertex ids[k]: the gather for the
+// survivors of meshlet culling (see GatherMeshlets). `out` is resized to ids.size().
+void TransformQuantizedPoints(const math::Affine3& model,
+                              const QuantizedMesh& mesh,
+                              std::span<const std::uint32_t> ids,
+                              math::Vec3Batch& out);
+void TransformQuantizedNormals(const Mat3& normalMatrix,
+                               const QuantizedMesh& mesh,
+                               std::span<const std::uint32_t> ids,
+                               math::Vec3Batch& out);
+
+// out.size() must be at least the vertex count; the mesh must have UVs.
+void DecodeUVs(const QuantizedMesh& mesh, std::span<Vec2> out);
+
+} // namespace render
@@ -0,0 +1,301 @@
+#include "render/Rasterizer.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace render {
+
+namespace {
+
+// Phong fragments are shaded in batches of at most this many
+constexpr std::size_t kFlushFragments = std::size_t{1} << 14;
+
+// Pixel offsets of the four lanes of a 2x2 quad
+constexpr std::array<float, 4> kQuadDx = {0.f, 1.f, 0.f, 1.f};
+constexpr std::array<float, 4> kQuadDy = {0.f, 0.f, 1.f, 1.f};
+
+struct ScreenVertex {
+    float x, y;  // pixels, y down
+    float z;     // NDC depth
+    float invW;
+};
+
+// E(p) = A*px + B*py + C, positive inside for a triangle with positive area. Pixels exactly
+// on an edge belong to it only when (A, B) points "right/down", so a shared edge (seen with
+// negated A, B by the neighbour) is drawn exactly once.
+struct Edge {
+    float A, B, C;
+    bool ownsTies;
+
+    Edge(const ScreenVertex& a, const ScreenVertex& b)
+        : A(a.y - b.y),
+          B(b.x - a.x),
+          C(-(A * a.x + B * a.y)),
+          ownsTies(A > 0.f || (A == 0.f && B > 0.f)) {}
+
+    float At(float px, float py) const { return A * px + B * py + C; }
+};
+
+bool Inside(float e, const Edge& edge) {
+    return e > 0.f || (e == 0.f && edge.ownsTies);
+}
+
+std::array<float, 3> UnpackRgb(const std::uint8_t* rgba) {
+    return {static_cast<float>(rgba[0]), static_cast<float>(rgba[1]), static_cast<float>(rgba[2])};
+}
+
+// Shades `count` points in one batch through phongBatch; rgba gets 4 bytes per point.
+void ShadePoints(std::size_t count,
+                 math::Vec3Batch& pos,
+                 math::Vec3Batch& nrm,
+                 const auto& positionAt,
+                 const auto& normalAt,
+                 const math::ShadeParams& shade,
+                 const math::SpecularTable& specular,
+                 std::vector<std::uint8_t>& rgba) {
+    if (pos.size() != count) pos.resize(count);
+    if (nrm.size() != count) nrm.resize(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        pos.set(i, positionAt(i));
+        nrm.set(i, normalAt(i));
+    }
+    rgba.resize(count * math::kRgba8Stride);
+    math::phongBatch(pos, nrm, shade, specular, rgba);
+}
+
+// Ambient term as written by phongBatch, in 0..255: what a fully shadowed pixel keeps
+std::array<float, 3> AmbientRgb(const math::ShadeParams& shade) {
+    const Vec3 a = glm::clamp(shade.ka * shade.materialColor * shade.lightColor, 0.f, 1.f) * 255.f;
+    return {a.r, a.g, a.b};
+}
+
+// Scales the lit part of a shaded pixel (everything above ambient) by its visibility
+void ApplyVisibility(std::uint8_t* rgb, const std::array<float, 3>& ambient, float visibility) {
+    for (int c = 0; c < 3; ++c) {
+        const float value = ambient[c] + visibility * (static_cast<float>(rgb[c]) - ambient[c]);
+        rgb[c] = static_cast<std::uint8_t>(std::clamp(value + 0.5f, 0.f, 255.f));
+    }
+}
+
+} // namespace
+
+void Framebuffer::Resize(int w, int h) {
+    width = std::max(w, 0);
+    height = std::max(h, 0);
+    const auto n = static_cast<std::size_t>(width) * static_cast<std::size_t>(height);
+    color.assign(n * 4, 0);
+    depth.assign(n, 1.f);
+}
+
+void Framebuffer::Clear(std::uint8_t r, std::uint8_t g, std::uint8_t b, std::uint8_t a) {
+    for (std::size_t i = 0; i < color.size(); i += 4) {
+        color[i + 0] = r;
+        color[i + 1] = g;
+        color[i + 2] = b;
+        color[i + 3] = a;
+    }
+    std::fill(depth.begin(), depth.end(), 1.f);
+}
+
+void Rasterizer::FlushFragments(Framebuffer& fb,
+                                const math::ShadeParams& shade,
+                                const math::SpecularTable& specular,
+                                const ShadowMap* shadow,
+                                int pcf) {
+    const std::size_t n = fragPixel_.size();
+    if (n == 0) {
+        return;
+    }
+    ShadePoints(n, shadePos_, shadeNrm_,
+                [&](std::size_t i) { return fragPos_[i]; },
+                [&](std::size_t i) { return fragNrm_[i]; },
+                shade, specular, shadeRgba_);
+    if (shadow) {
+        fragVis_.resize(n);
+        shadow->Visibility(shadePos_, pcf, fragVis_);
+        const std::array<float, 3> ambient = AmbientRgb(shade);
+        for (std::size_t i = 0; i < n; ++i) {
+            ApplyVisibility(&shadeRgba_[i * math::kRgba8Stride], ambient, fragVis_[i]);
+        }
+    }
+    // In submission order, so a later fragment that passed the depth test still wins
+    for (std::size_t i = 0; i < n; ++i) {
+        std::copy_n(&shadeRgba_[i * math::kRgba8Stride], 4, &fb.color[std::size_t{fragPixel_[i]} * 4]);
+    }
+    fragPixel_.clear();
+    fragPos_.clear();
+    fragNrm_.clear();
+}
+
+RasterStats Rasterizer::Draw(Framebuffer& fb,
+                             std::span<const RasterVertex> vertices,
+                             std::span<const std::uint32_t> indices,
+                             ShadingMode mode,
+                             const math::ShadeParams& shade,
+                             const math::SpecularTable& specular,
+                             const ShadowMap* shadow,
+                             int pcf) {
+    RasterStats stats;
+    const std::size_t triCount = indices.size() / 3;
+    if (fb.width == 0 || fb.height == 0 || triCount == 0) {
+        return stats;
+    }
+
+    // Colors that do not depend on the pixel are shaded up front, in one batch each
+    std::vector<std::uint8_t> flatRgba;
+    std::vector<std::uint8_t> vertexRgba;
+    if (mode == ShadingMode::Flat) {
+        ShadePoints(triCount, shadePos_, shadeNrm_,
+                    [&](std::size_t t) {
+                        return (vertices[indices[3 * t]].world + vertices[indices[3 * t + 1]].world +
+                                vertices[indices[3 * t + 2]].world) / 3.f;
+                    },
+                    [&](std::size_t t) {
+                        return glm::normalize(vertices[indices[3 * t]].normal + vertices[indices[3 * t + 1]].normal +
+                                              vertices[indices[3 * t + 2]].normal);
+                    },
+                    shade, specular, flatRgba);
+    } else if (mode == ShadingMode::Gouraud) {
+        ShadePoints(vertices.size(), shadePos_, shadeNrm_,
+                    [&](std::size_t i) { return vertices[i].world; },
+                    [&](std::size_t i) { return vertices[i].normal; },
+                    shade, specular, vertexRgba);
+    }
+
+    const std::array<float, 3> ambient = AmbientRgb(shade);
+    const float halfW = 0.5f * static_cast<float>(fb.width);
+    const float halfH = 0.5f * static_cast<float>(fb.height);
+
+    for (std::size_t t = 0; t < triCount; ++t) {
+        std::array<std::uint32_t, 3> id = {indices[3 * t], indices[3 * t + 1], indices[3 * t + 2]};
+        std::array<ScreenVertex, 3> sv{};
+        bool behind = false;
+        for (int k = 0; k < 3; ++k) {
+            const Vec4& c = vertices[id[k]].clip;
+            behind = behind || c.w <= 1e-6f;
+            const float invW = 1.f / c.w;
+            sv[k] = {(c.x * invW + 1.f) * halfW, (1.f - c.y * invW) * halfH, c.z * invW, invW};
+        }
+        if (behind) {
+            continue;
+        }
+
+        // Two-sided: reorder so the edge functions are positive inside
+        float area = Edge(sv[0], sv[1]).At(sv[2].x, sv[2].y);
+        if (area < 0.f) {
+            std::swap(sv[1], sv[2]);
+            std::swap(id[1], id[2]);
+            area = -area;
+        }
+        if (area <= 0.f) {
+            continue;
+        }
+
+        const int minX = std::max(0, static_cast<int>(std::floor(std::min({sv[0].x, sv[1].x, sv[2].x}))));
+        const int minY = std::max(0, static_cast<int>(std::floor(std::min({sv[0].y, sv[1].y, sv[2].y}))));
+        const int maxX = std::min(fb.width - 1, static_cast<int>(std::ceil(std::max({sv[0].x, sv[1].x, sv[2].x}))));
+        const int maxY = std::min(fb.height - 1, static_cast<int>(std::ceil(std::max({sv[0].y, sv[1].y, sv[2].y}))));
+        if (minX > maxX || minY > maxY) {
+            continue;
+        }
+        ++stats.triangles;
+
+        // Edge k is opposite vertex k, so E_k / area is vertex k's barycentric weight
+        const Edge e0(sv[1], sv[2]);
+        const Edge e1(sv[2], sv[0]);
+        const Edge e2(sv[0], sv[1]);
+        const float invArea = 1.f / area;
+
+        const std::uint8_t* flat = mode == ShadingMode::Flat ? &flatRgba[t * math::kRgba8Stride] : nullptr;
+        std::array<std::array<float, 3>, 3> vrgb{};
+        if (mode == ShadingMode::Gouraud) {
+            for (int k = 0; k < 3; ++k) {
+                vrgb[k] = UnpackRgb(&vertexRgba[std::size_t{id[k]} * math::kRgba8Stride]);
+            }
+        }
+        const RasterVertex& v0 = vertices[id[0]];
+        const RasterVertex& v1 = vertices[id[1]];
+        const RasterVertex& v2 = vertices[id[2]];
+
+        for (int y = minY; y <= maxY; y += 2) {
+            // Row start evaluated directly, then stepped by 2A per quad
+            const float py = static_cast<float>(y) + 0.5f;
+            const float px = static_cast<float>(minX) + 0.5f;
+            float q0 = e0.At(px, py);
+            float q1 = e1.At(px, py);
+            float q2 = e2.At(px, py);
+
+            for (int x = minX; x <= maxX; x += 2, q0 += 2.f * e0.A, q1 += 2.f * e1.A, q2 += 2.f * e2.A) {
+                // The four lanes of the quad, written as fixed-width loops for SLP vectorization
+                std::array<float, 4> w0{}, w1{}, w2{};
+                std::array<bool, 4> covered{};
+                for (int k = 0; k < 4; ++k) {
+                    const float a = q0 + e0.A * kQuadDx[k] + e0.B * kQuadDy[k];
+                    const float b = q1 + e1.A * kQuadDx[k] + e1.B * kQuadDy[k];
+                    const float c = q2 + e2.A * kQuadDx[k] + e2.B * kQuadDy[k];
+                    covered[k] = Inside(a, e0) && Inside(b, e1) && Inside(c, e2);
+                    w0[k] = a * invArea;
+                    w1[k] = b * invArea;
+                    w2[k] = c * invArea;
+                }
+                if (!(covered[0] || covered[1] || covered[2] || covered[3])) {
+                    continue;
+                }
+
+                for (int k = 0; k < 4; ++k) {
+                    const int pxl = x + static_cast<int>(kQuadDx[k]);
+                    const int pyl = y + static_cast<int>(kQuadDy[k]);
+                    if (!covered[k] || pxl > maxX || pyl > maxY) {
+                        continue;
+                    }
+                    // Depth is affine in screen space; attributes need the 1/w correction
+                    const float z = w0[k] * sv[0].z + w1[k] * sv[1].z + w2[k] * sv[2].z;
+                    const std::size_t pixel = static_cast<std::size_t>(pyl) * static_cast<std::size_t>(fb.width) +
+                                              static_cast<std::size_t>(pxl);
+                    if (z < -1.f || z >= fb.depth[pixel]) {
+                        continue;
+                    }
+                    fb.depth[pixel] = z;
+                    ++stats.fragments;
+
+                    const float p0 = w0[k] * sv[0].invW;
+                    const float p1 = w1[k] * sv[1].invW;
+                    const float p2 = w2[k] * sv[2].invW;
+                    const float inv = 1.f / (p0 + p1 + p2);
+                    const float b0 = p0 * inv, b1 = p1 * inv, b2 = p2 * inv;
+
+                    std::uint8_t* out = &fb.color[pixel * 4];
+                    if (mode != ShadingMode::Phong) {
+                        if (mode == ShadingMode::Flat) {
+                            std::copy_n(flat, 4, out);
+                        } else {
+                            for (int c = 0; c < 3; ++c) {
+                                const float value = b0 * vrgb[0][c] + b1 * vrgb[1][c] + b2 * vrgb[2][c];
+                                out[c] = static_cast<std::uint8_t>(std::clamp(value + 0.5f, 0.f, 255.f));
+                            }
+                            out[3] = 255;
+                        }
+                        if (shadow) {
+                            const Vec3 world = b0 * v0.world + b1 * v1.world + b2 * v2.world;
+                            ApplyVisibility(out, ambient, shadow->Visibility(world, pcf));
+                        }
+                    } else {
+                        fragPixel_.push_back(static_cast<std::uint32_t>(pixel));
+                        fragPos_.push_back(b0 * v0.world + b1 * v1.world + b2 * v2.world);
+                        fragNrm_.push_back(glm::normalize(b0 * v0.normal + b1 * v1.normal + b2 * v2.normal));
+                    }
+                }
+            }
+        }
+
+        if (fragPixel_.size() >= kFlushFragments) {
+            FlushFragments(fb, shade, specular, shadow, pcf);
+        }
+    }
+
+    FlushFragments(fb, shade, specular, shadow, pcf);
+    return stats;
+}
+
+} // namespace render
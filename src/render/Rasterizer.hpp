@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "math/LightingBatch.hpp"
+#include "math/Types.hpp"
+#include "math/Vec3Batch.hpp"
+#include "render/ShadowMap.hpp"
+
+namespace render {
+
+enum class ShadingMode {
+    Flat,    // one color per triangle, shaded at the centroid
+    Gouraud, // colors shaded per vertex, interpolated
+    Phong    // position and normal interpolated, shaded per pixel
+};
+
+// RGBA8 color and float depth (NDC z, smaller is nearer). Row 0 is the top of the image,
+// matching sf::Texture::update.
+struct Framebuffer {
+    int width{};
+    int height{};
+    std::vector<std::uint8_t> color;
+    std::vector<float> depth;
+
+    void Resize(int w, int h);
+    void Clear(std::uint8_t r, std::uint8_t g, std::uint8_t b, std::uint8_t a = 255);
+};
+
+struct RasterVertex {
+    Vec4 clip;   // P * V * M * position
+    Vec3 world;  // for lighting
+    Vec3 normal; // world space, unit
+};
+
+struct RasterStats {
+    std::size_t triangles{}; // rasterized (not rejected)
+    std::size_t fragments{}; // passed the depth test and were shaded
+};
+
+// Triangle rasterizer over edge functions stepped incrementally in 2x2 pixel quads, with
+// perspective-correct interpolation (attributes / w, divided by interpolated 1 / w).
+// Triangles with a vertex at or behind the eye (w <= 0) are dropped rather than clipped.
+// With a shadow map, each pixel's diffuse and specular are scaled by its visibility
+// (ambient stays). Keeps scratch buffers between calls, so reuse one instance per framebuffer.
+class Rasterizer {
+public:
+    RasterStats Draw(Framebuffer& fb,
+                     std::span<const RasterVertex> vertices,
+                     std::span<const std::uint32_t> indices,
+                     ShadingMode mode,
+                     const math::ShadeParams& shade,
+                     const math::SpecularTable& specular,
+                     const ShadowMap* shadow = nullptr,
+                     int pcf = 1);
+
+private:
+    void FlushFragments(Framebuffer& fb,
+                        const math::ShadeParams& shade,
+                        const math::SpecularTable& specular,
+                        const ShadowMap* shadow,
+                        int pcf);
+
+    math::Vec3Batch shadePos_;
+    math::Vec3Batch shadeNrm_;
+    std::vector<std::uint8_t> shadeRgba_;
+    std::vector<std::uint32_t> fragPixel_;  // pending Phong fragments: pixel index ...
+    std::vector<Vec3> fragPos_;             // ... world position ...
+    std::vector<Vec3> fragNrm_;             // ... and interpolated normal
+    std::vector<float> fragVis_;            // shadow-map visibility per flushed fragment
+};
+
+} // namespace render
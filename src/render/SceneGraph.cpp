@@ -0,0 +1,102 @@
+#include "render/SceneGraph.hpp"
+
+#include <algorithm>
+#include <type_traits>
+
+namespace render {
+
+NodeId SceneGraph::AddNode(NodeId parent, const math::Affine3& local) {
+    const auto id = static_cast<NodeId>(slot_.size());
+    const auto at = static_cast<std::uint32_t>(parent_.size());
+    const std::uint32_t parentSlot = parent == kNoNode ? kNoNode : slot_[parent];
+    const std::uint32_t depth = parent == kNoNode ? 0 : depth_[parentSlot] + 1;
+    // Appended; Update() restores the breadth-first order if this broke it
+    sorted_ = sorted_ && (depth_.empty() || depth >= depth_.back());
+    parent_.push_back(parentSlot);
+    depth_.push_back(depth);
+    local_.push_back(local);
+    world_.emplace_back();
+    dirty_.push_back(1);
+    node_.push_back(id);
+    slot_.push_back(at);
+    firstDirty_ = std::min<std::size_t>(firstDirty_, at);
+    return id;
+}
+
+void SceneGraph::SetLocal(NodeId node, const math::Affine3& local) {
+    const std::uint32_t s = slot_[node];
+    if (local_[s].rows == local.rows) {
+        return;
+    }
+    local_[s] = local;
+    dirty_[s] = 1;
+    firstDirty_ = std::min<std::size_t>(firstDirty_, s);
+}
+
+NodeId SceneGraph::Parent(NodeId node) const {
+    const std::uint32_t p = parent_[slot_[node]];
+    return p == kNoNode ? kNoNode : node_[p];
+}
+
+void SceneGraph::SortByDepth() {
+    // Counting sort on depth, stable, so siblings keep their insertion order
+    const std::size_t n = parent_.size();
+    const std::uint32_t maxDepth = *std::max_element(depth_.begin(), depth_.end());
+    std::vector<std::uint32_t> start(maxDepth + 2, 0);
+    for (const std::uint32_t d : depth_) {
+        ++start[d + 1];
+    }
+    for (std::uint32_t d = 0; d <= maxDepth; ++d) {
+        start[d + 1] += start[d];
+    }
+    std::vector<std::uint32_t> newSlot(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        newSlot[i] = start[depth_[i]]++;
+    }
+
+    const auto permute = [&](auto& values) {
+        std::remove_reference_t<decltype(values)> moved(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            moved[newSlot[i]] = values[i];
+        }
+        values.swap(moved);
+    };
+    for (std::uint32_t& p : parent_) {
+        p = p == kNoNode ? kNoNode : newSlot[p];
+    }
+    permute(parent_);
+    permute(depth_);
+    permute(local_);
+    permute(world_);
+    permute(dirty_);
+    permute(node_);
+    for (std::uint32_t& s : slot_) {
+        s = newSlot[s];
+    }
+    firstDirty_ = static_cast<std::size_t>(std::find(dirty_.begin(), dirty_.end(), 1) - dirty_.begin());
+    sorted_ = true;
+}
+
+std::size_t SceneGraph::Update() {
+    if (!sorted_) {
+        SortByDepth();
+    }
+    const std::size_t n = parent_.size();
+    std::size_t updated = 0;
+    for (std::size_t i = firstDirty_; i < n; ++i) {
+        // The parent's flag is final by now and already includes its own ancestors'
+        const std::uint32_t p = parent_[i];
+        dirty_[i] |= p != kNoNode ? dirty_[p] : 0;
+        if (dirty_[i]) {
+            world_[i] = p == kNoNode ? local_[i] : world_[p] * local_[i];
+            ++updated;
+        }
+    }
+    if (firstDirty_ < n) {
+        std::fill(dirty_.begin() + static_cast<std::ptrdiff_t>(firstDirty_), dirty_.end(), 0);
+    }
+    firstDirty_ = n;
+    return updated;
+}
+
+} // namespace render
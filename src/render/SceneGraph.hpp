@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "math/Affine.hpp"
+
+namespace render {
+
+using NodeId = std::uint32_t;
+constexpr NodeId kNoNode = std::numeric_limits<NodeId>::max();
+
+// Transform hierarchy: each node has a local transform relative to its parent and a cached
+// world transform (parent world * local). The node data lives in parallel arrays kept in
+// breadth-first order, so every parent precedes its children and Update() is one forward
+// pass over contiguous memory, level by level, with no recursion or pointer chasing.
+// NodeIds stay valid as nodes are added; they map to array slots internally.
+//
+// SetLocal marks a node dirty only when the value changes, so setting the same transform
+// every frame is cheap; Update() recomputes the dirty nodes and their subtrees and nothing
+// else, and returns at once when nothing changed.
+class SceneGraph {
+public:
+    // parent = kNoNode adds a root. Nodes are appended; the next Update() re-sorts the
+    // arrays by depth (linear time) when an insertion broke the order.
+    NodeId AddNode(NodeId parent, const math::Affine3& local = {});
+    void SetLocal(NodeId node, const math::Affine3& local);
+
+    const math::Affine3& Local(NodeId node) const { return local_[slot_[node]]; }
+    // As of the last Update(); a new node's is identity until then.
+    const math::Affine3& World(NodeId node) const { return world_[slot_[node]]; }
+    NodeId Parent(NodeId node) const;
+    std::size_t NodeCount() const { return slot_.size(); }
+
+    // Recomputes the world transforms that changed; returns how many.
+    std::size_t Update();
+
+private:
+    void SortByDepth();
+
+    // Per slot, in breadth-first order
+    std::vector<std::uint32_t> parent_;  // slot of the parent, kNoNode for roots
+    std::vector<std::uint32_t> depth_;
+    std::vector<math::Affine3> local_;
+    std::vector<math::Affine3> world_;
+    std::vector<std::uint8_t> dirty_;
+    std::vector<NodeId> node_;           // NodeId in each slot
+    std::vector<std::uint32_t> slot_;    // slot of each NodeId
+    std::size_t firstDirty_{};           // no dirty slot before this one
+    bool sorted_ = true;                 // breadth-first order holds
+};
+
+} // namespace render
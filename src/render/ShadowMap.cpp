@@ -0,0 +1,172 @@
+#include "render/ShadowMap.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+#include "math/Parallel.hpp"
+
+namespace render {
+
+namespace {
+
+// Triangle in texel space, with depth as a plane z = z0 + dzdx * (x - x0) + dzdy * (y - y0)
+struct DepthTriangle {
+    std::array<float, 3> x, y;
+    float z0, dzdx, dzdy;
+    int minX, minY, maxX, maxY;
+};
+
+// Lookups per thread block in the batched Visibility()
+constexpr std::size_t kLookupBlock = 4096;
+
+} // namespace
+
+void ShadowMap::Resize(int size) {
+    size_ = std::max(size, 1);
+    depth_.assign(static_cast<std::size_t>(size_) * static_cast<std::size_t>(size_), 1.f);
+}
+
+void ShadowMap::Render(std::span<const Vec3> positions,
+                       std::span<const std::uint32_t> indices,
+                       const Mat4& lightViewProj,
+                       float constantBias,
+                       float slopeBias) {
+    lightViewProj_ = lightViewProj;
+    std::fill(depth_.begin(), depth_.end(), 1.f);
+    if (size_ == 0) {
+        return;
+    }
+
+    const float half = 0.5f * static_cast<float>(size_);
+    std::vector<Vec3> texel(positions.size()); // x, y in texels (row 0 at the top), z in [0, 1]
+    std::vector<std::uint8_t> behind(positions.size());
+    for (std::size_t i = 0; i < positions.size(); ++i) {
+        const Vec4 c = lightViewProj * Vec4(positions[i], 1.f);
+        behind[i] = c.w <= 1e-6f;
+        const float invW = 1.f / (behind[i] ? 1.f : c.w);
+        texel[i] = {(c.x * invW + 1.f) * half, (1.f - c.y * invW) * half, 0.5f * (c.z * invW + 1.f)};
+    }
+
+    // Set up triangles once, then bin them into the tiles their bounds overlap
+    const int tiles = (size_ + kTileSize - 1) / kTileSize;
+    std::vector<DepthTriangle> triangles;
+    std::vector<std::vector<std::uint32_t>> bins(static_cast<std::size_t>(tiles * tiles));
+    for (std::size_t t = 0; t + 2 < indices.size(); t += 3) {
+        const std::uint32_t i0 = indices[t], i1 = indices[t + 1], i2 = indices[t + 2];
+        if (behind[i0] || behind[i1] || behind[i2]) {
+            continue; // no near clipping, as in Rasterizer
+        }
+        const Vec3 &a = texel[i0], &b = texel[i1], &c = texel[i2];
+        const float area = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+        if (std::abs(area) < 1e-12f) {
+            continue;
+        }
+        DepthTriangle tri;
+        tri.x = {a.x, b.x, c.x};
+        tri.y = {a.y, b.y, c.y};
+        tri.dzdx = ((b.z - a.z) * (c.y - a.y) - (c.z - a.z) * (b.y - a.y)) / area;
+        tri.dzdy = ((c.z - a.z) * (b.x - a.x) - (b.z - a.z) * (c.x - a.x)) / area;
+        tri.z0 = a.z + constantBias + slopeBias * std::max(std::abs(tri.dzdx), std::abs(tri.dzdy));
+        tri.minX = std::max(0, static_cast<int>(std::floor(std::min({a.x, b.x, c.x}))));
+        tri.minY = std::max(0, static_cast<int>(std::floor(std::min({a.y, b.y, c.y}))));
+        tri.maxX = std::min(size_ - 1, static_cast<int>(std::ceil(std::max({a.x, b.x, c.x}))));
+        tri.maxY = std::min(size_ - 1, static_cast<int>(std::ceil(std::max({a.y, b.y, c.y}))));
+        if (tri.minX > tri.maxX || tri.minY > tri.maxY) {
+            continue;
+        }
+        // Winding doesn't matter for depth: orient so the edge functions are positive inside
+        if (area < 0.f) {
+            std::swap(tri.x[1], tri.x[2]);
+            std::swap(tri.y[1], tri.y[2]);
+        }
+
+        const auto id = static_cast<std::uint32_t>(triangles.size());
+        triangles.push_back(tri);
+        for (int ty = tri.minY / kTileSize; ty <= tri.maxY / kTileSize; ++ty) {
+            for (int tx = tri.minX / kTileSize; tx <= tri.maxX / kTileSize; ++tx) {
+                bins[static_cast<std::size_t>(ty * tiles + tx)].push_back(id);
+            }
+        }
+    }
+
+    // Tiles own disjoint texels, so they rasterize without synchronization
+    math::ParallelFor(bins.size(), [&](std::size_t tile) {
+        const int tx0 = static_cast<int>(tile % static_cast<std::size_t>(tiles)) * kTileSize;
+        const int ty0 = static_cast<int>(tile / static_cast<std::size_t>(tiles)) * kTileSize;
+        for (std::uint32_t id : bins[tile]) {
+            const DepthTriangle& tri = triangles[id];
+            const int x0 = std::max(tri.minX, tx0), x1 = std::min(tri.maxX, tx0 + kTileSize - 1);
+            const int y0 = std::max(tri.minY, ty0), y1 = std::min(tri.maxY, ty0 + kTileSize - 1);
+
+            // Edge k runs from vertex k to k + 1; inside is E >= 0 for all three
+            std::array<float, 3> A{}, B{}, C{};
+            for (int k = 0; k < 3; ++k) {
+                const int n = (k + 1) % 3;
+                A[k] = tri.y[k] - tri.y[n];
+                B[k] = tri.x[n] - tri.x[k];
+                C[k] = -(A[k] * tri.x[k] + B[k] * tri.y[k]);
+            }
+            for (int y = y0; y <= y1; ++y) {
+                const float py = static_cast<float>(y) + 0.5f;
+                float* row = &depth_[static_cast<std::size_t>(y) * static_cast<std::size_t>(size_)];
+                for (int x = x0; x <= x1; ++x) {
+                    const float px = static_cast<float>(x) + 0.5f;
+                    const float e0 = A[0] * px + B[0] * py + C[0];
+                    const float e1 = A[1] * px + B[1] * py + C[1];
+                    const float e2 = A[2] * px + B[2] * py + C[2];
+                    const float z = tri.z0 + tri.dzdx * (px - tri.x[0]) + tri.dzdy * (py - tri.y[0]);
+                    // Conservative on edges (>= 0): a texel covered twice just keeps the nearer depth
+                    const bool inside = e0 >= 0.f && e1 >= 0.f && e2 >= 0.f;
+                    row[x] = inside && z < row[x] ? z : row[x];
+                }
+            }
+        }
+    });
+}
+
+float ShadowMap::Visibility(const Vec3& world, int pcf) const {
+    const Vec4 c = lightViewProj_ * Vec4(world, 1.f);
+    if (c.w <= 1e-6f || size_ == 0) {
+        return 1.f;
+    }
+    const float invW = 1.f / c.w;
+    const float z = 0.5f * (c.z * invW + 1.f);
+    if (z > 1.f) {
+        return 1.f;
+    }
+    const float half = 0.5f * static_cast<float>(size_);
+    const float u = (c.x * invW + 1.f) * half;
+    const float v = (1.f - c.y * invW) * half;
+
+    // A k x k block of texels centred on the point: k = 1 is the texel containing it
+    const int k = std::clamp(pcf, 1, 8);
+    const float offset = 0.5f * static_cast<float>(k - 1);
+    const int bx = static_cast<int>(std::floor(u - offset));
+    const int by = static_cast<int>(std::floor(v - offset));
+    int lit = 0;
+    for (int j = 0; j < k; ++j) {
+        for (int i = 0; i < k; ++i) {
+            const int x = bx + i, y = by + j;
+            if (x < 0 || y < 0 || x >= size_ || y >= size_) {
+                ++lit;
+                continue;
+            }
+            lit += z <= depth_[static_cast<std::size_t>(y) * static_cast<std::size_t>(size_) + static_cast<std::size_t>(x)];
+        }
+    }
+    return static_cast<float>(lit) / static_cast<float>(k * k);
+}
+
+void ShadowMap::Visibility(const math::Vec3Batch& world, int pcf, std::span<float> out) const {
+    const std::size_t n = std::min(world.size(), out.size());
+    const std::size_t blocks = (n + kLookupBlock - 1) / kLookupBlock;
+    math::ParallelFor(blocks, [&](std::size_t block) {
+        const std::size_t end = std::min(n, (block + 1) * kLookupBlock);
+        for (std::size_t i = block * kLookupBlock; i < end; ++i) {
+            out[i] = Visibility(world.get(i), pcf);
+        }
+    });
+}
+
+} // namespace render
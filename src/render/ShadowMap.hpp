@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "math/Types.hpp"
+#include "math/Vec3Batch.hpp"
+
+namespace render {
+
+// Depth map rendered from a light (CPU, depth only), for shadows on any receiver, including
+// the caster itself. Render() rasterizes into square tiles in parallel; Visibility() compares
+// against it with optional percentage-closer filtering.
+class ShadowMap {
+public:
+    static constexpr int kTileSize = 64;
+
+    // Square map, size x size texels; contents are cleared.
+    void Resize(int size);
+    int Size() const { return size_; }
+
+    // Depth of the triangles (world space) seen through lightViewProj, a standard GL
+    // projection from the light (perspective for a point light). Depth is NDC z in [0, 1],
+    // pushed back by constantBias + slopeBias * max |dz/dtexel| per triangle (polygon
+    // offset) so lit surfaces don't shadow themselves.
+    void Render(std::span<const Vec3> positions,
+                std::span<const std::uint32_t> indices,
+                const Mat4& lightViewProj,
+                float constantBias = 1e-4f,
+                float slopeBias = 1.5f);
+
+    // 1 lit, 0 in shadow. pcf is the filter width in texels: 1 is a single compare, 2 and 4
+    // average a 2x2 or 4x4 block of compares around the point. Points outside the map are lit.
+    float Visibility(const Vec3& world, int pcf = 1) const;
+    // Batched lookups, split over threads in blocks; out needs world.size() entries.
+    void Visibility(const math::Vec3Batch& world, int pcf, std::span<float> out) const;
+
+    std::span<const float> Depth() const { return depth_; }
+
+private:
+    int size_{};
+    Mat4 lightViewProj_{1.f};
+    std::vector<float> depth_;
+};
+
+} // namespace render
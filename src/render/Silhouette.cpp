@@ -0,0 +1,70 @@
+#include "render/Silhouette.hpp"
+
+#include <algorithm>
+#include <map>
+#include <unordered_map>
+
+namespace render {
+
+SilhouetteExtractor::SilhouetteExtractor(const IndexedMesh& mesh)
+    : indices_(mesh.indices) {
+    // Weld: canonical id per distinct position
+    std::map<std::array<float, 3>, std::uint32_t> ids;
+    std::vector<std::uint32_t> weld(mesh.VertexCount());
+    for (std::size_t i = 0; i < mesh.VertexCount(); ++i) {
+        const Vec3& p = mesh.positions[i];
+        weld[i] = ids.try_emplace({p.x, p.y, p.z}, static_cast<std::uint32_t>(ids.size())).first->second;
+    }
+
+    // Undirected welded edge -> slot in edges_; a third face on an edge (non-manifold) is ignored
+    std::unordered_map<std::uint64_t, std::size_t> slots;
+    const std::size_t triCount = mesh.TriangleCount();
+    for (std::size_t t = 0; t < triCount; ++t) {
+        for (int k = 0; k < 3; ++k) {
+            const std::uint32_t a = indices_[3 * t + k];
+            const std::uint32_t b = indices_[3 * t + (k + 1) % 3];
+            const std::uint32_t wa = weld[a], wb = weld[b];
+            if (wa == wb) {
+                continue;
+            }
+            const std::uint64_t key = (std::uint64_t{std::min(wa, wb)} << 32) | std::max(wa, wb);
+            const auto [it, inserted] = slots.try_emplace(key, edges_.size());
+            if (inserted) {
+                edges_.push_back({a, b, static_cast<std::uint32_t>(t), kNoFace});
+            } else if (edges_[it->second].face1 == kNoFace) {
+                edges_[it->second].face1 = static_cast<std::uint32_t>(t);
+            }
+        }
+    }
+    lit_.resize(triCount);
+}
+
+const std::vector<SilhouetteEdge>& SilhouetteExtractor::Extract(std::span<const Vec3> positions, const Vec4& light) {
+    const Vec3 lightXyz{light};
+    for (std::size_t t = 0; t < lit_.size(); ++t) {
+        const Vec3& p0 = positions[indices_[3 * t]];
+        const Vec3& p1 = positions[indices_[3 * t + 1]];
+        const Vec3& p2 = positions[indices_[3 * t + 2]];
+        const Vec3 n = glm::cross(p1 - p0, p2 - p0);
+        lit_[t] = glm::dot(n, lightXyz - light.w * p0) > 0.f;
+    }
+
+    silhouette_.clear();
+    for (const EdgeFaces& e : edges_) {
+        const bool lit0 = lit_[e.face0] != 0;
+        if (e.face1 == kNoFace) {
+            if (lit0) {
+                silhouette_.push_back({e.a, e.b});
+            }
+            continue;
+        }
+        const bool lit1 = lit_[e.face1] != 0;
+        if (lit0 != lit1) {
+            // face1 winds the shared edge the other way
+            silhouette_.push_back(lit0 ? SilhouetteEdge{e.a, e.b} : SilhouetteEdge{e.b, e.a});
+        }
+    }
+    return silhouette_;
+}
+
+} // namespace render
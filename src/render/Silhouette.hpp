@@ -0,0 +1,46 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "math/Types.hpp"
+#include "render/Mesh.hpp"
+
+namespace render {
+
+using SilhouetteEdge = std::array<std::uint32_t, 2>; // vertex indices into the mesh
+
+// Edges where a light-facing triangle meets one facing away, plus boundary edges of
+// light-facing triangles on open meshes. Projected onto a receiver they outline the
+// shadow of a general (non-convex) caster. Edge adjacency is built once from the mesh
+// topology; vertices with equal positions are welded first, so meshes with split
+// normals (MakeIndexedCube) still share their edges.
+class SilhouetteExtractor {
+public:
+    explicit SilhouetteExtractor(const IndexedMesh& mesh);
+
+    // positions: current vertex positions, same order as the mesh (e.g. after skinning).
+    // light: homogeneous, (position, 1) for a point light or (-direction, 0).
+    // Edges follow the winding of their light-facing triangle.
+    const std::vector<SilhouetteEdge>& Extract(std::span<const Vec3> positions, const Vec4& light);
+
+    std::size_t EdgeCount() const { return edges_.size(); }
+
+private:
+    static constexpr std::uint32_t kNoFace = 0xffffffffu;
+
+    struct EdgeFaces {
+        std::uint32_t a, b;  // as wound in `face0`
+        std::uint32_t face0;
+        std::uint32_t face1; // kNoFace on the boundary
+    };
+
+    std::vector<std::uint32_t> indices_;
+    std::vector<EdgeFaces> edges_;
+    std::vector<std::uint8_t> lit_;  // per triangle, scratch
+    std::vector<SilhouetteEdge> silhouette_;
+};
+
+} // namespace render
@@ -0,0 +1,123 @@
+#include "render/Skinning.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace render {
+
+SkinnedMesh MakeChainSkin(const IndexedMesh& mesh, int boneCount, float length) {
+    SkinnedMesh skinned;
+    skinned.bind = mesh;
+    skinned.influences.resize(mesh.positions.size());
+
+    const float segment = length / static_cast<float>(boneCount);
+    const float last = static_cast<float>(boneCount - 1);
+    for (std::size_t i = 0; i < mesh.positions.size(); ++i) {
+        // Position between the centres of the two nearest bones
+        const float u = std::clamp(mesh.positions[i].y / segment - 0.5f, 0.f, last);
+        const int b0 = std::min(static_cast<int>(u), boneCount - 1);
+        const int b1 = std::min(b0 + 1, boneCount - 1);
+        const float f = u - static_cast<float>(b0);
+        const float s = f * f * (3.f - 2.f * f); // smoothstep
+
+        BoneInfluence& inf = skinned.influences[i];
+        inf.bones = {static_cast<std::uint32_t>(b0), static_cast<std::uint32_t>(b1), 0, 0};
+        inf.weights = {1.f - s, s, 0.f, 0.f};
+    }
+
+    return skinned;
+}
+
+std::vector<math::DualQuat> ChainPose(int boneCount, float length, float bendPerJoint) {
+    const float segment = length / static_cast<float>(boneCount);
+    const math::DualQuat link = math::fromRotationTranslation(
+        math::fromAxisAngle({0, 0, 1}, bendPerJoint), {0.f, segment, 0.f});
+
+    std::vector<math::DualQuat> skin(static_cast<std::size_t>(boneCount));
+    math::DualQuat pose{};
+    for (int j = 0; j < boneCount; ++j) {
+        if (j > 0) {
+            pose = math::multiply(pose, link);
+        }
+        // Joint j rests at y = j * segment; move the vertex into its frame first
+        const math::DualQuat invBind =
+            math::fromRotationTranslation({1, 0, 0, 0}, {0.f, -segment * static_cast<float>(j), 0.f});
+        skin[static_cast<std::size_t>(j)] = math::multiply(pose, invBind);
+    }
+    return skin;
+}
+
+void SkinDualQuat(const SkinnedMesh& mesh,
+                  std::span<const math::DualQuat> bones,
+                  math::Vec3Batch& outPositions,
+                  math::Vec3Batch& outNormals) {
+    const std::size_t n = mesh.bind.positions.size();
+    if (outPositions.size() != n) outPositions.resize(n);
+    if (outNormals.size() != n) outNormals.resize(n);
+
+    const Vec3* pos = mesh.bind.positions.data();
+    const Vec3* nrm = mesh.bind.normals.data();
+    const BoneInfluence* inf = mesh.influences.data();
+    // Bone palette flattened to 8 floats per bone: per-lane bone fetches become gathers,
+    // which need an element-sized index scale rather than a 32-byte struct stride
+    std::vector<float> palette(bones.size() * 8);
+    for (std::size_t b = 0; b < bones.size(); ++b) {
+        const math::DualQuat& q = bones[b];
+        float* dst = palette.data() + b * 8;
+        dst[0] = q.real.w; dst[1] = q.real.x; dst[2] = q.real.y; dst[3] = q.real.z;
+        dst[4] = q.dual.w; dst[5] = q.dual.x; dst[6] = q.dual.y; dst[7] = q.dual.z;
+    }
+    const float* pal = palette.data();
+    float* px = outPositions.x.data(); float* py = outPositions.y.data(); float* pz = outPositions.z.data();
+    float* nx = outNormals.x.data(); float* ny = outNormals.y.data(); float* nz = outNormals.z.data();
+
+    // Math spelled out inline (no calls into Quaternion.cpp) so the lane body vectorizes
+    math::ForEachLane(n, [=](std::size_t i) {
+        const int b0 = inf[i].bones[0] * 8;
+        float rw = 0.f, rx = 0.f, ry = 0.f, rz = 0.f;
+        float dw = 0.f, dx = 0.f, dy = 0.f, dz = 0.f;
+
+        const auto accumulate = [&](int k) {
+            const int b = inf[i].bones[k] * 8;
+            const float dp = pal[b0] * pal[b] + pal[b0 + 1] * pal[b + 1] +
+                             pal[b0 + 2] * pal[b + 2] + pal[b0 + 3] * pal[b + 3];
+            const float w = dp < 0.f ? -inf[i].weights[k] : inf[i].weights[k];
+            rw += w * pal[b + 0];
+            rx += w * pal[b + 1];
+            ry += w * pal[b + 2];
+            rz += w * pal[b + 3];
+            dw += w * pal[b + 4];
+            dx += w * pal[b + 5];
+            dy += w * pal[b + 6];
+            dz += w * pal[b + 7];
+        };
+        // Unrolled: a nested loop counts as control flow and keeps the lane loop scalar
+        static_assert(kMaxBoneInfluences == 4);
+        accumulate(0);
+        accumulate(1);
+        accumulate(2);
+        accumulate(3);
+
+        const float inv = 1.f / std::sqrt(rw * rw + rx * rx + ry * ry + rz * rz);
+        const math::Quat r{rw * inv, rx * inv, ry * inv, rz * inv};
+        const math::Quat d{dw * inv, dx * inv, dy * inv, dz * inv};
+
+        // Rotation: v + 2 rv x (rv x v + w v); translation: 2 (w dv - dw rv + rv x dv)
+        const Vec3 rv{r.x, r.y, r.z};
+        const Vec3 dv{d.x, d.y, d.z};
+        const Vec3 t = 2.f * (r.w * dv - d.w * rv + glm::cross(rv, dv));
+        const Vec3 p = pos[i];
+        const Vec3 q = nrm[i];
+        const Vec3 p2 = p + 2.f * glm::cross(rv, glm::cross(rv, p) + r.w * p) + t;
+        const Vec3 n2 = q + 2.f * glm::cross(rv, glm::cross(rv, q) + r.w * q);
+
+        px[i] = p2.x;
+        py[i] = p2.y;
+        pz[i] = p2.z;
+        nx[i] = n2.x;
+        ny[i] = n2.y;
+        nz[i] = n2.z;
+    });
+}
+
+} // namespace render
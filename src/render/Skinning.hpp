@@ -0,0 +1,43 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "math/DualQuat.hpp"
+#include "math/Vec3Batch.hpp"
+#include "render/Mesh.hpp"
+
+namespace render {
+
+constexpr int kMaxBoneInfluences = 4;
+
+// Bone indices and weights for one vertex. Unused slots have weight 0.
+struct BoneInfluence {
+    std::array<std::uint32_t, kMaxBoneInfluences> bones{};
+    std::array<float, kMaxBoneInfluences> weights{};
+};
+
+struct SkinnedMesh {
+    IndexedMesh bind;                     // rest pose
+    std::vector<BoneInfluence> influences; // one per vertex
+};
+
+// Weights a mesh along +y for a chain of `boneCount` equal segments spanning `length`:
+// each vertex blends the two nearest joints with a smooth falloff.
+SkinnedMesh MakeChainSkin(const IndexedMesh& mesh, int boneCount, float length);
+
+// Joint transforms for a chain along +y bent by `bendPerJoint` (radians, about z) at each
+// joint. Returned as skinning transforms, i.e. already multiplied by the inverse bind pose.
+std::vector<math::DualQuat> ChainPose(int boneCount, float length, float bendPerJoint);
+
+// Dual-quaternion linear blend skinning for all vertices. Every vertex blends exactly
+// kMaxBoneInfluences transforms with sign correction, so the loop is branch-free and runs
+// lane-parallel; outputs are SoA.
+void SkinDualQuat(const SkinnedMesh& mesh,
+                  std::span<const math::DualQuat> bones,
+                  math::Vec3Batch& outPositions,
+                  math::Vec3Batch& outNormals);
+
+} // namespace render
@@ -1,9 +1,15 @@
 #include "ui/MatrixLabUI.hpp"
 
+#include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstdio>
 
 #include <imgui.h>
 
+#include "math/Decompose.hpp"
+#include "math/Eigen3x3.hpp"
+
 namespace {
 
 void Vec3Row(const char* label, const Vec3& v) {
@@ -59,6 +65,10 @@ void ModeTogglesSection(app::ViewParams& view) {
     ImGui::Checkbox("Orthographic", &view.useParallelProj);
     ImGui::SameLine();
     ImGui::TextDisabled("(%s)", view.useParallelProj ? "ortho" : "perspective");
+
+    ImGui::Checkbox("Orthonormal u", &view.showOrthonormalU);
+    ImGui::SameLine();
+    ImGui::TextDisabled("(u white, Gram-Schmidt yellow)");
 }
 
 void ObjectTransformSection(app::TransformParams& transform) {
@@ -71,8 +81,17 @@ void ObjectTransformSection(app::TransformParams& transform) {
     ImGui::DragFloat("Y Translate", &transform.yTrans, 0.05f);
     ImGui::DragFloat("Axis Angle", &transform.axisAngle, 0.01f);
     ImGui::DragFloat("Plane Pitch", &transform.pitchPlane, 0.01f);
+    ImGui::Checkbox("Singular vectors", &transform.showSvd);
+    if (transform.showSvd) {
+        // A rotation has all three at 1; arcball drift shows up as a spread
+        const Vec3& s = transform.singularValues;
+        ImGui::TextDisabled("sigma %.5f %.5f %.5f", s.x, s.y, s.z);
+    }
+    ImGui::TextDisabled("scene graph: %zu nodes, %zu updated", transform.sceneNodes, transform.nodesUpdated);
     if (ImGui::Button("Reset Transform")) {
+        const bool showSvd = transform.showSvd;
         transform = app::TransformParams{};
+        transform.showSvd = showSvd;
     }
 }
 
@@ -88,11 +107,232 @@ void CameraSection(app::ViewParams& view) {
     }
 }
 
-void BasisSection(const app::SceneGeometry& scene) {
+void InputSection(app::ControlSettings& controls) {
+    if (!ImGui::CollapsingHeader("Input")) {
+        return;
+    }
+    ImGui::Checkbox("Sub-frame arcball", &controls.arcballSubframe);
+    ImGui::SameLine();
+    ImGui::TextDisabled("(%s)", controls.arcballSubframe ? "path" : "net");
+    ImGui::SliderFloat("Velocity window", &controls.velocityWindow, 0.016f, 0.25f, "%.3f s");
+    ImGui::SliderInt("Re-orthonormalize", &controls.reorthonormalizeFrames, 0, 600,
+                     controls.reorthonormalizeFrames > 0 ? "every %d frames" : "never");
+}
+
+void ShadingSection(app::MaterialParams& material) {
+    if (!ImGui::CollapsingHeader("Shading")) {
+        return;
+    }
+    ImGui::ColorEdit3("Color", &material.color.x);
+    ImGui::SliderFloat("ka", &material.ka, 0.f, 1.f);
+    ImGui::SliderFloat("kd", &material.kd, 0.f, 1.f);
+    ImGui::SliderFloat("ks", &material.ks, 0.f, 1.f);
+    ImGui::SliderFloat("Shininess", &material.shininess, 1.f, 128.f, "%.0f");
+    ImGui::Checkbox("Blinn-Phong", &material.blinn);
+}
+
+void LightsSection(app::LightingParams& lighting) {
+    if (!ImGui::CollapsingHeader("Lights")) {
+        return;
+    }
+    ImGui::SliderInt("Extra lights", &lighting.extraLights, 0, 1000);
+    ImGui::SliderFloat("Light range", &lighting.extraRange, 0.2f, 5.f);
+    ImGui::Checkbox("Clustered culling", &lighting.clustered);
+    ImGui::TextDisabled("build %.3f ms  shade %.3f ms", lighting.buildMs, lighting.shadeMs);
+    if (lighting.clustered && lighting.extraLights > 0) {
+        ImGui::TextDisabled("max lights / cluster: %zu", lighting.maxPerCluster);
+    }
+}
+
+void ShadowsSection(app::ShadowParams& shadow) {
+    if (!ImGui::CollapsingHeader("Shadows")) {
+        return;
+    }
+    ImGui::Checkbox("Directional light", &shadow.directional);
+    ImGui::Checkbox("Back wall", &shadow.wall);
+    if (shadow.wall) {
+        ImGui::SliderFloat("Wall depth", &shadow.wallDepth, 0.5f, 10.f);
+    }
+    ImGui::Checkbox("Single polygon (hull)", &shadow.hull);
+    ImGui::TextDisabled("matrix rebuilds: %zu  triangles: %zu", shadow.rebuilds, shadow.triangles);
+
+    ImGui::Checkbox("Shadow map (software rasterizer)", &shadow.shadowMap);
+    if (shadow.shadowMap) {
+        static const char* pcfNames[] = {"off", "2x2", "4x4"};
+        ImGui::SliderInt("Map size", &shadow.mapSize, 128, 4096, "%d", ImGuiSliderFlags_Logarithmic);
+        ImGui::Combo("PCF", &shadow.pcf, pcfNames, IM_ARRAYSIZE(pcfNames));
+        ImGui::TextDisabled("depth pass: %.3f ms", shadow.mapMs);
+    }
+}
+
+void RasterSection(app::RasterParams& raster) {
+    if (!ImGui::CollapsingHeader("Software Rasterizer")) {
+        return;
+    }
+    static const char* modeNames[] = {"Flat", "Gouraud", "Phong"};
+    ImGui::Checkbox("Rasterize object", &raster.enabled);
+    ImGui::SameLine();
+    ImGui::Checkbox("Sphere", &raster.sphere);
+    ImGui::Combo("Shading", &raster.mode, modeNames, IM_ARRAYSIZE(modeNames));
+    ImGui::SliderInt("Downscale", &raster.downscale, 1, 4);
+    ImGui::Checkbox("Quantized vertices", &raster.quantized);
+    ImGui::SameLine();
+    ImGui::Checkbox("Meshlet culling", &raster.meshletCulling);
+    if (raster.enabled) {
+        const float mpix = raster.rasterMs > 0.f ? static_cast<float>(raster.fragments) / (raster.rasterMs * 1000.f) : 0.f;
+        ImGui::TextDisabled("%.3f ms  %zu px  %.1f Mpix/s", raster.rasterMs, raster.fragments, mpix);
+        ImGui::TextDisabled("vertices %.3f ms  %zu B/vertex", raster.vertexMs, raster.vertexBytes);
+        ImGui::TextDisabled("ACMR %.2f -> %.2f  %zu meshlets", raster.acmrBefore, raster.acmrAfter, raster.meshlets);
+        if (raster.meshletCulling) {
+            ImGui::TextDisabled("drawn %zu  frustum %zu  back-facing %zu", raster.meshletsDrawn, raster.frustumCulled,
+                                raster.backfaceCulled);
+        }
+        ImGui::TextDisabled("%zu vertices transformed", raster.verticesTransformed);
+    }
+}
+
+void SmoothingSection(app::SmoothingParams& smoothing, app::RasterParams& raster) {
+    if (!ImGui::CollapsingHeader("Laplacian Smoothing")) {
+        return;
+    }
+    static const char* sizeNames[] = {"256^2 (65K)", "512^2 (262K)", "1024^2 (1M)"};
+    if (ImGui::Checkbox("Smooth sphere", &smoothing.enabled) && smoothing.enabled) {
+        raster.enabled = true; // drawn by the software rasterizer
+    }
+    ImGui::SameLine();
+    ImGui::Checkbox("Run", &smoothing.run);
+    ImGui::Combo("Vertices", &smoothing.resolution, sizeNames, IM_ARRAYSIZE(sizeNames));
+    ImGui::Checkbox("Cotangent weights", &smoothing.cotangent);
+    ImGui::SameLine();
+    ImGui::Checkbox("RCM order", &smoothing.reorder);
+    ImGui::SliderFloat("Lambda", &smoothing.lambda, 0.05f, 1.f, "%.2f");
+    ImGui::SliderInt("Steps / frame", &smoothing.stepsPerFrame, 1, 8);
+    ImGui::SliderFloat("Noise", &smoothing.noise, 0.f, 0.1f, "%.3f");
+    if (ImGui::Button("Add noise")) {
+        smoothing.addNoise = true;
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Reset")) {
+        smoothing.reset = true;
+    }
+    if (smoothing.enabled) {
+        ImGui::TextDisabled("%zu vertices  %zu nnz  bandwidth %zu", smoothing.vertices, smoothing.nonZeros,
+                            smoothing.bandwidth);
+        const float mvtx = smoothing.smoothMs > 0.f
+            ? static_cast<float>(smoothing.vertices) * static_cast<float>(smoothing.stepsPerFrame) / (smoothing.smoothMs * 1000.f)
+            : 0.f;
+        ImGui::TextDisabled("smooth %.2f ms (%.1f Mvtx/s)  normals %.2f ms", smoothing.smoothMs, mvtx,
+                            smoothing.normalsMs);
+        ImGui::TextDisabled("build %.0f ms (weld, assemble, RCM)", smoothing.buildMs);
+    }
+}
+
+void DeformationSection(app::DeformParams& deform, app::SmoothingParams& smoothing, app::RasterParams& raster) {
+    if (!ImGui::CollapsingHeader("Laplacian Deformation")) {
+        return;
+    }
+    static const char* sizeNames[] = {"64^2 (4K)", "128^2 (16K)", "256^2 (65K)"};
+    static const char* preconditionerNames[] = {"None", "Jacobi", "IC(0)"};
+    if (ImGui::Checkbox("Deform sphere", &deform.enabled) && deform.enabled) {
+        raster.enabled = true;     // drawn by the software rasterizer
+        smoothing.enabled = false; // which would otherwise take its place
+    }
+    ImGui::Combo("Vertices##deform", &deform.resolution, sizeNames, IM_ARRAYSIZE(sizeNames));
+    ImGui::Combo("Preconditioner", &deform.preconditioner, preconditionerNames, IM_ARRAYSIZE(preconditionerNames));
+    ImGui::SliderFloat("Cap height", &deform.capHeight, 0.2f, 0.95f, "%.2f");
+    ImGui::DragFloat3("Handle offset", &deform.handleOffset.x, 0.01f, -1.f, 1.f, "%.2f");
+    ImGui::SliderAngle("Handle twist", &deform.handleTwist, -180.f, 180.f);
+    ImGui::SliderFloat("Slice budget ms", &deform.budgetMs, 0.5f, 16.f, "%.1f");
+    ImGui::SliderFloat("Tolerance", &deform.tolerance, 1e-7f, 1e-2f, "%.0e", ImGuiSliderFlags_Logarithmic);
+    if (deform.enabled) {
+        ImGui::TextDisabled("%zu vertices, %zu free  setup %.0f ms", deform.vertices, deform.freeVertices,
+                            deform.setupMs);
+        ImGui::TextDisabled("%s  %zu it (%zu total)  residual %.1e  %.2f ms",
+                            deform.converged ? "converged" : deform.busy ? "solving" : "stalled",
+                            deform.iterations, deform.totalIterations, deform.residual, deform.solveMs);
+        ImGui::PlotLines("log10 residual", deform.residualLog.data(), app::DeformParams::kHistory, 0, nullptr,
+                         -8.f, 0.f, ImVec2(0.f, 60.f));
+    }
+}
+
+void PrecisionSection(app::PrecisionParams& precision) {
+    if (!ImGui::CollapsingHeader("Precision")) {
+        return;
+    }
+    static const char* sizeNames[] = {"64 rings (8K)", "128 rings (33K)", "512 rings (525K)"};
+    ImGui::SliderFloat("Offset", &precision.offset, 1.f, 1e7f, "%.0f", ImGuiSliderFlags_Logarithmic);
+    ImGui::SliderFloat("Distance", &precision.distance, 0.5f, 1e3f, "%.1f", ImGuiSliderFlags_Logarithmic);
+    ImGui::SliderFloat("Near##precision", &precision.nearPlane, 1e-3f, 1.f, "%.3f", ImGuiSliderFlags_Logarithmic);
+    ImGui::SliderFloat("Far##precision", &precision.farPlane, 10.f, 1e6f, "%.0f", ImGuiSliderFlags_Logarithmic);
+    ImGui::Combo("Points", &precision.resolution, sizeNames, IM_ARRAYSIZE(sizeNames));
+    if (ImGui::Button("Run study")) {
+        precision.run = true;
+    }
+    if (!precision.valid) {
+        return;
+    }
+    static const char* modeNames[] = {"double", "float", "half"};
+    if (ImGui::BeginTable("precision", 6, ImGuiTableFlags_Borders | ImGuiTableFlags_SizingFixedFit)) {
+        ImGui::TableSetupColumn("mode");
+        ImGui::TableSetupColumn("max px");
+        ImGui::TableSetupColumn("rms px");
+        ImGui::TableSetupColumn("depth");
+        ImGui::TableSetupColumn("Mpt/s");
+        ImGui::TableSetupColumn("B/pt");
+        ImGui::TableHeadersRow();
+        for (int m = 0; m < 3; ++m) {
+            const render::PrecisionResult& r = precision.results[m];
+            ImGui::TableNextRow();
+            ImGui::TableSetColumnIndex(0);
+            ImGui::TextUnformatted(modeNames[m]);
+            ImGui::TableSetColumnIndex(1);
+            ImGui::Text("%.2e", r.error.maxPixels);
+            ImGui::TableSetColumnIndex(2);
+            ImGui::Text("%.2e", r.error.rmsPixels);
+            ImGui::TableSetColumnIndex(3);
+            ImGui::Text("%.1e", r.error.maxDepth);
+            ImGui::TableSetColumnIndex(4);
+            ImGui::Text("%.0f", r.pointsPerSecond * 1e-6);
+            ImGui::TableSetColumnIndex(5);
+            ImGui::Text("%zu", r.bytesPerPoint);
+        }
+        ImGui::EndTable();
+    }
+    ImGui::TextDisabled("errors against the double pipeline; half stores positions only");
+}
+
+void SkinningSection(app::SkinningParams& skinning) {
+    if (!ImGui::CollapsingHeader("Skinning")) {
+        return;
+    }
+    ImGui::Checkbox("Show tube", &skinning.enabled);
+    ImGui::SameLine();
+    ImGui::Checkbox("Animate", &skinning.animate);
+    ImGui::SliderInt("Bones", &skinning.boneCount, 1, 16);
+    ImGui::SliderFloat("Bend / joint", &skinning.bend, -1.5f, 1.5f, "%.2f rad");
+    ImGui::TextDisabled("dual quaternions: 8 floats per bone");
+}
+
+void BasisSection(const app::SceneGeometry& scene, app::PointCloudParams& cloud) {
     if (!ImGui::CollapsingHeader("Basis and Coordinates")) {
         return;
     }
 
+    ImGui::Text("det(u) = %.4f%s", scene.uTransform.Determinant(),
+                scene.uTransform.IsDegenerate() ? "  (degenerate)" : "");
+    const Vec3 sigma = math::svd(Mat3(scene.uBasis[0], scene.uBasis[1], scene.uBasis[2])).sigma;
+    const float smallest = std::abs(sigma.z);
+    if (smallest > 0.f) {
+        ImGui::Text("sigma(u) = %.3f %.3f %.3f  cond %.1f", sigma.x, sigma.y, sigma.z, sigma.x / smallest);
+    } else {
+        ImGui::Text("sigma(u) = %.3f %.3f %.3f  cond inf", sigma.x, sigma.y, sigma.z);
+    }
+    ImGui::Checkbox("Point cloud in u-basis", &cloud.enabled);
+    if (cloud.enabled) {
+        ImGui::SliderInt("Points", &cloud.count, 1000, 1000000, "%d", ImGuiSliderFlags_Logarithmic);
+        ImGui::TextDisabled("FromCoords batch: %.3f ms", cloud.convertMs);
+    }
+
     if (ImGui::BeginTable("v-basis", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_SizingFixedFit)) {
         ImGui::TableSetupColumn("vec");
         ImGui::TableSetupColumn("x");
@@ -116,6 +356,9 @@ void BasisSection(const app::SceneGeometry& scene) {
         Vec3Row("u1", scene.uBasis[0]);
         Vec3Row("u2", scene.uBasis[1]);
         Vec3Row("u3", scene.uBasis[2]);
+        Vec3Row("q1 (Gram-Schmidt)", scene.uOrthonormal[0]);
+        Vec3Row("q2", scene.uOrthonormal[1]);
+        Vec3Row("q3", scene.uOrthonormal[2]);
         Vec3Row("b (coords)", scene.b);
         ImGui::EndTable();
     }
@@ -130,6 +373,100 @@ void MatricesSection(const ui::FrameContext& frame) {
     Mat4Table("Projection", frame.projection);
 }
 
+void GeneralMatrixSection(app::GeneralMatrixParams& general) {
+    if (!ImGui::CollapsingHeader("General Matrix")) {
+        return;
+    }
+    ImGui::Checkbox("Apply to unit cube", &general.enabled);
+    ImGui::PushItemWidth(200.f);
+    ImGui::DragFloat3("row 1", &general.m[0], 0.01f);
+    ImGui::DragFloat3("row 2", &general.m[3], 0.01f);
+    ImGui::DragFloat3("row 3", &general.m[6], 0.01f);
+    ImGui::PopItemWidth();
+    if (ImGui::Button("Identity")) {
+        general.m = {1, 0, 0, 0, 1, 0, 0, 0, 1};
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Shear")) {
+        general.m = {1, 0.8f, 0, 0, 1, 0, 0, 0, 1};
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Singular")) {
+        general.m = {1, 0, 0, 0, 1, 0, 1, 1, 0};
+    }
+}
+
+void MatrixTable(const char* label, const math::Matrix<float>& m) {
+    ImGui::PushID(label);
+    if (ImGui::BeginTable("##matrix", static_cast<int>(m.Cols()), ImGuiTableFlags_Borders | ImGuiTableFlags_SizingFixedFit)) {
+        for (std::size_t row = 0; row < m.Rows(); ++row) {
+            ImGui::TableNextRow();
+            for (std::size_t col = 0; col < m.Cols(); ++col) {
+                ImGui::TableSetColumnIndex(static_cast<int>(col));
+                ImGui::Text("%.4f", m(row, col));
+            }
+        }
+        ImGui::EndTable();
+    }
+    ImGui::PopID();
+}
+
+// Factors the general matrix with a trace and scrubs through the working matrix step by
+// step; the trace is cached in `general` and rebuilt only when the matrix or the method
+// changes. The large timed runs are done on App's worker (they take seconds at n = 2000)
+void DecompositionSection(app::GeneralMatrixParams& general) {
+    if (!ImGui::CollapsingHeader("Decompositions")) {
+        return;
+    }
+    static const char* methods[] = {"LU (partial pivoting)", "QR (Householder)", "Cholesky of M^T M"};
+    ImGui::PushItemWidth(200.f);
+    ImGui::Combo("Method", &general.method, methods, IM_ARRAYSIZE(methods));
+    ImGui::PopItemWidth();
+
+    if (general.m != general.factoredM || general.method != general.factoredMethod) {
+        general.factoredM = general.m;
+        general.factoredMethod = general.method;
+        math::Matrix<float> M(3, 3);
+        for (std::size_t k = 0; k < 9; ++k) {
+            M(k / 3, k % 3) = general.m[k];
+        }
+        general.trace = {};
+        char result[64];
+        if (general.method == 0) {
+            const auto f = math::luFactor(M, &general.trace);
+            std::snprintf(result, sizeof(result), "det = %.4f%s", math::luDeterminant(f), f.singular ? " (singular)" : "");
+        } else if (general.method == 1) {
+            math::qrFactor(M, &general.trace);
+            std::snprintf(result, sizeof(result), "R on and above the diagonal, reflectors below");
+        } else {
+            const auto f = math::choleskyFactor(M.Transposed() * M, &general.trace);
+            std::snprintf(result, sizeof(result), "%s", f.ok ? "M^T M = L L^T" : "M^T M is not positive definite (M singular)");
+        }
+        general.result = result;
+    }
+
+    const math::FactorTrace<float>& trace = general.trace;
+    const int steps = static_cast<int>(trace.steps.size());
+    general.step = std::clamp(general.step, 0, std::max(steps - 1, 0));
+    ImGui::SliderInt("Step", &general.step, 0, std::max(steps - 1, 0));
+    if (steps > 0) {
+        const math::FactorStep<float>& step = trace.steps[static_cast<std::size_t>(general.step)];
+        ImGui::Text("column %zu  pivot row %zu  pivot %.4f", step.column, step.pivotRow, step.pivot);
+        MatrixTable("working", trace.Snapshot(static_cast<std::size_t>(general.step)));
+    }
+    ImGui::TextUnformatted(general.result.c_str());
+
+    ImGui::Separator();
+    ImGui::SliderInt("n", &general.benchSize, 100, 2000);
+    ImGui::SameLine();
+    if (general.benchBusy) {
+        ImGui::TextDisabled("timing...");
+    } else if (ImGui::Button("Time n x n")) {
+        general.runBench = true;
+    }
+    ImGui::Text("LU %.1f ms  QR %.1f ms  Cholesky %.1f ms", general.luMs, general.qrMs, general.choleskyMs);
+}
+
 void PipelineSection(const app::SceneGeometry& scene, const ui::FrameContext& frame) {
     if (!ImGui::CollapsingHeader("Pipeline (world -> screen)")) {
         return;
@@ -193,6 +530,17 @@ namespace ui {
 
 void ShowMatrixLab(app::TransformParams& transform,
                    app::ViewParams& view,
+                   app::ControlSettings& controls,
+                   app::MaterialParams& material,
+                   app::LightingParams& lighting,
+                   app::ShadowParams& shadow,
+                   app::RasterParams& raster,
+                   app::SmoothingParams& smoothing,
+                   app::DeformParams& deform,
+                   app::PrecisionParams& precision,
+                   app::GeneralMatrixParams& general,
+                   app::SkinningParams& skinning,
+                   app::PointCloudParams& cloud,
                    const app::SceneGeometry& scene,
                    const FrameContext& frame) {
     ImGui::Begin("Matrix Lab");
@@ -201,8 +549,19 @@ void ShowMatrixLab(app::TransformParams& transform,
     ModeTogglesSection(view);
     ObjectTransformSection(transform);
     CameraSection(view);
-    BasisSection(scene);
+    InputSection(controls);
+    ShadingSection(material);
+    LightsSection(lighting);
+    ShadowsSection(shadow);
+    RasterSection(raster);
+    SmoothingSection(smoothing, raster);
+    DeformationSection(deform, smoothing, raster);
+    PrecisionSection(precision);
+    SkinningSection(skinning);
+    BasisSection(scene, cloud);
     MatricesSection(frame);
+    GeneralMatrixSection(general);
+    DecompositionSection(general);
     PipelineSection(scene, frame);
 
     ImGui::PopItemWidth();
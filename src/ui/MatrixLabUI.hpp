@@ -17,6 +17,17 @@ struct FrameContext {
 
 void ShowMatrixLab(app::TransformParams& transform,
                    app::ViewParams& view,
+                   app::ControlSettings& controls,
+                   app::MaterialParams& material,
+                   app::LightingParams& lighting,
+                   app::ShadowParams& shadow,
+                   app::RasterParams& raster,
+                   app::SmoothingParams& smoothing,
+                   app::DeformParams& deform,
+                   app::PrecisionParams& precision,
+                   app::GeneralMatrixParams& general,
+                   app::SkinningParams& skinning,
+                   app::PointCloudParams& cloud,
                    const app::SceneGeometry& scene,
                    const FrameContext& frame);
 
@@ -0,0 +1,104 @@
+//
+// Affine3 (3x4) transforms against the equivalent Mat4 arithmetic.
+// Built into the linalg_tests executable.
+//
+
+#include <gtest/gtest.h>
+#include "TestUtil.hpp"
+#include "math/Affine.hpp"
+#include "math/Camera.hpp"
+#include <glm/gtc/matrix_transform.hpp>
+#include <cmath>
+#include <vector>
+
+namespace {
+
+// Translation * rotation * non-uniform scale, as a model transform might be
+math::Affine3 sampleTransform(float f) {
+    return math::Affine3::Translation({0.3f * f, -1.f, 2.f}) *
+           math::Affine3::Rotation(0.4f + f, Vec3{1.f, 2.f, f}) *
+           math::Affine3::Scale({1.f, 2.f, 0.5f + f});
+}
+
+} // namespace
+
+TEST(Affine, MatchesGlmConstructorsAndComposition) {
+    expectNear(math::Affine3::Translation({1.f, 2.f, 3.f}).ToMat4(), glm::translate(Mat4(1.f), Vec3{1.f, 2.f, 3.f}));
+    expectNear(math::Affine3::Rotation(0.7f, {1.f, 1.f, 0.f}).ToMat4(), glm::rotate(Mat4(1.f), 0.7f, Vec3{1.f, 1.f, 0.f}));
+    expectNear(math::Affine3::Scale({2.f, 3.f, 4.f}).ToMat4(), glm::scale(Mat4(1.f), Vec3{2.f, 3.f, 4.f}));
+
+    const math::Affine3 a = sampleTransform(0.2f);
+    const math::Affine3 b = sampleTransform(1.1f);
+    expectNear((a * b).ToMat4(), a.ToMat4() * b.ToMat4());
+    expectNear(math::Affine3::FromMat4(a.ToMat4()).ToMat4(), a.ToMat4(), 0.f);
+    expectNear(math::Affine3::FromLinear(a.Linear(), a.Offset()).ToMat4(), a.ToMat4(), 0.f);
+
+    const Vec3 p{0.5f, -0.25f, 2.f};
+    expectNear(a.TransformPoint(p), Vec3(a.ToMat4() * Vec4(p, 1.f)));
+    expectNear(a.TransformDirection(p), Vec3(a.ToMat4() * Vec4(p, 0.f)));
+}
+
+TEST(Affine, ProjectionPromotesToMat4) {
+    const Mat4 P = glm::perspective(glm::radians(60.f), 1.5f, 0.1f, 50.f);
+    const math::Affine3 mv = sampleTransform(0.6f);
+    expectNear(P * mv, P * mv.ToMat4());
+}
+
+TEST(Affine, InversesAndNormalMatrix) {
+    const math::Affine3 a = sampleTransform(0.3f);
+    expectNear((a * a.Inverse()).ToMat4(), Mat4(1.f), 1e-5f);
+    expectNear(a.Inverse().ToMat4(), glm::inverse(a.ToMat4()), 1e-5f);
+
+    const math::Affine3 rigid = math::Affine3::Translation({1.f, 2.f, 3.f}) * math::Affine3::Rotation(1.2f, {0.f, 1.f, 1.f});
+    expectNear(rigid.RigidInverse().ToMat4(), rigid.Inverse().ToMat4());
+
+    const Mat3 expected = glm::transpose(glm::inverse(a.Linear()));
+    const Mat3 normal = a.NormalMatrix();
+    for (int c = 0; c < 3; ++c) {
+        expectNear(normal[c], expected[c]);
+    }
+    // Normals stay perpendicular to transformed tangents under non-uniform scale
+    const Vec3 tangent{1.f, 1.f, 0.f}, n{1.f, -1.f, 0.5f};
+    EXPECT_NEAR(glm::dot(a.TransformDirection(tangent), normal * n), glm::dot(tangent, n), 1e-5f);
+}
+
+TEST(Affine, QuaternionsAndLookAtMatchTheMat4Versions) {
+    const math::Quat q = math::fromAxisAngle(glm::normalize(Vec3{1.f, 2.f, 3.f}), 0.9f);
+    expectNear(math::quatToAffine(q).ToMat4(), math::quatToMat4(q));
+
+    math::QuatBatch batch(19);
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+        batch.set(i, math::fromAxisAngle(glm::normalize(Vec3{1.f, static_cast<float>(i), 0.5f}), 0.1f * static_cast<float>(i)));
+    }
+    std::vector<math::Affine3> affines(batch.size());
+    math::quatToAffine(batch, affines);
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+        expectNear(affines[i].ToMat4(), math::quatToMat4(batch.get(i)));
+    }
+
+    const Vec3 eye{1.f, 2.f, 5.f}, target{0.f, 0.5f, -1.f}, up{0.f, 1.f, 0.f};
+    expectNear(math::lookAtAffine(eye, target, up).ToMat4(), math::lookAtMatrix(eye, target, up));
+    expectNear(math::lookAtAffine(eye, target, up).ToMat4(), glm::lookAt(eye, target, up));
+}
+
+TEST(Affine, BatchedTransforms) {
+    const math::Affine3 a = sampleTransform(0.8f);
+    math::Vec3Batch in(37), points, directions;
+    for (std::size_t i = 0; i < in.size(); ++i) {
+        const float f = static_cast<float>(i);
+        in.set(i, {std::sin(f), std::cos(f), 0.1f * f});
+    }
+    math::transformPoints(a, in, points);
+    math::transformDirections(a, in, directions);
+    ASSERT_EQ(points.size(), in.size());
+    for (std::size_t i = 0; i < in.size(); ++i) {
+        expectNear(points.get(i), a.TransformPoint(in.get(i)));
+        expectNear(directions.get(i), a.TransformDirection(in.get(i)));
+    }
+
+    // In place
+    math::transformPoints(a, in, in);
+    for (std::size_t i = 0; i < in.size(); ++i) {
+        expectNear(in.get(i), points.get(i), 0.f);
+    }
+}
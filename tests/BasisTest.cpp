@@ -0,0 +1,72 @@
+//
+// Change of basis: BasisTransform (scalar and batched) against CoordsInBasis/FromCoords.
+// Built into the linalg_tests executable.
+//
+
+#include <gtest/gtest.h>
+#include "TestUtil.hpp"
+#include "math/Basis.hpp"
+#include <cmath>
+
+namespace {
+
+// Not a multiple of kSimdLanes so the padded tail is exercised
+constexpr std::size_t kCount = 53;
+
+Vec3 samplePoint(std::size_t i) {
+    const float f = static_cast<float>(i);
+    return {std::sin(f), 0.5f * f - 3.f, std::cos(1.7f * f)};
+}
+
+// The lab's u-basis: u1 = v1, u2 = v1 + v2, u3 = v1 + v2 + v3
+const Vec3 kU1{1, 0, 0};
+const Vec3 kU2{1, 1, 0};
+const Vec3 kU3{1, 1, 1};
+
+} // namespace
+
+TEST(BasisTransform, DefaultIsStandardBasis) {
+    const math::BasisTransform t;
+    EXPECT_FALSE(t.IsDegenerate());
+    expectNear(t.ToCoords({1, 2, 3}), {1, 2, 3});
+    expectNear(t.FromCoords({1, 2, 3}), {1, 2, 3});
+}
+
+TEST(BasisTransform, MatchesCoordsInBasis) {
+    const math::BasisTransform t(kU1, kU2, kU3);
+    EXPECT_NEAR(t.Determinant(), 1.f, 1e-6f);
+    for (std::size_t i = 0; i < kCount; ++i) {
+        const Vec3 w = samplePoint(i);
+        expectNear(t.ToCoords(w), math::CoordsInBasis(kU1, kU2, kU3, w));
+        expectNear(t.FromCoords(w), math::FromCoords(kU1, kU2, kU3, w));
+    }
+}
+
+TEST(BasisTransform, RoundTrip) {
+    const math::BasisTransform t({2, 0, 1}, {0, 3, -1}, {1, 1, 4});
+    const Vec3 w{0.3f, -2.f, 5.f};
+    expectNear(t.FromCoords(t.ToCoords(w)), w);
+}
+
+TEST(BasisTransform, DegenerateBasisIsFlagged) {
+    const math::BasisTransform t({1, 0, 0}, {0, 1, 0}, {1, 1, 0});
+    EXPECT_TRUE(t.IsDegenerate());
+    expectNear(t.ToCoords({1, 2, 3}), {0, 0, 0});
+}
+
+TEST(BasisTransform, BatchMatchesScalar) {
+    const math::BasisTransform t({2, 0, 1}, {0, 3, -1}, {1, 1, 4});
+    math::Vec3Batch points(kCount), coords, back;
+    for (std::size_t i = 0; i < kCount; ++i) {
+        points.set(i, samplePoint(i));
+    }
+
+    t.ToCoords(points, coords);
+    t.FromCoords(coords, back);
+
+    ASSERT_EQ(coords.size(), kCount);
+    for (std::size_t i = 0; i < kCount; ++i) {
+        expectNear(coords.get(i), t.ToCoords(samplePoint(i)));
+        expectNear(back.get(i), samplePoint(i), 1e-4f);
+    }
+}
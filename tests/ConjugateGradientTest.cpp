@@ -0,0 +1,144 @@
+//
+// Conjugate gradients with and without preconditioning, warm starts and time budgets,
+// checked against the dense Cholesky solve.
+// Built into the linalg_tests executable.
+//
+
+#include <gtest/gtest.h>
+#include "math/ConjugateGradient.hpp"
+#include "math/Decompose.hpp"
+#include <cmath>
+#include <vector>
+
+namespace {
+
+// 5-point Laplacian of a w x h grid plus `shift` on the diagonal, with the diagonal of
+// every row scaled by `scale(row)` (symmetrically, D A D), so it stays SPD.
+template <class Scale>
+math::SparseMatrix<double> gridMatrix(std::uint32_t w, std::uint32_t h, double shift, Scale scale) {
+    std::vector<math::Triplet<double>> triplets;
+    const auto add = [&](std::uint32_t i, std::uint32_t j, double v) {
+        triplets.push_back({i, j, v * scale(i) * scale(j)});
+    };
+    for (std::uint32_t y = 0; y < h; ++y) {
+        for (std::uint32_t x = 0; x < w; ++x) {
+            const std::uint32_t v = y * w + x;
+            add(v, v, 4.0 + shift);
+            if (x + 1 < w) {
+                add(v, v + 1, -1.0);
+                add(v + 1, v, -1.0);
+            }
+            if (y + 1 < h) {
+                add(v, v + w, -1.0);
+                add(v + w, v, -1.0);
+            }
+        }
+    }
+    return math::SparseMatrix<double>::FromTriplets(w * h, w * h, triplets);
+}
+
+math::SparseMatrix<double> gridMatrix(std::uint32_t w, std::uint32_t h, double shift) {
+    return gridMatrix(w, h, shift, [](std::uint32_t) { return 1.0; });
+}
+
+std::vector<double> sampleRhs(std::size_t n) {
+    std::vector<double> b(n);
+    for (std::size_t i = 0; i < n; ++i) b[i] = std::sin(0.37 * static_cast<double>(i)) + 0.5;
+    return b;
+}
+
+std::size_t iterationsWith(const math::SparseMatrix<double>& A, math::PreconditionerKind kind) {
+    const std::vector<double> b = sampleRhs(A.Rows());
+    std::vector<double> x(A.Rows(), 0.0);
+    const math::CgSettings<double> settings{.maxIterations = 10000, .tolerance = 1e-8};
+    const auto result = math::conjugateGradient<double>(A, b, x, settings, math::Preconditioner<double>(A, kind));
+    EXPECT_TRUE(result.converged);
+    return result.iterations;
+}
+
+} // namespace
+
+TEST(ConjugateGradient, MatchesDenseCholesky) {
+    const auto A = gridMatrix(12, 9, 0.1);
+    const std::vector<double> b = sampleRhs(A.Rows());
+    std::vector<double> x(A.Rows(), 0.0);
+    const auto result = math::conjugateGradient<double>(A, b, x, {.tolerance = 1e-12});
+    ASSERT_TRUE(result.converged);
+    EXPECT_EQ(result.history.size(), result.iterations + 1);
+    EXPECT_LE(result.history.back(), 1e-12);
+
+    const auto chol = math::choleskyFactor(A.ToDense());
+    ASSERT_TRUE(chol.ok);
+    math::Matrix<double> B(b.size(), 1);
+    for (std::size_t i = 0; i < b.size(); ++i) B(i, 0) = b[i];
+    ASSERT_TRUE(math::choleskySolve(chol, B));
+    for (std::size_t i = 0; i < b.size(); ++i) {
+        EXPECT_NEAR(x[i], B(i, 0), 1e-9);
+    }
+}
+
+TEST(ConjugateGradient, PreconditionersCutIterations) {
+    // Rows scaled over an order of magnitude: plain CG suffers, Jacobi undoes the scaling,
+    // IC(0) also captures the coupling
+    const auto A = gridMatrix(40, 40, 0.01, [](std::uint32_t i) { return std::pow(10.0, 0.5 * std::sin(0.7 * i)); });
+    const std::size_t none = iterationsWith(A, math::PreconditionerKind::None);
+    const std::size_t jacobi = iterationsWith(A, math::PreconditionerKind::Jacobi);
+    const std::size_t ic = iterationsWith(A, math::PreconditionerKind::IncompleteCholesky);
+    EXPECT_LT(jacobi, none);
+    EXPECT_LT(ic, jacobi);
+}
+
+TEST(ConjugateGradient, IncompleteCholeskyIsExactWithoutFill) {
+    // A tridiagonal matrix has no fill-in, so IC(0) is its Cholesky factor
+    std::vector<math::Triplet<double>> triplets;
+    for (std::uint32_t i = 0; i < 50; ++i) {
+        triplets.push_back({i, i, 2.5});
+        if (i + 1 < 50) {
+            triplets.push_back({i, i + 1, -1.0});
+            triplets.push_back({i + 1, i, -1.0});
+        }
+    }
+    const auto A = math::SparseMatrix<double>::FromTriplets(50, 50, triplets);
+    const math::Preconditioner<double> ic(A, math::PreconditionerKind::IncompleteCholesky);
+    EXPECT_EQ(ic.Kind(), math::PreconditionerKind::IncompleteCholesky);
+    EXPECT_EQ(ic.Shift(), 0.0);
+    const std::vector<double> b = sampleRhs(50);
+    std::vector<double> x(50, 0.0);
+    const auto result = math::conjugateGradient<double>(A, b, x, {.tolerance = 1e-10}, ic);
+    EXPECT_TRUE(result.converged);
+    EXPECT_EQ(result.iterations, 1u);
+}
+
+TEST(ConjugateGradient, WarmStartFromTheSolutionIsFree) {
+    const auto A = gridMatrix(20, 20, 0.1);
+    const std::vector<double> b = sampleRhs(A.Rows());
+    std::vector<double> x(A.Rows(), 0.0);
+    ASSERT_TRUE(math::conjugateGradient<double>(A, b, x, {.tolerance = 1e-10}).converged);
+    const auto again = math::conjugateGradient<double>(A, b, x, {.tolerance = 1e-9});
+    EXPECT_TRUE(again.converged);
+    EXPECT_EQ(again.iterations, 0u);
+}
+
+TEST(ConjugateGradient, BudgetStopsEarlyAndResumes) {
+    const auto A = gridMatrix(60, 60, 0.001);
+    const std::vector<double> b = sampleRhs(A.Rows());
+    std::vector<double> x(A.Rows(), 0.0);
+    const math::CgSettings<double> tight{.tolerance = 1e-10, .budgetMs = 1e-6};
+    const auto first = math::conjugateGradient<double>(A, b, x, tight);
+    EXPECT_TRUE(first.outOfTime);
+    EXPECT_FALSE(first.converged);
+    EXPECT_EQ(first.iterations, 1u);
+
+    // Restarting from the partial solution still gets there
+    const auto rest = math::conjugateGradient<double>(A, b, x, {.maxIterations = 5000, .tolerance = 1e-10});
+    EXPECT_TRUE(rest.converged);
+    EXPECT_LT(rest.history.front(), first.history.front());
+}
+
+TEST(ConjugateGradient, ZeroRightHandSideGivesZero) {
+    const auto A = gridMatrix(5, 5, 1.0);
+    const std::vector<double> b(A.Rows(), 0.0);
+    std::vector<double> x(A.Rows(), 3.0);
+    EXPECT_TRUE(math::conjugateGradient<double>(A, b, x, {}).converged);
+    for (double v : x) EXPECT_EQ(v, 0.0);
+}
@@ -0,0 +1,181 @@
+//
+// LU, QR and Cholesky factorizations: reconstruction, solves, failure flags and traces.
+// Built into the linalg_tests executable.
+//
+
+#include <gtest/gtest.h>
+#include "TestUtil.hpp"
+#include "math/Decompose.hpp"
+#include <cmath>
+#include <random>
+
+namespace {
+
+// Uniform in [-1, 1): full rank with overwhelming probability (sin(a r + b c) is only rank 2)
+template <class T>
+math::Matrix<T> sampleMatrix(std::size_t rows, std::size_t cols, math::Layout layout, T seed) {
+    std::mt19937 rng(static_cast<unsigned>(seed * 1000));
+    std::uniform_real_distribution<T> dist(T{-1}, T{1});
+    math::Matrix<T> m(rows, cols, layout);
+    for (std::size_t r = 0; r < rows; ++r) {
+        for (std::size_t c = 0; c < cols; ++c) {
+            m(r, c) = dist(rng);
+        }
+    }
+    return m;
+}
+
+// A^T A + n I: symmetric positive definite and well conditioned
+template <class T>
+math::Matrix<T> sampleSpd(std::size_t n, T seed) {
+    const auto A = sampleMatrix<T>(n, n, math::Layout::RowMajor, seed);
+    math::Matrix<T> S(n, n);
+    math::gemm<T>(A.Ref().Transposed(), A.Ref(), S.Ref());
+    for (std::size_t i = 0; i < n; ++i) {
+        S(i, i) += static_cast<T>(n);
+    }
+    return S;
+}
+
+// P^T L U from packed factors
+math::Matrix<double> luProduct(const math::LUFactors<double>& f) {
+    const std::size_t m = f.lu.Rows(), n = f.lu.Cols(), k = f.pivots.size();
+    math::Matrix<double> L(m, k), U(k, n);
+    for (std::size_t r = 0; r < m; ++r) {
+        for (std::size_t c = 0; c < k; ++c) {
+            L(r, c) = r == c ? 1.0 : (r > c ? f.lu(r, c) : 0.0);
+        }
+    }
+    for (std::size_t r = 0; r < k; ++r) {
+        for (std::size_t c = r; c < n; ++c) {
+            U(r, c) = f.lu(r, c);
+        }
+    }
+    math::Matrix<double> A = L * U;
+    for (std::size_t j = k; j-- > 0;) {
+        for (std::size_t c = 0; c < n; ++c) {
+            std::swap(A(j, c), A(f.pivots[j], c));
+        }
+    }
+    return A;
+}
+
+} // namespace
+
+TEST(Decomposition, LUReconstructsSquareAndRectangular) {
+    // 150 columns spans three panels, so the blocked trailing update is exercised
+    for (auto [m, n] : {std::pair{150u, 150u}, std::pair{170u, 90u}, std::pair{70u, 130u}}) {
+        const auto A = sampleMatrix<double>(m, n, math::Layout::ColMajor, 0.3);
+        const auto f = math::luFactor(A);
+        EXPECT_FALSE(f.singular);
+        expectMatrixNear(luProduct(f), A.WithLayout(math::Layout::RowMajor), 1e-10);
+    }
+}
+
+TEST(Decomposition, LUSolvesAndDeterminant) {
+    const auto A = sampleMatrix<double>(200, 200, math::Layout::RowMajor, 1.1);
+    const auto X = sampleMatrix<double>(200, 3, math::Layout::RowMajor, 2.0);
+    auto B = A * X;
+    const auto f = math::luFactor(A);
+    ASSERT_TRUE(math::luSolve(f, B));
+    expectMatrixNear(B, X, 1e-8);
+
+    math::Matrix<double> D(3, 3);
+    D(0, 0) = 2.0; D(0, 1) = 1.0;
+    D(1, 0) = 4.0; D(1, 1) = 1.0; D(1, 2) = 3.0;
+    D(2, 1) = 5.0; D(2, 2) = 1.0;
+    EXPECT_NEAR(math::luDeterminant(math::luFactor(D)), -32.0, 1e-12);
+}
+
+TEST(Decomposition, LUFlagsSingular) {
+    auto A = sampleMatrix<double>(6, 6, math::Layout::RowMajor, 0.0);
+    for (std::size_t r = 0; r < 6; ++r) {
+        A(r, 5) = 0.0; // stays exactly zero through the elimination
+    }
+    const auto f = math::luFactor(A);
+    EXPECT_TRUE(f.singular);
+    EXPECT_EQ(math::luDeterminant(f), 0.0);
+    auto B = sampleMatrix<double>(6, 1, math::Layout::RowMajor, 1.0);
+    EXPECT_FALSE(math::luSolve(f, B));
+}
+
+TEST(Decomposition, QRIsOrthonormalAndReconstructs) {
+    const auto A = sampleMatrix<double>(180, 140, math::Layout::RowMajor, 0.5);
+    const auto f = math::qrFactor(A);
+    const auto Q = math::qrQ(f);
+    ASSERT_EQ(Q.Rows(), 180u);
+    ASSERT_EQ(Q.Cols(), 140u);
+
+    const auto QtQ = Q.Transposed() * Q;
+    expectMatrixNear(QtQ, math::Matrix<double>::Identity(140), 1e-10);
+
+    math::Matrix<double> R(140, 140);
+    for (std::size_t r = 0; r < 140; ++r) {
+        for (std::size_t c = r; c < 140; ++c) {
+            R(r, c) = f.qr(r, c);
+        }
+    }
+    expectMatrixNear(Q * R, A, 1e-10);
+}
+
+TEST(Decomposition, QRSolvesLeastSquares) {
+    // Consistent overdetermined system: the least-squares solution is exact
+    const auto A = sampleMatrix<double>(120, 80, math::Layout::ColMajor, 0.9);
+    const auto x = sampleMatrix<double>(80, 2, math::Layout::RowMajor, 3.0);
+    auto B = A * x;
+    ASSERT_TRUE(math::qrSolve(math::qrFactor(A), B));
+    for (std::size_t r = 0; r < 80; ++r) {
+        EXPECT_NEAR(B(r, 0), x(r, 0), 1e-9);
+        EXPECT_NEAR(B(r, 1), x(r, 1), 1e-9);
+    }
+}
+
+TEST(Decomposition, CholeskyReconstructsAndSolves) {
+    const auto S = sampleSpd<double>(160, 0.2);
+    const auto f = math::choleskyFactor(S);
+    ASSERT_TRUE(f.ok);
+    EXPECT_EQ(f.l(3, 10), 0.0);
+    expectMatrixNear(f.l * f.l.Transposed(), S, 1e-9);
+
+    const auto X = sampleMatrix<double>(160, 2, math::Layout::RowMajor, 4.0);
+    auto B = S * X;
+    ASSERT_TRUE(math::choleskySolve(f, B));
+    expectMatrixNear(B, X, 1e-9);
+}
+
+TEST(Decomposition, CholeskyRejectsIndefinite) {
+    auto S = sampleSpd<double>(8, 0.2);
+    S(5, 5) = -1.0;
+    const auto f = math::choleskyFactor(S);
+    EXPECT_FALSE(f.ok);
+    auto B = sampleMatrix<double>(8, 1, math::Layout::RowMajor, 1.0);
+    EXPECT_FALSE(math::choleskySolve(f, B));
+}
+
+TEST(Decomposition, TraceKeepsSnapshotsOfSmallMatrices) {
+    const auto A = sampleMatrix<float>(4, 4, math::Layout::RowMajor, 0.0f);
+    math::FactorTrace<float> trace;
+    const auto f = math::luFactor(A, &trace);
+    ASSERT_EQ(trace.steps.size(), 4u);
+    ASSERT_TRUE(trace.HasSnapshots());
+    EXPECT_EQ(trace.steps[0].pivotRow, f.pivots[0]);
+    expectMatrixNear(trace.Snapshot(3), f.lu, 0.f);
+    EXPECT_TRUE(trace.Snapshot(4).Empty());
+
+    // Too large for snapshots: pivots only
+    math::FactorTrace<float> big;
+    math::choleskyFactor(sampleSpd<float>(20, 0.f), &big);
+    EXPECT_EQ(big.steps.size(), 20u);
+    EXPECT_FALSE(big.HasSnapshots());
+}
+
+TEST(Decomposition, ThreadedTrailingUpdateMatchesSerial) {
+    // Large enough for gemm to go parallel on the trailing update
+    const auto S = sampleSpd<float>(320, 0.6f);
+    const auto f = math::choleskyFactor(S);
+    ASSERT_TRUE(f.ok);
+    const auto X = sampleMatrix<float>(320, 1, math::Layout::RowMajor, 0.f);
+    auto B = S * X;
+    ASSERT_TRUE(math::choleskySolve(f, B));
+    expectMatrixNear(B, X, 1e-3f);
+}
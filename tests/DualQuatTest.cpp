@@ -0,0 +1,109 @@
+//
+// Dual quaternion transforms and DLB skinning, checked against Mat4 equivalents.
+// Built into the quaternion_tests executable.
+//
+
+#include <gtest/gtest.h>
+#include "TestUtil.hpp"
+#include "math/DualQuat.hpp"
+#include "render/Skinning.hpp"
+#include <cmath>
+#include <numbers>
+#include <vector>
+
+namespace {
+
+constexpr float kEps = 1e-5f;
+
+Vec3 applyMat4(const Mat4& M, const Vec3& p) {
+    const Vec4 r = M * Vec4(p, 1.f);
+    return {r.x, r.y, r.z};
+}
+
+math::DualQuat sampleTransform(float seed) {
+    const math::Quat r = math::fromAxisAngle(glm::normalize(Vec3{1.f, seed, 0.5f}), seed);
+    return math::fromRotationTranslation(r, {seed, -2.f * seed, 0.5f});
+}
+
+} // namespace
+
+TEST(DualQuat, IdentityLeavesPointsAlone) {
+    const math::DualQuat id{};
+    expectNear(math::transformPoint(id, {1.f, 2.f, 3.f}), {1.f, 2.f, 3.f});
+}
+
+TEST(DualQuat, TranslationRoundTrips) {
+    const math::DualQuat dq = sampleTransform(0.7f);
+    expectNear(math::translation(dq), {0.7f, -1.4f, 0.5f});
+}
+
+TEST(DualQuat, TransformPointMatchesMat4) {
+    const math::DualQuat dq = sampleTransform(1.3f);
+    const Mat4 M = math::dualQuatToMat4(dq);
+    const Vec3 p{0.3f, -1.f, 2.f};
+    expectNear(math::transformPoint(dq, p), applyMat4(M, p));
+}
+
+TEST(DualQuat, MultiplyComposesLikeMat4) {
+    const math::DualQuat a = sampleTransform(0.4f);
+    const math::DualQuat b = sampleTransform(-1.1f);
+    const Mat4 M = math::dualQuatToMat4(a) * math::dualQuatToMat4(b);
+    const Vec3 p{1.f, 0.5f, -0.25f};
+    expectNear(math::transformPoint(math::multiply(a, b), p), applyMat4(M, p));
+}
+
+TEST(DualQuat, InverseUndoesTransform) {
+    const math::DualQuat dq = sampleTransform(2.1f);
+    const Vec3 p{-1.f, 4.f, 0.5f};
+    expectNear(math::transformPoint(math::inverse(dq), math::transformPoint(dq, p)), p, 1e-4f);
+}
+
+TEST(DualQuat, BlendIgnoresQuaternionSign) {
+    const math::DualQuat a = sampleTransform(0.9f);
+    const math::DualQuat flipped{-a.real, -a.dual};
+    const math::DualQuat ts[] = {a, flipped};
+    const float ws[] = {0.5f, 0.5f};
+    const Vec3 p{1.f, 2.f, 3.f};
+    expectNear(math::transformPoint(math::blend(ts, ws), p), math::transformPoint(a, p));
+}
+
+TEST(DualQuat, BlendOfTwoRotationsPreservesLength) {
+    // Linear blending of matrices shrinks a point halfway between +-90 degrees; DLB must not
+    const float h = std::numbers::pi_v<float> / 2.f;
+    const math::DualQuat ts[] = {
+        math::fromRotationTranslation(math::fromAxisAngle({0, 0, 1}, h), {}),
+        math::fromRotationTranslation(math::fromAxisAngle({0, 0, 1}, -h), {}),
+    };
+    const float ws[] = {0.5f, 0.5f};
+    const Vec3 p{1.f, 0.f, 0.f};
+    EXPECT_NEAR(glm::length(math::transformPoint(math::blend(ts, ws), p)), 1.f, kEps);
+}
+
+TEST(Skinning, RestPoseIsIdentity) {
+    const render::SkinnedMesh mesh = render::MakeChainSkin(render::MakeTube(0.2f, 2.f, 9, 7), 4, 2.f);
+    const auto bones = render::ChainPose(4, 2.f, 0.f);
+    math::Vec3Batch pos, nrm;
+    render::SkinDualQuat(mesh, bones, pos, nrm);
+
+    ASSERT_EQ(pos.size(), mesh.bind.VertexCount());
+    for (std::size_t i = 0; i < pos.size(); ++i) {
+        expectNear(pos.get(i), mesh.bind.positions[i]);
+        expectNear(nrm.get(i), mesh.bind.normals[i]);
+    }
+}
+
+TEST(Skinning, MatchesScalarBlend) {
+    const render::SkinnedMesh mesh = render::MakeChainSkin(render::MakeTube(0.2f, 2.f, 9, 7), 4, 2.f);
+    const auto bones = render::ChainPose(4, 2.f, 0.6f);
+    math::Vec3Batch pos, nrm;
+    render::SkinDualQuat(mesh, bones, pos, nrm);
+
+    for (std::size_t i = 0; i < pos.size(); ++i) {
+        const render::BoneInfluence& inf = mesh.influences[i];
+        std::vector<math::DualQuat> ts;
+        for (std::uint32_t b : inf.bones) ts.push_back(bones[b]);
+        const math::DualQuat dq = math::blend(ts, inf.weights);
+        expectNear(pos.get(i), math::transformPoint(dq, mesh.bind.positions[i]), 1e-4f);
+        expectNear(nrm.get(i), math::transformVector(dq, mesh.bind.normals[i]), 1e-4f);
+    }
+}
@@ -0,0 +1,136 @@
+//
+// 3x3 symmetric eigen decomposition and SVD, scalar and batched.
+// Built into the linalg_tests executable.
+//
+
+#include <gtest/gtest.h>
+#include "TestUtil.hpp"
+#include "math/Eigen3x3.hpp"
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr float kEps = 2e-5f;
+
+void expectRotation(const Mat3& m) {
+    expectNear(glm::transpose(m) * m, Mat3(1.f), kEps);
+    EXPECT_NEAR(glm::determinant(m), 1.f, kEps);
+}
+
+Mat3 diagonal(const Vec3& d) {
+    Mat3 m(0.f);
+    m[0][0] = d.x;
+    m[1][1] = d.y;
+    m[2][2] = d.z;
+    return m;
+}
+
+std::vector<Mat3> sampleMatrices(std::size_t n) {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> dist(-1.f, 1.f);
+    std::vector<Mat3> out(n);
+    for (Mat3& m : out) {
+        for (int c = 0; c < 3; ++c) {
+            m[c] = Vec3{dist(rng), dist(rng), dist(rng)};
+        }
+    }
+    return out;
+}
+
+} // namespace
+
+TEST(SymmetricEigen3, ReconstructsRandomSymmetric) {
+    for (const Mat3& m : sampleMatrices(200)) {
+        const Mat3 A = m + glm::transpose(m);
+        const math::SymmetricEigen3 e = math::symmetricEigen(A);
+        expectRotation(e.vectors);
+        EXPECT_GE(e.values.x, e.values.y);
+        EXPECT_GE(e.values.y, e.values.z);
+        expectNear(e.vectors * diagonal(e.values) * glm::transpose(e.vectors), A, 1e-4f);
+    }
+}
+
+TEST(SymmetricEigen3, HandlesRepeatedAndZeroEigenvalues) {
+    const math::SymmetricEigen3 zero = math::symmetricEigen(Mat3(0.f));
+    EXPECT_EQ(zero.values, Vec3(0.f));
+    expectRotation(zero.vectors);
+
+    // diag(1, 2, 2) seen in a rotated frame
+    const Mat3 R = math::svd(sampleMatrices(1)[0]).u;
+    const Mat3 A = R * diagonal({1.f, 2.f, 2.f}) * glm::transpose(R);
+    const math::SymmetricEigen3 e = math::symmetricEigen(A);
+    EXPECT_NEAR(e.values.x, 2.f, kEps);
+    EXPECT_NEAR(e.values.y, 2.f, kEps);
+    EXPECT_NEAR(e.values.z, 1.f, kEps);
+    EXPECT_NEAR(std::abs(glm::dot(e.vectors[2], R[0])), 1.f, kEps);
+}
+
+TEST(Svd3, ReconstructsWithRotationsAndSignedSmallestValue) {
+    for (const Mat3& A : sampleMatrices(200)) {
+        const math::Svd3 s = math::svd(A);
+        expectRotation(s.u);
+        expectRotation(s.v);
+        EXPECT_GE(s.sigma.x, s.sigma.y);
+        EXPECT_GE(s.sigma.y, std::abs(s.sigma.z) - kEps);
+        EXPECT_EQ(s.sigma.z < 0.f, glm::determinant(A) < 0.f);
+        expectNear(s.u * diagonal(s.sigma) * glm::transpose(s.v), A, 1e-4f);
+    }
+}
+
+TEST(Svd3, RankDeficientStaysOrthonormal) {
+    // Rank 1: outer product
+    Mat3 A(0.f);
+    const Vec3 a{1.f, 2.f, -1.f}, b{0.5f, 0.f, 1.f};
+    for (int c = 0; c < 3; ++c) {
+        A[c] = a * b[c];
+    }
+    const math::Svd3 s = math::svd(A);
+    expectRotation(s.u);
+    expectRotation(s.v);
+    EXPECT_NEAR(s.sigma.x, glm::length(a) * glm::length(b), 1e-5f);
+    EXPECT_NEAR(s.sigma.y, 0.f, 1e-3f);
+    EXPECT_NEAR(s.sigma.z, 0.f, 1e-3f);
+    expectNear(s.u * diagonal(s.sigma) * glm::transpose(s.v), A, 1e-4f);
+}
+
+TEST(Eigen3x3Batch, MatchesScalar) {
+    const std::vector<Mat3> ms = sampleMatrices(37); // not a multiple of the lane count
+    math::Mat3Batch batch(ms.size()), sym(ms.size());
+    for (std::size_t i = 0; i < ms.size(); ++i) {
+        batch.set(i, ms[i]);
+        sym.set(i, ms[i] + glm::transpose(ms[i]));
+    }
+
+    math::Mat3Batch u, v, vectors;
+    math::Vec3Batch sigma, values;
+    math::svd(batch, u, sigma, v);
+    math::symmetricEigen(sym, values, vectors);
+    ASSERT_EQ(u.size(), ms.size());
+    for (std::size_t i = 0; i < ms.size(); ++i) {
+        const math::Svd3 s = math::svd(ms[i]);
+        expectNear(u.get(i), s.u, kEps);
+        expectNear(v.get(i), s.v, kEps);
+        EXPECT_NEAR(glm::length(sigma.get(i) - s.sigma), 0.f, kEps);
+
+        const math::SymmetricEigen3 e = math::symmetricEigen(sym.get(i));
+        expectNear(vectors.get(i), e.vectors, kEps);
+        EXPECT_NEAR(glm::length(values.get(i) - e.values), 0.f, kEps);
+    }
+}
+
+TEST(Covariance, SmallestEigenvectorIsPlaneNormal) {
+    const Vec3 normal = glm::normalize(Vec3{1.f, 2.f, 2.f});
+    const Vec3 t1 = glm::normalize(glm::cross(normal, Vec3{0.f, 0.f, 1.f}));
+    const Vec3 t2 = glm::cross(normal, t1);
+    std::vector<Vec3> points;
+    for (int i = 0; i < 50; ++i) {
+        const float f = static_cast<float>(i);
+        points.push_back(Vec3{3.f, -1.f, 0.5f} + t1 * std::sin(f) * 2.f + t2 * std::cos(1.7f * f));
+    }
+    const math::SymmetricEigen3 e = math::symmetricEigen(math::covariance(points));
+    EXPECT_NEAR(e.values.z, 0.f, 1e-5f);
+    EXPECT_NEAR(std::abs(glm::dot(e.vectors[2], normal)), 1.f, 1e-5f);
+    EXPECT_NEAR(std::abs(glm::dot(e.vectors[0], t1)), 1.f, 1e-2f); // the longer spread
+}
@@ -0,0 +1,118 @@
+//
+// Expression templates: fused element-wise expressions and matrix chains agree with the
+// same arithmetic written directly in glm.
+// Built into the linalg_tests executable.
+//
+
+#include <gtest/gtest.h>
+#include "TestUtil.hpp"
+#include "math/Expr.hpp"
+#include <glm/gtc/matrix_transform.hpp>
+#include <cmath>
+#include <vector>
+
+namespace {
+
+using namespace math::expr;
+
+constexpr float kEps = 1e-5f;
+
+std::vector<Vec3> samplePoints(std::size_t n) {
+    std::vector<Vec3> points(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        const float f = static_cast<float>(i);
+        points[i] = {std::sin(f), std::cos(1.3f * f), 0.5f * std::sin(0.7f * f)};
+    }
+    return points;
+}
+
+} // namespace
+
+TEST(Expr, ConstantsEvaluateLikeGlm) {
+    const Vec3 a{1.f, 2.f, 3.f}, b{-0.5f, 0.25f, 4.f}, c{2.f, 2.f, 2.f};
+    const float u = 0.3f, v = 0.8f;
+    const Vec3 fused = eval((1.f - u) * (1.f - v) * lazy(a) + u * (1.f - v) * lazy(b) + lazy(c) * (u * v));
+    const Vec3 direct = (1.f - u) * (1.f - v) * a + u * (1.f - v) * b + u * v * c;
+    EXPECT_NEAR(glm::length(fused - direct), 0.f, kEps);
+
+    EXPECT_EQ(eval(-lazy(a) / 2.f), -a / 2.f);
+    EXPECT_EQ(eval(lazy(a) - b * lazy(c)), a - b * c);
+    EXPECT_FLOAT_EQ(eval(lazy(2.f) * 3.f + 1.f), 7.f);
+}
+
+TEST(Expr, MapFallsBackToGlm) {
+    const Vec3 a{3.f, 0.f, 4.f}, b{0.f, 1.f, 0.f};
+    const auto normalized = map([](const Vec3& x) { return glm::normalize(x); }, lazy(a) * 2.f);
+    EXPECT_EQ(eval(normalized), glm::normalize(a * 2.f));
+    const auto crossed = map([](const Vec3& x, const Vec3& y) { return glm::cross(x, y); }, a, lazy(b));
+    EXPECT_EQ(eval(crossed), glm::cross(a, b));
+    EXPECT_FLOAT_EQ(eval(map([](const Vec3& x) { return glm::dot(x, x); }, a)), 25.f);
+}
+
+TEST(Expr, AssignFusesSequencesAndConstants) {
+    const std::vector<Vec3> a = samplePoints(37);
+    const std::vector<Vec3> b = samplePoints(74);
+    const std::span<const Vec3> bHead(b.data(), a.size());
+    std::vector<Vec3> out(a.size());
+    const Vec3 offset{0.1f, -0.2f, 0.3f};
+    assign(std::span<Vec3>(out), lazy(a) * 2.f + lazy(bHead) - offset);
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        EXPECT_EQ(out[i], a[i] * 2.f + b[i] - offset) << i;
+    }
+
+    // In place: element i is read before it is written
+    assign(std::span<Vec3>(out), lazy(out) * 0.5f);
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        EXPECT_EQ(out[i], (a[i] * 2.f + b[i] - offset) * 0.5f) << i;
+    }
+}
+
+TEST(Expr, AssignsBatches) {
+    const std::vector<Vec3> points = samplePoints(21);
+    math::Vec3Batch in(points.size()), out(points.size());
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        in.set(i, points[i]);
+    }
+    const Vec3 scale{1.f, 2.f, 3.f};
+    assign(out, lazy(in) * scale + lazy(points));
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        EXPECT_EQ(out.get(i), points[i] * scale + points[i]) << i;
+    }
+    EXPECT_EQ(out.x[out.paddedSize() - 1], 0.f); // padding untouched
+}
+
+TEST(Expr, MatrixChainsMatchEitherOrder) {
+    const Mat4 P = glm::perspective(glm::radians(60.f), 1.5f, 0.1f, 50.f);
+    const Mat4 V = glm::lookAt(Vec3{1.f, 2.f, 5.f}, Vec3{0.f}, Vec3{0.f, 1.f, 0.f});
+    const Mat4 M = glm::rotate(glm::translate(Mat4(1.f), Vec3{0.f, 0.5f, -2.f}), 0.7f, Vec3{1.f, 1.f, 0.f});
+    const Mat4 PVM = P * V * M;
+
+    const auto chain = lazy(P) * V * M;
+    for (int k = 0; k < 4; ++k) {
+        expectNear(eval(chain)[k], PVM[k]);
+    }
+    EXPECT_EQ(eval(lazy(P) * V), P * V);
+
+    // One vector: right to left
+    const Vec4 p{0.3f, -0.4f, 0.9f, 1.f};
+    expectNear(eval(chain * p), PVM * p, 1e-4f);
+
+    // A sequence: collapsed once
+    const std::vector<Vec3> points = samplePoints(16);
+    std::vector<Vec4> clip(points.size());
+    assign(std::span<Vec4>(clip), chain * point(lazy(points)));
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        expectNear(clip[i], PVM * Vec4(points[i], 1.f), 1e-4f);
+    }
+    expectNear(eval(lazy(M) * direction(lazy(Vec3{0.f, 0.f, 1.f}))), M * Vec4(0.f, 0.f, 1.f, 0.f));
+}
+
+TEST(Expr, CoversChecksEveryArray) {
+    const std::vector<float> a(8, 1.f);
+    const std::vector<float> b(5, 2.f);
+    const auto sum = lazy(a) * 2.f + lazy(b);
+    EXPECT_TRUE(sum.Covers(5));
+    EXPECT_FALSE(sum.Covers(6)); // b is short, whatever a holds
+    EXPECT_TRUE((lazy(1.f) + 2.f).Covers(1000));
+    EXPECT_FALSE(map([](float x, float y) { return x * y; }, lazy(b), lazy(a)).Covers(8));
+}
@@ -0,0 +1,168 @@
+//
+// Laplacian-editing deformation: constraints, warm starts and the asynchronous solver.
+// Built into the render_tests executable.
+//
+
+#include <gtest/gtest.h>
+#include "render/LaplacianDeform.hpp"
+#include "render/Mesh.hpp"
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace {
+
+// Welded sphere with the bottom cap anchored and the top cap as the handle
+struct Scene {
+    render::IndexedMesh mesh;
+    std::vector<render::VertexRole> roles;
+};
+
+Scene sphereScene(int rings = 24, float cap = 0.6f) {
+    Scene s;
+    s.mesh = render::WeldVertices(render::MakeSphere(1.f, rings, rings + 8));
+    for (const Vec3& p : s.mesh.positions) {
+        s.roles.push_back(p.y < -cap ? render::VertexRole::Anchor
+                          : p.y > cap ? render::VertexRole::Handle
+                                      : render::VertexRole::Free);
+    }
+    return s;
+}
+
+const math::CgSettings<float> kSettings{.maxIterations = 2000, .tolerance = 1e-6f};
+
+} // namespace
+
+TEST(LaplacianDeform, RestPoseIsTheSolution) {
+    const Scene s = sphereScene();
+    render::LaplacianDeformer deformer(s.mesh, s.roles, math::PreconditionerKind::IncompleteCholesky);
+    EXPECT_GT(deformer.FreeCount(), 0u);
+    EXPECT_LT(deformer.FreeCount(), s.mesh.VertexCount());
+    const render::DeformStats stats = deformer.Solve(kSettings);
+    EXPECT_TRUE(stats.converged);
+    EXPECT_EQ(stats.iterations, 0u); // warm-started from the rest pose
+    std::vector<Vec3> positions;
+    deformer.Positions(positions);
+    for (std::size_t i = 0; i < positions.size(); ++i) {
+        EXPECT_NEAR(glm::length(positions[i] - s.mesh.positions[i]), 0.f, 1e-5f);
+    }
+}
+
+TEST(LaplacianDeform, ConstraintsHoldAndFreeVerticesInterpolate) {
+    const Scene s = sphereScene();
+    for (auto kind : {math::PreconditionerKind::None, math::PreconditionerKind::Jacobi,
+                      math::PreconditionerKind::IncompleteCholesky}) {
+        render::LaplacianDeformer deformer(s.mesh, s.roles, kind);
+        const Vec3 offset{0.3f, 0.5f, 0.f};
+        deformer.SetHandleTransform(glm::translate(Mat4(1.f), offset));
+        const render::DeformStats stats = deformer.Solve(kSettings);
+        EXPECT_TRUE(stats.converged);
+        EXPECT_LE(stats.residual, 1e-6f);
+
+        std::vector<Vec3> positions;
+        deformer.Positions(positions);
+        for (std::size_t i = 0; i < positions.size(); ++i) {
+            const Vec3 moved = positions[i] - s.mesh.positions[i];
+            switch (s.roles[i]) {
+                case render::VertexRole::Anchor:
+                    EXPECT_EQ(moved, Vec3(0.f));
+                    break;
+                case render::VertexRole::Handle:
+                    EXPECT_NEAR(glm::length(moved - offset), 0.f, 1e-5f);
+                    break;
+                case render::VertexRole::Free:
+                    EXPECT_GT(moved.y, -1e-4f);
+                    EXPECT_LT(moved.y, offset.y + 1e-4f);
+                    break;
+            }
+        }
+    }
+}
+
+TEST(LaplacianDeform, WarmStartTracksSmallEdits) {
+    // A few iterations per frame: after a converged solve, a small handle move starts close
+    // to its answer, while a large first move from the rest pose does not
+    const Scene s = sphereScene(96, 0.95f);
+    const math::CgSettings<float> fewIterations{.maxIterations = 5, .tolerance = 1e-6f};
+    render::LaplacianDeformer deformer(s.mesh, s.roles, math::PreconditionerKind::Jacobi);
+    deformer.SetHandleTransform(glm::translate(Mat4(1.f), Vec3{0.f, 0.5f, 0.f}));
+    const render::DeformStats cold = deformer.Solve(fewIterations);
+    EXPECT_FALSE(cold.converged);
+    ASSERT_TRUE(deformer.Solve(kSettings).converged);
+
+    deformer.SetHandleTransform(glm::translate(Mat4(1.f), Vec3{0.f, 0.52f, 0.f}));
+    const render::DeformStats warm = deformer.Solve(fewIterations);
+    EXPECT_LT(warm.residual, 0.1f * cold.residual);
+}
+
+TEST(LaplacianDeform, AsyncSolveMatchesSynchronous) {
+    const Scene s = sphereScene();
+    const Mat4 handle = glm::rotate(glm::translate(Mat4(1.f), Vec3{0.f, 0.4f, 0.2f}), 0.5f, Vec3{0.f, 1.f, 0.f});
+    render::LaplacianDeformer sync(s.mesh, s.roles, math::PreconditionerKind::IncompleteCholesky);
+    sync.SetHandleTransform(handle);
+    ASSERT_TRUE(sync.Solve(kSettings).converged);
+    std::vector<Vec3> expected;
+    sync.Positions(expected);
+
+    render::AsyncDeformer async(render::LaplacianDeformer(s.mesh, s.roles, math::PreconditionerKind::IncompleteCholesky));
+    math::CgSettings<float> sliced = kSettings;
+    sliced.budgetMs = 0.2; // many small slices
+    async.Request(handle, sliced);
+
+    std::vector<Vec3> positions;
+    render::DeformStats stats;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!(async.Poll(positions, stats) && stats.converged) && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ASSERT_TRUE(stats.converged);
+    EXPECT_FALSE(async.Busy());
+    ASSERT_EQ(positions.size(), expected.size());
+    for (std::size_t i = 0; i < positions.size(); ++i) {
+        EXPECT_NEAR(glm::length(positions[i] - expected[i]), 0.f, 1e-4f);
+    }
+}
+
+TEST(LaplacianDeform, OneNonImprovingSliceDoesNotEndTheSolve) {
+    render::SliceProgress progress;
+    const auto slice = [](float residual) { return render::DeformStats{.iterations = 20, .residual = residual}; };
+    EXPECT_TRUE(progress.Continue(slice(1e-2f)));
+    EXPECT_TRUE(progress.Continue(slice(4e-3f)));
+    // CG restarted on a short budget and came out higher: keep going
+    EXPECT_TRUE(progress.Continue(slice(5e-3f)));
+    EXPECT_TRUE(progress.Continue(slice(1e-3f)));
+    // Judged against the best so far, not the previous slice: k slices without progress stop
+    EXPECT_TRUE(progress.Continue(slice(2e-3f)));
+    EXPECT_TRUE(progress.Continue(slice(1e-3f)));
+    EXPECT_FALSE(progress.Continue(slice(1.5e-3f)));
+
+    progress.Reset();
+    EXPECT_TRUE(progress.Continue(slice(1.5e-3f)));
+    EXPECT_FALSE(progress.Continue({.iterations = 5, .residual = 1e-7f, .converged = true}));
+    progress.Reset();
+    EXPECT_FALSE(progress.Continue({.iterations = 0, .residual = 1.f}));
+}
+
+TEST(LaplacianDeform, AsyncStopsWhenSlicesStopHelping) {
+    // Tolerance 0 is never reached: the worker must go idle once the residual stops falling
+    const Scene s = sphereScene();
+    render::AsyncDeformer async(render::LaplacianDeformer(s.mesh, s.roles, math::PreconditionerKind::Jacobi));
+    math::CgSettings<float> settings = kSettings;
+    settings.tolerance = 0.f;
+    settings.budgetMs = 0.2;
+    async.Request(glm::translate(Mat4(1.f), Vec3{0.f, 0.3f, 0.f}), settings);
+
+    std::vector<Vec3> positions;
+    render::DeformStats stats;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (async.Busy() && std::chrono::steady_clock::now() < deadline) {
+        async.Poll(positions, stats);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_FALSE(async.Busy());
+    async.Poll(positions, stats);
+    EXPECT_FALSE(stats.converged);
+    EXPECT_LT(stats.residual, 1e-4f);
+}
@@ -0,0 +1,158 @@
+//
+// Clustered light culling: conservative assignment and shading equal to brute force, and
+// one-light shading equal to phongBatch.
+// Built into the render_tests executable.
+//
+
+#include <gtest/gtest.h>
+#include "TestUtil.hpp"
+#include "math/Camera.hpp"
+#include "math/LightClusters.hpp"
+#include "math/LightingBatch.hpp"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <vector>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace {
+
+constexpr float kNear = 0.1f;
+constexpr float kFar = 50.f;
+
+std::vector<math::Light> sampleLights(std::size_t count) {
+    std::vector<math::Light> lights(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const float f = static_cast<float>(i);
+        lights[i].position = {6.f * std::sin(1.3f * f), 3.f * std::cos(0.7f * f), -8.f + 6.f * std::sin(f)};
+        lights[i].color = {0.5f + 0.5f * std::sin(f), 0.5f, 0.5f + 0.5f * std::cos(f)};
+        lights[i].range = 1.f + static_cast<float>(i % 5);
+    }
+    return lights;
+}
+
+Vec3 samplePoint(std::size_t i) {
+    const float f = static_cast<float>(i);
+    return {4.f * std::sin(2.1f * f), 2.5f * std::cos(1.1f * f), -8.f + 5.f * std::cos(0.37f * f)};
+}
+
+} // namespace
+
+TEST(Attenuation, ZeroAtAndBeyondRange) {
+    math::Light light;
+    light.range = 4.f;
+    EXPECT_GT(math::attenuation(light, 0.f), 0.f);
+    EXPECT_GT(math::attenuation(light, 3.9f), 0.f);
+    EXPECT_EQ(math::attenuation(light, 4.f), 0.f);
+    EXPECT_EQ(math::attenuation(light, 10.f), 0.f);
+}
+
+TEST(LightClusters, EveryReachingLightIsInTheCluster) {
+    const auto lights = sampleLights(200);
+    const Mat4 view = glm::lookAt(Vec3{0, 1, 4}, Vec3{0, 0, -8}, Vec3{0, 1, 0});
+    for (const Mat4& projection : {glm::perspective(glm::radians(60.f), 16.f / 9.f, kNear, kFar),
+                                   math::orthographic(8.f, 16.f / 9.f, kNear, kFar)}) {
+        math::LightClusters clusters;
+        clusters.Build(lights, view, projection, kNear, kFar);
+
+        for (std::size_t i = 0; i < 500; ++i) {
+            const Vec3 p = samplePoint(i);
+            const int cluster = clusters.ClusterIndex(Vec3(view * Vec4(p, 1.f)));
+            if (cluster < 0) {
+                continue;
+            }
+            const auto assigned = clusters.PointLights(cluster);
+            for (std::size_t li = 0; li < lights.size(); ++li) {
+                if (glm::length(lights[li].position - p) < lights[li].range) {
+                    EXPECT_NE(std::find(assigned.begin(), assigned.end(), li), assigned.end())
+                        << "light " << li << " missing at point " << i;
+                }
+            }
+        }
+    }
+}
+
+TEST(LightClusters, CullsMostLights) {
+    const auto lights = sampleLights(200);
+    const Mat4 view = glm::lookAt(Vec3{0, 1, 4}, Vec3{0, 0, -8}, Vec3{0, 1, 0});
+    math::LightClusters clusters;
+    clusters.Build(lights, view, glm::perspective(glm::radians(60.f), 16.f / 9.f, kNear, kFar), kNear, kFar);
+    EXPECT_LT(clusters.MaxLightsPerCluster(), lights.size() / 2);
+}
+
+TEST(LightClusters, DirectionalAndUnboundedLightsAreGlobal) {
+    std::vector<math::Light> lights = sampleLights(3);
+    lights[1].type = math::LightType::Directional;
+    lights[2].range = 0.f;
+    math::LightClusters clusters;
+    clusters.Build(lights, Mat4(1.f), glm::perspective(glm::radians(60.f), 1.f, kNear, kFar), kNear, kFar);
+    ASSERT_EQ(clusters.GlobalLights().size(), 2u);
+    EXPECT_EQ(clusters.GlobalLights()[0], 1u);
+    EXPECT_EQ(clusters.GlobalLights()[1], 2u);
+}
+
+TEST(ShadeLights, ClusteredMatchesBruteForce) {
+    auto lights = sampleLights(100);
+    lights[7].type = math::LightType::Directional;
+    const Mat4 view = glm::lookAt(Vec3{0, 1, 4}, Vec3{0, 0, -8}, Vec3{0, 1, 0});
+    math::LightClusters clusters;
+    clusters.Build(lights, view, glm::perspective(glm::radians(60.f), 16.f / 9.f, kNear, kFar), kNear, kFar);
+
+    std::vector<std::uint32_t> points, directional{7};
+    for (std::uint32_t i = 0; i < lights.size(); ++i) {
+        if (i != 7) points.push_back(i);
+    }
+    const math::PhongMaterial material{};
+    const math::SpecularTable specular(16.f);
+    for (std::size_t i = 0; i < 200; ++i) {
+        const Vec3 p = samplePoint(i);
+        const Vec3 n = glm::normalize(Vec3{std::sin(float(i)), 1.f, 0.3f});
+        const int cluster = clusters.ClusterIndex(Vec3(view * Vec4(p, 1.f)));
+        if (cluster < 0) {
+            continue;
+        }
+        const Vec3 brute = math::shadeLights(p, n, {0, 1, 4}, material, specular, lights, Vec3(1.f), points, directional);
+        const Vec3 culled = math::shadeLights(p, n, {0, 1, 4}, material, specular, lights, Vec3(1.f),
+                                              clusters.PointLights(cluster), clusters.GlobalLights());
+        expectNear(culled, brute, 1e-4f);
+    }
+}
+
+TEST(LightClusters, OneLightMatchesPhongBatch) {
+    // A colored, unbounded light: ambient must be scaled by it in both paths
+    const math::Light light{.position = {2.f, 3.f, 1.f}, .color = {1.f, 0.6f, 0.3f}, .range = 0.f};
+    const math::PhongMaterial material{.color = {0.2f, 0.8f, 0.5f}, .ka = 0.3f};
+    const math::SpecularTable specular(16.f);
+    const Vec3 eye{0.f, 1.f, 4.f};
+    constexpr std::size_t kCount = 64;
+    math::Vec3Batch positions(kCount), normals(kCount);
+    for (std::size_t i = 0; i < kCount; ++i) {
+        const float f = static_cast<float>(i);
+        positions.set(i, {std::sin(f), 0.5f * std::cos(1.7f * f), -std::cos(0.3f * f)});
+        normals.set(i, glm::normalize(Vec3{std::sin(2.f * f), std::cos(f), 0.4f * std::sin(0.5f * f)}));
+    }
+    const math::ShadeParams params{
+        .materialColor = material.color,
+        .ka = material.ka,
+        .kd = material.kd,
+        .ks = material.ks,
+        .lightPos = light.position,
+        .lightColor = light.color,
+        .eye = eye
+    };
+    std::vector<std::uint8_t> rgba(kCount * math::kRgba8Stride);
+    math::phongBatch(positions, normals, params, specular, rgba);
+
+    const std::vector<math::Light> lights{light};
+    const std::vector<std::uint32_t> all{0};
+    for (std::size_t i = 0; i < kCount; ++i) {
+        const Vec3 c = glm::clamp(
+            math::shadeLights(positions.get(i), normals.get(i), eye, material, specular, lights, light.color, all, {}),
+            0.f, 1.f);
+        // phongBatch truncates to 8 bits
+        for (int k = 0; k < 3; ++k) {
+            EXPECT_NEAR(c[k] * 255.f, static_cast<float>(rgba[i * math::kRgba8Stride + k]) + 0.5f, 0.51f) << i << " " << k;
+        }
+    }
+}
@@ -0,0 +1,145 @@
+//
+// Batched Phong/Blinn-Phong shading, uniform and per-item materials, checked against
+// math::phong and std::pow.
+// Built into the render_tests executable.
+//
+
+#include <gtest/gtest.h>
+#include "math/Lighting.h"
+#include "math/LightingBatch.hpp"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t kCount = 41;
+
+Vec3 sampleNormal(std::size_t i) {
+    const float f = static_cast<float>(i);
+    return glm::normalize(Vec3{std::sin(f), std::cos(0.7f * f), 0.6f});
+}
+
+Vec3 samplePosition(std::size_t i) {
+    const float f = static_cast<float>(i);
+    return {0.1f * f - 2.f, std::sin(f), std::cos(f)};
+}
+
+math::ShadeParams sampleParams() {
+    math::ShadeParams p;
+    p.materialColor = {0.8f, 0.3f, 0.3f};
+    p.ka = 0.1f;
+    p.kd = 0.7f;
+    p.ks = 0.5f;
+    p.lightPos = {2.f, 4.f, 1.f};
+    p.lightColor = {1.f, 1.f, 1.f};
+    p.eye = {0.f, 1.f, 8.f};
+    return p;
+}
+
+} // namespace
+
+TEST(SpecularTable, ErrorWithinBound) {
+    for (float exponent : {1.f, 8.f, 32.f, 128.f}) {
+        const math::SpecularTable table(exponent);
+        for (int i = 0; i <= 1000; ++i) {
+            const float x = static_cast<float>(i) / 1000.f;
+            EXPECT_NEAR(table(x), std::pow(x, exponent), table.MaxError() + 1e-6f) << "exponent " << exponent;
+        }
+    }
+}
+
+TEST(SpecularTable, ErrorWithinBoundForSmallExponents) {
+    // f'' is unbounded at 0 below exponent 2: sample the first intervals densely
+    for (float exponent : {0.5f, 1.25f, 1.5f, 1.75f, 2.f}) {
+        const math::SpecularTable table(exponent, 256);
+        const float h = 1.f / 255.f;
+        float worst = 0.f;
+        for (int i = 0; i <= 4000; ++i) {
+            const float x = static_cast<float>(i) * (4.f * h / 4000.f);
+            worst = std::max(worst, std::abs(table(x) - std::pow(x, exponent)));
+        }
+        EXPECT_LE(worst, table.MaxError() + 1e-6f) << "exponent " << exponent;
+        EXPECT_GT(worst, 0.5f * table.MaxError()) << "exponent " << exponent; // and not loose
+    }
+}
+
+TEST(SpecularTable, BoundBelowHalfAByteStepUpTo128) {
+    EXPECT_LT(math::SpecularTable(128.f).MaxError(), 1.f / 510.f);
+}
+
+TEST(PhongBatch, MatchesScalarPhong) {
+    const math::ShadeParams params = sampleParams();
+    const math::SpecularTable table(32.f);
+    math::Vec3Batch positions(kCount), normals(kCount);
+    for (std::size_t i = 0; i < kCount; ++i) {
+        positions.set(i, samplePosition(i));
+        normals.set(i, sampleNormal(i));
+    }
+    std::vector<std::uint8_t> rgba(kCount * math::kRgba8Stride);
+    math::phongBatch(positions, normals, params, table, rgba);
+
+    for (std::size_t i = 0; i < kCount; ++i) {
+        const Vec3 p = samplePosition(i);
+        const Vec3 l = glm::normalize(params.lightPos - p);
+        const Vec3 v = glm::normalize(params.eye - p);
+        const Vec3 c = glm::clamp(math::phong(sampleNormal(i), l, v, params.materialColor, params.ka, params.kd,
+                                              params.ks, 32.f, params.lightColor), 0.f, 1.f) * 255.f;
+        // One step for truncation of a value that lands near an integer
+        EXPECT_NEAR(rgba[4 * i + 0], c.r, 1.01f);
+        EXPECT_NEAR(rgba[4 * i + 1], c.g, 1.01f);
+        EXPECT_NEAR(rgba[4 * i + 2], c.b, 1.01f);
+        EXPECT_EQ(rgba[4 * i + 3], 255);
+    }
+}
+
+TEST(PhongBatch, PerItemMaterialsMatchScalarPhong) {
+    const math::ShadeParams params = sampleParams();
+    const math::SpecularTable table(32.f);
+    math::Vec3Batch positions(kCount), normals(kCount);
+    math::MaterialBatch materials(kCount);
+    for (std::size_t i = 0; i < kCount; ++i) {
+        const float f = static_cast<float>(i);
+        positions.set(i, samplePosition(i));
+        normals.set(i, sampleNormal(i));
+        materials.set(i, {0.5f + 0.5f * std::sin(f), 0.4f, 0.5f + 0.5f * std::cos(f)}, 0.05f * static_cast<float>(i % 4),
+                      0.3f + 0.1f * static_cast<float>(i % 5), 0.2f * static_cast<float>(i % 3));
+    }
+    std::vector<std::uint8_t> rgba(kCount * math::kRgba8Stride);
+    math::phongBatch(positions, normals, materials, params, table, rgba);
+
+    for (std::size_t i = 0; i < kCount; ++i) {
+        const Vec3 p = samplePosition(i);
+        const Vec3 l = glm::normalize(params.lightPos - p);
+        const Vec3 v = glm::normalize(params.eye - p);
+        const Vec3 c = glm::clamp(math::phong(sampleNormal(i), l, v, materials.color.get(i), materials.ka[i],
+                                              materials.kd[i], materials.ks[i], 32.f, params.lightColor), 0.f, 1.f) * 255.f;
+        EXPECT_NEAR(rgba[4 * i + 0], c.r, 1.01f) << i;
+        EXPECT_NEAR(rgba[4 * i + 1], c.g, 1.01f) << i;
+        EXPECT_NEAR(rgba[4 * i + 2], c.b, 1.01f) << i;
+        EXPECT_EQ(rgba[4 * i + 3], 255);
+    }
+}
+
+TEST(PhongBatch, BlinnUsesHalfVector) {
+    math::ShadeParams params = sampleParams();
+    params.blinn = true;
+    params.ka = 0.f;
+    params.kd = 0.f;
+    params.ks = 1.f;
+    const math::SpecularTable table(16.f);
+    math::Vec3Batch positions(kCount), normals(kCount);
+    for (std::size_t i = 0; i < kCount; ++i) {
+        positions.set(i, samplePosition(i));
+        normals.set(i, sampleNormal(i));
+    }
+    std::vector<std::uint8_t> rgba(kCount * math::kRgba8Stride);
+    math::phongBatch(positions, normals, params, table, rgba);
+
+    for (std::size_t i = 0; i < kCount; ++i) {
+        const Vec3 p = samplePosition(i);
+        const Vec3 h = glm::normalize(glm::normalize(params.lightPos - p) + glm::normalize(params.eye - p));
+        const float expected = std::pow(std::max(glm::dot(sampleNormal(i), h), 0.f), 16.f) * 255.f;
+        EXPECT_NEAR(rgba[4 * i + 0], expected, 1.01f);
+    }
+}
@@ -0,0 +1,154 @@
+//
+// Vertex welding and the graph / cotangent Laplacians built from mesh adjacency.
+// Built into the render_tests executable.
+//
+
+#include <gtest/gtest.h>
+#include "render/Mesh.hpp"
+#include "render/MeshLaplacian.hpp"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr int kRings = 12;
+constexpr int kSegments = 16;
+
+// Flat (x, z) grid of n x n vertices in the unit square with a perturbed interior, so the
+// cotangent weights are not all equal.
+render::IndexedMesh flatGrid(std::uint32_t n) {
+    render::IndexedMesh mesh;
+    for (std::uint32_t j = 0; j < n; ++j) {
+        for (std::uint32_t i = 0; i < n; ++i) {
+            const bool interior = i > 0 && j > 0 && i + 1 < n && j + 1 < n;
+            const float jitter = interior ? 0.2f * std::sin(static_cast<float>(3 * i + 7 * j)) : 0.f;
+            mesh.positions.push_back({(static_cast<float>(i) + jitter) / static_cast<float>(n - 1), 0.f,
+                                      (static_cast<float>(j) - jitter) / static_cast<float>(n - 1)});
+        }
+    }
+    for (std::uint32_t j = 0; j + 1 < n; ++j) {
+        for (std::uint32_t i = 0; i + 1 < n; ++i) {
+            const std::uint32_t a = j * n + i;
+            mesh.indices.insert(mesh.indices.end(), {a, a + n, a + 1, a + 1, a + n, a + n + 1});
+        }
+    }
+    render::ComputeVertexNormals(mesh);
+    return mesh;
+}
+
+void expectSymmetricZeroRowSums(const math::SparseMatrix<float>& L, float eps) {
+    const auto offsets = L.Offsets();
+    const auto indices = L.Indices();
+    const auto values = L.Values();
+    for (std::size_t r = 0; r < L.Rows(); ++r) {
+        float sum = 0.f;
+        for (std::uint32_t p = offsets[r]; p < offsets[r + 1]; ++p) {
+            sum += values[p];
+            ASSERT_NEAR(values[p], L(indices[p], r), eps) << r << ", " << indices[p];
+        }
+        ASSERT_NEAR(sum, 0.f, eps) << r;
+    }
+}
+
+} // namespace
+
+TEST(MeshLaplacian, WeldSharesSeamAndPoleVertices) {
+    const render::IndexedMesh sphere = render::MakeSphere(1.f, kRings, kSegments);
+    const render::IndexedMesh welded = render::WeldVertices(sphere);
+    EXPECT_EQ(welded.VertexCount(), static_cast<std::size_t>((kRings - 1) * kSegments + 2));
+    // The pole triangles of each cap collapse to nothing
+    EXPECT_EQ(welded.TriangleCount(), static_cast<std::size_t>(2 * kRings * kSegments - 2 * kSegments));
+    for (std::size_t i = 0; i < welded.VertexCount(); ++i) {
+        EXPECT_NEAR(glm::dot(welded.normals[i], glm::normalize(welded.positions[i])), 1.f, 1e-4f);
+    }
+}
+
+TEST(MeshLaplacian, ComputedNormalsPointOutOfTheSphere) {
+    render::IndexedMesh sphere = render::WeldVertices(render::MakeSphere(1.f, kRings, kSegments));
+    render::ComputeVertexNormals(sphere);
+    for (std::size_t i = 0; i < sphere.VertexCount(); ++i) {
+        EXPECT_GT(glm::dot(sphere.normals[i], glm::normalize(sphere.positions[i])), 0.98f);
+    }
+}
+
+TEST(MeshLaplacian, GraphLaplacianHasValenceOnTheDiagonal) {
+    const render::IndexedMesh sphere = render::WeldVertices(render::MakeSphere(1.f, kRings, kSegments));
+    const math::SparseMatrix<float> L = render::GraphLaplacian(sphere);
+    expectSymmetricZeroRowSums(L, 0.f);
+    // Valence 6 everywhere except the poles and the rings next to them
+    int poles = 0, nearPoles = 0;
+    for (float d : L.Diagonal()) {
+        poles += d == static_cast<float>(kSegments);
+        nearPoles += d == 5.f;
+        EXPECT_TRUE(d == 5.f || d == 6.f || d == static_cast<float>(kSegments)) << d;
+    }
+    EXPECT_EQ(poles, 2);
+    EXPECT_EQ(nearPoles, 2 * kSegments);
+}
+
+TEST(MeshLaplacian, CotangentLaplacianIsLinearPrecise) {
+    constexpr std::uint32_t kN = 9;
+    const render::IndexedMesh grid = flatGrid(kN);
+    const math::SparseMatrix<float> L = render::CotangentLaplacian(grid);
+    expectSymmetricZeroRowSums(L, 1e-4f);
+
+    // L applied to the x and z coordinates vanishes at every interior vertex
+    const math::Matrix<float> X = render::PositionMatrix(grid.positions);
+    math::Matrix<float> LX(X.Rows(), 3);
+    ASSERT_TRUE(math::spmm(L, X, LX));
+    for (std::uint32_t j = 1; j + 1 < kN; ++j) {
+        for (std::uint32_t i = 1; i + 1 < kN; ++i) {
+            EXPECT_NEAR(LX(j * kN + i, 0), 0.f, 1e-4f);
+            EXPECT_NEAR(LX(j * kN + i, 2), 0.f, 1e-4f);
+        }
+    }
+}
+
+TEST(MeshLaplacian, SmoothingDampsNoise) {
+    // The operator is linear, so smoothing the noisy sphere minus smoothing the clean one is
+    // smoothing the noise alone, without the shrinkage every Laplacian flow also causes
+    const render::IndexedMesh sphere = render::WeldVertices(render::MakeSphere(1.f, 24, 32));
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> noise(-0.05f, 0.05f);
+    std::vector<Vec3> noisy = sphere.positions;
+    for (Vec3& p : noisy) {
+        p *= 1.f + noise(rng);
+    }
+
+    for (const auto& L : {render::GraphLaplacian(sphere), render::CotangentLaplacian(sphere)}) {
+        const math::SparseMatrix<float> S = render::SmoothingOperator(L, 0.5f);
+        math::Matrix<float> X = render::PositionMatrix(noisy);
+        math::Matrix<float> clean = render::PositionMatrix(sphere.positions);
+        math::Matrix<float> scratch;
+        render::SmoothPositions(S, X, scratch, 10);
+        render::SmoothPositions(S, clean, scratch, 10);
+
+        // Mean squared displacement due to the noise
+        float before = 0.f, after = 0.f;
+        for (std::size_t i = 0; i < noisy.size(); ++i) {
+            const Vec3 d0 = noisy[i] - sphere.positions[i];
+            const Vec3 d1{X(i, 0) - clean(i, 0), X(i, 1) - clean(i, 1), X(i, 2) - clean(i, 2)};
+            before += glm::dot(d0, d0);
+            after += glm::dot(d1, d1);
+        }
+        EXPECT_LT(after, 0.05f * before);
+    }
+}
+
+TEST(MeshLaplacian, ReorderingPermutesTheLaplacian) {
+    const render::IndexedMesh sphere = render::WeldVertices(render::MakeSphere(1.f, kRings, kSegments));
+    const math::SparseMatrix<float> L = render::GraphLaplacian(sphere);
+    const std::vector<std::uint32_t> order = math::reverseCuthillMcKee(L);
+    const render::IndexedMesh reordered = render::ReorderVertices(sphere, order);
+    const math::SparseMatrix<float> expected = L.Permuted(order);
+    const math::SparseMatrix<float> rebuilt = render::GraphLaplacian(reordered);
+    ASSERT_EQ(rebuilt.NonZeros(), expected.NonZeros());
+    for (std::size_t r = 0; r < rebuilt.Rows(); ++r) {
+        for (std::uint32_t p = rebuilt.Offsets()[r]; p < rebuilt.Offsets()[r + 1]; ++p) {
+            ASSERT_EQ(rebuilt.Values()[p], expected(r, rebuilt.Indices()[p]));
+        }
+    }
+    EXPECT_LE(rebuilt.Bandwidth(), L.Bandwidth());
+}
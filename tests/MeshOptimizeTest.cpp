@@ -0,0 +1,158 @@
+//
+// Mesh optimization: Tipsify keeps the triangles and lowers ACMR, fetch reordering follows
+// first use, and meshlets cover every triangle once with bounds and cones that hold.
+// Built into the render_tests executable.
+//
+
+#include <gtest/gtest.h>
+#include "render/Mesh.hpp"
+#include "render/MeshOptimize.hpp"
+#include <algorithm>
+#include <array>
+#include <random>
+#include <vector>
+
+namespace {
+
+using Triangle = std::array<Vec3, 3>;
+
+// Triangles by position, each rotated to start at its smallest corner (winding kept), sorted
+std::vector<std::array<float, 9>> canonicalTriangles(const std::vector<Triangle>& triangles) {
+    std::vector<std::array<float, 9>> out;
+    for (const Triangle& t : triangles) {
+        std::array<std::array<float, 3>, 3> c{};
+        for (int k = 0; k < 3; ++k) {
+            c[k] = {t[k].x, t[k].y, t[k].z};
+        }
+        std::rotate(c.begin(), std::min_element(c.begin(), c.end()), c.end());
+        out.push_back({c[0][0], c[0][1], c[0][2], c[1][0], c[1][1], c[1][2], c[2][0], c[2][1], c[2][2]});
+    }
+    std::sort(out.begin(), out.end());
+    return out;
+}
+
+std::vector<Triangle> trianglesOf(const render::IndexedMesh& mesh) {
+    std::vector<Triangle> out;
+    for (std::size_t t = 0; t < mesh.TriangleCount(); ++t) {
+        out.push_back({mesh.positions[mesh.indices[3 * t]], mesh.positions[mesh.indices[3 * t + 1]],
+                       mesh.positions[mesh.indices[3 * t + 2]]});
+    }
+    return out;
+}
+
+render::IndexedMesh shuffledSphere() {
+    render::IndexedMesh mesh = render::WeldVertices(render::MakeSphere(1.f, 40, 60));
+    std::vector<std::array<std::uint32_t, 3>> triangles(mesh.TriangleCount());
+    std::copy_n(mesh.indices.data(), mesh.indices.size(), triangles.front().data());
+    std::shuffle(triangles.begin(), triangles.end(), std::mt19937(7));
+    std::copy_n(triangles.front().data(), mesh.indices.size(), mesh.indices.data());
+    return mesh;
+}
+
+} // namespace
+
+TEST(MeshOptimize, AcmrCountsFifoMisses) {
+    const std::vector<std::uint32_t> one = {0, 1, 2};
+    EXPECT_DOUBLE_EQ(render::ComputeACMR(one, 3), 3.0);
+    const std::vector<std::uint32_t> quad = {0, 1, 2, 0, 2, 3};
+    EXPECT_DOUBLE_EQ(render::ComputeACMR(quad, 4), 2.0);
+    // With a 3-entry FIFO, 3 and 4 push out 0 and then 1, although 1 was just used
+    const std::vector<std::uint32_t> evicted = {0, 1, 2, 2, 1, 3, 3, 1, 4, 4, 1, 0};
+    EXPECT_DOUBLE_EQ(render::ComputeACMR(evicted, 5, 3), 7.0 / 4.0);
+    EXPECT_DOUBLE_EQ(render::ComputeACMR(evicted, 5, 16), 5.0 / 4.0);
+}
+
+TEST(MeshOptimize, TipsifyKeepsTrianglesAndLowersAcmr) {
+    const render::IndexedMesh shuffled = shuffledSphere();
+    render::IndexedMesh mesh = shuffled;
+    const render::MeshOptimizeReport report = render::OptimizeMesh(mesh);
+
+    EXPECT_EQ(canonicalTriangles(trianglesOf(mesh)), canonicalTriangles(trianglesOf(shuffled)));
+    EXPECT_EQ(mesh.VertexCount(), shuffled.VertexCount());
+    EXPECT_DOUBLE_EQ(report.acmrBefore, render::ComputeACMR(shuffled.indices, shuffled.VertexCount()));
+    EXPECT_GT(report.acmrBefore, 2.0);
+    EXPECT_LT(report.acmrAfter, 0.8);
+
+    // The generator's row-by-row order is already decent; Tipsify still beats it
+    render::IndexedMesh grid = render::WeldVertices(render::MakeSphere(1.f, 40, 60));
+    const render::MeshOptimizeReport gridReport = render::OptimizeMesh(grid);
+    EXPECT_LT(gridReport.acmrAfter, gridReport.acmrBefore);
+}
+
+TEST(MeshOptimize, FetchOrderFollowsFirstUse) {
+    render::IndexedMesh mesh = shuffledSphere();
+    render::OptimizeMesh(mesh);
+    std::uint32_t next = 0;
+    for (const std::uint32_t v : mesh.indices) {
+        ASSERT_LE(v, next);
+        next = std::max(next, v + 1);
+    }
+
+    // Without vertex reordering the positions stay where they were
+    render::IndexedMesh kept = shuffledSphere();
+    const std::vector<Vec3> positions = kept.positions;
+    render::OptimizeMesh(kept, {.reorderVertices = false});
+    EXPECT_EQ(kept.positions, positions);
+}
+
+TEST(MeshOptimize, MeshletsCoverEveryTriangleOnce) {
+    render::IndexedMesh mesh = shuffledSphere();
+    render::OptimizeMesh(mesh);
+    const render::MeshletSet set = render::BuildMeshlets(mesh, 64, 124);
+
+    std::vector<Triangle> rebuilt;
+    for (const render::Meshlet& m : set.meshlets) {
+        ASSERT_LE(m.vertexCount, 64u);
+        ASSERT_LE(m.triangleCount, 124u);
+        for (std::uint32_t t = 0; t < m.triangleCount; ++t) {
+            Triangle tri;
+            for (int c = 0; c < 3; ++c) {
+                const std::uint8_t local = set.triangles[m.triangleOffset + 3 * t + c];
+                ASSERT_LT(local, m.vertexCount);
+                tri[c] = mesh.positions[set.vertices[m.vertexOffset + local]];
+                EXPECT_LE(glm::distance(tri[c], m.center), m.radius * 1.0001f);
+            }
+            rebuilt.push_back(tri);
+        }
+    }
+    EXPECT_EQ(canonicalTriangles(rebuilt), canonicalTriangles(trianglesOf(mesh)));
+    // Cache-ordered triangles fill meshlets well: close to the triangle limit on average
+    EXPECT_LT(set.meshlets.size(), mesh.TriangleCount() / 80);
+}
+
+TEST(MeshOptimize, MeshletConesAreConservative) {
+    render::IndexedMesh mesh = render::WeldVertices(render::MakeSphere(1.f, 40, 60));
+    render::OptimizeMesh(mesh);
+    const render::MeshletSet set = render::BuildMeshlets(mesh);
+
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> coord(-4.f, 4.f);
+    std::size_t culled = 0;
+    for (int trial = 0; trial < 50; ++trial) {
+        const Vec3 eye{coord(rng), coord(rng), coord(rng)};
+        if (glm::length(eye) < 1.2f) {
+            continue;
+        }
+        for (const render::Meshlet& m : set.meshlets) {
+            if (glm::dot(glm::normalize(m.coneApex - eye), m.coneAxis) < m.coneCutoff) {
+                continue;
+            }
+            ++culled;
+            for (std::uint32_t t = 0; t < m.triangleCount; ++t) {
+                const std::uint8_t* tri = set.triangles.data() + m.triangleOffset + 3 * t;
+                const Vec3 a = mesh.positions[set.vertices[m.vertexOffset + tri[0]]];
+                const Vec3 b = mesh.positions[set.vertices[m.vertexOffset + tri[1]]];
+                const Vec3 c = mesh.positions[set.vertices[m.vertexOffset + tri[2]]];
+                EXPECT_GE(glm::dot(glm::cross(b - a, c - a), a - eye), -1e-6f) << "front-facing triangle in a culled meshlet";
+            }
+        }
+    }
+    EXPECT_GT(culled, 0u);
+
+    // A flat patch has a zero-width cone: culled exactly from behind
+    const render::IndexedMesh floor = render::MakeFloor(1.f, 0.f);
+    const render::Meshlet patch = render::BuildMeshlets(floor).meshlets.front();
+    EXPECT_NEAR(patch.coneCutoff, 0.f, 1e-6f);
+    EXPECT_GE(glm::dot(glm::normalize(patch.coneApex - Vec3{0.3f, -2.f, 0.f}), patch.coneAxis), patch.coneCutoff);
+    EXPECT_LT(glm::dot(glm::normalize(patch.coneApex - Vec3{0.3f, 2.f, 0.f}), patch.coneAxis), patch.coneCutoff);
+}
@@ -0,0 +1,143 @@
+//
+// Meshlet culling: frustum planes classify points as the clip test does, culling never
+// drops a meshlet holding a visible front-facing triangle, and the gathered draw lists
+// rebuild the surviving triangles. Built into the render_tests executable.
+//
+
+#include <gtest/gtest.h>
+#include "render/Mesh.hpp"
+#include "render/MeshOptimize.hpp"
+#include "render/MeshletCull.hpp"
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+bool insideClip(const Mat4& clip, const Vec3& p) {
+    const Vec4 c = clip * Vec4(p, 1.f);
+    return std::abs(c.x) <= c.w && std::abs(c.y) <= c.w && std::abs(c.z) <= c.w;
+}
+
+bool insidePlanes(const std::array<Vec4, 6>& planes, const Vec3& p) {
+    return std::all_of(planes.begin(), planes.end(), [&](const Vec4& n) { return glm::dot(Vec3(n), p) + n.w >= 0.f; });
+}
+
+render::IndexedMesh optimizedSphere() {
+    render::IndexedMesh mesh = render::WeldVertices(render::MakeSphere(1.f, 48, 64));
+    render::OptimizeMesh(mesh);
+    return mesh;
+}
+
+} // namespace
+
+TEST(MeshletCull, FrustumPlanesMatchClipTest) {
+    const Mat4 clip = glm::perspective(glm::radians(60.f), 1.5f, 0.1f, 20.f) *
+                      glm::lookAt(Vec3(1.f, 2.f, 5.f), Vec3(0.f), Vec3(0.f, 1.f, 0.f));
+    const std::array<Vec4, 6> planes = render::FrustumPlanes(clip);
+    for (const Vec4& p : planes) {
+        EXPECT_NEAR(glm::length(Vec3(p)), 1.f, 1e-5f);
+    }
+    int inside = 0;
+    for (float x = -6.f; x <= 6.f; x += 0.75f) {
+        for (float y = -6.f; y <= 6.f; y += 0.75f) {
+            for (float z = -20.f; z <= 6.f; z += 0.75f) {
+                const Vec3 p(x, y, z);
+                EXPECT_EQ(insidePlanes(planes, p), insideClip(clip, p)) << x << " " << y << " " << z;
+                inside += insideClip(clip, p) ? 1 : 0;
+            }
+        }
+    }
+    EXPECT_GT(inside, 100);
+}
+
+TEST(MeshletCull, KeepsEveryVisibleFrontFacingTriangle) {
+    const render::IndexedMesh mesh = optimizedSphere();
+    const render::MeshletSet set = render::BuildMeshlets(mesh);
+    // Close enough that the sphere overflows the view on the left: both tests have work
+    const Vec3 eye(1.5f, 0.5f, 2.5f);
+    const Mat4 clip = glm::perspective(glm::radians(40.f), 1.f, 0.1f, 20.f) *
+                      glm::lookAt(eye, Vec3(1.f, 0.f, 0.f), Vec3(0.f, 1.f, 0.f));
+    std::vector<std::uint32_t> visible;
+    const render::MeshletCullStats stats = render::CullMeshlets(set, clip, eye, true, visible);
+    EXPECT_GT(stats.frustumCulled, 0u);
+    EXPECT_GT(stats.backfaceCulled, 0u);
+    EXPECT_EQ(visible.size() + stats.frustumCulled + stats.backfaceCulled, set.meshlets.size());
+
+    std::vector<std::uint8_t> kept(set.meshlets.size(), 0);
+    for (const std::uint32_t i : visible) {
+        kept[i] = 1;
+    }
+    for (std::size_t i = 0; i < set.meshlets.size(); ++i) {
+        if (kept[i]) {
+            continue;
+        }
+        const render::Meshlet& m = set.meshlets[i];
+        for (std::uint32_t t = 0; t < m.triangleCount; ++t) {
+            const std::uint8_t* tri = set.triangles.data() + m.triangleOffset + 3 * t;
+            const Vec3& a = mesh.positions[set.vertices[m.vertexOffset + tri[0]]];
+            const Vec3& b = mesh.positions[set.vertices[m.vertexOffset + tri[1]]];
+            const Vec3& c = mesh.positions[set.vertices[m.vertexOffset + tri[2]]];
+            const bool front = glm::dot(glm::cross(b - a, c - a), eye - a) > 0.f;
+            const bool seen = insideClip(clip, a) || insideClip(clip, b) || insideClip(clip, c);
+            EXPECT_FALSE(front && seen) << "meshlet " << i << " triangle " << t;
+        }
+    }
+}
+
+TEST(MeshletCull, ConeTestCanBeDisabled) {
+    const render::IndexedMesh mesh = optimizedSphere();
+    const render::MeshletSet set = render::BuildMeshlets(mesh);
+    const Vec3 eye(0.f, 0.f, 6.f);
+    const Mat4 clip = glm::perspective(glm::radians(60.f), 1.f, 0.1f, 20.f) *
+                      glm::lookAt(eye, Vec3(0.f), Vec3(0.f, 1.f, 0.f));
+    std::vector<std::uint32_t> visible;
+    const render::MeshletCullStats culled = render::CullMeshlets(set, clip, eye, true, visible);
+    EXPECT_GT(culled.backfaceCulled, set.meshlets.size() / 4);
+    EXPECT_EQ(culled.frustumCulled, 0u);
+    const render::MeshletCullStats all = render::CullMeshlets(set, clip, eye, false, visible);
+    EXPECT_EQ(all.backfaceCulled, 0u);
+    EXPECT_EQ(visible.size(), set.meshlets.size());
+    EXPECT_EQ(all.triangles, mesh.TriangleCount());
+}
+
+TEST(MeshletCull, GatherRebuildsVisibleTriangles) {
+    const render::IndexedMesh mesh = optimizedSphere();
+    const render::MeshletSet set = render::BuildMeshlets(mesh);
+    const std::vector<std::uint32_t> visible = {0, 2, static_cast<std::uint32_t>(set.meshlets.size() - 1)};
+    std::vector<std::uint32_t> vertexIds;
+    std::vector<std::uint32_t> indices;
+    render::GatherMeshlets(set, visible, vertexIds, indices);
+
+    std::vector<std::uint32_t> expected;
+    std::size_t vertices = 0;
+    for (const std::uint32_t i : visible) {
+        const render::Meshlet& m = set.meshlets[i];
+        vertices += m.vertexCount;
+        for (std::uint32_t k = 0; k < 3 * m.triangleCount; ++k) {
+            expected.push_back(set.vertices[m.vertexOffset + set.triangles[m.triangleOffset + k]]);
+        }
+    }
+    ASSERT_EQ(vertexIds.size(), vertices);
+    ASSERT_EQ(indices.size(), expected.size());
+    for (std::size_t k = 0; k < indices.size(); ++k) {
+        ASSERT_LT(indices[k], vertexIds.size());
+        EXPECT_EQ(vertexIds[indices[k]], expected[k]);
+    }
+}
+
+TEST(MeshletCull, UpdatedBoundsFollowMovedVertices) {
+    render::IndexedMesh mesh = optimizedSphere();
+    render::MeshletSet set = render::BuildMeshlets(mesh);
+    for (Vec3& p : mesh.positions) {
+        p = 2.f * p + Vec3(3.f, 0.f, 0.f);
+    }
+    render::UpdateMeshletBounds(mesh, set);
+    const render::MeshletSet rebuilt = render::BuildMeshlets(mesh);
+    ASSERT_EQ(set.meshlets.size(), rebuilt.meshlets.size());
+    for (std::size_t i = 0; i < set.meshlets.size(); ++i) {
+        EXPECT_NEAR(glm::distance(set.meshlets[i].center, rebuilt.meshlets[i].center), 0.f, 1e-5f);
+        EXPECT_FLOAT_EQ(set.meshlets[i].radius, rebuilt.meshlets[i].radius);
+        EXPECT_FLOAT_EQ(set.meshlets[i].coneCutoff, rebuilt.meshlets[i].coneCutoff);
+    }
+}
@@ -0,0 +1,154 @@
+//
+// Gram-Schmidt and Householder orthonormalization: 3D frames, batches and N-D bases.
+// Built into the linalg_tests executable.
+//
+
+#include <gtest/gtest.h>
+#include "math/Orthonormalize.hpp"
+#include <glm/gtc/matrix_transform.hpp>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr float kEps = 1e-5f;
+
+void expectOrthonormal(const std::array<Vec3, 3>& q, float eps = kEps) {
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            EXPECT_NEAR(glm::dot(q[i], q[j]), i == j ? 1.f : 0.f, eps) << i << ", " << j;
+        }
+    }
+}
+
+float det(const std::array<Vec3, 3>& q) {
+    return glm::dot(q[0], glm::cross(q[1], q[2]));
+}
+
+template <class T>
+T maxOffIdentity(const math::Matrix<T>& Q) {
+    const auto QtQ = Q.Transposed() * Q;
+    T worst{};
+    for (std::size_t r = 0; r < QtQ.Rows(); ++r) {
+        for (std::size_t c = 0; c < QtQ.Cols(); ++c) {
+            worst = std::max(worst, std::abs(QtQ(r, c) - (r == c ? T{1} : T{0})));
+        }
+    }
+    return worst;
+}
+
+math::Matrix<double> sampleMatrix(std::size_t rows, std::size_t cols) {
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    math::Matrix<double> m(rows, cols);
+    for (std::size_t r = 0; r < rows; ++r) {
+        for (std::size_t c = 0; c < cols; ++c) {
+            m(r, c) = dist(rng);
+        }
+    }
+    return m;
+}
+
+} // namespace
+
+TEST(Orthonormalize, KeepsFirstDirectionAndHandedness) {
+    // The app's u-basis: (1,0,0), (1,1,0), (1,1,1)
+    const std::array<Vec3, 3> u = {Vec3{1, 0, 0}, Vec3{1, 1, 0}, Vec3{1, 1, 1}};
+    const auto q = math::orthonormalize(u);
+    expectOrthonormal(q);
+    EXPECT_NEAR(glm::dot(q[0], Vec3{1, 0, 0}), 1.f, kEps);
+    EXPECT_NEAR(glm::dot(q[1], Vec3{0, 1, 0}), 1.f, kEps);
+    EXPECT_NEAR(det(q), 1.f, kEps);
+
+    const auto left = math::orthonormalize({Vec3{0, 2, 0}, Vec3{1, 1, 0}, Vec3{0.3f, 0, 3}});
+    expectOrthonormal(left);
+    EXPECT_NEAR(det(left), -1.f, kEps);
+}
+
+TEST(Orthonormalize, CompletesDependentVectors) {
+    const auto q = math::orthonormalize({Vec3{0, 0, 2}, Vec3{0, 0, -1}, Vec3{0.f}});
+    expectOrthonormal(q);
+    EXPECT_NEAR(q[0].z, 1.f, kEps);
+    EXPECT_NEAR(det(q), 1.f, kEps);
+
+    expectOrthonormal(math::orthonormalize({Vec3{0.f}, Vec3{0.f}, Vec3{0.f}}));
+}
+
+TEST(Orthonormalize, RemovesRotationDrift) {
+    // Many small rotations multiplied in float drift away from orthonormal
+    const Mat3 step = Mat3(glm::rotate(Mat4(1.f), 0.01f, glm::normalize(Vec3{1, 2, 3})));
+    Mat3 r(1.f);
+    for (int i = 0; i < 20000; ++i) {
+        r = step * r;
+    }
+    const Mat3 fixed = math::orthonormalizeColumns(r);
+    expectOrthonormal({fixed[0], fixed[1], fixed[2]});
+    EXPECT_NEAR(glm::determinant(fixed), 1.f, kEps);
+    for (int c = 0; c < 3; ++c) {
+        EXPECT_LT(glm::length(fixed[c] - r[c]), 1e-2f); // a correction, not a different rotation
+    }
+
+    const Mat4 withTranslation = glm::translate(Mat4(1.f), Vec3{1, 2, 3}) * Mat4(r);
+    const Mat4 fixed4 = math::orthonormalizeRotation(withTranslation);
+    EXPECT_EQ(Vec3(fixed4[3]), Vec3(1, 2, 3));
+    EXPECT_NEAR(glm::length(Vec3(fixed4[1]) - fixed[1]), 0.f, kEps);
+}
+
+TEST(Orthonormalize, BatchMatchesScalar) {
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> dist(-1.f, 1.f);
+    std::vector<Mat3> ms(29);
+    math::Mat3Batch batch(ms.size());
+    for (std::size_t i = 0; i < ms.size(); ++i) {
+        ms[i] = Mat3(Vec3{dist(rng), dist(rng), dist(rng)}, Vec3{dist(rng), dist(rng), dist(rng)},
+                     Vec3{dist(rng), dist(rng), dist(rng)});
+        batch.set(i, ms[i]);
+    }
+    batch.set(3, Mat3(0.f)); // degenerate lanes too
+    ms[3] = Mat3(0.f);
+
+    math::orthonormalizeColumns(batch);
+    for (std::size_t i = 0; i < ms.size(); ++i) {
+        const Mat3 expected = math::orthonormalizeColumns(ms[i]);
+        const Mat3 got = batch.get(i);
+        for (int c = 0; c < 3; ++c) {
+            EXPECT_NEAR(glm::length(got[c] - expected[c]), 0.f, kEps) << i;
+        }
+    }
+}
+
+TEST(Orthonormalize, GramSchmidtNd) {
+    const auto A = sampleMatrix(60, 20);
+    auto Q = A;
+    ASSERT_TRUE(math::gramSchmidt(Q));
+    EXPECT_EQ(Q.GetLayout(), A.GetLayout());
+    EXPECT_LT(maxOffIdentity(Q), 1e-12);
+
+    // Same span: projecting A onto Q's columns gives A back
+    const auto QtA = Q.Transposed() * A;
+    const auto back = Q * QtA;
+    for (std::size_t r = 0; r < A.Rows(); ++r) {
+        for (std::size_t c = 0; c < A.Cols(); ++c) {
+            ASSERT_NEAR(back(r, c), A(r, c), 1e-12);
+        }
+    }
+
+    auto dependent = A;
+    for (std::size_t r = 0; r < A.Rows(); ++r) {
+        dependent(r, 7) = A(r, 2) - 3.0 * A(r, 5);
+    }
+    EXPECT_FALSE(math::gramSchmidt(dependent));
+    EXPECT_EQ(dependent(0, 7), 0.0);
+}
+
+TEST(Orthonormalize, HouseholderBasisIsOrthonormalEvenWhenRankDeficient) {
+    auto A = sampleMatrix(40, 12);
+    for (std::size_t r = 0; r < A.Rows(); ++r) {
+        A(r, 4) = A(r, 1);
+    }
+    const auto Q = math::householderBasis(A);
+    ASSERT_EQ(Q.Rows(), 40u);
+    ASSERT_EQ(Q.Cols(), 12u);
+    EXPECT_LT(maxOffIdentity(Q), 1e-12);
+}
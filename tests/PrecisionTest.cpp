@@ -0,0 +1,101 @@
+//
+// Scalar-templated math: half-float conversion, Affine3 in double against float, and the
+// float and half projection paths against the double reference.
+// Built into the render_tests executable.
+//
+
+#include <gtest/gtest.h>
+#include "math/Affine.hpp"
+#include "math/Half.hpp"
+#include "render/Precision.hpp"
+#include <glm/gtc/matrix_transform.hpp>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace {
+
+using render::ScalarMode;
+
+constexpr std::uint16_t bitsOf(float f) { return math::toHalf(f).bits; }
+
+static_assert(bitsOf(1.f) == 0x3c00 && bitsOf(-2.f) == 0xc000 && bitsOf(65504.f) == 0x7bff);
+static_assert(math::toFloat(math::Half{0x3555}) == 0.333251953125f);
+
+} // namespace
+
+TEST(Half, RoundTripsExactValuesAndRoundsToNearestEven) {
+    for (const float f : {0.f, -0.f, 1.f, 0.5f, -3.75f, 1024.f, 65504.f, 6.103515625e-05f, 5.9604645e-08f}) {
+        EXPECT_EQ(math::toFloat(math::toHalf(f)), f) << f;
+    }
+    // 1 + 2^-11 is halfway between 1 and the next half (1 + 2^-10): ties go to the even 1
+    EXPECT_EQ(bitsOf(1.f + std::ldexp(1.f, -11)), 0x3c00);
+    EXPECT_EQ(bitsOf(1.f + 3.f * std::ldexp(1.f, -11)), 0x3c02);
+    EXPECT_EQ(bitsOf(65520.f), 0x7c00); // rounds past the largest finite half
+    EXPECT_EQ(bitsOf(std::numeric_limits<float>::infinity()), 0x7c00);
+    EXPECT_TRUE(std::isnan(math::toFloat(math::toHalf(std::numeric_limits<float>::quiet_NaN()))));
+    EXPECT_EQ(bitsOf(1e-9f), 0x0000);
+
+    // Relative error of normal halves is at most 2^-11
+    for (float f = 1e-3f; f < 6e4f; f *= 1.37f) {
+        EXPECT_LE(std::abs(math::toFloat(math::toHalf(f)) - f), f * std::ldexp(1.f, -11)) << f;
+    }
+}
+
+TEST(Precision, Affine3dMatchesAffine3) {
+    const math::Affine3d a = math::Affine3d::Translation({1.0, -2.0, 0.5}) *
+                             math::Affine3d::Rotation(0.7, Vec3d{1.0, 2.0, 3.0}) *
+                             math::Affine3d::Scale({1.0, 2.0, 0.5});
+    const math::Affine3 f = math::affineCast<float>(a);
+    const Mat4d inverse = a.Inverse().ToMat4();
+    const Mat4 inverseF = f.Inverse().ToMat4();
+    const Mat4d identity = a.ToMat4() * inverse;
+    for (int c = 0; c < 4; ++c) {
+        for (int r = 0; r < 4; ++r) {
+            EXPECT_NEAR(identity[c][r], c == r ? 1.0 : 0.0, 1e-14);
+            EXPECT_NEAR(inverseF[c][r], inverse[c][r], 1e-6);
+        }
+    }
+}
+
+TEST(Precision, FloatAndDoubleProjectionsAgreeNearTheOrigin) {
+    const Mat4d P = glm::perspective(glm::radians(60.0), 1.5, 0.1, 50.0);
+    const Mat4d MV = glm::translate(Mat4d(1.0), Vec3d{0.2, -0.1, -3.0});
+    std::vector<Vec3d> points;
+    for (int i = 0; i < 100; ++i) {
+        const double t = 0.1 * i;
+        points.push_back({std::sin(t), std::cos(1.3 * t), 0.5 * std::sin(0.7 * t)});
+    }
+    std::vector<Vec3> pointsF(points.begin(), points.end());
+    std::vector<Vec3d> screen(points.size());
+    std::vector<Vec3> screenF(points.size());
+    render::ProjectPoints<double>(points, P, MV, 1200, 800, screen);
+    render::ProjectPoints<float>(pointsF, Mat4(P), Mat4(MV), 1200, 800, screenF);
+
+    const render::ProjectionError error = render::MeasureProjectionError<float>(screenF, screen);
+    EXPECT_LT(error.maxPixels, 1e-3);
+    EXPECT_LT(error.maxDepth, 1e-5);
+    EXPECT_EQ(render::MeasureProjectionError<double>(screen, screen).maxPixels, 0.0);
+}
+
+TEST(Precision, FloatErrorGrowsWithDistanceFromTheOrigin) {
+    render::PrecisionSetup setup;
+    setup.rings = 16;
+    setup.repeats = 1;
+    setup.offset = 1.0;
+    const auto nearOrigin = render::RunPrecisionStudy(setup);
+    setup.offset = 1e6;
+    const auto farAway = render::RunPrecisionStudy(setup);
+
+    const auto& exact = farAway[static_cast<int>(ScalarMode::Double)];
+    EXPECT_EQ(exact.error.maxPixels, 0.0);
+    EXPECT_EQ(exact.bytesPerPoint, 24u);
+    EXPECT_EQ(farAway[static_cast<int>(ScalarMode::Half)].bytesPerPoint, 6u);
+
+    // A pixel-accurate sphere near the origin; at a million units float cannot even place it
+    EXPECT_LT(nearOrigin[static_cast<int>(ScalarMode::Float)].error.maxPixels, 0.01);
+    EXPECT_GT(farAway[static_cast<int>(ScalarMode::Float)].error.maxPixels, 1.0);
+    // Half storage adds its rounding (2^-11 of the unit radius) on top of float
+    EXPECT_GT(nearOrigin[static_cast<int>(ScalarMode::Half)].error.maxPixels,
+              nearOrigin[static_cast<int>(ScalarMode::Float)].error.maxPixels);
+}
@@ -0,0 +1,137 @@
+//
+// Quantized vertex storage: octahedral normal round trips, position error within half a
+// quantization step of the bounds, and the decoding transform kernels (whole mesh and
+// gathered ids) against the float path.
+// Built into the render_tests executable.
+//
+
+#include <gtest/gtest.h>
+#include "render/Mesh.hpp"
+#include "render/QuantizedMesh.hpp"
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+// Directions spread over the whole sphere, both hemispheres and the fold lines
+std::vector<Vec3> testDirections() {
+    std::vector<Vec3> dirs = {{1, 0, 0}, {-1, 0, 0}, {0, 1, 0}, {0, -1, 0}, {0, 0, 1}, {0, 0, -1},
+                              {1, 1, -1}, {-1, 1e-4f, -1}};
+    for (int i = 0; i < 4000; ++i) {
+        const float z = 1.f - 2.f * (static_cast<float>(i) + 0.5f) / 4000.f;
+        const float r = std::sqrt(1.f - z * z);
+        const float phi = 2.399963f * static_cast<float>(i); // golden angle
+        dirs.push_back({r * std::cos(phi), r * std::sin(phi), z});
+    }
+    for (Vec3& d : dirs) {
+        d = glm::normalize(d);
+    }
+    return dirs;
+}
+
+float angleBetween(const Vec3& a, const Vec3& b) {
+    return std::atan2(glm::length(glm::cross(a, b)), glm::dot(a, b));
+}
+
+} // namespace
+
+TEST(QuantizedMesh, OctahedralNormalsRoundTrip) {
+    float worst = 0.f;
+    for (const Vec3& d : testDirections()) {
+        const Vec3 decoded = render::DecodeOctahedral(render::EncodeOctahedral(d));
+        EXPECT_NEAR(glm::length(decoded), 1.f, 1e-6f);
+        worst = std::max(worst, angleBetween(d, decoded));
+    }
+    EXPECT_LT(worst, glm::radians(0.01f));
+    EXPECT_EQ(render::DecodeOctahedral(render::EncodeOctahedral({0.f, 0.f, -1.f})), Vec3(0.f, 0.f, -1.f));
+}
+
+TEST(QuantizedMesh, PositionsStayWithinHalfAStep) {
+    const render::IndexedMesh sphere = render::MakeSphere(2.5f, 24, 32);
+    const render::QuantizedMesh q = render::Quantize(sphere);
+    ASSERT_EQ(q.VertexCount(), sphere.VertexCount());
+    EXPECT_EQ(q.indices, sphere.indices);
+    EXPECT_EQ(q.BytesPerVertex(), 10u);
+    EXPECT_EQ(q.x.size() % math::kSimdLanes, 0u);
+
+    const render::IndexedMesh back = render::Dequantize(q);
+    const Vec3 tolerance = q.PositionTolerance() + Vec3(1e-6f);
+    for (std::size_t i = 0; i < sphere.VertexCount(); ++i) {
+        const Vec3 error = glm::abs(back.positions[i] - sphere.positions[i]);
+        EXPECT_LE(error.x, tolerance.x) << i;
+        EXPECT_LE(error.y, tolerance.y) << i;
+        EXPECT_LE(error.z, tolerance.z) << i;
+        EXPECT_LT(angleBetween(back.normals[i], sphere.normals[i]), glm::radians(0.01f)) << i;
+    }
+}
+
+TEST(QuantizedMesh, FlatMeshesKeepTheirConstantAxis) {
+    const render::IndexedMesh floor = render::MakeFloor(3.f, -1.f);
+    const render::IndexedMesh back = render::Dequantize(render::Quantize(floor));
+    for (std::size_t i = 0; i < floor.VertexCount(); ++i) {
+        EXPECT_EQ(back.positions[i], floor.positions[i]);
+        EXPECT_EQ(back.normals[i], floor.normals[i]);
+    }
+}
+
+TEST(QuantizedMesh, TransformKernelsMatchTheFloatPath) {
+    const render::IndexedMesh sphere = render::MakeSphere(1.f, 16, 24);
+    const render::QuantizedMesh q = render::Quantize(sphere);
+    const math::Affine3 model = math::Affine3::Translation({0.5f, -1.f, -4.f}) *
+                                math::Affine3::Rotation(0.8f, Vec3{1.f, 2.f, 0.5f}) * math::Affine3::Scale({1.f, 2.f, 0.5f});
+    const Mat3 normalMatrix = model.NormalMatrix();
+
+    math::Vec3Batch world, normals;
+    render::TransformQuantizedPoints(model, q, world);
+    render::TransformQuantizedNormals(normalMatrix, q, normals);
+    ASSERT_EQ(world.size(), sphere.VertexCount());
+    ASSERT_EQ(normals.size(), sphere.VertexCount());
+    // The bounds step scaled by the model's largest stretch (2), with float rounding on top
+    const float tolerance = 2.f * glm::length(q.PositionTolerance()) + 1e-5f;
+    for (std::size_t i = 0; i < sphere.VertexCount(); ++i) {
+        EXPECT_LE(glm::distance(world.get(i), model.TransformPoint(sphere.positions[i])), tolerance) << i;
+        const Vec3 expected = glm::normalize(normalMatrix * sphere.normals[i]);
+        EXPECT_LT(angleBetween(normals.get(i), expected), glm::radians(0.02f)) << i;
+    }
+}
+
+TEST(QuantizedMesh, GatherKernelsMatchTheWholeMeshKernels) {
+    const render::IndexedMesh sphere = render::MakeSphere(1.f, 16, 24);
+    const render::QuantizedMesh q = render::Quantize(sphere);
+    const math::Affine3 model = math::Affine3::Translation({0.5f, -1.f, -4.f}) * math::Affine3::Rotation(0.8f, Vec3{1.f, 2.f, 0.5f});
+    const Mat3 normalMatrix = model.NormalMatrix();
+
+    math::Vec3Batch world, normals;
+    render::TransformQuantizedPoints(model, q, world);
+    render::TransformQuantizedNormals(normalMatrix, q, normals);
+    // Out of order and repeated, as gathered meshlet vertex lists are
+    const auto last = static_cast<std::uint32_t>(sphere.VertexCount() - 1);
+    const std::vector<std::uint32_t> ids = {7, 0, last, 7, 42, 3, 100, 1, 2};
+    math::Vec3Batch gatheredWorld, gatheredNormals;
+    render::TransformQuantizedPoints(model, q, ids, gatheredWorld);
+    render::TransformQuantizedNormals(normalMatrix, q, ids, gatheredNormals);
+    ASSERT_EQ(gatheredWorld.size(), ids.size());
+    ASSERT_EQ(gatheredNormals.size(), ids.size());
+    for (std::size_t k = 0; k < ids.size(); ++k) {
+        EXPECT_EQ(gatheredWorld.get(k), world.get(ids[k])) << k;
+        EXPECT_EQ(gatheredNormals.get(k), normals.get(ids[k])) << k;
+    }
+}
+
+TEST(QuantizedMesh, UVsRoundTrip) {
+    const render::IndexedMesh sphere = render::MakeSphere(1.f, 8, 12);
+    std::vector<Vec2> uvs;
+    for (std::size_t i = 0; i < sphere.VertexCount(); ++i) {
+        uvs.push_back({static_cast<float>(i % 13) / 12.f * 4.f, static_cast<float>(i / 13) / 8.f - 0.5f});
+    }
+    const render::QuantizedMesh q = render::Quantize(sphere, uvs);
+    EXPECT_EQ(q.BytesPerVertex(), 14u);
+    std::vector<Vec2> decoded(uvs.size());
+    render::DecodeUVs(q, decoded);
+    for (std::size_t i = 0; i < uvs.size(); ++i) {
+        EXPECT_NEAR(decoded[i].x, uvs[i].x, 4.f / 65535.f) << i;
+        EXPECT_NEAR(decoded[i].y, uvs[i].y, 1.f / 65535.f) << i;
+    }
+    EXPECT_EQ(decoded.front(), uvs.front());
+}
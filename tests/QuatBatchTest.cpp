@@ -0,0 +1,121 @@
+//
+// QuatBatch (SoA) kernels checked lane-by-lane against the scalar versions.
+// Built into the quaternion_tests executable.
+//
+
+#include <gtest/gtest.h>
+#include "math/QuatBatch.hpp"
+#include <cmath>
+#include <vector>
+
+namespace {
+
+// Deliberately not a multiple of kSimdLanes so the tail and padding are exercised
+constexpr std::size_t kCount = 37;
+
+math::Quat sampleQuat(std::size_t i) {
+    const float f = static_cast<float>(i);
+    return {std::cos(f), 0.3f * f - 2.f, std::sin(2.f * f), 1.f - 0.1f * f};
+}
+
+void expectQuatNear(const math::Quat& a, const math::Quat& b, float eps = 1e-5f) {
+    EXPECT_NEAR(a.w, b.w, eps);
+    EXPECT_NEAR(a.x, b.x, eps);
+    EXPECT_NEAR(a.y, b.y, eps);
+    EXPECT_NEAR(a.z, b.z, eps);
+}
+
+} // namespace
+
+TEST(QuatBatch, ResizePadsWithIdentity) {
+    math::QuatBatch q(kCount);
+    EXPECT_EQ(q.size(), kCount);
+    EXPECT_EQ(q.paddedSize() % math::kSimdLanes, 0u);
+    EXPECT_GE(q.paddedSize(), kCount);
+    expectQuatNear(q.get(q.paddedSize() - 1), {1, 0, 0, 0});
+}
+
+TEST(QuatBatch, MultiplyMatchesScalar) {
+    math::QuatBatch a(kCount), b(kCount), out;
+    for (std::size_t i = 0; i < kCount; ++i) {
+        a.set(i, sampleQuat(i));
+        b.set(i, sampleQuat(i + 100));
+    }
+    math::multiply(a, b, out);
+    ASSERT_EQ(out.size(), kCount);
+    for (std::size_t i = 0; i < kCount; ++i) {
+        expectQuatNear(out.get(i), math::multiply(sampleQuat(i), sampleQuat(i + 100)), 1e-4f);
+    }
+}
+
+TEST(QuatBatch, MultiplyInPlace) {
+    math::QuatBatch a(kCount), b(kCount);
+    for (std::size_t i = 0; i < kCount; ++i) {
+        a.set(i, sampleQuat(i));
+        b.set(i, sampleQuat(i + 7));
+    }
+    math::multiply(a, b, a);
+    for (std::size_t i = 0; i < kCount; ++i) {
+        expectQuatNear(a.get(i), math::multiply(sampleQuat(i), sampleQuat(i + 7)), 1e-4f);
+    }
+}
+
+TEST(QuatBatch, NormalizeAndConjugateMatchScalar) {
+    math::QuatBatch q(kCount), n, c;
+    for (std::size_t i = 0; i < kCount; ++i) {
+        q.set(i, sampleQuat(i));
+    }
+    q.set(3, {0, 0, 0, 0});  // degenerate lane -> identity
+    math::normalize(q, n);
+    math::conjugate(q, c);
+    for (std::size_t i = 0; i < kCount; ++i) {
+        expectQuatNear(n.get(i), math::normalize(q.get(i)));
+        expectQuatNear(c.get(i), math::conjugate(q.get(i)));
+    }
+}
+
+TEST(QuatBatch, FromAxisAngleMatchesScalar) {
+    math::Vec3Batch axes(kCount);
+    std::vector<float> angles(kCount);
+    for (std::size_t i = 0; i < kCount; ++i) {
+        const float f = static_cast<float>(i);
+        axes.set(i, {std::sin(f), 1.f + f, -0.5f * f});
+        angles[i] = -20.f + 1.3f * f;  // spans several turns, both signs
+    }
+    axes.set(5, {0, 0, 0});
+
+    math::QuatBatch q;
+    math::fromAxisAngle(axes, angles, q);
+    for (std::size_t i = 0; i < kCount; ++i) {
+        expectQuatNear(q.get(i), math::fromAxisAngle(axes.get(i), angles[i]));
+    }
+}
+
+TEST(QuatBatch, QuatToMat4MatchesScalar) {
+    math::QuatBatch q(kCount);
+    for (std::size_t i = 0; i < kCount; ++i) {
+        q.set(i, math::normalize(sampleQuat(i)));
+    }
+    std::vector<Mat4> mats(kCount);
+    math::quatToMat4(q, mats);
+    for (std::size_t i = 0; i < kCount; ++i) {
+        const Mat4 ref = math::quatToMat4(q.get(i));
+        for (int c = 0; c < 4; ++c) {
+            for (int r = 0; r < 4; ++r) {
+                EXPECT_NEAR(mats[i][c][r], ref[c][r], 1e-5f);
+            }
+        }
+    }
+}
+
+TEST(QuatBatch, SinCosAccuracy) {
+    std::vector<float> x(4096), s(x.size()), c(x.size());
+    for (std::size_t i = 0; i < x.size(); ++i) {
+        x[i] = -500.f + 1000.f * static_cast<float>(i) / static_cast<float>(x.size());
+    }
+    math::sincosBatch(x, s, c);
+    for (std::size_t i = 0; i < x.size(); ++i) {
+        EXPECT_NEAR(s[i], std::sin(static_cast<double>(x[i])), 2e-6f) << x[i];
+        EXPECT_NEAR(c[i], std::cos(static_cast<double>(x[i])), 2e-6f) << x[i];
+    }
+}
@@ -185,6 +185,38 @@ TEST(FromAxisAngle, NonUnitAxisGetsNormalized) {
     EXPECT_NEAR(q.z, 0, kEpsilon);
 }
 
+TEST(ToAxisAngle, RoundTripsFromAxisAngle) {
+    math::Quat q = math::fromAxisAngle({1, 2, 3}, 1.1f);
+    Vec3 axis;
+    float angle = 0.f;
+    math::toAxisAngle(q, axis, angle);
+
+    Vec3 expected = glm::normalize(Vec3{1, 2, 3});
+    EXPECT_NEAR(angle, 1.1f, 1e-5f);
+    EXPECT_NEAR(axis.x, expected.x, 1e-5f);
+    EXPECT_NEAR(axis.y, expected.y, 1e-5f);
+    EXPECT_NEAR(axis.z, expected.z, 1e-5f);
+}
+
+TEST(ToAxisAngle, NegatedQuatTakesShortWay) {
+    // -q is the same rotation; expect angle <= pi and a flipped axis
+    math::Quat q = math::fromAxisAngle({0, 0, 1}, 0.5f);
+    math::Quat neg = {-q.w, -q.x, -q.y, -q.z};
+    Vec3 axis;
+    float angle = 0.f;
+    math::toAxisAngle(neg, axis, angle);
+
+    EXPECT_NEAR(angle, 0.5f, 1e-5f);
+    EXPECT_NEAR(axis.z, 1.0f, 1e-5f);
+}
+
+TEST(ToAxisAngle, IdentityGivesZeroAngle) {
+    Vec3 axis;
+    float angle = 1.f;
+    math::toAxisAngle({1, 0, 0, 0}, axis, angle);
+    EXPECT_FLOAT_EQ(angle, 0.0f);
+}
+
 // =============================================================================
 // quatToMat4 Tests
 // =============================================================================
@@ -399,3 +431,116 @@ TEST(Validation, MatrixVsQuat_NegativeAngle) {
 
     EXPECT_TRUE(vectorsEqual(result_mat, result_quat));
 }
+
+// =============================================================================
+// Interpolation Tests
+// =============================================================================
+
+namespace {
+    bool sameRotation(const math::Quat& a, const math::Quat& b, float eps = 1e-5f) {
+        // q and -q are the same rotation
+        return std::fabs(std::fabs(math::dot(a, b)) - 1.0f) < eps;
+    }
+}
+
+TEST(Slerp, EndpointsAreExact) {
+    math::Quat a = math::fromAxisAngle({0, 1, 0}, 0.3f);
+    math::Quat b = math::fromAxisAngle({1, 0, 1}, 2.0f);
+    EXPECT_TRUE(sameRotation(math::slerp(a, b, 0.0f), a));
+    EXPECT_TRUE(sameRotation(math::slerp(a, b, 1.0f), b));
+}
+
+TEST(Slerp, HalfwayIsHalfTheAngle) {
+    math::Quat id = {1, 0, 0, 0};
+    math::Quat b = math::fromAxisAngle({0, 0, 1}, M_PI / 2.0f);
+    math::Quat mid = math::slerp(id, b, 0.5f);
+    EXPECT_TRUE(sameRotation(mid, math::fromAxisAngle({0, 0, 1}, M_PI / 4.0f)));
+}
+
+TEST(Slerp, TakesShortestArc) {
+    // -b is the same rotation; interpolating toward it must not go the long way
+    math::Quat id = {1, 0, 0, 0};
+    math::Quat b = math::fromAxisAngle({0, 0, 1}, M_PI / 2.0f);
+    math::Quat mid = math::slerp(id, -b, 0.5f);
+    EXPECT_TRUE(sameRotation(mid, math::fromAxisAngle({0, 0, 1}, M_PI / 4.0f)));
+}
+
+TEST(Slerp, ConstantAngularVelocity) {
+    math::Quat a = math::fromAxisAngle({1, 1, 0}, 0.2f);
+    math::Quat b = math::fromAxisAngle({0, 1, 1}, 2.2f);
+    float d1 = math::dot(math::slerp(a, b, 0.1f), math::slerp(a, b, 0.2f));
+    float d2 = math::dot(math::slerp(a, b, 0.7f), math::slerp(a, b, 0.8f));
+    EXPECT_NEAR(d1, d2, 1e-5f);
+}
+
+TEST(Nlerp, MatchesSlerpForCloseQuats) {
+    math::Quat a = math::fromAxisAngle({0, 1, 0}, 0.50f);
+    math::Quat b = math::fromAxisAngle({0, 1, 0}, 0.52f);
+    for (float t : {0.0f, 0.25f, 0.5f, 0.75f, 1.0f}) {
+        EXPECT_TRUE(sameRotation(math::nlerp(a, b, t), math::slerp(a, b, t)));
+        EXPECT_NEAR(math::norm(math::nlerp(a, b, t)), 1.0f, 1e-6f);
+    }
+}
+
+TEST(QuatLogExp, RoundTrip) {
+    math::Quat q = math::fromAxisAngle({1, -2, 0.5f}, 1.3f);
+    math::Quat l = math::quatLog(q);
+    EXPECT_NEAR(l.w, 0.0f, 1e-6f);  // unit quaternion -> pure log
+    EXPECT_TRUE(sameRotation(math::quatExp(l), q));
+}
+
+TEST(QuatLogExp, IdentityLogIsZero) {
+    math::Quat l = math::quatLog({1, 0, 0, 0});
+    EXPECT_TRUE(quatEqual(l, 0, 0, 0, 0));
+}
+
+TEST(Squad, PassesThroughKeys) {
+    std::vector<math::Quat> keys = {
+        math::fromAxisAngle({0, 1, 0}, 0.0f),
+        math::fromAxisAngle({0, 1, 0}, 1.0f),
+        math::fromAxisAngle({1, 0, 0}, 1.0f),
+        math::fromAxisAngle({0, 0, 1}, 2.0f),
+    };
+    // 3 segments, 4 samples per segment + 1 -> keys land on every 4th sample
+    std::vector<math::Quat> out(13);
+    math::squadSamples(keys, out);
+    for (std::size_t k = 0; k < keys.size(); ++k) {
+        EXPECT_TRUE(sameRotation(out[k * 4], keys[k])) << "key " << k;
+    }
+}
+
+TEST(Squad, CollinearKeysReduceToSlerp) {
+    // Keys evenly spaced on one great circle: squad has nothing to smooth
+    math::Quat q0 = math::fromAxisAngle({0, 0, 1}, 0.0f);
+    math::Quat q1 = math::fromAxisAngle({0, 0, 1}, 0.8f);
+    math::Quat q2 = math::fromAxisAngle({0, 0, 1}, 1.6f);
+    math::Quat s1 = math::squadControl(q0, q1, q2);
+    EXPECT_TRUE(sameRotation(s1, q1));
+    math::Quat mid = math::squad(q0, q1, q0, s1, 0.5f);
+    EXPECT_TRUE(sameRotation(mid, math::fromAxisAngle({0, 0, 1}, 0.4f)));
+}
+
+TEST(SlerpBatch, MatchesScalar) {
+    math::Quat a = math::fromAxisAngle({1, 0, 0}, 0.1f);
+    math::Quat b = math::fromAxisAngle({0, 1, 1}, 2.5f);
+    std::vector<float> ts = {0.0f, 0.13f, 0.5f, 0.77f, 1.0f};
+    std::vector<math::Quat> out(ts.size());
+    math::slerpBatch(a, b, ts, out);
+    for (std::size_t i = 0; i < ts.size(); ++i) {
+        EXPECT_TRUE(sameRotation(out[i], math::slerp(a, b, ts[i])));
+    }
+}
+
+TEST(SlerpSamples, RecurrenceStaysOnArc) {
+    // Long enough to cross several reseed blocks
+    math::Quat a = math::fromAxisAngle({0, 1, 0}, -1.0f);
+    math::Quat b = math::fromAxisAngle({1, 1, 1}, 2.0f);
+    std::vector<math::Quat> out(5000);
+    math::slerpSamples(a, b, out);
+    for (std::size_t i = 0; i < out.size(); i += 37) {
+        float t = static_cast<float>(i) / static_cast<float>(out.size() - 1);
+        EXPECT_TRUE(sameRotation(out[i], math::slerp(a, b, t))) << "sample " << i;
+        EXPECT_NEAR(math::norm(out[i]), 1.0f, 1e-5f);
+    }
+    EXPECT_TRUE(sameRotation(out.back(), b));
+}
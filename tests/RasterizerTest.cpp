@@ -0,0 +1,156 @@
+//
+// Software rasterizer: fill rule, depth test and perspective-correct interpolation.
+// Built into the render_tests executable.
+//
+
+#include <gtest/gtest.h>
+#include "render/Mesh.hpp"
+#include "render/Rasterizer.hpp"
+#include <cmath>
+#include <vector>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace {
+
+constexpr int kSize = 64;
+
+render::RasterVertex clipVertex(float x, float y, float z, float w = 1.f) {
+    return {Vec4{x * w, y * w, z * w, w}, Vec3{x, y, z}, Vec3{0, 0, 1}};
+}
+
+math::ShadeParams ambientOnly() {
+    math::ShadeParams p;
+    p.materialColor = {1.f, 1.f, 1.f};
+    p.ka = 1.f;
+    p.kd = 0.f;
+    p.ks = 0.f;
+    return p;
+}
+
+std::size_t drawnPixels(const render::Framebuffer& fb) {
+    std::size_t n = 0;
+    for (float d : fb.depth) n += d < 1.f;
+    return n;
+}
+
+} // namespace
+
+TEST(Rasterizer, SharedEdgeIsDrawnExactlyOnce) {
+    // Full-screen quad split along a diagonal that crosses pixel centres
+    const std::vector<render::RasterVertex> v = {
+        clipVertex(-1, -1, 0), clipVertex(1, -1, 0), clipVertex(1, 1, 0), clipVertex(-1, 1, 0)};
+    const std::vector<std::uint32_t> first = {0, 1, 2};
+    const std::vector<std::uint32_t> second = {0, 2, 3};
+    const math::SpecularTable specular;
+    render::Rasterizer raster;
+
+    render::Framebuffer a, b;
+    a.Resize(kSize, kSize);
+    b.Resize(kSize, kSize);
+    raster.Draw(a, v, first, render::ShadingMode::Flat, ambientOnly(), specular);
+    raster.Draw(b, v, second, render::ShadingMode::Flat, ambientOnly(), specular);
+
+    EXPECT_EQ(drawnPixels(a) + drawnPixels(b), static_cast<std::size_t>(kSize * kSize));
+    for (std::size_t i = 0; i < a.depth.size(); ++i) {
+        EXPECT_FALSE(a.depth[i] < 1.f && b.depth[i] < 1.f) << "pixel " << i << " drawn twice";
+    }
+}
+
+TEST(Rasterizer, NearerTriangleWinsInEitherOrder) {
+    const std::vector<render::RasterVertex> v = {
+        clipVertex(-1, -1, 0.5f), clipVertex(3, -1, 0.5f), clipVertex(-1, 3, 0.5f),
+        clipVertex(-1, -1, -0.5f), clipVertex(3, -1, -0.5f), clipVertex(-1, 3, -0.5f)};
+    math::ShadeParams far = ambientOnly();
+    const math::SpecularTable specular;
+    render::Rasterizer raster;
+
+    for (const std::vector<std::uint32_t>& order : {std::vector<std::uint32_t>{0, 1, 2, 3, 4, 5},
+                                                    std::vector<std::uint32_t>{3, 4, 5, 0, 1, 2}}) {
+        render::Framebuffer fb;
+        fb.Resize(kSize, kSize);
+        raster.Draw(fb, v, order, render::ShadingMode::Flat, far, specular);
+        for (float d : fb.depth) {
+            EXPECT_FLOAT_EQ(d, -0.5f);
+        }
+    }
+}
+
+TEST(Rasterizer, PhongInterpolationIsPerspectiveCorrect) {
+    // A triangle receding from z = -2 to z = -12, normals varying across it; a distant light
+    // on the view axis makes each pixel's diffuse term read back the interpolated normal.
+    const Mat4 P = glm::perspective(glm::radians(60.f), 1.f, 0.1f, 100.f);
+    const std::array<Vec3, 3> world = {Vec3{-1.5f, -1.f, -2.f}, Vec3{1.5f, -1.f, -2.f}, Vec3{0.f, 1.f, -12.f}};
+    const std::array<Vec3, 3> normals = {glm::normalize(Vec3{-0.8f, 0.f, 1.f}), glm::normalize(Vec3{0.8f, 0.f, 1.f}),
+                                         Vec3{0.f, 0.f, 1.f}};
+    std::vector<render::RasterVertex> v;
+    for (int k = 0; k < 3; ++k) {
+        v.push_back({P * Vec4(world[k], 1.f), world[k], normals[k]});
+    }
+    const std::vector<std::uint32_t> idx = {0, 1, 2};
+
+    math::ShadeParams shade;
+    shade.materialColor = {1.f, 1.f, 1.f};
+    shade.ka = 0.f;
+    shade.kd = 1.f;
+    shade.ks = 0.f;
+    shade.lightPos = {0.f, 0.f, 1e6f};
+    const math::SpecularTable specular;
+
+    render::Framebuffer fb;
+    fb.Resize(kSize, kSize);
+    render::Rasterizer raster;
+    raster.Draw(fb, v, idx, render::ShadingMode::Phong, shade, specular);
+
+    const Vec3 plane = glm::normalize(glm::cross(world[1] - world[0], world[2] - world[0]));
+    const float tanHalf = std::tan(glm::radians(30.f));
+    int checked = 0;
+    for (int y = 0; y < kSize; y += 5) {
+        for (int x = 0; x < kSize; x += 5) {
+            const std::size_t pixel = static_cast<std::size_t>(y * kSize + x);
+            if (fb.depth[pixel] >= 1.f) continue;
+
+            // Cast the pixel-centre ray and intersect the triangle's plane
+            const float nx = (static_cast<float>(x) + 0.5f) / kSize * 2.f - 1.f;
+            const float ny = 1.f - (static_cast<float>(y) + 0.5f) / kSize * 2.f;
+            const Vec3 dir{nx * tanHalf, ny * tanHalf, -1.f};
+            const Vec3 hit = dir * (glm::dot(plane, world[0]) / glm::dot(plane, dir));
+
+            // World-space barycentrics of the hit point
+            const Vec3 e0 = world[1] - world[0], e1 = world[2] - world[0], h = hit - world[0];
+            const float d00 = glm::dot(e0, e0), d01 = glm::dot(e0, e1), d11 = glm::dot(e1, e1);
+            const float d20 = glm::dot(h, e0), d21 = glm::dot(h, e1);
+            const float den = d00 * d11 - d01 * d01;
+            const float b1 = (d11 * d20 - d01 * d21) / den;
+            const float b2 = (d00 * d21 - d01 * d20) / den;
+            const Vec3 n = glm::normalize((1.f - b1 - b2) * normals[0] + b1 * normals[1] + b2 * normals[2]);
+            const float expected = glm::dot(n, glm::normalize(shade.lightPos - hit)) * 255.f;
+
+            EXPECT_NEAR(fb.color[pixel * 4], expected, 2.f) << "pixel " << x << "," << y;
+            ++checked;
+        }
+    }
+    EXPECT_GT(checked, 10);
+}
+
+TEST(Rasterizer, ModesCoverTheSamePixels) {
+    const render::IndexedMesh sphere = render::MakeSphere(1.f, 12, 16);
+    const Mat4 PV = glm::perspective(glm::radians(60.f), 1.f, 0.1f, 100.f) *
+                    glm::translate(Mat4(1.f), Vec3{0.f, 0.f, -3.f});
+    std::vector<render::RasterVertex> v;
+    for (std::size_t i = 0; i < sphere.VertexCount(); ++i) {
+        v.push_back({PV * Vec4(sphere.positions[i], 1.f), sphere.positions[i], sphere.normals[i]});
+    }
+    const math::SpecularTable specular;
+    render::Rasterizer raster;
+
+    std::size_t reference = 0;
+    for (auto mode : {render::ShadingMode::Flat, render::ShadingMode::Gouraud, render::ShadingMode::Phong}) {
+        render::Framebuffer fb;
+        fb.Resize(kSize, kSize);
+        raster.Draw(fb, v, sphere.indices, mode, ambientOnly(), specular);
+        if (reference == 0) reference = drawnPixels(fb);
+        EXPECT_EQ(drawnPixels(fb), reference);
+    }
+    EXPECT_GT(reference, 0u);
+}
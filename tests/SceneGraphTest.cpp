@@ -0,0 +1,91 @@
+//
+// Scene graph: world transforms are the products of the locals down each path, wherever
+// the nodes were inserted, and an update touches only the subtrees of changed nodes.
+// Built into the render_tests executable.
+//
+
+#include <gtest/gtest.h>
+#include "TestUtil.hpp"
+#include "render/SceneGraph.hpp"
+#include <random>
+#include <vector>
+
+namespace {
+
+math::Affine3 randomAffine(std::mt19937& rng) {
+    std::uniform_real_distribution<float> u(-1.f, 1.f);
+    return math::Affine3::Translation(Vec3(u(rng), u(rng), u(rng))) *
+           math::Affine3::Rotation(2.f * u(rng), Vec3(u(rng), u(rng), 1.f));
+}
+
+// World by walking the parent chain, as a reference
+math::Affine3 composedWorld(const render::SceneGraph& graph, render::NodeId node) {
+    math::Affine3 world = graph.Local(node);
+    for (render::NodeId p = graph.Parent(node); p != render::kNoNode; p = graph.Parent(p)) {
+        world = graph.Local(p) * world;
+    }
+    return world;
+}
+
+} // namespace
+
+TEST(SceneGraph, WorldIsProductOfLocals) {
+    std::mt19937 rng(3);
+    render::SceneGraph graph;
+    std::vector<render::NodeId> parents = {render::kNoNode};
+    // Random parents: deep and shallow nodes interleave, so slots keep shifting
+    for (int i = 0; i < 200; ++i) {
+        const auto pick = std::uniform_int_distribution<std::size_t>(0, parents.size() - 1)(rng);
+        parents.push_back(graph.AddNode(parents[pick], randomAffine(rng)));
+    }
+    EXPECT_EQ(graph.NodeCount(), 200u);
+    EXPECT_EQ(graph.Update(), 200u);
+    for (render::NodeId id = 0; id < graph.NodeCount(); ++id) {
+        expectNear(graph.World(id).ToMat4(), composedWorld(graph, id).ToMat4());
+    }
+}
+
+TEST(SceneGraph, UpdatesOnlyChangedSubtrees) {
+    render::SceneGraph graph;
+    const render::NodeId root = graph.AddNode(render::kNoNode, math::Affine3::Translation(Vec3(0.f, 0.f, -4.f)));
+    const render::NodeId arm = graph.AddNode(root, math::Affine3::Translation(Vec3(1.f, 0.f, 0.f)));
+    const render::NodeId hand = graph.AddNode(arm, math::Affine3::Rotation(0.5f, Vec3(0.f, 0.f, 1.f)));
+    const render::NodeId finger = graph.AddNode(hand, math::Affine3::Translation(Vec3(0.f, 0.2f, 0.f)));
+    const render::NodeId statue = graph.AddNode(root, math::Affine3::Translation(Vec3(-2.f, 0.f, 0.f)));
+    EXPECT_EQ(graph.Update(), 5u);
+    EXPECT_EQ(graph.Update(), 0u);
+
+    // Same value again: nothing to do
+    graph.SetLocal(arm, graph.Local(arm));
+    EXPECT_EQ(graph.Update(), 0u);
+
+    const math::Affine3 statueWorld = graph.World(statue);
+    graph.SetLocal(arm, math::Affine3::Rotation(1.f, Vec3(0.f, 1.f, 0.f)));
+    EXPECT_EQ(graph.Update(), 3u); // arm, hand, finger
+    EXPECT_EQ(graph.World(statue).rows, statueWorld.rows);
+    expectNear(graph.World(finger).ToMat4(), composedWorld(graph, finger).ToMat4());
+
+    // Two changes on one path: the subtree is still recomputed once
+    graph.SetLocal(hand, math::Affine3::Rotation(-0.5f, Vec3(0.f, 0.f, 1.f)));
+    graph.SetLocal(root, math::Affine3{});
+    EXPECT_EQ(graph.Update(), 5u);
+    expectNear(graph.World(finger).ToMat4(), composedWorld(graph, finger).ToMat4());
+    expectNear(graph.World(statue).ToMat4(), math::Affine3::Translation(Vec3(-2.f, 0.f, 0.f)).ToMat4());
+}
+
+TEST(SceneGraph, HandlesSurviveLaterInsertions) {
+    render::SceneGraph graph;
+    const render::NodeId a = graph.AddNode(render::kNoNode, math::Affine3::Translation(Vec3(1.f, 0.f, 0.f)));
+    const render::NodeId b = graph.AddNode(a, math::Affine3::Translation(Vec3(0.f, 1.f, 0.f)));
+    graph.Update();
+    // A second root and a child of `a` both land before `b` in breadth-first order
+    const render::NodeId c = graph.AddNode(render::kNoNode, math::Affine3::Translation(Vec3(0.f, 0.f, 5.f)));
+    const render::NodeId d = graph.AddNode(a, math::Affine3::Scale(Vec3(2.f)));
+    EXPECT_EQ(graph.Update(), 2u);
+    EXPECT_EQ(graph.Parent(b), a);
+    EXPECT_EQ(graph.Parent(d), a);
+    EXPECT_EQ(graph.Parent(c), render::kNoNode);
+    expectNear(graph.World(b).ToMat4(), math::Affine3::Translation(Vec3(1.f, 1.f, 0.f)).ToMat4());
+    expectNear(graph.World(d).ToMat4(), composedWorld(graph, d).ToMat4());
+    expectNear(graph.World(c).ToMat4(), graph.Local(c).ToMat4());
+}
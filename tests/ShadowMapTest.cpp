@@ -0,0 +1,84 @@
+//
+// Software shadow map: depth pass from a light, depth-compare lookups and PCF.
+// Built into the render_tests executable.
+//
+
+#include <gtest/gtest.h>
+#include "render/ShadowMap.hpp"
+#include <vector>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace {
+
+// Light straight above the origin; a 2x2 occluder at y = 2 over a 10x10 floor at y = 0
+struct Scene {
+    std::vector<Vec3> positions;
+    std::vector<std::uint32_t> indices;
+    Mat4 lightViewProj;
+
+    Scene() {
+        const auto quad = [this](float half, float y) {
+            const auto base = static_cast<std::uint32_t>(positions.size());
+            positions.insert(positions.end(), {{-half, y, -half}, {half, y, -half}, {half, y, half}, {-half, y, half}});
+            indices.insert(indices.end(), {base, base + 1, base + 2, base, base + 2, base + 3});
+        };
+        quad(5.f, 0.f);
+        quad(1.f, 2.f);
+        lightViewProj = glm::perspective(glm::radians(120.f), 1.f, 0.5f, 20.f) *
+                        glm::lookAt(Vec3{0.f, 5.f, 0.f}, Vec3{0.f}, Vec3{0.f, 0.f, -1.f});
+    }
+};
+
+render::ShadowMap renderScene(const Scene& scene, int size) {
+    render::ShadowMap map;
+    map.Resize(size);
+    map.Render(scene.positions, scene.indices, scene.lightViewProj);
+    return map;
+}
+
+} // namespace
+
+TEST(ShadowMap, OccluderShadowsTheFloorBelowIt) {
+    const Scene scene;
+    const render::ShadowMap map = renderScene(scene, 256);
+    EXPECT_EQ(map.Visibility({0.f, 0.f, 0.f}), 0.f);
+    EXPECT_EQ(map.Visibility({0.5f, 0.f, -1.f}), 0.f);
+    EXPECT_EQ(map.Visibility({3.f, 0.f, 0.f}), 1.f);
+}
+
+TEST(ShadowMap, LitSurfacesDoNotShadowThemselves) {
+    const Scene scene;
+    const render::ShadowMap map = renderScene(scene, 256);
+    for (const Vec3& p : {Vec3{0.f, 2.f, 0.f}, Vec3{0.7f, 2.f, -0.4f}, Vec3{4.f, 0.f, 4.f}, Vec3{-2.5f, 0.f, 1.f}}) {
+        EXPECT_EQ(map.Visibility(p), 1.f) << p.x << "," << p.y << "," << p.z;
+    }
+}
+
+TEST(ShadowMap, PcfSoftensTheShadowEdge) {
+    // The occluder edge x = 1 at height 2 lands on the floor at x = 5/3
+    const Scene scene;
+    const render::ShadowMap map = renderScene(scene, 128);
+    const Vec3 edge{5.f / 3.f, 0.f, 0.f};
+    const float soft = map.Visibility(edge, 4);
+    EXPECT_GT(soft, 0.f);
+    EXPECT_LT(soft, 1.f);
+    // Well inside or outside, filtering changes nothing
+    EXPECT_EQ(map.Visibility({0.f, 0.f, 0.f}, 4), 0.f);
+    EXPECT_EQ(map.Visibility({3.f, 0.f, 0.f}, 4), 1.f);
+}
+
+TEST(ShadowMap, BatchedLookupsMatchScalar) {
+    const Scene scene;
+    const render::ShadowMap map = renderScene(scene, 200); // not a multiple of the tile size
+    math::Vec3Batch points(10000);
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        const float f = static_cast<float>(i);
+        points.set(i, {4.f * std::sin(0.013f * f), 0.f, 4.f * std::cos(0.029f * f)});
+    }
+    std::vector<float> vis(points.size());
+    map.Visibility(points, 2, vis);
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        ASSERT_EQ(vis[i], map.Visibility(points.get(i), 2)) << i;
+    }
+}
@@ -0,0 +1,158 @@
+//
+// Planar shadow projection onto arbitrary planes, point and directional lights, and the
+// convex hull / silhouette reductions used to draw a shadow as one polygon.
+// Built into the render_tests executable.
+//
+
+#include <gtest/gtest.h>
+#include "TestUtil.hpp"
+#include "math/ConvexHull.hpp"
+#include "math/Shadow.h"
+#include "render/Silhouette.hpp"
+#include <array>
+#include <vector>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace {
+
+constexpr float kEps = 1e-4f;
+
+Vec3 project(const Mat4& M, const Vec3& p) {
+    const Vec4 r = M * Vec4(p, 1.f);
+    return Vec3(r) / r.w;
+}
+
+const math::Plane kTilted{glm::normalize(Vec3{0.3f, 1.f, -0.4f}), 0.7f};
+
+} // namespace
+
+TEST(PlanarShadow, MatchesLegacyGroundProjection) {
+    // The original y = 0 construction: translate to the light, project, translate back
+    const Vec3 light{2.f, 4.f, 1.f};
+    Mat4 M{1.f};
+    M[3][3] = 0.f;
+    M[1][3] = 1.f / -light.y;
+    const Mat4 legacy = glm::translate(Mat4(1.f), light) * M * glm::translate(Mat4(1.f), -light);
+
+    for (const Vec3& p : {Vec3{0.5f, 0.5f, -0.5f}, Vec3{-1.f, 2.f, 3.f}}) {
+        expectNear(project(math::shadowFrom(light), p), project(legacy, p), kEps);
+    }
+}
+
+TEST(PlanarShadow, PointLightLandsOnPlaneAlongLightRay) {
+    const Vec3 light{1.f, 5.f, 2.f};
+    const Mat4 S = math::planarShadow(kTilted, math::pointShadowLight(light));
+    const Vec3 p{0.2f, 1.5f, -0.3f};
+    const Vec3 s = project(S, p);
+
+    EXPECT_NEAR(glm::dot(kTilted.normal, s) + kTilted.offset, 0.f, kEps);
+    const Vec3 ray = glm::cross(p - light, s - light);
+    EXPECT_NEAR(glm::length(ray), 0.f, kEps);
+}
+
+TEST(PlanarShadow, DirectionalLightShiftsAlongDirection) {
+    const Vec3 dir = glm::normalize(Vec3{0.5f, -1.f, 0.25f});
+    const Mat4 S = math::planarShadow(kTilted, math::directionalShadowLight(dir));
+    const Vec3 p{0.2f, 1.5f, -0.3f};
+    const Vec3 s = project(S, p);
+
+    EXPECT_NEAR(glm::dot(kTilted.normal, s) + kTilted.offset, 0.f, kEps);
+    EXPECT_NEAR(glm::length(glm::cross(s - p, dir)), 0.f, kEps);
+    EXPECT_GT(glm::dot(s - p, dir), 0.f);
+}
+
+TEST(PlanarShadow, PointsOnThePlaneStayPut) {
+    const Mat4 S = math::planarShadow(kTilted, math::pointShadowLight({0.f, 6.f, 0.f}));
+    const Vec3 onPlane = -kTilted.offset * kTilted.normal + glm::cross(kTilted.normal, Vec3{1.f, 0.f, 0.f});
+    const Vec4 r = S * Vec4(onPlane, 1.f);
+    EXPECT_NEAR(r.w, 1.f, kEps);
+    expectNear(Vec3(r), onPlane, kEps);
+}
+
+TEST(ShadowProjector, RebuildsOnlyWhenInputsChange) {
+    const std::array<math::Plane, 2> planes = {math::Plane{}, kTilted};
+    math::ShadowProjector projector;
+    projector.SetReceivers(planes);
+    projector.SetLight(math::pointShadowLight({1.f, 4.f, 0.f}));
+    const std::size_t built = projector.Rebuilds();
+
+    projector.SetReceivers(planes);
+    projector.SetLight(math::pointShadowLight({1.f, 4.f, 0.f}));
+    EXPECT_EQ(projector.Rebuilds(), built);
+
+    projector.SetLight(math::pointShadowLight({1.f, 4.5f, 0.f}));
+    EXPECT_EQ(projector.Rebuilds(), built + 1);
+    ASSERT_EQ(projector.Matrices().size(), 2u);
+}
+
+TEST(ShadowProjector, BatchMatchesPerPointMatrices) {
+    const std::array<math::Plane, 2> planes = {math::Plane{}, kTilted};
+    math::ShadowProjector projector;
+    projector.SetReceivers(planes);
+    projector.SetLight(math::directionalShadowLight(glm::normalize(Vec3{0.2f, -1.f, 0.1f})));
+
+    math::Vec3Batch points(37);
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        const float f = static_cast<float>(i);
+        points.set(i, {0.1f * f - 1.f, 1.f + 0.05f * f, 0.5f - 0.03f * f});
+    }
+    std::vector<math::Vec3Batch> out;
+    projector.Project(points, out);
+
+    ASSERT_EQ(out.size(), planes.size());
+    for (std::size_t r = 0; r < planes.size(); ++r) {
+        for (std::size_t i = 0; i < points.size(); ++i) {
+            expectNear(out[r].get(i), project(projector.Matrices()[r], points.get(i)), kEps);
+        }
+    }
+}
+
+TEST(ConvexHull, DropsInteriorAndCollinearPoints) {
+    const std::vector<glm::vec2> points = {{0, 0}, {2, 0}, {1, 0}, {2, 2}, {0, 2}, {1, 1}, {0.5f, 1.5f}, {2, 2}};
+    const std::vector<glm::vec2> hull = math::convexHull(points);
+
+    ASSERT_EQ(hull.size(), 4u);
+    // Counter-clockwise from the lowest-leftmost point
+    const std::array<glm::vec2, 4> expected = {glm::vec2{0, 0}, glm::vec2{2, 0}, glm::vec2{2, 2}, glm::vec2{0, 2}};
+    for (std::size_t i = 0; i < hull.size(); ++i) {
+        EXPECT_FLOAT_EQ(hull[i].x, expected[i].x);
+        EXPECT_FLOAT_EQ(hull[i].y, expected[i].y);
+    }
+}
+
+TEST(ConvexHull, DegenerateInputsComeBackDeduplicated) {
+    const std::vector<glm::vec2> one = {{1, 1}, {1, 1}};
+    EXPECT_EQ(math::convexHull(one).size(), 1u);
+    EXPECT_TRUE(math::convexHull({}).empty());
+}
+
+TEST(Silhouette, CubeUnderOverheadLightIsTheTopRim) {
+    const render::IndexedMesh cube = render::MakeIndexedCube(render::MakeCube(0.5f));
+    render::SilhouetteExtractor extractor(cube);
+    EXPECT_EQ(extractor.EdgeCount(), 12u + 6u); // cube edges plus one diagonal per face
+
+    // Straight down: the top face is lit, the sides are edge-on and count as unlit
+    const auto& edges = extractor.Extract(cube.positions, math::directionalShadowLight({0.f, -1.f, 0.f}));
+    ASSERT_EQ(edges.size(), 4u);
+    for (const render::SilhouetteEdge& e : edges) {
+        EXPECT_FLOAT_EQ(cube.positions[e[0]].y, 0.5f);
+        EXPECT_FLOAT_EQ(cube.positions[e[1]].y, 0.5f);
+    }
+}
+
+TEST(Silhouette, CornerLightGivesAClosedSixEdgeLoop) {
+    const render::IndexedMesh cube = render::MakeIndexedCube(render::MakeCube(0.5f));
+    render::SilhouetteExtractor extractor(cube);
+    const auto& edges = extractor.Extract(cube.positions, math::pointShadowLight({3.f, 4.f, 5.f}));
+    ASSERT_EQ(edges.size(), 6u);
+
+    // Consistently wound: every edge's end is exactly one other edge's start (by position)
+    for (const render::SilhouetteEdge& e : edges) {
+        int next = 0;
+        for (const render::SilhouetteEdge& f : edges) {
+            next += cube.positions[e[1]] == cube.positions[f[0]];
+        }
+        EXPECT_EQ(next, 1);
+    }
+}
@@ -0,0 +1,189 @@
+//
+// CSR/CSC SparseMatrix assembly, products and reordering, checked against dense equivalents.
+// Built into the linalg_tests executable.
+//
+
+#include <gtest/gtest.h>
+#include "TestUtil.hpp"
+#include "math/Sparse.hpp"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr double kEps = 1e-12;
+
+constexpr math::Layout kRow = math::Layout::RowMajor;
+constexpr math::Layout kCol = math::Layout::ColMajor;
+
+// Random rows x cols pattern with about `perRow` entries per row, duplicates included.
+std::vector<math::Triplet<double>> sampleTriplets(std::size_t rows, std::size_t cols, std::size_t perRow,
+                                                  unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<std::uint32_t> col(0, static_cast<std::uint32_t>(cols - 1));
+    std::uniform_real_distribution<double> value(-1.0, 1.0);
+    std::vector<math::Triplet<double>> triplets;
+    for (std::uint32_t r = 0; r < rows; ++r) {
+        for (std::size_t k = 0; k < perRow; ++k) {
+            triplets.push_back({r, col(rng), value(rng)});
+        }
+    }
+    return triplets;
+}
+
+// 5-point Laplacian of a w x h grid, vertices numbered through `label` (label[grid] = index).
+math::SparseMatrix<double> gridLaplacian(std::uint32_t w, std::uint32_t h, const std::vector<std::uint32_t>& label) {
+    std::vector<math::Triplet<double>> triplets;
+    for (std::uint32_t y = 0; y < h; ++y) {
+        for (std::uint32_t x = 0; x < w; ++x) {
+            const std::uint32_t v = label[y * w + x];
+            triplets.push_back({v, v, 4.0});
+            if (x + 1 < w) {
+                triplets.push_back({v, label[y * w + x + 1], -1.0});
+                triplets.push_back({label[y * w + x + 1], v, -1.0});
+            }
+            if (y + 1 < h) {
+                triplets.push_back({v, label[(y + 1) * w + x], -1.0});
+                triplets.push_back({label[(y + 1) * w + x], v, -1.0});
+            }
+        }
+    }
+    return math::SparseMatrix<double>::FromTriplets(w * h, w * h, triplets);
+}
+
+} // namespace
+
+TEST(Sparse, TripletsSumDuplicatesAndDropOutOfRange) {
+    const std::vector<math::Triplet<double>> triplets = {
+        {1, 2, 1.0}, {0, 0, 2.0}, {1, 2, 0.5}, {3, 0, 9.0}, {1, 0, -1.0}, {0, 5, 9.0}, {1, 2, 0.25}};
+    for (math::Layout layout : {kRow, kCol}) {
+        const auto A = math::SparseMatrix<double>::FromTriplets(2, 3, triplets, layout);
+        EXPECT_EQ(A.NonZeros(), 3u);
+        EXPECT_DOUBLE_EQ(A(1, 2), 1.75);
+        EXPECT_DOUBLE_EQ(A(0, 0), 2.0);
+        EXPECT_DOUBLE_EQ(A(1, 0), -1.0);
+        EXPECT_DOUBLE_EQ(A(0, 1), 0.0);
+        for (std::size_t k = 0; k < A.OuterSize(); ++k) {
+            const auto slice = A.Indices().subspan(A.Offsets()[k], A.Offsets()[k + 1] - A.Offsets()[k]);
+            EXPECT_TRUE(std::is_sorted(slice.begin(), slice.end()));
+        }
+    }
+}
+
+TEST(Sparse, LayoutConversionAndTransposeKeepValues) {
+    const auto triplets = sampleTriplets(40, 25, 4, 1);
+    const auto csr = math::SparseMatrix<double>::FromTriplets(40, 25, triplets);
+    const auto csc = csr.WithLayout(kCol);
+    EXPECT_EQ(csc.GetLayout(), kCol);
+    expectMatrixNear(csr.ToDense(), csc.ToDense(), kEps);
+    expectMatrixNear(csc.WithLayout(kRow).ToDense(), csr.ToDense(), kEps);
+
+    const auto t = csr.Transposed();
+    EXPECT_EQ(t.Rows(), 25u);
+    expectMatrixNear(t.ToDense(), csr.ToDense().Transposed().WithLayout(kRow), kEps);
+}
+
+TEST(Sparse, SpmvMatchesDense) {
+    // Large enough to be split across threads
+    constexpr std::size_t kRows = 30000, kCols = 20000;
+    const auto triplets = sampleTriplets(kRows, kCols, 5, 2);
+    std::vector<double> x(kCols), y0(kRows);
+    for (std::size_t i = 0; i < kCols; ++i) x[i] = std::sin(0.1 * static_cast<double>(i));
+    for (std::size_t i = 0; i < kRows; ++i) y0[i] = std::cos(0.3 * static_cast<double>(i));
+
+    // Reference straight from the triplets
+    std::vector<double> ref(kRows);
+    for (std::size_t i = 0; i < kRows; ++i) ref[i] = 0.5 * y0[i];
+    for (const auto& t : triplets) ref[t.row] += 2.0 * t.value * x[t.col];
+
+    for (math::Layout layout : {kRow, kCol}) {
+        const auto A = math::SparseMatrix<double>::FromTriplets(kRows, kCols, triplets, layout);
+        ASSERT_GE(A.NonZeros(), std::size_t{1} << 16);
+        for (unsigned threads : {1u, 4u}) {
+            std::vector<double> y = y0;
+            ASSERT_TRUE(math::spmv<double>(A, x, y, 2.0, 0.5, threads));
+            for (std::size_t i = 0; i < kRows; ++i) {
+                ASSERT_NEAR(y[i], ref[i], 1e-12) << i;
+            }
+        }
+    }
+}
+
+TEST(Sparse, SpmmMatchesDenseForEveryLayout) {
+    const auto triplets = sampleTriplets(300, 200, 6, 3);
+    for (std::size_t k : {3u, 11u}) {
+        math::Matrix<double> X(200, k);
+        for (std::size_t r = 0; r < 200; ++r) {
+            for (std::size_t c = 0; c < k; ++c) X(r, c) = std::sin(static_cast<double>(r * 7 + c));
+        }
+        for (math::Layout la : {kRow, kCol}) {
+            const auto A = math::SparseMatrix<double>::FromTriplets(300, 200, triplets, la);
+            const math::Matrix<double> ref = A.ToDense() * X;
+            for (math::Layout lx : {kRow, kCol}) {
+                math::Matrix<double> Y(300, k, lx);
+                ASSERT_TRUE(math::spmm(A, X.WithLayout(lx), Y));
+                expectMatrixNear(Y, ref, kEps);
+            }
+        }
+    }
+}
+
+TEST(Sparse, ProductsRejectMismatchedSizes) {
+    const auto A = math::SparseMatrix<double>::Identity(4);
+    std::vector<double> x(3), y(4, 7.0);
+    EXPECT_FALSE(math::spmv<double>(A, x, y));
+    EXPECT_EQ(y[0], 7.0);
+    math::Matrix<double> X(4, 2), Y(4, 3);
+    EXPECT_FALSE(math::spmm(A, X, Y));
+}
+
+TEST(Sparse, PermutedMatchesDensePermutation) {
+    const auto A = math::SparseMatrix<double>::FromTriplets(30, 30, sampleTriplets(30, 30, 4, 4));
+    std::vector<std::uint32_t> order(30);
+    std::iota(order.begin(), order.end(), 0u);
+    std::shuffle(order.begin(), order.end(), std::mt19937(5));
+
+    const auto B = A.Permuted(order);
+    const auto dense = A.ToDense();
+    math::Matrix<double> ref(30, 30);
+    for (std::size_t i = 0; i < 30; ++i) {
+        for (std::size_t j = 0; j < 30; ++j) ref(i, j) = dense(order[i], order[j]);
+    }
+    expectMatrixNear(B.ToDense(), ref, kEps);
+
+    const auto inverse = math::invertPermutation(order);
+    for (std::size_t i = 0; i < 30; ++i) EXPECT_EQ(inverse[order[i]], i);
+}
+
+TEST(Sparse, ReverseCuthillMcKeeRecoversGridBandwidth) {
+    // A 40 x 25 grid numbered at random has bandwidth near n; RCM should bring it back to
+    // about the short side of the grid
+    constexpr std::uint32_t kW = 40, kH = 25;
+    std::vector<std::uint32_t> label(kW * kH);
+    std::iota(label.begin(), label.end(), 0u);
+    std::shuffle(label.begin(), label.end(), std::mt19937(6));
+    const auto A = gridLaplacian(kW, kH, label);
+    EXPECT_GT(A.Bandwidth(), 500u);
+
+    const auto order = math::reverseCuthillMcKee(A);
+    ASSERT_EQ(order.size(), A.Rows());
+    std::vector<std::uint32_t> sorted = order;
+    std::sort(sorted.begin(), sorted.end());
+    for (std::uint32_t i = 0; i < sorted.size(); ++i) ASSERT_EQ(sorted[i], i);
+
+    const auto B = A.Permuted(order);
+    EXPECT_LE(B.Bandwidth(), kH + 2u);
+    EXPECT_EQ(B.NonZeros(), A.NonZeros());
+}
+
+TEST(Sparse, ReverseCuthillMcKeeCoversDisconnectedComponents) {
+    const std::vector<math::Triplet<double>> triplets = {
+        {0, 0, 1.0}, {1, 1, 1.0}, {2, 2, 1.0}, {3, 3, 1.0}, {0, 3, 1.0}, {3, 0, 1.0}};
+    const auto order = math::reverseCuthillMcKee(math::SparseMatrix<double>::FromTriplets(4, 4, triplets));
+    std::vector<std::uint32_t> sorted = order;
+    std::sort(sorted.begin(), sorted.end());
+    EXPECT_EQ(sorted, (std::vector<std::uint32_t>{0, 1, 2, 3}));
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+//
+// Comparison helpers shared by the test files. expectNear compares vectors by distance and
+// glm matrices element by element; expectMatrixNear does the same for math::Matrix. Failures
+// name the offending element.
+//
+
+#include <gtest/gtest.h>
+#include <cstddef>
+
+#include "math/Matrix.hpp"
+#include "math/Types.hpp"
+
+inline void expectNear(const Vec3& a, const Vec3& b, float eps = 1e-5f) {
+    EXPECT_NEAR(glm::length(a - b), 0.f, eps) << "(" << a.x << ", " << a.y << ", " << a.z << ") vs ("
+                                              << b.x << ", " << b.y << ", " << b.z << ")";
+}
+
+inline void expectNear(const Vec4& a, const Vec4& b, float eps = 1e-5f) {
+    for (int k = 0; k < 4; ++k) {
+        EXPECT_NEAR(a[k], b[k], eps) << k;
+    }
+}
+
+inline void expectNear(const Mat3& a, const Mat3& b, float eps = 1e-5f) {
+    for (int c = 0; c < 3; ++c) {
+        for (int r = 0; r < 3; ++r) {
+            EXPECT_NEAR(a[c][r], b[c][r], eps) << "(" << r << ", " << c << ")";
+        }
+    }
+}
+
+inline void expectNear(const Mat4& a, const Mat4& b, float eps = 1e-5f) {
+    for (int c = 0; c < 4; ++c) {
+        for (int r = 0; r < 4; ++r) {
+            EXPECT_NEAR(a[c][r], b[c][r], eps) << "(" << r << ", " << c << ")";
+        }
+    }
+}
+
+template <class T>
+void expectMatrixNear(const math::Matrix<T>& a, const math::Matrix<T>& b, T eps) {
+    ASSERT_EQ(a.Rows(), b.Rows());
+    ASSERT_EQ(a.Cols(), b.Cols());
+    for (std::size_t r = 0; r < a.Rows(); ++r) {
+        for (std::size_t c = 0; c < a.Cols(); ++c) {
+            ASSERT_NEAR(a(r, c), b(r, c), eps) << "(" << r << ", " << c << ")";
+        }
+    }
+}